@@ -0,0 +1,352 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/enums/MessageContext.hpp"
+#include "controllers/filters/FilterRecord.hpp"
+#include "controllers/filters/FilterSet.hpp"
+#include "messages/layouts/MessageLayout.hpp"
+#include "messages/layouts/MessageLayoutContext.hpp"
+#include "messages/Message.hpp"
+#include "MessageBuilding.hpp"
+#include "providers/twitch/IrcMessageHandler.hpp"
+#include "providers/twitch/TwitchChannel.hpp"
+#include "singletons/Settings.hpp"
+#include "util/VectorMessageSink.hpp"
+
+#include <benchmark/benchmark.h>
+#include <IrcMessage>
+#include <QFile>
+#include <QString>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+using namespace Qt::Literals;
+
+// Allocations are counted by interposing glibc's malloc. Sanitizers
+// replace malloc themselves, so there's no count with them. With
+// CHATTERINO_DEBUG_STAGE_ALLOCATIONS, chatterino-lib interposes it already.
+#if defined(__GLIBC__) && !defined(CHATTERINO_BENCHMARK_NO_MALLOC_HOOKS) && \
+    !defined(CHATTERINO_DEBUG_STAGE_ALLOCATIONS)
+#    define INGEST_REPLAY_COUNT_ALLOCATIONS
+#endif
+
+namespace {
+
+/// Only set on the thread running the replay while it processes a message,
+/// so other benchmarks and background threads aren't counted
+thread_local bool countAllocations = false;
+thread_local uint64_t allocationCount = 0;
+
+}  // namespace
+
+#ifdef INGEST_REPLAY_COUNT_ALLOCATIONS
+
+// NOLINTBEGIN(bugprone-reserved-identifier,readability-identifier-naming)
+extern "C" {
+
+void *__libc_malloc(std::size_t size) noexcept;
+void *__libc_calloc(std::size_t count, std::size_t size) noexcept;
+void *__libc_realloc(void *ptr, std::size_t size) noexcept;
+
+// operator new and Qt's containers both end up here
+void *malloc(std::size_t size) noexcept
+{
+    allocationCount += countAllocations ? 1 : 0;
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size) noexcept
+{
+    allocationCount += countAllocations ? 1 : 0;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, std::size_t size) noexcept
+{
+    allocationCount += countAllocations ? 1 : 0;
+    return __libc_realloc(ptr, size);
+}
+
+}  // extern "C"
+// NOLINTEND(bugprone-reserved-identifier,readability-identifier-naming)
+
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int LAYOUT_WIDTH = 400;
+
+/// A filter that has to look at every message, but doesn't hide any
+const QString FILTER_TEXT =
+    uR".(!(message.content contains "ingest-replay-never-matches"))."_s;
+
+struct RecordedEvent {
+    /// Time since the start of the recording
+    std::chrono::milliseconds offset;
+    QByteArray line;
+};
+
+/// Reads a recording where each line is `<milliseconds>\t<raw IRC line>`.
+/// Empty lines and lines starting with `#` are skipped.
+std::vector<RecordedEvent> readRecording(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QFile::ReadOnly))
+    {
+        _exit(1);
+    }
+
+    std::vector<RecordedEvent> events;
+    while (!file.atEnd())
+    {
+        auto line = file.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#'))
+        {
+            continue;
+        }
+
+        auto tab = line.indexOf('\t');
+        bool ok = false;
+        auto offset = line.left(tab).toLongLong(&ok);
+        if (tab < 0 || !ok)
+        {
+            _exit(1);
+        }
+        events.push_back({
+            .offset = std::chrono::milliseconds(offset),
+            .line = line.mid(tab + 1),
+        });
+    }
+
+    return events;
+}
+
+enum class Stage : uint8_t {
+    /// Tokenizing the raw line into a Communi::IrcMessage
+    Parse,
+    /// Building the messages, this includes checking highlights
+    Build,
+    Filter,
+    /// Channel::addMessage
+    Add,
+    Layout,
+};
+constexpr std::array STAGE_NAMES = {"parse", "build", "filter", "add",
+                                    "layout"};
+
+class StageSamples
+{
+public:
+    void add(Stage stage, Clock::duration elapsed)
+    {
+        this->samples_[static_cast<size_t>(stage)].push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count());
+    }
+
+    /// Time spent in all stages
+    std::chrono::nanoseconds total() const
+    {
+        int64_t sum = 0;
+        for (const auto &stage : this->samples_)
+        {
+            for (auto sample : stage)
+            {
+                sum += sample;
+            }
+        }
+        return std::chrono::nanoseconds(sum);
+    }
+
+    /// Adds `<stage>_p50` and `<stage>_p99` counters in nanoseconds
+    void report(benchmark::State &state)
+    {
+        for (size_t i = 0; i < this->samples_.size(); i++)
+        {
+            auto &samples = this->samples_[i];
+            if (samples.empty())
+            {
+                continue;
+            }
+            std::ranges::sort(samples);
+            auto at = [&](double percentile) {
+                auto idx = static_cast<size_t>(
+                    percentile * static_cast<double>(samples.size() - 1));
+                return static_cast<double>(samples[idx]);
+            };
+            std::string name = STAGE_NAMES[i];
+            state.counters[name + "_p50"] = at(0.5);
+            state.counters[name + "_p99"] = at(0.99);
+        }
+    }
+
+private:
+    std::array<std::vector<int64_t>, STAGE_NAMES.size()> samples_;
+};
+
+/**
+ * Replays a recording of raw IRC traffic through the same stages a message
+ * goes through when it's received: parsing, building (with highlights),
+ * filtering, adding it to the channel and laying it out.
+ *
+ * The benchmark argument is the speed-up over the recorded timing. With 0,
+ * the messages are replayed as fast as possible. Otherwise, each message
+ * waits for its (scaled) time and `max_lag_ms` reports how far the ingest
+ * fell behind.
+ *
+ * On glibc, `allocs_per_msg` reports the malloc, calloc and realloc calls
+ * per message, from any stage.
+ **/
+class IngestReplay : public bench::MessageBenchmark
+{
+public:
+    explicit IngestReplay(const QString &recording)
+        : bench::MessageBenchmark(u"nymn"_s)
+        , events(readRecording(u":/bench/ingest-%1.txt"_s.arg(recording)))
+    {
+        auto id = QUuid(0x1265e57, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        getSettings()->filterRecords.append(
+            std::make_shared<FilterRecord>(u"ingest"_s, FILTER_TEXT, id));
+        this->filters = std::make_unique<FilterSet>(QList<QUuid>{id});
+    }
+
+    void run(benchmark::State &state) override
+    {
+        auto speedUp = state.range(0);
+        auto wordFlags = getApp()->getWindows()->getWordFlags();
+        MessageColors colors;
+
+        StageSamples samples;
+        int64_t nMessages = 0;
+        uint64_t nAllocations = 0;
+        Clock::duration maxLag{};
+
+        for (auto _ : state)
+        {
+            auto start = Clock::now();
+            for (const auto &event : this->events)
+            {
+                if (speedUp > 0)
+                {
+                    auto due = start + event.offset / speedUp;
+                    std::this_thread::sleep_until(due);
+                    maxLag = std::max(maxLag, Clock::now() - due);
+                }
+
+                auto allocationsBefore = allocationCount;
+                countAllocations = true;
+
+                auto t0 = Clock::now();
+                std::unique_ptr<Communi::IrcMessage> ircMessage(
+                    Communi::IrcMessage::fromData(event.line, nullptr));
+                auto t1 = Clock::now();
+                samples.add(Stage::Parse, t1 - t0);
+
+                VectorMessageSink sink;
+                IrcMessageHandler::parseMessageInto(ircMessage.get(), sink,
+                                                    this->chan.get());
+                auto built = std::move(sink).takeMessages();
+                auto t2 = Clock::now();
+                samples.add(Stage::Build, t2 - t1);
+
+                for (const auto &msg : built)
+                {
+                    auto f0 = Clock::now();
+                    bool shown = this->filters->filter(msg, this->chan);
+                    auto f1 = Clock::now();
+                    samples.add(Stage::Filter, f1 - f0);
+                    if (!shown)
+                    {
+                        continue;
+                    }
+
+                    this->chan->addMessage(msg, MessageContext::Original);
+                    auto f2 = Clock::now();
+                    samples.add(Stage::Add, f2 - f1);
+
+                    MessageLayout layout(msg);
+                    layout.layout(
+                        {
+                            .messageColors = colors,
+                            .flags = wordFlags,
+                            .width = LAYOUT_WIDTH,
+                            .scale = 1,
+                            .imageScale = 1,
+                            .selectedChannel = nullptr,
+                            .message = *msg,
+                        },
+                        false);
+                    samples.add(Stage::Layout, Clock::now() - f2);
+                    benchmark::DoNotOptimize(layout.getHeight());
+                }
+
+                countAllocations = false;
+                nMessages += static_cast<int64_t>(built.size());
+                nAllocations += allocationCount - allocationsBefore;
+            }
+        }
+
+        samples.report(state);
+        state.SetItemsProcessed(nMessages);
+
+        auto busy = std::chrono::duration<double>(samples.total()).count();
+        if (busy > 0)
+        {
+            state.counters["msgs_per_s"] =
+                static_cast<double>(nMessages) / busy;
+        }
+#ifdef INGEST_REPLAY_COUNT_ALLOCATIONS
+        if (nMessages > 0)
+        {
+            state.counters["allocs_per_msg"] =
+                static_cast<double>(nAllocations) /
+                static_cast<double>(nMessages);
+        }
+#endif
+        if (speedUp > 0)
+        {
+            state.counters["max_lag_ms"] =
+                std::chrono::duration<double, std::milli>(maxLag).count();
+        }
+    }
+
+private:
+    std::vector<RecordedEvent> events;
+    std::unique_ptr<FilterSet> filters;
+};
+
+void BM_IngestReplay(benchmark::State &state, const QString &recording)
+{
+    IngestReplay bench(recording);
+    bench.run(state);
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_IngestReplay, raid, u"raid"_s)
+    ->Arg(0)
+    ->Arg(20)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_IngestReplay, subtrain, u"subtrain"_s)
+    ->Arg(0)
+    ->Arg(20)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_IngestReplay, emotes, u"emotes"_s)
+    ->Arg(0)
+    ->Arg(20)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
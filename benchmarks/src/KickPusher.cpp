@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/kick/KickPusherEvent.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/json.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+constexpr size_t FRAMES = 5000;
+constexpr uint64_t ROOM_ID = 668;
+
+std::string makeFrame(std::string_view event, std::string_view channel,
+                      const boost::json::object &data)
+{
+    return boost::json::serialize(boost::json::object{
+        {"event", event},
+        {"channel", channel},
+        {"data", boost::json::serialize(data)},
+    });
+}
+
+boost::json::object makeChatMessage(size_t i, std::mt19937 &rng)
+{
+    std::uniform_int_distribution<int> words(3, 30);
+    std::string content;
+    for (int w = words(rng); w > 0; w--)
+    {
+        content += w % 4 == 0 ? "[emote:37226:KEKW] " : "chatting ";
+    }
+
+    boost::json::array badges;
+    if (i % 3 == 0)
+    {
+        badges.emplace_back(boost::json::object{
+            {"type", "subscriber"},
+            {"text", "Subscriber"},
+            {"count", 6},
+        });
+    }
+    if (i % 17 == 0)
+    {
+        badges.emplace_back(boost::json::object{
+            {"type", "moderator"},
+            {"text", "Moderator"},
+        });
+    }
+
+    return {
+        {"id", "9f4a2a1e-2c7b-4e0a-8f0e-" + std::to_string(100000 + i)},
+        {"chatroom_id", ROOM_ID},
+        {"content", content},
+        {"type", i % 10 == 0 ? "reply" : "message"},
+        {"created_at", "2026-10-18T12:00:00+00:00"},
+        {"sender",
+         boost::json::object{
+             {"id", 1000 + (i % 400)},
+             {"username", "chatter" + std::to_string(i % 400)},
+             {"slug", "chatter" + std::to_string(i % 400)},
+             {"identity",
+              boost::json::object{
+                  {"color", "#75FD46"},
+                  {"badges", badges},
+              }},
+         }},
+        {"metadata", i % 10 == 0 ? boost::json::value(boost::json::object{
+                                       {"original_message",
+                                        boost::json::object{
+                                            {"id", "reply-target"},
+                                            {"content", "hello"},
+                                        }},
+                                   })
+                                 : boost::json::value()},
+    };
+}
+
+/// A synthesized busy chat: mostly chat messages, with the occasional
+/// deletion, ban and pong mixed in.
+///
+/// Unlike the Twitch benchmarks, this doesn't replay a recording: there's
+/// none of Kick's websocket, and recording a real chat would check in other
+/// people's messages. The payloads have the fields KickMessageBuilder reads.
+std::vector<std::string> makeFrames()
+{
+    std::mt19937 rng(1337);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    auto channel = "chatrooms." + std::to_string(ROOM_ID) + ".v2";
+
+    std::vector<std::string> frames;
+    frames.reserve(FRAMES);
+    for (size_t i = 0; i < FRAMES; i++)
+    {
+        auto roll = percent(rng);
+        if (roll < 2)
+        {
+            frames.emplace_back(makeFrame("App\\Events\\MessageDeletedEvent",
+                                          channel,
+                                          {
+                                              {"id", "deleted"},
+                                              {"message",
+                                               boost::json::object{
+                                                   {"id", "message"},
+                                               }},
+                                          }));
+        }
+        else if (roll < 3)
+        {
+            frames.emplace_back(makeFrame(
+                "App\\Events\\UserBannedEvent", channel,
+                {
+                    {"id", "ban"},
+                    {"user",
+                     boost::json::object{{"id", 1}, {"username", "spammer"}}},
+                    {"banned_by",
+                     boost::json::object{{"id", 2}, {"username", "mod"}}},
+                    {"permanent", true},
+                }));
+        }
+        else if (roll < 4)
+        {
+            frames.emplace_back(R"({"event":"pusher:pong","data":"{}"})");
+        }
+        else
+        {
+            frames.emplace_back(makeFrame("App\\Events\\ChatMessageEvent",
+                                          channel, makeChatMessage(i, rng)));
+        }
+    }
+    return frames;
+}
+
+/// How frames were decoded before: two parses using the default allocator.
+void BM_KickPusher_DecodeDefaultAllocator(benchmark::State &state)
+{
+    auto frames = makeFrames();
+    size_t bytes = 0;
+    for (const auto &frame : frames)
+    {
+        bytes += frame.size();
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto &frame : frames)
+        {
+            boost::system::error_code ec;
+            auto root = boost::json::parse(frame, ec);
+            boost::json::value data;
+            const auto *obj = root.if_object();
+            if (const auto *str = obj ? obj->if_contains("data") : nullptr;
+                str && str->is_string() && str->get_string() != "{}")
+            {
+                data = boost::json::parse(str->get_string(), ec);
+            }
+            benchmark::DoNotOptimize(data);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<int64_t>(frames.size()));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+
+void BM_KickPusher_Decode(benchmark::State &state)
+{
+    auto frames = makeFrames();
+    size_t bytes = 0;
+    for (const auto &frame : frames)
+    {
+        bytes += frame.size();
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto &frame : frames)
+        {
+            auto event = KickPusherEvent::decode(frame);
+            benchmark::DoNotOptimize(event);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<int64_t>(frames.size()));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+
+}  // namespace
+
+BENCHMARK(BM_KickPusher_DecodeDefaultAllocator);
+BENCHMARK(BM_KickPusher_Decode);
@@ -94,6 +94,43 @@ void BM_LimitedQueue_Snapshot_ExpensiveCopy(benchmark::State &state)
     }
 }
 
+/// A view appending a message and taking a snapshot to lay it out
+void BM_LimitedQueue_PushBack_Snapshot(benchmark::State &state)
+{
+    LimitedQueue<std::shared_ptr<int>> queue(1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        queue.pushBack(std::make_shared<int>(i));
+    }
+
+    auto item = std::make_shared<int>(0);
+    auto snapshot = queue.getSnapshot();
+    for (auto _ : state)
+    {
+        queue.pushBack(item);
+        snapshot = queue.getSnapshot();
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+
+/// Replacing an item while a snapshot is held has to copy the items
+void BM_LimitedQueue_Replace_Snapshot(benchmark::State &state)
+{
+    LimitedQueue<std::shared_ptr<int>> queue(1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        queue.pushBack(std::make_shared<int>(i));
+    }
+
+    auto item = std::make_shared<int>(0);
+    for (auto _ : state)
+    {
+        auto snapshot = queue.getSnapshot();
+        queue.replaceItem(500, item);
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+
 void BM_LimitedQueue_Find(benchmark::State &state)
 {
     LimitedQueue<int> queue(1000);
@@ -117,4 +154,6 @@ BENCHMARK(BM_LimitedQueue_PushFront_Many);
 BENCHMARK(BM_LimitedQueue_Replace);
 BENCHMARK(BM_LimitedQueue_Snapshot);
 BENCHMARK(BM_LimitedQueue_Snapshot_ExpensiveCopy);
+BENCHMARK(BM_LimitedQueue_PushBack_Snapshot);
+BENCHMARK(BM_LimitedQueue_Replace_Snapshot);
 BENCHMARK(BM_LimitedQueue_Find);
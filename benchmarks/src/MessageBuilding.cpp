@@ -47,6 +47,8 @@ namespace chatterino::bench {
 
 MockMessageApplication::MockMessageApplication()
     : highlights(this->settings, &this->accounts)
+    , windowManager(this->args_, this->paths_, this->settings, this->theme,
+                    this->fonts)
 {
     this->settings.disableSave();
 }
@@ -17,6 +17,7 @@
 #include "providers/seventv/SeventvBadges.hpp"
 #include "providers/seventv/SeventvPersonalEmotes.hpp"
 #include "providers/twitch/TwitchBadges.hpp"
+#include "singletons/WindowManager.hpp"
 
 #include <benchmark/benchmark.h>
 
@@ -112,6 +113,11 @@ public:
         return &this->seventvPersonalEmotes;
     }
 
+    WindowManager *getWindows() override
+    {
+        return &this->windowManager;
+    }
+
     mock::EmptyLogging logging;
     AccountController accounts;
     mock::EmoteController emotes;
@@ -129,6 +135,7 @@ public:
     SeventvEmotes seventvEmotes;
     DisabledStreamerMode streamerMode;
     SeventvPersonalEmotes seventvPersonalEmotes;
+    WindowManager windowManager;
 };
 
 class MessageBenchmark
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/repetitions/RepeatedMessageDetector.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+
+#include <random>
+#include <vector>
+
+using namespace chatterino;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+constexpr int MESSAGES = 20000;
+
+/// A chat where a spam wave starts halfway through: `spammers` users repeat
+/// one of a few messages with small variations, everyone else chats
+/// normally.
+std::vector<RepeatedMessageCheck> makeSpamWave(int chatters, int spammers)
+{
+    std::mt19937 rng(1337);
+    std::uniform_int_distribution<int> chatter(0, chatters - 1);
+    std::uniform_int_distribution<int> spammer(0, spammers - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    const std::vector<QString> spam{
+        u"FREE SUBS AT example dot com go go go"_s,
+        u"!!!!! COPY PASTE THIS IN CHAT IF YOU ARE A TRUE FAN !!!!!"_s,
+        u"KEKW KEKW KEKW KEKW KEKW KEKW KEKW"_s,
+    };
+    const std::vector<QString> words{
+        u"forsen"_s, u"pajlada"_s, u"LULW"_s, u"the"_s,  u"stream"_s,
+        u"is"_s,     u"good"_s,    u"today"_s, u"what"_s, u"game"_s,
+    };
+
+    std::vector<RepeatedMessageCheck> checks;
+    checks.reserve(MESSAGES);
+    for (int i = 0; i < MESSAGES; i++)
+    {
+        RepeatedMessageCheck check{
+            .channelID = u"11148817"_s,
+            .messageID = QString::number(i),
+            .channelCanModerate = true,
+        };
+
+        if (i > MESSAGES / 2 && percent(rng) < 70)
+        {
+            check.userID = u"spammer"_s + QString::number(spammer(rng));
+            check.message = spam[static_cast<size_t>(i) % spam.size()];
+            // Bypass attempts, matched through the sketches
+            if (percent(rng) < 50)
+            {
+                check.message += u" "_s + QString::number(percent(rng));
+            }
+        }
+        else
+        {
+            check.userID = u"user"_s + QString::number(chatter(rng));
+            for (int w = 0; w < 6; w++)
+            {
+                check.message += words[static_cast<size_t>(percent(rng)) %
+                                       words.size()] +
+                                 u' ';
+            }
+        }
+        checks.push_back(std::move(check));
+    }
+    return checks;
+}
+
+void BM_RepeatedMessageDetector_SpamWave(benchmark::State &state)
+{
+    auto checks = makeSpamWave(static_cast<int>(state.range(0)),
+                               static_cast<int>(state.range(1)));
+
+    size_t trackedUsers = 0;
+    for (auto _ : state)
+    {
+        RepeatedMessageDetector detector;
+        for (const auto &check : checks)
+        {
+            auto count = detector.check(check);
+            benchmark::DoNotOptimize(count);
+        }
+        trackedUsers = detector.trackedUsers();
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<int64_t>(checks.size()));
+    state.counters["trackedUsers"] = static_cast<double>(trackedUsers);
+}
+
+}  // namespace
+
+BENCHMARK(BM_RepeatedMessageDetector_SpamWave)
+    ->Args({1000, 50})
+    ->Args({100000, 500})
+    ->Args({100000, 5000});
@@ -156,12 +156,26 @@ declare namespace c2 {
 
     enum EventType {
         CompletionRequested = "CompletionRequested",
+        MessagesReceived = "MessagesReceived",
+    }
+
+    interface MessageBatchEntry {
+        channel: Channel;
+        message: Message;
+    }
+
+    interface MessageBatch {
+        entries: MessageBatchEntry[];
+        dropped: number;
     }
 
     type CbFuncCompletionsRequested = (ev: CompletionEvent) => CompletionList;
+    type CbFuncMessagesReceived = (batch: MessageBatch) => void;
     type CbFunc<T> = T extends EventType.CompletionRequested
         ? CbFuncCompletionsRequested
-        : never;
+        : T extends EventType.MessagesReceived
+          ? CbFuncMessagesReceived
+          : never;
 
     function register_callback<T>(type: T, func: CbFunc<T>): void;
     function later(callback: () => void, msec: number): void;
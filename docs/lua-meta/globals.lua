@@ -18,6 +18,7 @@ c2.LogLevel = {
 ---@enum c2.EventType
 c2.EventType = {
     CompletionRequested = {}, ---@type c2.EventType.CompletionRequested
+    MessagesReceived = {}, ---@type c2.EventType.MessagesReceived
 }
 
 -- End src/controllers/plugins/api/EventType.hpp
@@ -36,6 +37,14 @@ c2.EventType = {
 ---@field cursor_position integer Position of the cursor in the text input in unicode codepoints (not bytes)
 ---@field is_first_word boolean True if this is the first word in the input
 
+---@class MessageBatchEntry
+---@field channel c2.Channel The channel the message was added to
+---@field message c2.Message The message. It's frozen and can't be modified.
+
+---@class MessageBatch
+---@field entries MessageBatchEntry[] Messages added since the last batch, oldest first
+---@field dropped integer Number of messages that were dropped since the last batch because they arrived faster than they could be delivered
+
 
 
 ---@alias QSize [integer, integer] A pair of [width, height]
@@ -960,8 +969,13 @@ c2.HTTPMethod = {
 ---@return boolean ok  Returns `true` if everything went ok, `false` if a command with this name exists.
 function c2.register_command(name, handler) end
 
---- Registers a callback to be invoked when completions for a term are requested.
+--- Registers a callback to be invoked when completions for a term are requested
+--- or when messages were added to any channel.
+---
+--- Messages are delivered in batches. A batch callback that runs for too long
+--- is aborted, and the following batch is skipped.
 ---
+---@overload fun(type: c2.EventType.MessagesReceived, func: fun(batch: MessageBatch))
 ---@param type c2.EventType.CompletionRequested
 ---@param func fun(event: CompletionEvent): CompletionList The callback to be invoked.
 function c2.register_callback(type, func) end
@@ -67,6 +67,11 @@ public:
         return &this->twitchUsers;
     }
 
+    UserMetadataStore *getUserMetadata() override
+    {
+        return nullptr;
+    }
+
     BttvLiveUpdates *getBttvLiveUpdates() override
     {
         return nullptr;
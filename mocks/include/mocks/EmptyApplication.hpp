@@ -315,6 +315,13 @@ public:
         return nullptr;
     }
 
+    UserMetadataStore *getUserMetadata() override
+    {
+        assert(false && "EmptyApplication::getUserMetadata was called without "
+                        "being initialized");
+        return nullptr;
+    }
+
     eventsub::IController *getEventSub() override
     {
         assert(false && "EmptyApplication::getEventSub was called without "
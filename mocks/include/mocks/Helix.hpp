@@ -534,7 +534,8 @@ public:
          (FailureCallback<HelixUnpinMessageError, QString>)failureCallback),
         (override));
 
-    MOCK_METHOD(void, update, (QString clientId, QString oauthToken),
+    MOCK_METHOD(void, update,
+                (QString clientId, QString userId, QString oauthToken),
                 (override));
 
 protected:
@@ -17,8 +17,10 @@
 #include "controllers/notifications/NotificationController.hpp"
 #include "controllers/sound/ISoundController.hpp"
 #include "controllers/spellcheck/SpellChecker.hpp"
+#include "debug/StartupTrace.hpp"
 #include "providers/bttv/BttvBadges.hpp"
 #include "providers/bttv/BttvEmotes.hpp"
+#include "providers/emoji/Emojis.hpp"
 #include "providers/ffz/FfzEmotes.hpp"
 #include "providers/kick/KickChatServer.hpp"
 #include "providers/links/LinkResolver.hpp"
@@ -59,6 +61,7 @@
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "providers/twitch/TwitchUsers.hpp"
+#include "providers/UserMetadataStore.hpp"
 #include "singletons/CrashHandler.hpp"
 #include "singletons/Fonts.hpp"
 #include "singletons/helper/LoggingChannel.hpp"
@@ -80,10 +83,14 @@
 #include <QApplication>
 #include <QDateTime>
 #include <QDesktopServices>
+#include <QFuture>
+#include <QtConcurrent>
 #include <QTimer>
 #include <QUrl>
 #include <QUrlQuery>
 
+#include <utility>
+
 namespace {
 
 using namespace chatterino;
@@ -116,6 +123,42 @@ ISoundController *makeSoundController(Settings &settings)
     }
 }
 
+/// Decodes the sounds that highlights can play, so the first ping of a
+/// custom sound doesn't have to read it from the disk
+void preloadHighlightSounds(ISoundController &sound, Settings &settings)
+{
+    sound.preload(QUrl::fromLocalFile(settings.pathHighlightSound));
+    for (const auto *url : {
+             &settings.selfHighlightSoundUrl,
+             &settings.whisperHighlightSoundUrl,
+             &settings.subHighlightSoundUrl,
+             &settings.automodHighlightSoundUrl,
+             &settings.threadHighlightSoundUrl,
+         })
+    {
+        sound.preload(QUrl(url->getValue()));
+    }
+
+    for (const auto *phrases :
+         {&settings.highlightedMessages, &settings.highlightedUsers})
+    {
+        for (const auto &phrase : *phrases->readOnly())
+        {
+            if (phrase.hasCustomSound())
+            {
+                sound.preload(phrase.getSoundUrl());
+            }
+        }
+    }
+    for (const auto &badge : *settings.highlightedBadges.readOnly())
+    {
+        if (badge.hasCustomSound())
+        {
+            sound.preload(badge.getSoundUrl());
+        }
+    }
+}
+
 BttvLiveUpdates *makeBttvLiveUpdates(Settings &settings)
 {
     bool enabled =
@@ -210,6 +253,7 @@ Application::Application(Settings &_settings, const Paths &paths,
     , seventvEventAPI(makeSeventvEventAPI(_settings))
     , linkResolver(new LinkResolver)
     , streamerMode(new StreamerMode)
+    , userMetadata(new UserMetadataStore(paths.cacheFilePath("users.bin")))
     , twitchUsers(new TwitchUsers)
     , pronouns(new pronouns::Pronouns)
     , spellChecker(new SpellChecker)
@@ -252,32 +296,108 @@ void Application::initialize(Settings &settings, const Paths &paths)
     {
         getSettings()->currentVersion.setValue(CHATTERINO_VERSION);
     }
-    this->emotes->initialize();
-
-    this->accounts->load();
-
-    this->windows->initialize();
-
-    this->ffzBadges->load();
-    this->moltorinoSupporterBadges->initialize();
 
-    // Load global emotes
-    this->bttvEmotes->loadEmotes();
-    this->ffzEmotes->loadEmotes();
-    this->seventvEmotes->loadGlobalEmotes();
-
-    this->twitch->initialize();
-    this->kickChatServer->initialize();
+    StartupTrace::Scope initTrace("init", "Application::initialize");
+    auto step = [](const char *name, auto &&fn) {
+        StartupTrace::Scope trace("init", name);
+        fn();
+    };
+    // Runs a step that doesn't need the GUI thread on the thread pool. It has
+    // to be waited for before the steps that depend on it.
+    auto background = [this, step](const char *name,
+                                   auto &&fn) -> QFuture<void> {
+        if (this->args_.sequentialStartup)
+        {
+            step(name, fn);
+            return {};
+        }
+        return QtConcurrent::run([step, name, fn] {
+            step(name, fn);
+        });
+    };
+
+    // The steps are ordered by their dependencies:
+    //
+    //   emoji data (thread pool) -> emotes -> windows
+    //   accounts -> global badges (Helix needs the current account)
+    //   emotes, accounts -> windows -> chat servers, notifications, plugins
+    //
+    // The emoji data is parsed while the GUI thread loads the accounts and
+    // starts the global badge and emote requests. Those requests are in
+    // flight while the windows and their splits are built, instead of
+    // queueing behind the requests of every split.
+    auto emojiData = background("emoji data", [this] {
+        this->emotes->getEmojis()->loadData();
+    });
+
+    step("accounts", [this] {
+        this->accounts->load();
+    });
+
+    step("global badges", [this] {
+        this->ffzBadges->load();
+        this->moltorinoSupporterBadges->initialize();
+        this->twitchBadges->loadTwitchBadges();
+    });
+    step("global emotes", [this] {
+        this->bttvEmotes->loadEmotes();
+        this->ffzEmotes->loadEmotes();
+        this->seventvEmotes->loadGlobalEmotes();
+    });
+
+    step("emotes", [this, &emojiData] {
+        emojiData.waitForFinished();
+        this->emotes->initialize();
+    });
+
+    step("windows", [this] {
+        this->windows->initialize();
+    });
+
+    step("chat servers", [this] {
+        this->twitch->initialize();
+        this->kickChatServer->initialize();
+    });
 
     // Load live status
-    this->notifications->initialize();
+    step("notifications", [this] {
+        this->notifications->initialize();
+    });
 
-    // XXX: Loading Twitch badges after Helix has been initialized, which only happens after
-    // the AccountController initialize has been called
-    this->twitchBadges->loadTwitchBadges();
+    step("sounds", [this, &settings] {
+        preloadHighlightSounds(*this->sound, settings);
+
+        // Settings are only-ever destroyed on application exit
+        // NOTE: SETTINGS_LIFETIME
+        auto reload = [this, &settings] {
+            if (this->sound)
+            {
+                preloadHighlightSounds(*this->sound, settings);
+            }
+        };
+        std::ignore = settings.highlightedMessages.delayedItemsChanged.connect(
+            reload);
+        std::ignore =
+            settings.highlightedUsers.delayedItemsChanged.connect(reload);
+        std::ignore =
+            settings.highlightedBadges.delayedItemsChanged.connect(reload);
+        for (auto *url : {
+                 &settings.pathHighlightSound,
+                 &settings.selfHighlightSoundUrl,
+                 &settings.whisperHighlightSoundUrl,
+                 &settings.subHighlightSoundUrl,
+                 &settings.automodHighlightSoundUrl,
+                 &settings.threadHighlightSoundUrl,
+             })
+        {
+            url->connect(reload, false);
+        }
+    });
 
 #ifdef CHATTERINO_HAVE_PLUGINS
-    this->plugins->initialize(settings);
+    step("plugins", [this, &settings] {
+        this->plugins->initialize(settings);
+    });
 #endif
 
     // Show crash message.
@@ -364,7 +484,7 @@ void Application::initialize(Settings &settings, const Paths &paths)
                                 QDateTime::currentDateTimeUtc()
                                     .addSecs(expiresIn)
                                     .toString(Qt::ISODate);
-                            settings.requestSave();
+                            settings.queueSave();
 
                             qCDebug(chatterinoApp)
                                 << "Bot badge app token refreshed.";
@@ -392,6 +512,7 @@ int Application::run()
     if (!this->args_.isFramelessEmbed)
     {
         this->windows->getMainWindow().show();
+        StartupTrace::instant("init", "main window shown");
     }
 
     getSettings()->enableBTTVChannelEmotes.connect(
@@ -660,6 +781,12 @@ ITwitchUsers *Application::getTwitchUsers()
     return this->twitchUsers.get();
 }
 
+UserMetadataStore *Application::getUserMetadata()
+{
+    // UserMetadataStore handles its own locks
+    return this->userMetadata.get();
+}
+
 BttvEmotes *Application::getBttvEmotes()
 {
     assertInGuiThread();
@@ -755,6 +882,7 @@ void Application::aboutToQuit()
 
     this->hotkeys->save();
     this->windows->save();
+    this->userMetadata->save();
 
     this->windows->closeAll();
 }
@@ -766,6 +894,7 @@ void Application::stop()
 #endif
     this->pronouns.reset();
     this->twitchUsers.reset();
+    this->userMetadata.reset();
     this->streamerMode.reset();
     this->linkResolver.reset();
     this->seventvEventAPI.reset();
@@ -61,6 +61,7 @@ class MoltorinoSupporterBadges;
 class RepeatedMessageDetector;
 class IStreamerMode;
 class ITwitchUsers;
+class UserMetadataStore;
 class NativeMessagingServer;
 namespace pronouns {
 class Pronouns;
@@ -130,6 +131,8 @@ public:
     virtual IStreamerMode *getStreamerMode() = 0;
     virtual ITwitchUsers *getTwitchUsers() = 0;
     virtual pronouns::Pronouns *getPronouns() = 0;
+    /// The store is optional, callers have to handle `nullptr`
+    virtual UserMetadataStore *getUserMetadata() = 0;
     virtual eventsub::IController *getEventSub() = 0;
     virtual SpellChecker *getSpellChecker() = 0;
     virtual KickChatServer *getKickChatServer() = 0;
@@ -204,6 +207,7 @@ private:
     std::unique_ptr<SeventvEventAPI> seventvEventAPI;
     std::unique_ptr<ILinkResolver> linkResolver;
     std::unique_ptr<IStreamerMode> streamerMode;
+    std::unique_ptr<UserMetadataStore> userMetadata;
     std::unique_ptr<ITwitchUsers> twitchUsers;
     std::unique_ptr<pronouns::Pronouns> pronouns;
     std::unique_ptr<SpellChecker> spellChecker;
@@ -267,6 +271,7 @@ public:
     ILinkResolver *getLinkResolver() override;
     IStreamerMode *getStreamerMode() override;
     ITwitchUsers *getTwitchUsers() override;
+    UserMetadataStore *getUserMetadata() override;
     SpellChecker *getSpellChecker() override;
     KickChatServer *getKickChatServer() override;
 
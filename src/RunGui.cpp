@@ -9,12 +9,14 @@
 #include "common/Modes.hpp"
 #include "common/network/NetworkManager.hpp"
 #include "common/QLogging.hpp"
+#include "debug/StartupTrace.hpp"
 #include "singletons/CrashHandler.hpp"
 #include "singletons/Paths.hpp"
 #include "singletons/Resources.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Updates.hpp"
 #include "singletons/WindowManager.hpp"
+#include "util/Backup.hpp"
 #include "util/CombinePath.hpp"
 #include "util/SelfCheck.hpp"
 #include "util/UnixSignalHandler.hpp"
@@ -274,6 +276,7 @@ void saveSessionState(Settings &settings)
 
     app->getWindows()->save();
     settings.requestSave();
+    backup::flushPendingSaves();
 }
 #endif
 
@@ -349,6 +352,11 @@ bool activateExistingGuiInstance(const Paths &paths)
 void runGui(QApplication & /*a*/, const Paths &paths, Settings &settings,
             const Args &args, Updates &updates)
 {
+    if (args.startupTracePath)
+    {
+        StartupTrace::start(*args.startupTracePath);
+    }
+
     initQt(args);
     initResources();
     initSignalHandler();
@@ -384,13 +392,18 @@ void runGui(QApplication & /*a*/, const Paths &paths, Settings &settings,
         assert(app != nullptr);
         app->aboutToQuit();
 
+        // Also writes a save that was queued with queueSave()
         getSettings()->requestSave();
         getSettings()->disableSave();
+        // The window layout is written in the background
+        backup::flushPendingSaves();
 
         app->stop();
     });
 
+    auto constructBegin = StartupTrace::now();
     Application app(settings, paths, args, updates);
+    StartupTrace::complete("init", "Application", constructBegin);
     app.initialize(settings, paths);
 
 #ifndef QT_NO_SESSIONMANAGER
@@ -158,6 +158,17 @@ Args::Args(const QApplication &app, const Paths &paths)
         "like you have to use this, please reach out to our issue tracker at "
         "https://github.com/Chatterino/chatterino2/issues");
 
+    QCommandLineOption traceStartupOption(
+        "trace-startup",
+        "Records a timeline of the first 30 seconds and writes it to the "
+        "supplied file as a Chrome trace.",
+        "file");
+
+    QCommandLineOption sequentialStartupOption(
+        "sequential-startup",
+        "Runs all startup steps on the main thread, one after another. This "
+        "is used to compare startup times.");
+
 #ifndef NDEBUG
     QCommandLineOption useLocalEventsubOption(
         "use-local-eventsub",
@@ -179,6 +190,8 @@ Args::Args(const QApplication &app, const Paths &paths)
         channelLayout,
         activateOption,
         useOldScalingOption,
+        traceStartupOption,
+        sequentialStartupOption,
 #ifndef NDEBUG
         useLocalEventsubOption,
 #endif
@@ -253,6 +266,16 @@ Args::Args(const QApplication &app, const Paths &paths)
         this->useOldScaling = true;
     }
 
+    if (parser.isSet(traceStartupOption))
+    {
+        this->startupTracePath = parser.value(traceStartupOption);
+    }
+
+    if (parser.isSet(sequentialStartupOption))
+    {
+        this->sequentialStartup = true;
+    }
+
 #ifndef NDEBUG
     if (parser.isSet(useLocalEventsubOption))
     {
@@ -33,6 +33,7 @@ class Paths;
 /// -c, --channels=t:channel1;t:channel2;...
 /// -a, --activate=t:channel
 ///     --safe-mode
+///     --trace-startup=file
 ///
 /// See documentation on `QGuiApplication` for documentation on Qt arguments like -platform.
 class Args
@@ -73,6 +74,11 @@ public:
 
     bool useOldScaling = false;
 
+    /// Where to write the startup trace to (see StartupTrace)
+    std::optional<QString> startupTracePath;
+    /// Run all initialize steps on the GUI thread, one after another
+    bool sequentialStartup = false;
+
 #ifndef NDEBUG
     // twitch event websocket start-server --ssl --port 3012
     bool useLocalEventsub = false;
@@ -5,6 +5,9 @@
 #include "common/Channel.hpp"
 
 #include "Application.hpp"
+#ifdef CHATTERINO_HAVE_PLUGINS
+#    include "controllers/plugins/PluginController.hpp"
+#endif
 #include "messages/Emote.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
@@ -14,6 +17,9 @@
 #include "singletons/Settings.hpp"
 #include "util/ChannelHelpers.hpp"
 
+#include <algorithm>
+#include <utility>
+
 namespace {
 
 constexpr uint8_t MAX_RECURSION = 64;
@@ -49,6 +55,12 @@ Channel::Channel(const QString &name, Type type)
     , lastDate_(QDate::currentDate())
     , name_(name)
     , messages_(getSettings()->scrollbackSplitLimit)
+    // Channels of type None hold copies of other channels' messages (e.g.
+    // search results), there's nothing to archive.
+    , archive_(type == Type::None
+                   ? 0
+                   : static_cast<size_t>(std::max(
+                         0, getSettings()->scrollbackArchiveLimit.getValue())))
     , type_(type)
 {
     if (this->isTwitchChannel())
@@ -64,6 +76,13 @@ Channel::Channel(const QString &name, Type type)
     {
         this->messagePlatform_ = MessagePlatform::AnyOrTwitch;
     }
+
+    // Fires once the event loop handled everything that's already queued
+    this->flushAppendsTimer_.setSingleShot(true);
+    this->flushAppendsTimer_.setInterval(0);
+    QObject::connect(&this->flushAppendsTimer_, &QTimer::timeout, [this] {
+        this->flushAppendedMessages();
+    });
 }
 
 Channel::~Channel()
@@ -125,12 +144,13 @@ size_t Channel::countMessages() const
     return this->messages_.size();
 }
 
-std::vector<MessagePtr> Channel::getMessageSnapshot() const
+LimitedQueueSnapshot<MessagePtr> Channel::getMessageSnapshot() const
 {
     return this->messages_.getSnapshot();
 }
 
-std::vector<MessagePtr> Channel::getMessageSnapshot(size_t nItems) const
+LimitedQueueSnapshot<MessagePtr> Channel::getMessageSnapshot(
+    size_t nItems) const
 {
     return this->messages_.lastN(nItems);
 }
@@ -142,6 +162,11 @@ std::vector<MessagePtrMut> Channel::getMessageSnapshotMut(size_t nItems) const
     });
 }
 
+const MessageArchive &Channel::archive() const
+{
+    return this->archive_;
+}
+
 MessagePtr Channel::getLastMessage() const
 {
     auto last = this->messages_.last();
@@ -184,10 +209,29 @@ void Channel::addMessage(MessagePtr message, MessageContext context,
 
     if (this->messages_.pushBack(message, deleted))
     {
+        this->archive_.add(deleted);
         this->messageRemovedFromStart(deleted);
     }
 
+#ifdef CHATTERINO_HAVE_PLUGINS
+    if (context == MessageContext::Original &&
+        this->getType() != Type::None && lua::MessageStream::hasSubscribers())
+    {
+        getApp()->getPlugins()->messageStream().push(this->weak_from_this(),
+                                                     message);
+    }
+#endif
+
     this->messageAppended.invoke(message, overridingFlags);
+
+    this->pendingAppends_.push_back({
+        .message = std::move(message),
+        .overridingFlags = overridingFlags,
+    });
+    if (!this->flushAppendsTimer_.isActive())
+    {
+        this->flushAppendsTimer_.start();
+    }
 }
 
 void Channel::addSystemMessage(const QString &contents)
@@ -253,6 +297,7 @@ void Channel::addMessagesAtStart(const std::vector<MessagePtr> &_messages)
 
     if (addedMessages.size() != 0)
     {
+        this->flushAppendedMessages();
         this->messagesAddedAtStart.invoke(addedMessages);
     }
 }
@@ -281,6 +326,7 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
         // There are no messages in this channel yet so we can just insert them
         // at the front in order
         this->messages_.pushFront(messages);
+        this->flushAppendedMessages();
         this->filledInMessages.invoke(messages);
         return;
     }
@@ -351,6 +397,7 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
     {
         // We only invoke a signal once at the end of filling all messages to
         // prevent doing any unnecessary repaints.
+        this->flushAppendedMessages();
         this->filledInMessages.invoke(messages);
     }
 }
@@ -369,6 +416,7 @@ void Channel::replaceMessage(const MessagePtr &message,
 
     if (index >= 0)
     {
+        this->flushAppendedMessages();
         this->messageReplaced.invoke((size_t)index, message, replacement);
     }
 }
@@ -386,6 +434,7 @@ void Channel::replaceMessage(size_t index, const MessagePtr &replacement)
     MessagePtr prev;
     if (this->messages_.replaceItem(index, replacement, &prev))
     {
+        this->flushAppendedMessages();
         this->messageReplaced.invoke(index, prev, replacement);
     }
 }
@@ -404,6 +453,7 @@ void Channel::replaceMessage(size_t hint, const MessagePtr &message,
     auto index = this->messages_.replaceItem(hint, message, replacement);
     if (index >= 0)
     {
+        this->flushAppendedMessages();
         this->messageReplaced.invoke(hint, message, replacement);
     }
 }
@@ -455,9 +505,26 @@ void Channel::clearMessages()
     }
 
     this->messages_.clear();
+    this->archive_.clear();
+    // Consumers of messagesAppended never see the removed messages
+    this->pendingAppends_.clear();
+    this->flushAppendsTimer_.stop();
     this->messagesCleared.invoke();
 }
 
+void Channel::flushAppendedMessages()
+{
+    if (this->pendingAppends_.empty())
+    {
+        return;
+    }
+    this->flushAppendsTimer_.stop();
+
+    // Messages appended while the signal is handled go into the next batch
+    auto messages = std::exchange(this->pendingAppends_, {});
+    this->messagesAppended.invoke(messages);
+}
+
 MessagePtr Channel::findMessageByID(QStringView messageID)
 {
     if (messageID.isEmpty())
@@ -7,6 +7,7 @@
 #include "common/enums/MessageContext.hpp"
 #include "controllers/completion/TabCompletionModel.hpp"
 #include "messages/LimitedQueue.hpp"
+#include "messages/MessageArchive.hpp"
 #include "messages/MessageFlag.hpp"
 #include "messages/MessageSink.hpp"
 
@@ -19,6 +20,7 @@
 #include <memory>
 #include <optional>
 #include <span>
+#include <vector>
 
 namespace chatterino {
 
@@ -30,6 +32,11 @@ enum class MessagePlatform : uint8_t;
 
 class EmoteMap;
 
+struct AppendedMessage {
+    MessagePtr message;
+    std::optional<MessageFlags> overridingFlags;
+};
+
 class Channel : public std::enable_shared_from_this<Channel>, public MessageSink
 {
 public:
@@ -70,6 +77,12 @@ public:
     // SIGNALS
     pajlada::Signals::Signal<MessagePtr &, std::optional<MessageFlags>>
         messageAppended;
+    /// Invoked once per event loop iteration with all messages appended since
+    /// the last invocation, in order. Before any other signal about the
+    /// messages of this channel is invoked, pending messages are flushed, so
+    /// consumers see the same order of changes as with #messageAppended.
+    pajlada::Signals::Signal<std::span<const AppendedMessage>>
+        messagesAppended;
     pajlada::Signals::Signal<std::vector<MessagePtr> &> messagesAddedAtStart;
     /// (index, prev-message, replacement)
     pajlada::Signals::Signal<size_t, const MessagePtr &, const MessagePtr &>
@@ -88,8 +101,8 @@ public:
     bool isTwitchOrKickChannel() const;
     virtual bool isEmpty() const;
 
-    std::vector<MessagePtr> getMessageSnapshot() const;
-    std::vector<MessagePtr> getMessageSnapshot(size_t nItems) const;
+    LimitedQueueSnapshot<MessagePtr> getMessageSnapshot() const;
+    LimitedQueueSnapshot<MessagePtr> getMessageSnapshot(size_t nItems) const;
 
     /// Essentially the same as #getMessageSnapshot(size_t), but the returned
     /// vector holds `std::shared_ptr<Message>`. This should only be used in
@@ -101,6 +114,9 @@ public:
     /// messages, this will return an empty shared pointer.
     MessagePtr getLastMessage() const;
 
+    /// Messages that were pushed out of this channel's message buffer
+    const MessageArchive &archive() const;
+
     // MESSAGES
     // overridingFlags can be filled in with flags that should be used instead
     // of the message's flags. This is useful in case a flag is specific to a
@@ -130,6 +146,9 @@ public:
     /// Removes all messages from this channel and invokes #messagesCleared
     void clearMessages();
 
+    /// Invokes #messagesAppended with the pending messages now
+    void flushAppendedMessages();
+
     MessagePtr findMessageByID(QStringView messageID) final;
 
     bool hasMessages() const;
@@ -177,6 +196,7 @@ private:
 
     const QString name_;
     LimitedQueue<MessagePtr> messages_;
+    MessageArchive archive_;
     Type type_;
     bool anythingLogged_ = false;
 
@@ -190,6 +210,10 @@ private:
 
     QTimer clearCompletionModelTimer_;
 
+    /// Messages that weren't passed to #messagesAppended yet
+    std::vector<AppendedMessage> pendingAppends_;
+    QTimer flushAppendsTimer_;
+
     MessagePlatform messagePlatform_;
 };
 
@@ -4,11 +4,13 @@
 
 #include "common/ChannelChatters.hpp"
 
+#include "Application.hpp"
 #include "common/Channel.hpp"
 #include "controllers/ignores/IgnoreController.hpp"
 #include "debug/AssertInGuiThread.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
+#include "providers/UserMetadataStore.hpp"
 
 #include <QColor>
 
@@ -133,6 +135,20 @@ QColor ChannelChatters::getUserColor(const QString &user) const
 
     if (!chatterColors->exists(lowerUser))
     {
+        // The user might've chatted before the last restart
+        if (this->channel_.isTwitchChannel())
+        {
+            auto *userMetadata = getApp()->getUserMetadata();
+            if (userMetadata != nullptr)
+            {
+                if (auto color = userMetadata->getByLogin(
+                        lowerUser, UserMetadataStore::Field::Color))
+                {
+                    return QColor(*color);
+                }
+            }
+        }
+
         // Returns an invalid color so we can decide not to override `textColor`
         return QColor();
     }
@@ -46,7 +46,7 @@ void runCallback(bool concurrent, auto &&fn)
     }
 }
 
-void loadUncached(std::shared_ptr<NetworkData> &&data)
+void startTask(std::shared_ptr<NetworkData> &&data)
 {
     DebugCount::increase(DebugObject::HTTPRequestStarted);
 
@@ -61,6 +61,20 @@ void loadUncached(std::shared_ptr<NetworkData> &&data)
     requester.requestUrl();
 }
 
+void loadUncached(std::shared_ptr<NetworkData> &&data)
+{
+    if (!data->scheduler)
+    {
+        startTask(std::move(data));
+        return;
+    }
+
+    auto scheduler = data->scheduler;
+    scheduler->schedule(data->priority, [data = std::move(data)]() mutable {
+        startTask(std::move(data));
+    });
+}
+
 void loadCached(std::shared_ptr<NetworkData> &&data)
 {
     if (isAppAboutToQuit())
@@ -6,6 +6,7 @@
 
 #include "common/Common.hpp"
 #include "common/network/NetworkCommon.hpp"
+#include "common/network/RequestScheduler.hpp"
 #include "util/DebugCount.hpp"
 
 #include <QHttpMultiPart>
@@ -58,6 +59,12 @@ public:
     QByteArray payload;
     std::unique_ptr<QHttpMultiPart, DeleteLater> multiPartPayload;
 
+    /// Decides when the request is sent, if set
+    std::shared_ptr<RequestScheduler> scheduler;
+    RequestPriority priority = RequestPriority::Visible;
+    /// The number of times the request was sent
+    int attempts = 0;
+
     /// By default, there's no explicit timeout for the request.
     /// To set a timeout, use NetworkRequest's timeout method
     std::optional<std::chrono::milliseconds> timeout{};
@@ -221,6 +221,14 @@ void NetworkRequest::initializeDefaultValues()
     this->data->request.setRawHeader("User-Agent", userAgent);
 }
 
+NetworkRequest NetworkRequest::scheduler(
+    std::shared_ptr<RequestScheduler> scheduler, RequestPriority priority) &&
+{
+    this->data->scheduler = std::move(scheduler);
+    this->data->priority = priority;
+    return std::move(*this);
+}
+
 NetworkRequest NetworkRequest::json(const QJsonArray &root) &&
 {
     return std::move(*this).json(QJsonDocument(root));
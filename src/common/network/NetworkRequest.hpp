@@ -8,6 +8,7 @@
 
 #include <QHttpMultiPart>
 
+#include <cstdint>
 #include <memory>
 
 class QJsonArray;
@@ -17,6 +18,8 @@ class QJsonDocument;
 namespace chatterino {
 
 class NetworkData;
+class RequestScheduler;
+enum class RequestPriority : uint8_t;
 
 class NetworkRequest final
 {
@@ -81,6 +84,10 @@ public:
      * `QNetworkRequest`'s defaults are used by default (Qt 5: no-follow, Qt 6: follow).
      */
     NetworkRequest followRedirects(bool on) &&;
+    /// Sends the request once `scheduler` has room for it. Requests answered
+    /// with 429 are retried a few times before the error is reported.
+    NetworkRequest scheduler(std::shared_ptr<RequestScheduler> scheduler,
+                             RequestPriority priority) &&;
     NetworkRequest json(const QJsonObject &root) &&;
     NetworkRequest json(const QJsonArray &root) &&;
     NetworkRequest json(const QJsonDocument &document) &&;
@@ -17,9 +17,10 @@ class NetworkResult
 {
 public:
     using NetworkError = QNetworkReply::NetworkError;
+    using Headers = QList<QNetworkReply::RawHeaderPair>;
 
     NetworkResult(NetworkError error, const QVariant &httpStatusCode,
-                  QByteArray data);
+                  QByteArray data, Headers headers = {});
 
     /// Parses the result as json and returns the root as an object.
     /// Returns empty object if parsing failed.
@@ -51,12 +52,17 @@ public:
         return this->status_;
     }
 
+    /// The value of the response header `name` (case insensitive) or a null
+    /// byte array if the response didn't have the header.
+    QByteArray header(QByteArrayView name) const;
+
     /// Formats the error.
     /// If a reply is received, returns the HTTP status otherwise, the network error.
     QString formatError() const;
 
 private:
     QByteArray data_;
+    Headers headers_;
 
     NetworkError error_;
     std::optional<int> status_;
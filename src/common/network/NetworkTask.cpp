@@ -8,7 +8,9 @@
 #include "common/network/NetworkManager.hpp"
 #include "common/network/NetworkPrivate.hpp"
 #include "common/network/NetworkResult.hpp"
+#include "common/network/RequestScheduler.hpp"
 #include "common/QLogging.hpp"
+#include "debug/StartupTrace.hpp"
 #include "singletons/Paths.hpp"
 #include "util/AbandonObject.hpp"
 #include "util/DebugCount.hpp"
@@ -25,6 +27,9 @@
 
 namespace {
 
+/// The number of times a request is sent before a 429 is reported
+constexpr int MAX_SCHEDULED_ATTEMPTS = 3;
+
 /// For DELETE requests, Qt remaps the operation to `DeleteOperation`:
 /// https://github.com/qt/qtbase/blob/bc60fa052b6163bcf444dab027bd6c1e717c9845/src/network/access/qnetworkreplyhttpimpl.cpp#L141-L161
 /// If we specified a body on the request. That will get dropped, because
@@ -52,6 +57,10 @@ NetworkTask::NetworkTask(std::shared_ptr<NetworkData> &&data)
 
 NetworkTask::~NetworkTask()
 {
+    // Requests that didn't get a response still used a slot
+    this->reportToScheduler(
+        {NetworkResult::NetworkError::OperationCanceledError, {}, {}});
+
     if (this->reply_)
     {
         this->reply_->deleteLater();
@@ -60,6 +69,8 @@ NetworkTask::~NetworkTask()
 
 void NetworkTask::run()
 {
+    this->traceBegin_ = StartupTrace::now();
+    this->data_->attempts++;
     this->reply_ = this->createReply();
     if (!this->reply_)
     {
@@ -209,6 +220,24 @@ void NetworkTask::logReply()
     }
 }
 
+void NetworkTask::traceReply(const QString &result) const
+{
+    if (!StartupTrace::enabled())
+    {
+        return;
+    }
+
+    const auto &url = this->data_->request.url();
+    StartupTrace::async(
+        "network", url.host() + url.path(),
+        reinterpret_cast<quintptr>(this), this->traceBegin_,
+        {
+            {"type", this->data_->typeString()},
+            {"url", url.toString()},
+            {"result", result},
+        });
+}
+
 void NetworkTask::writeToCache(const QByteArray &bytes) const
 {
     std::ignore = QtConcurrent::run([data = this->data_, bytes] {
@@ -239,6 +268,34 @@ void NetworkTask::writeToCache(const QByteArray &bytes) const
     });
 }
 
+void NetworkTask::reportToScheduler(const NetworkResult &result)
+{
+    if (this->reported_ || !this->data_->scheduler)
+    {
+        return;
+    }
+    this->reported_ = true;
+    this->data_->scheduler->finished(result);
+}
+
+bool NetworkTask::retry(const NetworkResult &result)
+{
+    const auto &data = this->data_;
+    // Multipart payloads are consumed by the first reply
+    if (!data->scheduler || data->multiPartPayload ||
+        data->attempts >= MAX_SCHEDULED_ATTEMPTS ||
+        !RequestScheduler::shouldRetry(result))
+    {
+        return false;
+    }
+
+    qCDebug(chatterinoHTTP).noquote()
+        << data->typeString() << "[retrying]" << result.formatError()
+        << data->request.url().toString();
+    load(std::shared_ptr<NetworkData>(data));
+    return true;
+}
+
 void NetworkTask::timeout()
 {
     AbandonObject guard(this);
@@ -251,8 +308,11 @@ void NetworkTask::timeout()
     qCDebug(chatterinoHTTP).noquote()
         << this->data_->typeString() << "[timed out]"
         << this->data_->request.url().toString();
+    this->traceReply("timed out");
 
-    this->data_->emitError({NetworkResult::NetworkError::TimeoutError, {}, {}});
+    NetworkResult result{NetworkResult::NetworkError::TimeoutError, {}, {}};
+    this->reportToScheduler(result);
+    this->data_->emitError(std::move(result));
     this->data_->emitFinally();
 }
 
@@ -277,10 +337,20 @@ void NetworkTask::finished()
         return;
     }
 
+    this->traceReply(status.isValid() ? status.toString()
+                                      : reply->errorString());
+
     if (reply->error() != QNetworkReply::NoError)
     {
         this->logReply();
-        this->data_->emitError({reply->error(), status, reply->readAll()});
+        NetworkResult result{reply->error(), status, reply->readAll(),
+                             reply->rawHeaderPairs()};
+        this->reportToScheduler(result);
+        if (this->retry(result))
+        {
+            return;
+        }
+        this->data_->emitError(std::move(result));
         this->data_->emitFinally();
 
         return;
@@ -295,7 +365,10 @@ void NetworkTask::finished()
 
     DebugCount::increase(DebugObject::HTTPRequestSuccess);
     this->logReply();
-    this->data_->emitSuccess({reply->error(), status, bytes});
+    NetworkResult result{reply->error(), status, bytes,
+                         reply->rawHeaderPairs()};
+    this->reportToScheduler(result);
+    this->data_->emitSuccess(std::move(result));
     this->data_->emitFinally();
 }
 
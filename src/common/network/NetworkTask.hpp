@@ -14,6 +14,7 @@ class QNetworkReply;
 namespace chatterino {
 
 class NetworkData;
+class NetworkResult;
 
 }  // namespace chatterino
 
@@ -40,11 +41,18 @@ private:
     QNetworkReply *createReply();
 
     void logReply();
+    void traceReply(const QString &result) const;
     void writeToCache(const QByteArray &bytes) const;
+    /// Reports the result to the scheduler of the request (if any)
+    void reportToScheduler(const NetworkResult &result);
+    /// Sends the request again if the scheduler wants to retry it
+    bool retry(const NetworkResult &result);
 
     std::shared_ptr<NetworkData> data_;
     QNetworkReply *reply_{};  // parent: default (accessManager)
     QTimer *timer_{};         // parent: this
+    qint64 traceBegin_{};     // see StartupTrace
+    bool reported_ = false;   // see reportToScheduler
 
     // NOLINTNEXTLINE(readability-redundant-access-specifiers)
 private Q_SLOTS:
@@ -0,0 +1,288 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/network/RequestScheduler.hpp"
+
+#include "common/network/NetworkResult.hpp"
+#include "common/QLogging.hpp"
+
+#include <QDateTime>
+#include <QHash>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+namespace {
+
+using namespace chatterino;
+
+constexpr int HTTP_TOO_MANY_REQUESTS = 429;
+constexpr std::chrono::milliseconds MIN_RATELIMIT_PAUSE{250};
+
+std::optional<qint64> headerNumber(const NetworkResult &result,
+                                   QByteArrayView name)
+{
+    auto value = result.header(name);
+    if (value.isNull())
+    {
+        return std::nullopt;
+    }
+
+    bool ok = false;
+    auto number = value.trimmed().toLongLong(&ok);
+    if (!ok)
+    {
+        return std::nullopt;
+    }
+    return number;
+}
+
+struct KeyedSchedulers {
+    std::mutex mutex;
+    QHash<QString, std::shared_ptr<RequestScheduler>> schedulers;
+};
+
+KeyedSchedulers &keyedSchedulers()
+{
+    // Leaked on purpose: the schedulers own timers, which must not be
+    // destroyed after the application.
+    static auto *keyed = new KeyedSchedulers;
+    return *keyed;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+RequestScheduler::RequestScheduler()
+    : RequestScheduler(Options{})
+{
+}
+
+RequestScheduler::RequestScheduler(Options options)
+    : options_(options)
+    , bucketSize_(options.bucketSize)
+    , tokens_(options.bucketSize)
+    , lastRefill_(Clock::now())
+{
+    this->wakeTimer_.setSingleShot(true);
+    QObject::connect(&this->wakeTimer_, &QTimer::timeout, [this] {
+        this->pump();
+    });
+}
+
+RequestScheduler::~RequestScheduler() = default;
+
+std::shared_ptr<RequestScheduler> RequestScheduler::forKey(
+    const QString &key, const Options &options)
+{
+    auto &keyed = keyedSchedulers();
+    std::lock_guard lock(keyed.mutex);
+    auto &scheduler = keyed.schedulers[key];
+    if (!scheduler)
+    {
+        scheduler = std::make_shared<RequestScheduler>(options);
+    }
+    return scheduler;
+}
+
+qsizetype RequestScheduler::keyedCount()
+{
+    auto &keyed = keyedSchedulers();
+    std::lock_guard lock(keyed.mutex);
+    return keyed.schedulers.size();
+}
+
+void RequestScheduler::schedule(RequestPriority priority,
+                                std::function<void()> start)
+{
+    std::unique_lock lock(this->mutex_);
+    this->queues_[static_cast<size_t>(priority)].emplace_back(
+        std::move(start));
+
+    auto starts = this->takeStartable(lock);
+    lock.unlock();
+    for (auto &fn : starts)
+    {
+        fn();
+    }
+}
+
+void RequestScheduler::finished(const NetworkResult &result)
+{
+    std::unique_lock lock(this->mutex_);
+    auto now = Clock::now();
+    this->inFlight_ = std::max(0, this->inFlight_ - 1);
+    this->refill(now);
+
+    if (auto limit = headerNumber(result, "Ratelimit-Limit"); limit > 0)
+    {
+        this->bucketSize_ = static_cast<int>(*limit);
+    }
+
+    if (result.status() == HTTP_TOO_MANY_REQUESTS)
+    {
+        this->tokens_ = 0;
+
+        std::chrono::milliseconds delay = this->backoff_.next();
+        if (auto reset = headerNumber(result, "Ratelimit-Reset"))
+        {
+            // The bucket is full again at the reset, but it refills
+            // continuously, so don't wait longer than the backoff.
+            std::chrono::milliseconds untilReset = std::chrono::seconds(
+                *reset - QDateTime::currentSecsSinceEpoch());
+            delay = std::clamp(untilReset, MIN_RATELIMIT_PAUSE, delay);
+        }
+        this->blockedUntil_ = std::max(this->blockedUntil_, now + delay);
+        qCDebug(chatterinoHTTP) << "Rate limited, pausing requests for"
+                                << delay.count() << "ms";
+    }
+    else if (auto remaining = headerNumber(result, "Ratelimit-Remaining"))
+    {
+        // The server doesn't know about the requests that are still in
+        // flight yet.
+        this->tokens_ = std::clamp<double>(
+            static_cast<double>(*remaining - this->inFlight_), 0.0,
+            this->bucketSize_);
+        this->backoff_.reset();
+    }
+    else if (result.status())
+    {
+        this->backoff_.reset();
+    }
+
+    auto starts = this->takeStartable(lock);
+    lock.unlock();
+    for (auto &fn : starts)
+    {
+        fn();
+    }
+}
+
+bool RequestScheduler::shouldRetry(const NetworkResult &result)
+{
+    return result.status() == HTTP_TOO_MANY_REQUESTS;
+}
+
+size_t RequestScheduler::queued() const
+{
+    std::lock_guard lock(this->mutex_);
+    size_t n = 0;
+    for (const auto &queue : this->queues_)
+    {
+        n += queue.size();
+    }
+    return n;
+}
+
+int RequestScheduler::inFlight() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->inFlight_;
+}
+
+double RequestScheduler::available() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->tokens_;
+}
+
+std::vector<std::function<void()>> RequestScheduler::takeStartable(
+    std::unique_lock<std::mutex> & /* lock */)
+{
+    auto now = Clock::now();
+    this->refill(now);
+
+    std::vector<std::function<void()>> starts;
+    if (now < this->blockedUntil_)
+    {
+        this->wakeIn(std::chrono::ceil<std::chrono::milliseconds>(
+            this->blockedUntil_ - now));
+        return starts;
+    }
+
+    while (this->inFlight_ < this->options_.maxInFlight)
+    {
+        auto it = std::ranges::find_if(this->queues_, [](const auto &queue) {
+            return !queue.empty();
+        });
+        if (it == this->queues_.end())
+        {
+            break;
+        }
+
+        auto priority =
+            static_cast<RequestPriority>(it - this->queues_.begin());
+        auto needed = 1.0 + this->reserveFor(priority);
+        if (this->tokens_ < needed)
+        {
+            // Lower priorities need even more tokens
+            auto perMs = static_cast<double>(this->bucketSize_) /
+                         static_cast<double>(
+                             this->options_.refillPeriod.count());
+            this->wakeIn(std::chrono::milliseconds(static_cast<int64_t>(
+                std::ceil((needed - this->tokens_) / perMs))));
+            break;
+        }
+
+        this->tokens_ -= 1.0;
+        this->inFlight_++;
+        starts.emplace_back(std::move(it->front()));
+        it->pop_front();
+    }
+
+    return starts;
+}
+
+void RequestScheduler::pump()
+{
+    std::unique_lock lock(this->mutex_);
+    auto starts = this->takeStartable(lock);
+    lock.unlock();
+    for (auto &fn : starts)
+    {
+        fn();
+    }
+}
+
+void RequestScheduler::refill(Clock::time_point now)
+{
+    std::chrono::duration<double, std::milli> elapsed =
+        now - this->lastRefill_;
+    this->lastRefill_ = now;
+
+    auto refilled = static_cast<double>(this->bucketSize_) * elapsed.count() /
+                    static_cast<double>(this->options_.refillPeriod.count());
+    this->tokens_ = std::min(this->tokens_ + refilled,
+                             static_cast<double>(this->bucketSize_));
+}
+
+double RequestScheduler::reserveFor(RequestPriority priority) const
+{
+    switch (priority)
+    {
+        case RequestPriority::Interactive:
+            return 0;
+        case RequestPriority::Visible:
+            return this->options_.visibleReserve * this->bucketSize_;
+        case RequestPriority::Background:
+            return this->options_.backgroundReserve * this->bucketSize_;
+    }
+    return 0;
+}
+
+void RequestScheduler::wakeIn(std::chrono::milliseconds delay)
+{
+    // The timer can only be started from its own thread
+    QMetaObject::invokeMethod(&this->wakeTimer_, [this, delay] {
+        if (!this->wakeTimer_.isActive() ||
+            this->wakeTimer_.remainingTime() > delay.count())
+        {
+            this->wakeTimer_.start(delay);
+        }
+    });
+}
+
+}  // namespace chatterino
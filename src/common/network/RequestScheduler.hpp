@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "util/ExponentialBackoff.hpp"
+
+#include <QString>
+#include <QTimer>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+
+class NetworkResult;
+
+enum class RequestPriority : uint8_t {
+    /// Actions the user is waiting for (e.g. moderation)
+    Interactive,
+    /// Fetches whose result is shown to the user
+    Visible,
+    /// Polling that can be delayed (e.g. live status or chatters)
+    Background,
+};
+
+/// Schedules the requests made with one token.
+///
+/// The scheduler keeps a token bucket that mirrors the one on the server.
+/// The `Ratelimit-Limit`, `Ratelimit-Remaining` and `Ratelimit-Reset`
+/// headers of every response correct the local estimate, so requests are
+/// started as soon as there's room for them instead of after a fixed delay.
+/// A share of the bucket is reserved for higher priorities, so background
+/// polling can't starve moderation actions.
+///
+/// Requests answered with 429 are retried by the network layer once the
+/// bucket is expected to have refilled.
+class RequestScheduler
+{
+public:
+    struct Options {
+        /// The size of the bucket until a response tells us the actual one
+        int bucketSize = 800;
+        /// The time it takes for an empty bucket to refill completely
+        std::chrono::milliseconds refillPeriod = std::chrono::seconds(60);
+        /// The maximum number of requests that are in flight at once
+        int maxInFlight = 16;
+        /// The part of the bucket that visible fetches leave untouched
+        double visibleReserve = 0.05;
+        /// The part of the bucket that background polling leaves untouched
+        double backgroundReserve = 0.25;
+    };
+
+    RequestScheduler();
+    explicit RequestScheduler(Options options);
+    ~RequestScheduler();
+
+    RequestScheduler(const RequestScheduler &) = delete;
+    RequestScheduler(RequestScheduler &&) = delete;
+    RequestScheduler &operator=(const RequestScheduler &) = delete;
+    RequestScheduler &operator=(RequestScheduler &&) = delete;
+
+    /// Returns the scheduler for `key` (e.g. a client and user ID), creating
+    /// it with `options` if it doesn't exist yet. Schedulers are never
+    /// removed, so keys must not include anything that changes over time
+    /// (like tokens).
+    static std::shared_ptr<RequestScheduler> forKey(const QString &key,
+                                                    const Options &options);
+
+    /// Returns the number of schedulers created by forKey()
+    static qsizetype keyedCount();
+
+    /// Calls `start` once the request may be sent. Can be called from any
+    /// thread. `start` is called on the thread that made room for the
+    /// request, which is either this one, the one that reported a response
+    /// or the thread of the scheduler.
+    ///
+    /// Every started request must be reported with finished().
+    void schedule(RequestPriority priority, std::function<void()> start);
+
+    /// Reports the response of a started request. `result` has no status if
+    /// the request didn't get a response.
+    void finished(const NetworkResult &result);
+
+    /// Whether a request that got `result` should be scheduled again
+    static bool shouldRetry(const NetworkResult &result);
+
+    size_t queued() const;
+    int inFlight() const;
+    /// The estimated number of requests that can be made right now
+    double available() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Starts as many queued requests as possible. Returns the requests to
+    /// start after unlocking.
+    std::vector<std::function<void()>> takeStartable(
+        std::unique_lock<std::mutex> &lock);
+    void pump();
+    void refill(Clock::time_point now);
+    double reserveFor(RequestPriority priority) const;
+    void wakeIn(std::chrono::milliseconds delay);
+
+    const Options options_;
+
+    mutable std::mutex mutex_;
+    std::array<std::deque<std::function<void()>>, 3> queues_;
+    int inFlight_ = 0;
+    int bucketSize_;
+    double tokens_;
+    Clock::time_point lastRefill_;
+    /// No requests are started before this (after a 429)
+    Clock::time_point blockedUntil_;
+    ExponentialBackoff<6> backoff_{std::chrono::seconds(1)};
+
+    /// Wakes the scheduler when tokens become available. Lives on the
+    /// thread the scheduler was created on.
+    QTimer wakeTimer_;
+};
+
+}  // namespace chatterino
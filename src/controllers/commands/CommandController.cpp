@@ -510,6 +510,10 @@ CommandController::CommandController(const Paths &paths)
     this->registerCommand("/debug-invalidate-buffers",
                           &commands::invalidateBuffers);
 
+    this->registerCommand("/debug-latency", &commands::debugLatency);
+
+    this->registerCommand("/debug-paint", &commands::debugPaint);
+
     this->registerCommand("/debug-kick-raw-event",
                           &commands::debugKickRawEvent);
 
@@ -580,7 +584,7 @@ CommandController::CommandController(const Paths &paths)
             }
 
             s.botBadgeAlwaysUse = enabling;
-            s.requestSave();
+            s.queueSave();
 
             ctx.channel->addSystemMessage(
                 enabling
@@ -25,7 +25,9 @@
 #include "singletons/Toasts.hpp"
 #include "singletons/Updates.hpp"
 #include "singletons/WindowManager.hpp"
+#include "util/DebugCount.hpp"
 #include "util/PostToThread.hpp"
+#include "widgets/helper/PaintProfiler.hpp"
 
 #include <QApplication>
 #include <QLoggingCategory>
@@ -219,6 +221,72 @@ QString invalidateBuffers(const CommandContext & /*ctx*/)
     return {};
 }
 
+QString debugLatency(const CommandContext &ctx)
+{
+    if (ctx.words.value(1) == u"reset"_s)
+    {
+        DebugCount::resetLatencies();
+        if (ctx.channel)
+        {
+            ctx.channel->addSystemMessage(u"Reset the stage latencies."_s);
+        }
+        return {};
+    }
+
+    if (!ctx.channel)
+    {
+        return {};
+    }
+
+    const auto lines =
+        DebugCount::getLatencyText().split('\n', Qt::SkipEmptyParts);
+    for (const auto &line : lines)
+    {
+        ctx.channel->addSystemMessage(line);
+    }
+    return {};
+}
+
+QString debugPaint(const CommandContext &ctx)
+{
+    // NOLINTNEXTLINE(readability-identifier-naming)
+    constexpr size_t MAX_REPORTED_VIEWS = 5;
+
+    auto &profiler = PaintProfiler::instance();
+    const auto command = ctx.words.value(1);
+
+    if (command == u"report"_s)
+    {
+        if (!ctx.channel)
+        {
+            return {};
+        }
+        if (!profiler.enabled())
+        {
+            ctx.channel->addSystemMessage(
+                u"Paint profiling is off, enable it with /debug-paint."_s);
+            return {};
+        }
+        for (const auto &line : profiler.report(MAX_REPORTED_VIEWS))
+        {
+            ctx.channel->addSystemMessage(line);
+        }
+        return {};
+    }
+
+    profiler.setEnabled(!profiler.enabled());
+    getApp()->getWindows()->repaintVisibleChatWidgets();
+    if (ctx.channel)
+    {
+        ctx.channel->addSystemMessage(
+            profiler.enabled()
+                ? u"Paint profiling enabled. Use /debug-paint report to list "
+                  u"the slowest splits."_s
+                : u"Paint profiling disabled."_s);
+    }
+    return {};
+}
+
 QString eventsub(const CommandContext & /*ctx*/)
 {
     getApp()->getEventSub()->debug();
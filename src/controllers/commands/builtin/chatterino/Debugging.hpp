@@ -34,6 +34,10 @@ QString incrementImageGeneration(const CommandContext &ctx);
 
 QString invalidateBuffers(const CommandContext &ctx);
 
+QString debugLatency(const CommandContext &ctx);
+
+QString debugPaint(const CommandContext &ctx);
+
 QString eventsub(const CommandContext &ctx);
 
 QString debugTest(const CommandContext &ctx);
@@ -4,9 +4,13 @@
 #include "controllers/commands/CommandContext.hpp"
 #include "providers/kick/KickChannel.hpp"
 #include "providers/kick/KickChatServer.hpp"
-#include "util/BoostJsonWrap.hpp"
+#include "providers/kick/KickPusherEvent.hpp"
 
+#include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+
+#include <string>
 
 namespace chatterino::commands {
 
@@ -34,9 +38,16 @@ QString debugKickRawEvent(const CommandContext &ctx)
     {
         return u"Failed to parse JSON: "_s + QString::fromStdString(ec.what());
     }
-    bool handled = getApp()->getKickChatServer()->onAppEvent(
-        ctx.kickChannel->roomID(), 0, eventName, BoostJsonValue(jv).toObject());
-    if (handled)
+
+    // Go through the same decoder as events from the websocket
+    auto frame = boost::json::serialize(boost::json::object{
+        {"event", eventName},
+        {"channel",
+         "chatrooms." + std::to_string(ctx.kickChannel->roomID()) + ".v2"},
+        {"data", boost::json::serialize(jv)},
+    });
+    auto event = KickPusherEvent::decode(frame);
+    if (event && getApp()->getKickChatServer()->onAppEvent(*event))
     {
         return {};
     }
@@ -49,9 +49,9 @@ constexpr int SPAM_FINISH_CHECK_MS = 1000;
 constexpr int SPAM_FINISH_MAX_WAIT_MS = 10000;
 constexpr int MAX_TIMEOUT_SECONDS = 14 * 24 * 60 * 60;
 constexpr int MAX_NUKE_RANGE_SECONDS = 10 * 60;
-constexpr int NUKE_DELETE_INTERVAL_MS = 80;
-constexpr int NUKE_MODERATION_INTERVAL_MS = 150;
-constexpr int NUKE_RATE_LIMIT_BACKOFF_MS = 1200;
+/// Actions of a nuke that are handed to Helix at once. Helix paces them
+/// according to the rate limit, this only keeps `/nuke stop` responsive.
+constexpr int NUKE_MAX_IN_FLIGHT = 16;
 
 // NOLINTNEXTLINE(performance-enum-size)
 enum class NukeAction {
@@ -107,9 +107,7 @@ struct NukeJob {
 
     bool stopped = false;
     bool windowOpen = true;
-    bool queueScheduled = false;
     bool fatalError = false;
-    int extraDelayMs = 0;
     int inFlight = 0;
 
     int matchingMessages = 0;
@@ -888,10 +886,10 @@ void maybeFinishNukeJob(const std::shared_ptr<NukeJob> &job)
     removeNukeJob(job);
 }
 
-void scheduleNukePump(const std::shared_ptr<NukeJob> &job);
+void pumpNukeQueue(const std::shared_ptr<NukeJob> &job);
 
 void onNukeActionFinished(const std::shared_ptr<NukeJob> &job, bool success,
-                          bool rateLimited, bool fatal)
+                          bool fatal)
 {
     job->inFlight = std::max(0, job->inFlight - 1);
     if (success)
@@ -903,11 +901,6 @@ void onNukeActionFinished(const std::shared_ptr<NukeJob> &job, bool success,
         job->failedActions++;
     }
 
-    if (rateLimited)
-    {
-        job->extraDelayMs =
-            std::max(job->extraDelayMs, NUKE_RATE_LIMIT_BACKOFF_MS);
-    }
     if (fatal)
     {
         if (!job->fatalError)
@@ -924,8 +917,7 @@ void onNukeActionFinished(const std::shared_ptr<NukeJob> &job, bool success,
         job->queue.clear();
     }
 
-    scheduleNukePump(job);
-    maybeFinishNukeJob(job);
+    pumpNukeQueue(job);
 }
 
 void performNukeAction(const std::shared_ptr<NukeJob> &job,
@@ -935,7 +927,7 @@ void performNukeAction(const std::shared_ptr<NukeJob> &job,
     auto twitchChannel = job->twitchChannel.lock();
     if (channel == nullptr || twitchChannel == nullptr)
     {
-        onNukeActionFinished(job, false, false, true);
+        onNukeActionFinished(job, false, true);
         return;
     }
 
@@ -946,7 +938,7 @@ void performNukeAction(const std::shared_ptr<NukeJob> &job,
             getHelix()->deleteChatMessages(
                 twitchChannel->roomId(), job->moderatorID, target.messageID,
                 [job] {
-                    onNukeActionFinished(job, true, false, false);
+                    onNukeActionFinished(job, true, false);
                 },
                 [job](HelixDeleteChatMessagesError error, const auto &message) {
                     const bool fatal =
@@ -958,7 +950,7 @@ void performNukeAction(const std::shared_ptr<NukeJob> &job,
                                      UserNotAuthenticated ||
                         (error == HelixDeleteChatMessagesError::Forwarded &&
                          isFatalForwardedModerationError(message));
-                    onNukeActionFinished(job, false, false, fatal);
+                    onNukeActionFinished(job, false, fatal);
                 });
             break;
         }
@@ -973,17 +965,15 @@ void performNukeAction(const std::shared_ptr<NukeJob> &job,
                 duration,
                 getSettings()->nukeModerationMessage.getValue().trimmed(),
                 [job] {
-                    onNukeActionFinished(job, true, false, false);
+                    onNukeActionFinished(job, true, false);
                 },
                 [job](HelixBanUserError error, const auto &message) {
-                    const bool rateLimited =
-                        error == HelixBanUserError::Ratelimited;
                     const bool fatal =
                         error == HelixBanUserError::UserMissingScope ||
                         error == HelixBanUserError::UserNotAuthorized ||
                         (error == HelixBanUserError::Forwarded &&
                          isFatalForwardedModerationError(message));
-                    onNukeActionFinished(job, false, rateLimited, fatal);
+                    onNukeActionFinished(job, false, fatal);
                 });
             break;
         }
@@ -992,40 +982,13 @@ void performNukeAction(const std::shared_ptr<NukeJob> &job,
 
 void pumpNukeQueue(const std::shared_ptr<NukeJob> &job)
 {
-    job->queueScheduled = false;
-    if (job->stopped || job->fatalError || job->queue.isEmpty())
-    {
-        maybeFinishNukeJob(job);
-        return;
-    }
-
-    const auto target = job->queue.takeFirst();
-    performNukeAction(job, target);
-
-    if (!job->queue.isEmpty())
-    {
-        scheduleNukePump(job);
-    }
-}
-
-void scheduleNukePump(const std::shared_ptr<NukeJob> &job)
-{
-    if (job->queueScheduled || job->stopped || job->fatalError ||
-        job->queue.isEmpty())
+    while (!job->stopped && !job->fatalError && !job->queue.isEmpty() &&
+           job->inFlight < NUKE_MAX_IN_FLIGHT)
     {
-        maybeFinishNukeJob(job);
-        return;
+        performNukeAction(job, job->queue.takeFirst());
     }
 
-    job->queueScheduled = true;
-    const auto baseDelay = job->plan.action == NukeAction::Delete
-                               ? NUKE_DELETE_INTERVAL_MS
-                               : NUKE_MODERATION_INTERVAL_MS;
-    const auto delay = baseDelay + job->extraDelayMs;
-    job->extraDelayMs = 0;
-    QTimer::singleShot(delay, [job] {
-        pumpNukeQueue(job);
-    });
+    maybeFinishNukeJob(job);
 }
 
 void enqueueTarget(const std::shared_ptr<NukeJob> &job,
@@ -1050,7 +1013,7 @@ void enqueueTarget(const std::shared_ptr<NukeJob> &job,
 
     job->queue.push_back(target);
     job->queuedActions++;
-    scheduleNukePump(job);
+    pumpNukeQueue(job);
 }
 
 void enqueueMatches(const std::shared_ptr<NukeJob> &job,
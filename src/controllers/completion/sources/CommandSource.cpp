@@ -57,6 +57,8 @@ QString commandUsage(const QString &command)
         {"/debug-increment-image-generation", ""},
         {"/debug-invalidate-buffers", ""},
         {"/debug-kick-raw-event", ""},
+        {"/debug-latency", "[reset]"},
+        {"/debug-paint", "[report]"},
         {"/debug-test", ""},
         {"/debug-update-to-no-stream", ""},
         {"/delete", "<message-id>"},
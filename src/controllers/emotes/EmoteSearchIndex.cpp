@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "controllers/emotes/EmoteSearchIndex.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+namespace chatterino {
+
+EmoteSearchIndex::EmoteSearchIndex(std::vector<EmoteSection> sections)
+    : sections_(std::move(sections))
+{
+    size_t nEmotes = 0;
+    for (const auto &section : this->sections_)
+    {
+        nEmotes += section.emotes.size();
+    }
+    this->locations_.reserve(nEmotes);
+    this->folded_.reserve(nEmotes);
+
+    for (uint32_t s = 0; s < this->sections_.size(); s++)
+    {
+        const auto &emotes = this->sections_[s].emotes;
+        for (uint32_t e = 0; e < emotes.size(); e++)
+        {
+            auto entry = static_cast<uint32_t>(this->folded_.size());
+            this->locations_.push_back({.section = s, .emote = e});
+            this->folded_.emplace_back(emotes[e].name.toCaseFolded());
+
+            auto length = static_cast<uint32_t>(this->folded_.back().size());
+            for (uint32_t offset = 0; offset < length; offset++)
+            {
+                this->suffixes_.push_back({.entry = entry, .offset = offset});
+            }
+        }
+    }
+
+    std::ranges::sort(this->suffixes_, [this](const auto &a, const auto &b) {
+        return this->suffix(a) < this->suffix(b);
+    });
+}
+
+std::vector<EmoteSection> EmoteSearchIndex::search(QStringView query) const
+{
+    auto folded = query.toString().toCaseFolded();
+    QStringView needle(folded);
+
+    std::vector<uint32_t> matches;
+    auto it = std::lower_bound(this->suffixes_.begin(), this->suffixes_.end(),
+                               needle,
+                               [this](const auto &suffix, QStringView value) {
+                                   return this->suffix(suffix) < value;
+                               });
+    for (; it != this->suffixes_.end() && this->suffix(*it).startsWith(needle);
+         ++it)
+    {
+        matches.push_back(it->entry);
+    }
+
+    // A name can contain the query more than once
+    std::ranges::sort(matches);
+    auto duplicates = std::ranges::unique(matches);
+    matches.erase(duplicates.begin(), duplicates.end());
+
+    std::vector<EmoteSection> result;
+    std::optional<uint32_t> currentSection;
+    for (auto entry : matches)
+    {
+        const auto &location = this->locations_[entry];
+        const auto &section = this->sections_[location.section];
+        if (currentSection != location.section)
+        {
+            currentSection = location.section;
+            result.push_back({.title = section.title, .emotes = {}});
+        }
+        result.back().emotes.push_back(section.emotes[location.emote]);
+    }
+
+    return result;
+}
+
+const std::vector<EmoteSection> &EmoteSearchIndex::sections() const
+{
+    return this->sections_;
+}
+
+QStringView EmoteSearchIndex::suffix(const Suffix &suffix) const
+{
+    return QStringView(this->folded_[suffix.entry]).sliced(suffix.offset);
+}
+
+}  // namespace chatterino
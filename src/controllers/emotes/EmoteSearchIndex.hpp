@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QString>
+#include <QStringView>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+struct Emote;
+using EmotePtr = std::shared_ptr<const Emote>;
+
+struct EmoteEntry {
+    /// The name that's searched for
+    QString name;
+    /// The text inserted into the input when the emote is clicked
+    QString insertText;
+    EmotePtr emote;
+};
+
+/// A titled group of emotes, such as an emote set or an emoji category
+struct EmoteSection {
+    QString title;
+    std::vector<EmoteEntry> emotes;
+};
+
+/**
+ * @brief A case-insensitive substring index over emote names
+ *
+ * The index is a sorted array of all suffixes of the case-folded names. A
+ * query is a binary search for the first suffix starting with it, followed by
+ * a walk over the suffixes sharing that prefix. Searching doesn't look at the
+ * names that don't match and doesn't fold any names.
+ **/
+class EmoteSearchIndex
+{
+public:
+    EmoteSearchIndex() = default;
+    explicit EmoteSearchIndex(std::vector<EmoteSection> sections);
+
+    /// Returns the sections with the emotes whose name contains `query`,
+    /// ignoring the case. Sections and emotes keep their order and sections
+    /// without a match are left out.
+    std::vector<EmoteSection> search(QStringView query) const;
+
+    const std::vector<EmoteSection> &sections() const;
+
+private:
+    struct Location {
+        uint32_t section = 0;
+        uint32_t emote = 0;
+    };
+    struct Suffix {
+        /// Index into `locations_` and `folded_`
+        uint32_t entry = 0;
+        uint32_t offset = 0;
+    };
+
+    QStringView suffix(const Suffix &suffix) const;
+
+    std::vector<EmoteSection> sections_;
+    /// Entries are in the order of the sections and their emotes
+    std::vector<Location> locations_;
+    std::vector<QString> folded_;
+    std::vector<Suffix> suffixes_;
+};
+
+}  // namespace chatterino
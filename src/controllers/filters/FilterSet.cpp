@@ -6,6 +6,7 @@
 
 #include "controllers/filters/FilterRecord.hpp"
 #include "singletons/Settings.hpp"
+#include "util/DebugCount.hpp"
 
 namespace chatterino {
 
@@ -46,6 +47,7 @@ bool FilterSet::filter(const MessagePtr &m, ChannelPtr channel) const
         return true;
     }
 
+    DebugStageTimer timer(DebugStage::Filter);
     filters::RunContext ctx{
         .message = *m,
         .channel = channel.get(),
@@ -18,6 +18,7 @@
 #include "providers/twitch/TwitchAccount.hpp"  // IWYU pragma: keep
 #include "providers/twitch/TwitchBadge.hpp"
 #include "singletons/Settings.hpp"
+#include "util/DebugCount.hpp"
 
 namespace {
 
@@ -501,6 +502,8 @@ std::pair<bool, HighlightResult> HighlightController::check(
     const QString &senderName, const QString &originalMessage,
     const MessageFlags &messageFlags, MessagePlatform platform) const
 {
+    DebugStageTimer timer(DebugStage::Highlight);
+
     bool highlighted = false;
     auto result = HighlightResult::emptyResult();
 
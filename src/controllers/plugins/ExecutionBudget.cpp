@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#ifdef CHATTERINO_HAVE_PLUGINS
+#    include "controllers/plugins/ExecutionBudget.hpp"
+
+#    include "controllers/plugins/LuaUtilities.hpp"
+
+#    include <lauxlib.h>
+
+namespace {
+
+using namespace chatterino::lua;
+
+// Plugins only run on the GUI thread, but keep this per-thread to be safe.
+thread_local ExecutionBudget *currentBudget = nullptr;
+
+}  // namespace
+
+namespace chatterino::lua {
+
+ExecutionBudget::ExecutionBudget(lua_State *L, Limits limits)
+    : L_(L)
+    , limits_(limits)
+    , previous_(currentBudget)
+    , previousHook_(lua_gethook(L))
+    , previousMask_(lua_gethookmask(L))
+    , previousCount_(lua_gethookcount(L))
+{
+    currentBudget = this;
+    this->timer_.start();
+    lua_sethook(L, &ExecutionBudget::hook, LUA_MASKCOUNT, HOOK_INTERVAL);
+}
+
+ExecutionBudget::~ExecutionBudget()
+{
+    lua_sethook(this->L_, this->previousHook_, this->previousMask_,
+                this->previousCount_);
+    currentBudget = this->previous_;
+}
+
+bool ExecutionBudget::exceeded() const noexcept
+{
+    return this->exceeded_;
+}
+
+std::chrono::nanoseconds ExecutionBudget::elapsed() const
+{
+    return std::chrono::nanoseconds(this->timer_.nsecsElapsed());
+}
+
+void ExecutionBudget::hook(lua_State *L, lua_Debug * /*ar*/)
+{
+    auto *self = currentBudget;
+    if (self == nullptr)
+    {
+        return;
+    }
+
+    self->instructions_ += HOOK_INTERVAL;
+    if (self->limits_.instructions > 0 &&
+        self->instructions_ > self->limits_.instructions)
+    {
+        self->exceeded_ = true;
+        fail(L, "execution budget exceeded: more than %I instructions",
+             static_cast<lua_Integer>(self->limits_.instructions));
+    }
+    if (self->limits_.time.count() > 0 &&
+        self->timer_.hasExpired(self->limits_.time.count()))
+    {
+        self->exceeded_ = true;
+        fail(L, "execution budget exceeded: ran for more than %d ms",
+             static_cast<int>(self->limits_.time.count()));
+    }
+}
+
+}  // namespace chatterino::lua
+
+#endif
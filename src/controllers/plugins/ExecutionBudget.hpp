@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#ifdef CHATTERINO_HAVE_PLUGINS
+
+#    include <lua.h>
+#    include <QElapsedTimer>
+
+#    include <chrono>
+#    include <cstdint>
+
+namespace chatterino::lua {
+
+/// Limits how much work a Lua callback may do.
+///
+/// While an instance is alive, a count hook is installed on the given state.
+/// Once either the instruction or the time budget is used up, the running
+/// code is aborted with a Lua error, which the surrounding protected call
+/// reports like any other error.
+///
+/// Budgets may be nested, the innermost one is checked.
+class ExecutionBudget
+{
+public:
+    struct Limits {
+        uint64_t instructions = 0;
+        std::chrono::milliseconds time{0};
+    };
+
+    /// How many instructions are executed between two checks
+    static constexpr int HOOK_INTERVAL = 1000;
+
+    ExecutionBudget(lua_State *L, Limits limits);
+    ~ExecutionBudget();
+
+    ExecutionBudget(const ExecutionBudget &) = delete;
+    ExecutionBudget(ExecutionBudget &&) = delete;
+    ExecutionBudget &operator=(const ExecutionBudget &) = delete;
+    ExecutionBudget &operator=(ExecutionBudget &&) = delete;
+
+    /// Returns true if the code was aborted because it ran out of budget
+    bool exceeded() const noexcept;
+
+    /// Time spent since the budget was created
+    std::chrono::nanoseconds elapsed() const;
+
+private:
+    static void hook(lua_State *L, lua_Debug *ar);
+
+    lua_State *L_;
+    Limits limits_;
+    QElapsedTimer timer_;
+    uint64_t instructions_ = 0;
+    bool exceeded_ = false;
+
+    ExecutionBudget *previous_;
+    lua_Hook previousHook_;
+    int previousMask_;
+    int previousCount_;
+};
+
+}  // namespace chatterino::lua
+
+#endif
@@ -8,8 +8,10 @@
 #    include "Application.hpp"
 #    include "common/QLogging.hpp"
 #    include "controllers/plugins/LuaUtilities.hpp"
+#    include "controllers/plugins/MessageStream.hpp"
 #    include "controllers/plugins/PluginController.hpp"
 #    include "controllers/plugins/SolTypes.hpp"  // for lua operations on QString{,List} for CompletionList
+#    include "messages/Message.hpp"
 
 #    include <lauxlib.h>
 #    include <lua.h>
@@ -80,10 +82,41 @@ sol::table toTable(lua_State *L, const CompletionEvent &ev)
     );
 }
 
+sol::table toTable(lua_State *L, const MessageBatch &batch)
+{
+    sol::state_view lua(L);
+    auto entries = lua.create_table(static_cast<int>(batch.entries.size()), 0);
+    for (const auto &entry : batch.entries)
+    {
+        auto channel = entry.channel.lock();
+        if (!channel)
+        {
+            continue;
+        }
+        entries.add(lua.create_table_with(
+            "channel", ChannelRef(channel),  //
+            "message",
+            // Plugins take messages as `Message`, but check that they're frozen
+            std::const_pointer_cast<Message>(entry.message)  //
+            ));
+    }
+
+    return lua.create_table_with(
+        "entries", entries,       //
+        "dropped", batch.dropped  //
+    );
+}
+
 void c2_register_callback(ThisPluginState L, EventType evtType,
                           sol::protected_function callback)
 {
-    L.plugin()->callbacks[evtType] = std::move(callback);
+    auto &callbacks = L.plugin()->callbacks;
+    if (evtType == EventType::MessagesReceived &&
+        !callbacks.contains(evtType))
+    {
+        MessageStream::addSubscriber();
+    }
+    callbacks[evtType] = std::move(callback);
 }
 
 void c2_log(ThisPluginState L, LogLevel lvl, sol::variadic_args args)
@@ -6,6 +6,7 @@
 
 #ifdef CHATTERINO_HAVE_PLUGINS
 #    include "controllers/plugins/api/ChannelRef.hpp"
+#    include "controllers/plugins/MessageStream.hpp"
 #    include "controllers/plugins/Plugin.hpp"
 #    include "controllers/plugins/SolTypes.hpp"
 
@@ -16,6 +17,7 @@
 
 #    include <cassert>
 #    include <memory>
+#    include <span>
 
 struct lua_State;
 namespace chatterino::lua::api {
@@ -84,6 +86,28 @@ struct CompletionEvent {
 
 sol::table toTable(lua_State *L, const CompletionEvent &ev);
 
+/**
+ * @lua@class MessageBatchEntry
+ * @lua@field channel c2.Channel The channel the message was added to
+ * @lua@field message c2.Message The message. It's frozen and can't be modified.
+ */
+
+/**
+ * @lua@class MessageBatch
+ */
+struct MessageBatch {
+    /**
+     * @lua@field entries MessageBatchEntry[] Messages added since the last batch, oldest first
+     */
+    std::span<const MessageStream::Entry> entries;
+    /**
+     * @lua@field dropped integer Number of messages that were dropped since the last batch because they arrived faster than they could be delivered
+     */
+    size_t dropped{};
+};
+
+sol::table toTable(lua_State *L, const MessageBatch &batch);
+
 /* @lua-fragment
 
 ---@alias QSize [integer, integer] A pair of [width, height]
@@ -114,8 +138,13 @@ sol::table toTable(lua_State *L, const CompletionEvent &ev);
  */
 
 /**
- * Registers a callback to be invoked when completions for a term are requested.
+ * Registers a callback to be invoked when completions for a term are requested
+ * or when messages were added to any channel.
+ *
+ * Messages are delivered in batches. A batch callback that runs for too long
+ * is aborted, and the following batch is skipped.
  *
+ * @lua@overload fun(type: c2.EventType.MessagesReceived, func: fun(batch: MessageBatch))
  * @lua@param type c2.EventType.CompletionRequested
  * @lua@param func fun(event: CompletionEvent): CompletionList The callback to be invoked.
  * @exposed c2.register_callback
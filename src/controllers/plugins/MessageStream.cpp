@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#ifdef CHATTERINO_HAVE_PLUGINS
+#    include "controllers/plugins/MessageStream.hpp"
+
+#    include <cassert>
+#    include <iterator>
+#    include <utility>
+#    include <vector>
+
+namespace chatterino::lua {
+
+std::atomic<size_t> MessageStream::subscribers{0};
+
+MessageStream::MessageStream(Sink sink)
+    : sink_(std::move(sink))
+{
+    this->flushTimer_.setSingleShot(true);
+    this->flushTimer_.setInterval(FLUSH_INTERVAL);
+    QObject::connect(&this->flushTimer_, &QTimer::timeout, &this->flushTimer_,
+                     [this] {
+                         this->flush();
+                     });
+}
+
+bool MessageStream::hasSubscribers() noexcept
+{
+    return subscribers.load(std::memory_order_relaxed) > 0;
+}
+
+void MessageStream::addSubscriber() noexcept
+{
+    subscribers.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MessageStream::removeSubscriber() noexcept
+{
+    [[maybe_unused]] auto prev =
+        subscribers.fetch_sub(1, std::memory_order_relaxed);
+    assert(prev > 0);
+}
+
+void MessageStream::push(std::weak_ptr<Channel> channel, MessagePtr message)
+{
+    if (this->pending_.size() >= MAX_PENDING)
+    {
+        this->pending_.pop_front();
+        this->dropped_++;
+    }
+    this->pending_.push_back({
+        .channel = std::move(channel),
+        .message = std::move(message),
+    });
+
+    if (!this->flushTimer_.isActive())
+    {
+        this->flushTimer_.start();
+    }
+}
+
+void MessageStream::flush()
+{
+    this->flushTimer_.stop();
+    if (this->pending_.empty() && this->dropped_ == 0)
+    {
+        return;
+    }
+
+    // take everything out first - plugins might add messages from their
+    // callbacks, these will end up in the next batch
+    std::vector<Entry> batch(std::make_move_iterator(this->pending_.begin()),
+                             std::make_move_iterator(this->pending_.end()));
+    this->pending_.clear();
+    auto dropped = std::exchange(this->dropped_, 0);
+
+    if (this->sink_)
+    {
+        this->sink_(batch, dropped);
+    }
+}
+
+size_t MessageStream::pending() const noexcept
+{
+    return this->pending_.size();
+}
+
+}  // namespace chatterino::lua
+
+#endif
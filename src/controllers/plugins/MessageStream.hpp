@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#ifdef CHATTERINO_HAVE_PLUGINS
+
+#    include <QTimer>
+
+#    include <atomic>
+#    include <chrono>
+#    include <cstddef>
+#    include <deque>
+#    include <functional>
+#    include <memory>
+#    include <span>
+
+namespace chatterino {
+
+class Channel;
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+}  // namespace chatterino
+
+namespace chatterino::lua {
+
+/// Collects messages added to any channel and hands them to plugins in
+/// batches.
+///
+/// Messages are queued as they arrive and flushed at most once per
+/// #FLUSH_INTERVAL. If more than #MAX_PENDING messages arrive between two
+/// flushes, the oldest ones are dropped and reported in the next batch
+/// instead of growing the queue.
+///
+/// This must only be used from the GUI thread.
+class MessageStream
+{
+public:
+    struct Entry {
+        std::weak_ptr<Channel> channel;
+        MessagePtr message;
+    };
+
+    using Sink = std::function<void(std::span<const Entry> entries,
+                                    size_t dropped)>;
+
+    static constexpr size_t MAX_PENDING = 1000;
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{100};
+
+    explicit MessageStream(Sink sink);
+
+    /// Returns true if any plugin is subscribed to the stream.
+    ///
+    /// This is cheap and doesn't require an Application, so it can be called
+    /// for every message.
+    static bool hasSubscribers() noexcept;
+    static void addSubscriber() noexcept;
+    static void removeSubscriber() noexcept;
+
+    void push(std::weak_ptr<Channel> channel, MessagePtr message);
+
+    /// Delivers all pending messages now.
+    void flush();
+
+    size_t pending() const noexcept;
+
+private:
+    Sink sink_;
+    std::deque<Entry> pending_;
+    size_t dropped_ = 0;
+    QTimer flushTimer_;
+
+    static std::atomic<size_t> subscribers;
+};
+
+}  // namespace chatterino::lua
+
+#endif
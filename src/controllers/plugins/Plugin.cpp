@@ -8,6 +8,7 @@
 #    include "Application.hpp"
 #    include "common/QLogging.hpp"
 #    include "controllers/commands/CommandController.hpp"
+#    include "controllers/plugins/MessageStream.hpp"
 #    include "controllers/plugins/PluginPermission.hpp"
 #    include "controllers/plugins/SignalCallback.hpp"
 
@@ -71,6 +72,10 @@ Plugin::~Plugin()
     this->activeTimeouts.clear();
     if (this->state_ != nullptr)
     {
+        if (this->callbacks.contains(lua::api::EventType::MessagesReceived))
+        {
+            lua::MessageStream::removeSubscriber();
+        }
         // clearing this after the state is gone is not safe to do
         this->ownedCommands.clear();
         this->callbacks.clear();
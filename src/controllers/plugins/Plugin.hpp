@@ -18,6 +18,7 @@
 #    include <semver/semver.hpp>
 #    include <sol/forward.hpp>
 
+#    include <chrono>
 #    include <memory>
 #    include <optional>
 #    include <unordered_map>
@@ -83,14 +84,14 @@ public:
         return this->loadDirectory_.absoluteFilePath("data");
     }
 
-    std::optional<sol::protected_function> getCompletionCallback()
+    std::optional<sol::protected_function> getCallback(
+        lua::api::EventType type)
     {
         if (this->state_ == nullptr || !this->error_.isNull())
         {
             return {};
         }
-        auto it =
-            this->callbacks.find(lua::api::EventType::CompletionRequested);
+        auto it = this->callbacks.find(type);
         if (it == this->callbacks.end())
         {
             return {};
@@ -98,6 +99,11 @@ public:
         return it->second;
     }
 
+    std::optional<sol::protected_function> getCompletionCallback()
+    {
+        return this->getCallback(lua::api::EventType::CompletionRequested);
+    }
+
     lua::SignalCallback createCallback(sol::main_protected_function pfn);
 
     /**
@@ -128,6 +134,18 @@ public:
     // This is a lifetime hack to ensure they get deleted with the plugin. This relies on the Plugin getting deleted on reload!
     std::vector<std::shared_ptr<lua::api::HTTPRequest>> httpRequests;
 
+    struct MessageStreamStats {
+        /// Total time spent in the MessagesReceived callback
+        std::chrono::nanoseconds callbackTime{0};
+        /// Time spent handling the most recent batch
+        std::chrono::nanoseconds lastBatchTime{0};
+        size_t batches = 0;
+        size_t delivered = 0;
+        size_t dropped = 0;
+        size_t budgetExceeded = 0;
+    };
+    MessageStreamStats messageStreamStats;
+
     pajlada::Signals::NoArgSignal onUnloaded;
     pajlada::Signals::Signal<lua::api::LogLevel, const QString &> onLog;
     lua::ConnectionManager connections;
@@ -145,6 +163,9 @@ private:
     std::vector<QTimer *> activeTimeouts;
     int lastTimerId = 0;
 
+    /// Set when the last batch exceeded its budget, the next batch is skipped
+    bool messageStreamThrottled_ = false;
+
     friend class PluginController;
     friend class PluginControllerAccess;  // this is for tests
 };
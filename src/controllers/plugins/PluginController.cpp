@@ -23,6 +23,7 @@
 #    include "controllers/plugins/api/Message.hpp"
 #    include "controllers/plugins/api/WebSocket.hpp"
 #    include "controllers/plugins/api/WindowManager.hpp"
+#    include "controllers/plugins/ExecutionBudget.hpp"
 #    include "controllers/plugins/LuaAPI.hpp"
 #    include "controllers/plugins/LuaUtilities.hpp"
 #    include "controllers/plugins/SolTypes.hpp"
@@ -48,10 +49,25 @@
 #    include <utility>
 #    include <variant>
 
+namespace {
+
+using namespace std::chrono_literals;
+using namespace chatterino;
+
+constexpr lua::ExecutionBudget::Limits MESSAGE_BATCH_BUDGET{
+    .instructions = 5'000'000,
+    .time = 20ms,
+};
+
+}  // namespace
+
 namespace chatterino {
 
 PluginController::PluginController(const Paths &paths_)
     : paths(paths_)
+    , messageStream_([this](auto entries, auto dropped) {
+        this->deliverMessages(entries, dropped);
+    })
 {
     this->loaders_.emplace_back("chatterino.json", &lua::api::loadJson);
 }
@@ -490,5 +506,63 @@ WebSocketPool &PluginController::webSocketPool()
     return this->webSocketPool_;
 }
 
+lua::MessageStream &PluginController::messageStream()
+{
+    return this->messageStream_;
+}
+
+void PluginController::deliverMessages(
+    std::span<const lua::MessageStream::Entry> entries, size_t dropped)
+{
+    for (const auto &[name, pl] : this->plugins())
+    {
+        auto cb = pl->getCallback(lua::api::EventType::MessagesReceived);
+        if (!cb)
+        {
+            continue;
+        }
+
+        auto &stats = pl->messageStreamStats;
+        if (pl->messageStreamThrottled_)
+        {
+            // The previous batch ran out of budget, give the GUI thread
+            // some room and count this batch as dropped.
+            pl->messageStreamThrottled_ = false;
+            stats.dropped += entries.size() + dropped;
+            continue;
+        }
+
+        auto batch = toTable(pl->state_, lua::api::MessageBatch{
+                                             .entries = entries,
+                                             .dropped = dropped,
+                                         });
+        // Entries of channels that are gone aren't part of the batch
+        auto delivered = batch.get<sol::table>("entries").size();
+
+        lua::ExecutionBudget budget(pl->state_, MESSAGE_BATCH_BUDGET);
+        auto res = lua::tryCall<void>(*cb, batch);
+
+        stats.lastBatchTime = budget.elapsed();
+        stats.callbackTime += stats.lastBatchTime;
+        stats.batches++;
+        stats.delivered += delivered;
+        stats.dropped += dropped;
+
+        if (budget.exceeded())
+        {
+            stats.budgetExceeded++;
+            pl->messageStreamThrottled_ = true;
+        }
+        if (!res)
+        {
+            qCWarning(chatterinoLua)
+                << "Got error from plugin" << pl->meta.name
+                << "while handling messages:" << res.error();
+            pl->onLog.invoke(lua::api::LogLevel::Warning,
+                             "Error while handling messages: " + res.error());
+        }
+    }
+}
+
 }  // namespace chatterino
 #endif
@@ -8,6 +8,7 @@
 
 #    include "common/websockets/WebSocketPool.hpp"
 #    include "controllers/commands/CommandContext.hpp"
+#    include "controllers/plugins/MessageStream.hpp"
 #    include "controllers/plugins/Plugin.hpp"
 
 #    include <pajlada/signals/signal.hpp>
@@ -20,6 +21,7 @@
 
 #    include <map>
 #    include <memory>
+#    include <span>
 #    include <utility>
 
 struct lua_State;
@@ -68,6 +70,10 @@ public:
 
     WebSocketPool &webSocketPool();
 
+    /// Messages pushed here are delivered to plugins that registered a
+    /// MessagesReceived callback.
+    lua::MessageStream &messageStream();
+
     pajlada::Signals::Signal<Plugin *> onPluginLoaded;
 
 private:
@@ -80,10 +86,14 @@ private:
 
     void initSol(sol::state_view &lua, Plugin *plugin);
 
+    void deliverMessages(std::span<const lua::MessageStream::Entry> entries,
+                         size_t dropped);
+
     static void loadChatterinoLib(lua_State *l);
     bool tryLoadFromDir(const QDir &pluginDir);
     std::map<QString, std::unique_ptr<Plugin>> plugins_;
     WebSocketPool webSocketPool_;
+    lua::MessageStream messageStream_;
 
     std::vector<
         std::pair<std::string, std::function<sol::object(sol::state_view)>>>
@@ -0,0 +1,225 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "controllers/sound/DecodedSound.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <miniaudio.h>
+#include <QFile>
+
+#include <algorithm>
+#include <utility>
+
+namespace chatterino {
+
+struct DecodedSound::Voice {
+    ma_audio_buffer_ref buffer{};
+    ma_sound sound{};
+    bool bufferInitialized = false;
+    bool soundInitialized = false;
+    std::chrono::steady_clock::time_point startedAt;
+
+    Voice() = default;
+    ~Voice()
+    {
+        if (this->soundInitialized)
+        {
+            ma_sound_uninit(&this->sound);
+        }
+        if (this->bufferInitialized)
+        {
+            ma_audio_buffer_ref_uninit(&this->buffer);
+        }
+    }
+
+    Voice(const Voice &) = delete;
+    Voice(Voice &&) = delete;
+    Voice &operator=(const Voice &) = delete;
+    Voice &operator=(Voice &&) = delete;
+};
+
+DecodedSound::DecodedSound(const Options &options)
+    : options_(options)
+{
+}
+
+DecodedSound::~DecodedSound() = default;
+
+std::unique_ptr<DecodedSound> DecodedSound::fromMemory(ma_engine *engine,
+                                                       const QByteArray &data,
+                                                       const Options &options)
+{
+    auto config = ma_decoder_config_init(ma_format_f32,
+                                         ma_engine_get_channels(engine),
+                                         ma_engine_get_sample_rate(engine));
+
+    ma_decoder decoder;
+    auto result = ma_decoder_init_memory(data.constData(),
+                                         static_cast<size_t>(data.size()),
+                                         &config, &decoder);
+    if (result != MA_SUCCESS)
+    {
+        qCWarning(chatterinoSound) << "Error initializing decoder:" << result;
+        return nullptr;
+    }
+
+    auto sound = decode(engine, &decoder, options);
+    ma_decoder_uninit(&decoder);
+    return sound;
+}
+
+std::unique_ptr<DecodedSound> DecodedSound::fromFile(ma_engine *engine,
+                                                     const QString &path,
+                                                     const Options &options)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qCWarning(chatterinoSound)
+            << "Error opening sound" << path << file.errorString();
+        return nullptr;
+    }
+
+    // The encoded file is smaller than the decoded sound
+    if (std::cmp_greater(file.size(), options.maxBytes))
+    {
+        qCDebug(chatterinoSound) << "Not decoding large sound" << path;
+        return nullptr;
+    }
+
+    return fromMemory(engine, file.readAll(), options);
+}
+
+std::unique_ptr<DecodedSound> DecodedSound::decode(ma_engine *engine,
+                                                   ma_decoder *decoder,
+                                                   const Options &options)
+{
+    auto channels = ma_engine_get_channels(engine);
+
+    ma_uint64 length = 0;
+    auto result = ma_decoder_get_length_in_pcm_frames(decoder, &length);
+    if (result != MA_SUCCESS || length == 0)
+    {
+        qCWarning(chatterinoSound)
+            << "Error getting the length of a sound:" << result;
+        return nullptr;
+    }
+
+    if (length * channels * sizeof(float) > options.maxBytes)
+    {
+        qCDebug(chatterinoSound)
+            << "Not decoding long sound with" << length << "frames";
+        return nullptr;
+    }
+
+    std::unique_ptr<DecodedSound> sound(new DecodedSound(options));
+    sound->frames_.resize(length * channels);
+
+    ma_uint64 read = 0;
+    result = ma_decoder_read_pcm_frames(decoder, sound->frames_.data(), length,
+                                        &read);
+    if ((result != MA_SUCCESS && result != MA_AT_END) || read == 0)
+    {
+        qCWarning(chatterinoSound) << "Error decoding sound:" << result;
+        return nullptr;
+    }
+    sound->frames_.resize(read * channels);
+
+    ma_uint32 soundFlags = 0;
+    // Disable pitch control (we don't use it, so this saves some performance)
+    soundFlags |= MA_SOUND_FLAG_NO_PITCH;
+    // Disable spatialization control, this brings the volume up to "normal levels"
+    soundFlags |= MA_SOUND_FLAG_NO_SPATIALIZATION;
+
+    for (size_t i = 0; i < options.voices; i++)
+    {
+        auto voice = std::make_unique<Voice>();
+
+        // All voices read from the same decoded frames
+        result = ma_audio_buffer_ref_init(ma_format_f32, channels,
+                                          sound->frames_.data(), read,
+                                          &voice->buffer);
+        if (result != MA_SUCCESS)
+        {
+            qCWarning(chatterinoSound)
+                << "Error initializing sound buffer:" << result;
+            return nullptr;
+        }
+        voice->bufferInitialized = true;
+
+        result = ma_sound_init_from_data_source(
+            engine, &voice->buffer, soundFlags, nullptr, &voice->sound);
+        if (result != MA_SUCCESS)
+        {
+            qCWarning(chatterinoSound)
+                << "Error initializing sound from data source:" << result;
+            return nullptr;
+        }
+        voice->soundInitialized = true;
+
+        sound->voices_.emplace_back(std::move(voice));
+    }
+
+    return sound;
+}
+
+DecodedSound::PlayResult DecodedSound::play(
+    std::chrono::steady_clock::time_point now)
+{
+    if (this->lastPlay_ &&
+        now - *this->lastPlay_ < this->options_.coalesceWindow)
+    {
+        return PlayResult::Coalesced;
+    }
+
+    if (this->voices_.empty())
+    {
+        return PlayResult::Failed;
+    }
+
+    auto it = std::ranges::find_if(this->voices_, [](const auto &voice) {
+        return !ma_sound_is_playing(&voice->sound);
+    });
+    bool stolen = it == this->voices_.end();
+    if (stolen)
+    {
+        it = std::ranges::min_element(this->voices_, {}, [](const auto &voice) {
+            return voice->startedAt;
+        });
+    }
+
+    auto &voice = **it;
+    ma_sound_seek_to_pcm_frame(&voice.sound, 0);
+    auto result = ma_sound_start(&voice.sound);
+    if (result != MA_SUCCESS)
+    {
+        qCWarning(chatterinoSound) << "Failed to start sound" << result;
+        return PlayResult::Failed;
+    }
+
+    voice.startedAt = now;
+    this->lastPlay_ = now;
+    return stolen ? PlayResult::Stolen : PlayResult::Started;
+}
+
+DecodedSound::PlayResult DecodedSound::play()
+{
+    return this->play(std::chrono::steady_clock::now());
+}
+
+size_t DecodedSound::sizeInBytes() const
+{
+    return this->frames_.size() * sizeof(float);
+}
+
+size_t DecodedSound::playingVoices() const
+{
+    return static_cast<size_t>(
+        std::ranges::count_if(this->voices_, [](const auto &voice) {
+            return ma_sound_is_playing(&voice->sound) == MA_TRUE;
+        }));
+}
+
+}  // namespace chatterino
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+struct ma_engine;
+struct ma_decoder;
+
+namespace chatterino {
+
+/**
+ * @brief A sound decoded into memory, played by a pool of voices
+ *
+ * Playing the sound doesn't read or decode anything. If all voices are busy,
+ * the one that started first is restarted. Plays that come right after the
+ * previous one are coalesced, so a burst of pings is heard as a few distinct
+ * pings.
+ *
+ * All functions must be called from the thread that owns the engine.
+ **/
+class DecodedSound
+{
+public:
+    struct Options {
+        /// How many times the sound can play at once
+        size_t voices = 4;
+        /// Plays within this time after the previous play are dropped
+        std::chrono::milliseconds coalesceWindow{100};
+        /// Sounds that are larger when decoded aren't kept in memory
+        size_t maxBytes = 16 * 1024 * 1024;
+    };
+
+    enum class PlayResult : std::uint8_t {
+        Started,
+        /// A voice that was still playing was restarted
+        Stolen,
+        /// The play came too soon after the previous one
+        Coalesced,
+        Failed,
+    };
+
+    /// Decodes `data` to the output format of `engine`.
+    /// Returns nullptr if the data can't be decoded or is too large.
+    static std::unique_ptr<DecodedSound> fromMemory(ma_engine *engine,
+                                                    const QByteArray &data,
+                                                    const Options &options);
+    /// Reads and decodes the file at `path`, see fromMemory()
+    static std::unique_ptr<DecodedSound> fromFile(ma_engine *engine,
+                                                  const QString &path,
+                                                  const Options &options);
+
+    ~DecodedSound();
+
+    DecodedSound(const DecodedSound &) = delete;
+    DecodedSound(DecodedSound &&) = delete;
+    DecodedSound &operator=(const DecodedSound &) = delete;
+    DecodedSound &operator=(DecodedSound &&) = delete;
+
+    PlayResult play(std::chrono::steady_clock::time_point now);
+    PlayResult play();
+
+    /// The size of the decoded PCM data
+    size_t sizeInBytes() const;
+    size_t playingVoices() const;
+
+private:
+    struct Voice;
+
+    explicit DecodedSound(const Options &options);
+
+    static std::unique_ptr<DecodedSound> decode(ma_engine *engine,
+                                                ma_decoder *decoder,
+                                                const Options &options);
+
+    const Options options_;
+    std::vector<float> frames_;
+    std::vector<std::unique_ptr<Voice>> voices_;
+    std::optional<std::chrono::steady_clock::time_point> lastPlay_;
+};
+
+}  // namespace chatterino
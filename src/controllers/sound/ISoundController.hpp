@@ -32,6 +32,15 @@ public:
     //
     // This function should not block
     virtual void play(const QUrl &sound) = 0;
+
+    // Prepare the sound from the given url so its first play doesn't have to
+    // load it
+    //
+    // This function should not block
+    virtual void preload(const QUrl &sound)
+    {
+        (void)sound;
+    }
 };
 
 }  // namespace chatterino
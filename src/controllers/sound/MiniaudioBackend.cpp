@@ -14,8 +14,10 @@
 #define MINIAUDIO_IMPLEMENTATION
 #include <miniaudio.h>
 #include <QFile>
+#include <QFileInfo>
 #include <QScopeGuard>
 
+#include <algorithm>
 #include <memory>
 
 namespace {
@@ -26,6 +28,9 @@ using namespace chatterino;
 // returning the handle to idle letting the computer or monitors sleep
 constexpr const auto STOP_AFTER_DURATION = std::chrono::seconds(30);
 
+// The number of custom sounds we keep decoded in memory
+constexpr const size_t MAX_CACHED_SOUNDS = 16;
+
 void miniaudioLogCallback(void *userData, ma_uint32 level, const char *pMessage)
 {
     (void)userData;
@@ -66,9 +71,6 @@ void miniaudioLogCallback(void *userData, ma_uint32 level, const char *pMessage)
 
 namespace chatterino {
 
-// NUM_SOUNDS specifies how many simultaneous default ping sounds & decoders to create
-constexpr const auto NUM_SOUNDS = 4;
-
 MiniaudioBackend::MiniaudioBackend(bool keepEngineAlive_)
     : context(std::make_unique<ma_context>())
     , engine(std::make_unique<ma_engine>())
@@ -153,56 +155,17 @@ MiniaudioBackend::MiniaudioBackend(bool keepEngineAlive_)
             }
         }
 
-        /// Initialize default ping sounds
+        /// Initialize default ping sound
         {
-            // TODO: Can we optimize this?
             BenchmarkGuard b("init sounds");
 
-            ma_uint32 soundFlags = 0;
-            // Decode the sound during loading instead of during playback
-            soundFlags |= MA_SOUND_FLAG_DECODE;
-            // Disable pitch control (we don't use it, so this saves some performance)
-            soundFlags |= MA_SOUND_FLAG_NO_PITCH;
-            // Disable spatialization control, this brings the volume up to "normal levels"
-            soundFlags |= MA_SOUND_FLAG_NO_SPATIALIZATION;
-
-            auto decoderConfig =
-                ma_decoder_config_init(ma_format_f32, 0, 48000);
-            // This must match the encoding format of our default ping sound
-            decoderConfig.encodingFormat = ma_encoding_format_wav;
-
-            for (auto i = 0; i < NUM_SOUNDS; ++i)
+            this->defaultPing = DecodedSound::fromMemory(
+                this->engine.get(), this->defaultPingData, {});
+            if (!this->defaultPing)
             {
-                auto dec = std::make_unique<ma_decoder>();
-                auto snd = std::make_unique<ma_sound>();
-
-                result = ma_decoder_init_memory(
-                    (void *)this->defaultPingData.data(),
-                    this->defaultPingData.size() * sizeof(char), &decoderConfig,
-                    dec.get());
-                if (result != MA_SUCCESS)
-                {
-                    qCWarning(chatterinoSound) << "Error initializing default "
-                                                  "ping decoder from memory:"
-                                               << result;
-                    this->state = State::Failed;
-                    return;
-                }
-
-                result = ma_sound_init_from_data_source(this->engine.get(),
-                                                        dec.get(), soundFlags,
-                                                        nullptr, snd.get());
-                if (result != MA_SUCCESS)
-                {
-                    qCWarning(chatterinoSound)
-                        << "Error initializing default sound from data source:"
-                        << result;
-                    this->state = State::Failed;
-                    return;
-                }
-
-                this->defaultPingDecoders.emplace_back(std::move(dec));
-                this->defaultPingSounds.emplace_back(std::move(snd));
+                qCWarning(chatterinoSound) << "Error decoding default ping";
+                this->state = State::Failed;
+                return;
             }
         }
 
@@ -226,14 +189,9 @@ MiniaudioBackend::~MiniaudioBackend()
     this->state = State::Stopping;
 
     boost::asio::post(this->ioContext, [this] {
-        for (const auto &snd : this->defaultPingSounds)
-        {
-            ma_sound_uninit(snd.get());
-        }
-        for (const auto &dec : this->defaultPingDecoders)
-        {
-            ma_decoder_uninit(dec.get());
-        }
+        // The sounds must be released before their engine
+        this->customSounds.clear();
+        this->defaultPing.reset();
 
         ma_engine_uninit(this->engine.get());
         ma_context_uninit(this->context.get());
@@ -265,8 +223,6 @@ void MiniaudioBackend::play(const QUrl &sound)
     }
 
     boost::asio::post(this->ioContext, [this, sound] {
-        static size_t i = 0;
-
         this->tgPlay.guard();
 
         if (this->state != State::Initialized)
@@ -283,27 +239,34 @@ void MiniaudioBackend::play(const QUrl &sound)
             return;
         }
 
+        // Play default sound, loaded from our resources in the constructor
+        DecodedSound *decoded = this->defaultPing.get();
         if (sound.isLocalFile())
         {
             auto soundPath = sound.toLocalFile();
-            result = ma_engine_play_sound(this->engine.get(),
-                                          qPrintable(soundPath), nullptr);
-            if (result != MA_SUCCESS)
+            decoded = this->cachedSound(soundPath).sound.get();
+            if (!decoded)
             {
-                qCWarning(chatterinoSound) << "Failed to play sound" << sound
-                                           << soundPath << ":" << result;
+                // Too large or not decodable into memory, let miniaudio
+                // stream it from the file
+                result = ma_engine_play_sound(this->engine.get(),
+                                              qPrintable(soundPath), nullptr);
+                if (result != MA_SUCCESS)
+                {
+                    qCWarning(chatterinoSound) << "Failed to play sound"
+                                               << sound << soundPath << ":"
+                                               << result;
+                }
             }
         }
-        else
+
+        if (decoded)
         {
-            // Play default sound, loaded from our resources in the constructor
-            auto &snd = this->defaultPingSounds[++i % NUM_SOUNDS];
-            ma_sound_seek_to_pcm_frame(snd.get(), 0);
-            result = ma_sound_start(snd.get());
-            if (result != MA_SUCCESS)
+            auto played = decoded->play();
+            if (played == DecodedSound::PlayResult::Coalesced)
             {
-                qCWarning(chatterinoSound)
-                    << "Failed to play default ping" << result;
+                qCDebug(chatterinoSound)
+                    << "Coalesced play of" << sound << "into the previous one";
             }
         }
 
@@ -329,4 +292,61 @@ void MiniaudioBackend::play(const QUrl &sound)
     });
 }
 
+void MiniaudioBackend::preload(const QUrl &sound)
+{
+    if (!sound.isLocalFile())
+    {
+        // The default ping is always decoded
+        return;
+    }
+
+    boost::asio::post(this->ioContext, [this, sound] {
+        this->tgPlay.guard();
+
+        if (this->state != State::Initialized)
+        {
+            return;
+        }
+
+        this->cachedSound(sound.toLocalFile());
+    });
+}
+
+MiniaudioBackend::CachedSound &MiniaudioBackend::cachedSound(
+    const QString &path)
+{
+    QFileInfo info(path);
+    auto now = std::chrono::steady_clock::now();
+
+    auto it = this->customSounds.find(path);
+    if (it != this->customSounds.end() &&
+        it->second.lastModified == info.lastModified() &&
+        it->second.size == info.size())
+    {
+        it->second.lastUsed = now;
+        return it->second;
+    }
+
+    if (it == this->customSounds.end() &&
+        this->customSounds.size() >= MAX_CACHED_SOUNDS)
+    {
+        auto oldest = std::ranges::min_element(
+            this->customSounds, {}, [](const auto &entry) {
+                return entry.second.lastUsed;
+            });
+        this->customSounds.erase(oldest);
+    }
+
+    BenchmarkGuard b("decode sound");
+
+    auto &entry = this->customSounds[path];
+    entry = {
+        .sound = DecodedSound::fromFile(this->engine.get(), path, {}),
+        .lastModified = info.lastModified(),
+        .size = info.size(),
+        .lastUsed = now,
+    };
+    return entry;
+}
+
 }  // namespace chatterino
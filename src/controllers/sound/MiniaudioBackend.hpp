@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "controllers/sound/DecodedSound.hpp"
 #include "controllers/sound/ISoundController.hpp"
 #include "util/OnceFlag.hpp"
 #include "util/ThreadGuard.hpp"
@@ -12,6 +13,7 @@
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <QByteArray>
+#include <QDateTime>
 #include <QString>
 #include <QUrl>
 
@@ -20,14 +22,12 @@
 #include <cstdint>
 #include <memory>
 #include <thread>
-#include <vector>
+#include <unordered_map>
 
 struct ma_engine;
 struct ma_device;
 struct ma_resource_manager;
 struct ma_context;
-struct ma_sound;
-struct ma_decoder;
 
 namespace chatterino {
 
@@ -54,7 +54,23 @@ public:
     // the default sound initialized in the initialize method
     void play(const QUrl &sound) final;
 
+    // Decode the sound from the given url ahead of its first play
+    void preload(const QUrl &sound) final;
+
 private:
+    struct CachedSound {
+        /// nullptr if the sound couldn't be decoded into memory. It's
+        /// streamed from the file instead.
+        std::unique_ptr<DecodedSound> sound;
+        QDateTime lastModified;
+        qint64 size = 0;
+        std::chrono::steady_clock::time_point lastUsed;
+    };
+
+    /// Returns the cached sound for the file at `path`, decoding it if it
+    /// isn't cached yet or the file has changed
+    CachedSound &cachedSound(const QString &path);
+
     // Used for selecting & initializing an appropriate sound backend
     std::unique_ptr<ma_context> context;
     // The engine is a high-level API for playing sounds from paths in a simple & efficient-enough manner
@@ -62,12 +78,10 @@ private:
 
     // Stores the data of our default ping sounds
     QByteArray defaultPingData;
-    // Stores N decoders for simultaneous default ping playback.
-    // We can't use the engine API for this as this requires direct access to a custom data_source
-    std::vector<std::unique_ptr<ma_decoder>> defaultPingDecoders;
-    // Stores N sounds for simultaneous default ping playback
-    // We can't use the engine API for this as this requires direct access to a custom data_source
-    std::vector<std::unique_ptr<ma_sound>> defaultPingSounds;
+    // The default ping, decoded with a voice pool for simultaneous playback
+    std::unique_ptr<DecodedSound> defaultPing;
+    // Custom sounds by their path, decoded on their first play
+    std::unordered_map<QString, CachedSound> customSounds;
 
     // Thread guard for the play method
     // Ensures play is only ever called from the same thread
@@ -5,11 +5,13 @@
 #include "debug/Benchmark.hpp"
 
 #include "common/QLogging.hpp"
+#include "debug/StartupTrace.hpp"
 
 namespace chatterino {
 
 BenchmarkGuard::BenchmarkGuard(const QString &_name)
     : name_(_name)
+    , traceBegin_(StartupTrace::now())
 {
     this->timer_.start();
 }
@@ -19,6 +21,7 @@ BenchmarkGuard::~BenchmarkGuard()
     qCDebug(chatterinoBenchmark)
         << this->name_ << float(this->timer_.nsecsElapsed()) / 1000000.0f
         << "ms";
+    StartupTrace::complete("benchmark", this->name_, this->traceBegin_);
 }
 
 qreal BenchmarkGuard::getElapsedMs()
@@ -26,6 +26,7 @@ public:
 private:
     QElapsedTimer timer_;
     QString name_;
+    qint64 traceBegin_;
 };
 
 }  // namespace chatterino
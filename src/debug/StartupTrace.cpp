@@ -0,0 +1,283 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "debug/StartupTrace.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+#include <QTimer>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+using namespace chatterino;
+
+struct State {
+    std::atomic<bool> enabled{false};
+    QElapsedTimer timer;
+
+    std::mutex mutex;
+    /// Increased for every trace, so the timeout of an earlier trace doesn't
+    /// finish a later one
+    quint64 generation = 0;
+    QString path;
+    QJsonArray events;
+    /// Chrome traces want small numeric thread IDs
+    std::unordered_map<Qt::HANDLE, int> threads;
+};
+
+State &state()
+{
+    // Leaked on purpose: events might be recorded during shutdown
+    static auto *state = new State;
+    return *state;
+}
+
+/// Returns the trace ID of the current thread. Needs the lock.
+int threadID(State &s)
+{
+    auto handle = QThread::currentThreadId();
+    auto it = s.threads.find(handle);
+    if (it != s.threads.end())
+    {
+        return it->second;
+    }
+
+    int id = static_cast<int>(s.threads.size()) + 1;
+    s.threads.emplace(handle, id);
+
+    auto *thread = QThread::currentThread();
+    auto name = thread->objectName();
+    if (thread == QCoreApplication::instance()->thread())
+    {
+        name = "GUI";
+    }
+    else if (name.isEmpty())
+    {
+        name = QString("Thread %1").arg(id);
+    }
+    s.events.append(QJsonObject{
+        {"ph", "M"},
+        {"name", "thread_name"},
+        {"pid", 1},
+        {"tid", id},
+        {"args", QJsonObject{{"name", name}}},
+    });
+
+    return id;
+}
+
+void record(QJsonObject event, const StartupTrace::Fields &fields)
+{
+    auto &s = state();
+    if (!s.enabled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    if (!fields.empty())
+    {
+        QJsonObject args;
+        for (const auto &[key, value] : fields)
+        {
+            args.insert(key, value);
+        }
+        event.insert("args", args);
+    }
+    event.insert("pid", 1);
+
+    std::lock_guard lock(s.mutex);
+    if (!s.enabled.load(std::memory_order_relaxed))
+    {
+        return;  // finished in the meantime
+    }
+    event.insert("tid", threadID(s));
+    s.events.append(event);
+}
+
+}  // namespace
+
+namespace chatterino {
+
+void StartupTrace::start(const QString &path)
+{
+    auto &s = state();
+    quint64 generation = 0;
+    {
+        std::lock_guard lock(s.mutex);
+        if (s.enabled)
+        {
+            return;
+        }
+        s.path = path;
+        s.events = {};
+        s.threads.clear();
+        s.timer.start();
+        s.enabled = true;
+        generation = ++s.generation;
+    }
+
+    qCDebug(chatterinoBenchmark) << "Tracing startup to" << path;
+
+    QTimer::singleShot(DURATION, QCoreApplication::instance(), [generation] {
+        auto &s = state();
+        {
+            std::lock_guard lock(s.mutex);
+            if (s.generation != generation)
+            {
+                return;
+            }
+        }
+        StartupTrace::finish();
+    });
+
+    static std::once_flag connectQuit;
+    std::call_once(connectQuit, [] {
+        QObject::connect(QCoreApplication::instance(),
+                         &QCoreApplication::aboutToQuit, [] {
+                             StartupTrace::finish();
+                         });
+    });
+}
+
+void StartupTrace::finish()
+{
+    auto &s = state();
+    QJsonArray events;
+    QString path;
+    {
+        std::lock_guard lock(s.mutex);
+        if (!s.enabled)
+        {
+            return;
+        }
+        s.enabled = false;
+        events = std::exchange(s.events, {});
+        path = s.path;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qCWarning(chatterinoBenchmark)
+            << "Failed to write startup trace to" << path << file.errorString();
+        return;
+    }
+
+    QJsonObject root{
+        {"traceEvents", events},
+        {"displayTimeUnit", "ms"},
+    };
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    qCDebug(chatterinoBenchmark)
+        << "Wrote" << events.size() << "startup trace events to" << path;
+}
+
+bool StartupTrace::enabled()
+{
+    return state().enabled.load(std::memory_order_relaxed);
+}
+
+qint64 StartupTrace::now()
+{
+    auto &s = state();
+    if (!s.enabled.load(std::memory_order_relaxed))
+    {
+        return 0;
+    }
+    return s.timer.nsecsElapsed() / 1000;
+}
+
+void StartupTrace::complete(const char *category, const QString &name,
+                            qint64 begin, const Fields &fields)
+{
+    if (!enabled())
+    {
+        return;
+    }
+
+    auto end = now();
+    record(
+        {
+            {"ph", "X"},
+            {"cat", category},
+            {"name", name},
+            {"ts", begin},
+            {"dur", end - begin},
+        },
+        fields);
+}
+
+void StartupTrace::async(const char *category, const QString &name,
+                         quint64 id, qint64 begin, const Fields &fields)
+{
+    if (!enabled())
+    {
+        return;
+    }
+
+    auto end = now();
+    auto traceId = QString::number(id, 16);
+    record(
+        {
+            {"ph", "b"},
+            {"cat", category},
+            {"name", name},
+            {"id", traceId},
+            {"ts", begin},
+        },
+        fields);
+    record(
+        {
+            {"ph", "e"},
+            {"cat", category},
+            {"name", name},
+            {"id", traceId},
+            {"ts", end},
+        },
+        {});
+}
+
+void StartupTrace::instant(const char *category, const QString &name,
+                           const Fields &fields)
+{
+    if (!enabled())
+    {
+        return;
+    }
+
+    record(
+        {
+            {"ph", "i"},
+            {"s", "g"},
+            {"cat", category},
+            {"name", name},
+            {"ts", now()},
+        },
+        fields);
+}
+
+StartupTrace::Scope::Scope(const char *category, QString name)
+    : category_(category)
+    , name_(std::move(name))
+    , begin_(StartupTrace::now())
+{
+}
+
+StartupTrace::Scope::~Scope()
+{
+    StartupTrace::complete(this->category_, this->name_, this->begin_);
+}
+
+}  // namespace chatterino
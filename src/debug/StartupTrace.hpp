@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QString>
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// Records a timeline of the startup and writes it as a Chrome trace-event
+/// JSON file (open it in chrome://tracing or https://ui.perfetto.dev).
+///
+/// Tracing is enabled with `--trace-startup <file>`. Events are recorded until
+/// `DURATION` has passed or the app quits, whichever comes first. Then the
+/// file is written.
+///
+/// All functions are thread safe and do nothing while tracing is disabled.
+class StartupTrace
+{
+public:
+    /// Extra key-value pairs shown for an event
+    using Fields = std::vector<std::pair<QString, QString>>;
+
+    static constexpr std::chrono::seconds DURATION{30};
+
+    /// Starts tracing. The trace is written to `path` once it's finished.
+    static void start(const QString &path);
+    /// Stops tracing and writes the trace file
+    static void finish();
+
+    static bool enabled();
+
+    /// Microseconds since tracing was started
+    static qint64 now();
+
+    /// Records a span from `begin` until now on the current thread.
+    /// Spans on one thread must be nested (use async() otherwise).
+    static void complete(const char *category, const QString &name,
+                         qint64 begin, const Fields &fields = {});
+
+    /// Records a span from `begin` until now that can overlap with other
+    /// spans (e.g. network requests). `id` has to be unique among
+    /// overlapping spans of the same category.
+    static void async(const char *category, const QString &name, quint64 id,
+                      qint64 begin, const Fields &fields = {});
+
+    /// Records a point in time
+    static void instant(const char *category, const QString &name,
+                        const Fields &fields = {});
+
+    /// Records a span for the lifetime of this object
+    class Scope
+    {
+    public:
+        Scope(const char *category, QString name);
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope(Scope &&) = delete;
+        Scope &operator=(const Scope &) = delete;
+        Scope &operator=(Scope &&) = delete;
+
+    private:
+        const char *category_;
+        QString name_;
+        qint64 begin_;
+    };
+};
+
+}  // namespace chatterino
@@ -0,0 +1,293 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/EmoteSnapshot.hpp"
+
+#include "Application.hpp"
+#include "common/QLogging.hpp"
+#include "messages/Image.hpp"
+#include "singletons/Paths.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QStringBuilder>
+#include <QThreadPool>
+
+namespace {
+
+using namespace chatterino;
+
+// "CEMS" - Chatterino EMote Snapshot
+constexpr quint32 MAGIC = 0x43454D53;
+
+enum EmoteFlag : quint8 {
+    ZeroWidth = 1 << 0,
+    HasBaseName = 1 << 1,
+};
+
+QString snapshotPath(const QString &id, const QString &provider)
+{
+    return getApp()->getPaths().cacheFilePath(id % u'.' % provider %
+                                              u".emotes");
+}
+
+void prepare(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_6_0);
+}
+
+void writeImage(QDataStream &stream, const ImagePtr &image)
+{
+    if (!image || image->isEmpty() || image->url().string.isEmpty())
+    {
+        stream << QString();
+        return;
+    }
+
+    auto autoScale = image->autoScale();
+    // The scale of autoscaled images is only known once they're loaded
+    stream << image->url().string
+           << static_cast<double>(autoScale ? 1 : image->scale())
+           << image->expectedSize() << autoScale.value_or(0);
+}
+
+ImagePtr readImage(QDataStream &stream)
+{
+    QString url;
+    stream >> url;
+    if (url.isEmpty())
+    {
+        return Image::getEmpty();
+    }
+
+    double scale = 1;
+    QSize expectedSize;
+    quint16 autoScale = 0;
+    stream >> scale >> expectedSize >> autoScale;
+
+    if (autoScale != 0)
+    {
+        return Image::fromAutoscaledUrl({url}, autoScale);
+    }
+    return Image::fromUrl({url}, scale, expectedSize);
+}
+
+}  // namespace
+
+namespace chatterino::emotesnapshot {
+
+QByteArray serialize(const EmoteMap &emotes)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    prepare(stream);
+
+    stream << MAGIC << VERSION << static_cast<quint32>(emotes.size());
+    for (const auto &[name, emote] : emotes)
+    {
+        quint8 flags = 0;
+        if (emote->zeroWidth)
+        {
+            flags |= ZeroWidth;
+        }
+        if (emote->baseName)
+        {
+            flags |= HasBaseName;
+        }
+
+        stream << name.string << emote->name.string << emote->id.string
+               << emote->author.string << emote->tooltip.string
+               << emote->homePage.string << flags;
+        if (emote->baseName)
+        {
+            stream << emote->baseName->string;
+        }
+        writeImage(stream, emote->images.getImage1());
+        writeImage(stream, emote->images.getImage2());
+        writeImage(stream, emote->images.getImage3());
+    }
+
+    return data;
+}
+
+std::optional<EmoteMap> deserialize(QByteArrayView data)
+{
+    // The stream only reads from `data`, it doesn't need a copy
+    auto raw = QByteArray::fromRawData(data.data(), data.size());
+    QDataStream stream(raw);
+    prepare(stream);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    stream >> magic >> version >> count;
+    // Every emote takes more than one byte, so this also rejects counts from
+    // corrupted files before reserving space for them.
+    if (stream.status() != QDataStream::Ok || magic != MAGIC ||
+        version != VERSION || count > static_cast<quint32>(data.size()))
+    {
+        return std::nullopt;
+    }
+
+    EmoteMap emotes;
+    emotes.reserve(count);
+    for (quint32 i = 0; i < count; i++)
+    {
+        QString key;
+        Emote emote;
+        quint8 flags = 0;
+        stream >> key >> emote.name.string >> emote.id.string >>
+            emote.author.string >> emote.tooltip.string >>
+            emote.homePage.string >> flags;
+        if ((flags & HasBaseName) != 0)
+        {
+            QString baseName;
+            stream >> baseName;
+            emote.baseName = EmoteName{baseName};
+        }
+        emote.zeroWidth = (flags & ZeroWidth) != 0;
+
+        auto image1 = readImage(stream);
+        auto image2 = readImage(stream);
+        auto image3 = readImage(stream);
+        if (stream.status() != QDataStream::Ok)
+        {
+            return std::nullopt;
+        }
+        emote.images = ImageSet(image1, image2, image3);
+
+        emotes.emplace(EmoteName{key},
+                       std::make_shared<const Emote>(std::move(emote)));
+    }
+
+    return emotes;
+}
+
+void write(const QString &id, const QString &provider, const EmoteMap &emotes)
+{
+    auto *threadPool = QThreadPool::globalInstance();
+    if (threadPool == nullptr)
+    {
+        // Must be exiting - do nothing
+        return;
+    }
+
+    threadPool->start([path = snapshotPath(id, provider), emotes] {
+        if (writeIfChanged(path, serialize(emotes)))
+        {
+            qCDebug(chatterinoCache) << "Saved emote snapshot" << path;
+        }
+    });
+}
+
+bool writeIfChanged(const QString &path, const QByteArray &data)
+{
+    {
+        // Revalidations mostly return the same emotes, don't write those
+        QFile current(path);
+        if (current.open(QIODevice::ReadOnly) &&
+            current.size() == data.size() && current.readAll() == data)
+        {
+            return false;
+        }
+    }
+
+    // QSaveFile writes to a unique temporary file first, so a snapshot is
+    // never read half-written - even if two writers race.
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() ||
+        !file.commit())
+    {
+        qCWarning(chatterinoCache)
+            << "Failed to write emote snapshot" << path << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void read(const QString &id, const QString &provider,
+          std::function<void(std::optional<EmoteMap>)> callback)
+{
+    auto *threadPool = QThreadPool::globalInstance();
+    if (threadPool == nullptr)
+    {
+        // Must be exiting - do nothing
+        return;
+    }
+
+    threadPool->start([path = snapshotPath(id, provider),
+                       callback = std::move(callback)]() mutable {
+        std::optional<EmoteMap> emotes;
+
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly))
+        {
+            auto size = file.size();
+            if (auto *mapped = file.map(0, size))
+            {
+                emotes = deserialize(QByteArrayView(mapped, size));
+                file.unmap(mapped);
+            }
+            else
+            {
+                emotes = deserialize(file.readAll());
+            }
+
+            if (emotes)
+            {
+                qCDebug(chatterinoCache)
+                    << "Loaded emote snapshot" << path << emotes->size();
+            }
+            else
+            {
+                qCWarning(chatterinoCache)
+                    << "Ignoring invalid emote snapshot" << path;
+            }
+        }
+
+        postToThread([callback = std::move(callback),
+                      emotes = std::move(emotes)]() mutable {
+            callback(std::move(emotes));
+        });
+    });
+}
+
+}  // namespace chatterino::emotesnapshot
+
+namespace chatterino {
+
+bool sameEmotes(const EmoteMap &a, const EmoteMap &b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+
+    for (const auto &[name, emote] : a)
+    {
+        auto it = b.find(name);
+        if (it == b.end())
+        {
+            return false;
+        }
+
+        const auto &other = it->second;
+        if (emote == other)
+        {
+            continue;
+        }
+        if (!(*emote == *other) || emote->zeroWidth != other->zeroWidth ||
+            emote->id != other->id || emote->author != other->author ||
+            emote->baseName != other->baseName)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "messages/Emote.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+
+#include <functional>
+#include <optional>
+
+namespace chatterino {
+
+/// Emote snapshots are binary copies of resolved emote sets of a provider.
+///
+/// They're stored in the cache directory as `<id>.<provider>.emotes` and
+/// contain everything needed to recreate the emotes (names, IDs, image URLs
+/// and sizes, flags) without parsing the provider's API response again.
+/// Snapshots with a different version are ignored.
+namespace emotesnapshot {
+
+/// Increase this when changing the format
+inline constexpr quint32 VERSION = 1;
+
+QByteArray serialize(const EmoteMap &emotes);
+
+/// Returns std::nullopt if `data` isn't a valid snapshot of this version
+std::optional<EmoteMap> deserialize(QByteArrayView data);
+
+/// Writes the snapshot on a worker thread, unless it didn't change
+void write(const QString &id, const QString &provider, const EmoteMap &emotes);
+
+/// Atomically replaces the file at `path` with `data`, unless it already
+/// contains `data`. Returns true if the file was written.
+bool writeIfChanged(const QString &path, const QByteArray &data);
+
+/// Reads the snapshot on a worker thread and calls `callback` with it on the
+/// GUI thread. The callback gets std::nullopt if there's no valid snapshot.
+void read(const QString &id, const QString &provider,
+          std::function<void(std::optional<EmoteMap>)> callback);
+
+}  // namespace emotesnapshot
+
+/// Checks if both maps contain equal emotes under the same names
+bool sameEmotes(const EmoteMap &a, const EmoteMap &b);
+
+}  // namespace chatterino
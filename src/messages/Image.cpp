@@ -19,6 +19,7 @@
 
 #include <boost/functional/hash.hpp>
 #include <QBuffer>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QImageReader>
 #include <QNetworkAccessManager>
@@ -30,13 +31,27 @@
 
 #include <algorithm>
 #include <atomic>
+#include <limits>
+#include <mutex>
 
 using namespace Qt::StringLiterals;
 
-// Duration between each check of every Image instance
-const auto IMAGE_POOL_CLEANUP_INTERVAL = std::chrono::minutes(1);
+// Duration between each (partial) sweep of the Image pool
+const auto IMAGE_POOL_SWEEP_INTERVAL = std::chrono::seconds(1);
+// Maximum number of images visited in one sweep
+constexpr size_t IMAGE_POOL_SWEEP_MAX_IMAGES = 2000;
+// Maximum time spent in one sweep
+const auto IMAGE_POOL_SWEEP_TIME_BUDGET = std::chrono::milliseconds(2);
+// Number of images visited between two checks of the time budget
+constexpr size_t IMAGE_POOL_SWEEP_STEP = 128;
 // Duration since last usage of Image pixmap before expiration of frames
 const auto IMAGE_POOL_IMAGE_LIFETIME = std::chrono::minutes(10);
+// Images drawn at more than this fraction of their size are decoded at their
+// native size - scaling them down wouldn't save much
+constexpr qreal IMAGE_DOWNSCALE_THRESHOLD = 0.9;
+// How much the display scale the frames should be decoded at has to differ
+// from the one they were decoded at to decode them again
+constexpr qreal IMAGE_REDECODE_GROWTH = 1.1;
 
 namespace chatterino::detail {
 
@@ -45,9 +60,15 @@ Frames::Frames()
     DebugCount::increase(DebugObject::Image);
 }
 
-Frames::Frames(QList<Frame> &&frames)
+Frames::Frames(QList<Frame> &&frames, QSize sourceSize)
     : items_(std::move(frames))
+    , sourceSize_(sourceSize)
 {
+    if (!this->sourceSize_.isValid() && !this->items_.empty())
+    {
+        this->sourceSize_ = this->items_.front().image.size();
+    }
+
     assertInGuiThread();
     auto *app = tryGetApp();
     if (app == nullptr)
@@ -203,16 +224,36 @@ std::optional<QPixmap> Frames::first() const
     return this->items_.front().image;
 }
 
-QList<Frame> readFrames(QImageReader &reader, const Url &url)
+std::optional<QSize> Frames::sourceSize() const
+{
+    if (this->items_.empty())
+    {
+        return std::nullopt;
+    }
+
+    return this->sourceSize_;
+}
+
+QList<Frame> readFrames(
+    QImageReader &reader, const Url &url, qreal devicePixelRatio,
+    const std::function<bool(const QList<Frame> &)> &onFrame)
 {
     QList<Frame> frames;
     frames.reserve(reader.imageCount());
 
     for (int index = 0; index < reader.imageCount(); ++index)
     {
-        auto pixmap = QPixmap::fromImageReader(&reader);
-        if (!pixmap.isNull())
+        auto image = reader.read();
+        if (!image.isNull())
         {
+            // Convert on this thread, so painting doesn't have to
+            if (image.hasAlphaChannel())
+            {
+                image.convertTo(QImage::Format_ARGB32_Premultiplied);
+            }
+            auto pixmap = QPixmap::fromImage(std::move(image));
+            pixmap.setDevicePixelRatio(devicePixelRatio);
+
             // It seems that browsers have special logic for fast animations.
             // This implements Chrome and Firefox's behavior which uses
             // a duration of 100 ms for any frames that specify a duration of <= 10 ms.
@@ -228,6 +269,11 @@ QList<Frame> readFrames(QImageReader &reader, const Url &url)
                 .image = std::move(pixmap),
                 .duration = duration,
             });
+
+            if (onFrame && !onFrame(frames))
+            {
+                break;
+            }
         }
     }
 
@@ -240,25 +286,44 @@ QList<Frame> readFrames(QImageReader &reader, const Url &url)
     return frames;
 }
 
-void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed)
+qreal decodedDevicePixelRatio(QSize sourceSize, qreal displayScale)
+{
+    if (displayScale <= 0 || displayScale >= IMAGE_DOWNSCALE_THRESHOLD ||
+        sourceSize.width() <= 0)
+    {
+        return 1;
+    }
+    auto scaledSize =
+        (sourceSize.toSizeF() * displayScale).toSize().expandedTo({1, 1});
+    return static_cast<qreal>(scaledSize.width()) /
+           static_cast<qreal>(sourceSize.width());
+}
+
+void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed,
+                  QSize sourceSize)
 {
     static bool isPushQueued;
 
-    auto cb = [parsed = std::move(parsed), weak = std::move(weak)]() mutable {
+    auto cb = [parsed = std::move(parsed), weak = std::move(weak),
+               sourceSize]() mutable {
         auto shared = weak.lock();
         if (!shared)
         {
             return;
         }
-        shared->frames_ = std::make_unique<detail::Frames>(std::move(parsed));
+        shared->setFrames(
+            std::make_unique<detail::Frames>(std::move(parsed), sourceSize));
+        shared->redecodePending_ = false;
+        // The requested scale might've changed while decoding
+        shared->updateDecodedScale();
         if (shared->autoScale_)
         {
             // FIXME: We should actually scale the pixmaps. However, we'd also
             //        need to cache that.
-            auto firstFrame = shared->frames_->first();
-            if (firstFrame)
+            auto frameSize = shared->frames_->sourceSize();
+            if (frameSize)
             {
-                auto actualSize = firstFrame->size();
+                auto actualSize = *frameSize;
                 shared->scale_ =
                     static_cast<qreal>(*shared->autoScale_) /
                     std::max({actualSize.width(), actualSize.height(), 1});
@@ -351,7 +416,14 @@ ImagePtr Image::fromUrl(const Url &url, qreal scale, QSize expectedSize)
 ImagePtr Image::fromAutoscaledUrl(const Url &url, uint16_t autoScale)
 {
     auto shared = Image::fromUrl(url, 1.0, {autoScale, autoScale});
-    shared->autoScale_ = autoScale;
+    // Emote snapshots are loaded on a worker, but the frames read the scale
+    // on the GUI thread
+    runInGuiThread([weak = std::weak_ptr<Image>(shared), autoScale] {
+        if (auto image = weak.lock())
+        {
+            image->autoScale_ = autoScale;
+        }
+    });
 
     return shared;
 }
@@ -422,8 +494,8 @@ Image::Image(qreal scale)
 void Image::setPixmap(const QPixmap &pixmap)
 {
     auto setFrames = [shared = this->shared_from_this(), pixmap]() {
-        shared->frames_ = std::make_unique<detail::Frames>(
-            QList<detail::Frame>{detail::Frame{pixmap, 1}});
+        shared->setFrames(std::make_unique<detail::Frames>(
+            QList<detail::Frame>{detail::Frame{pixmap, 1}}));
     };
 
     if (isGuiThread())
@@ -436,6 +508,16 @@ void Image::setPixmap(const QPixmap &pixmap)
     }
 }
 
+void Image::setFrames(std::unique_ptr<detail::Frames> frames)
+{
+    assertInGuiThread();
+
+    this->frames_ = std::move(frames);
+#ifndef DISABLE_IMAGE_EXPIRATION_POOL
+    ImageExpirationPool::updateUsage(this);
+#endif
+}
+
 const Url &Image::url() const
 {
     return this->url_;
@@ -453,7 +535,7 @@ bool Image::loaded() const
     return this->frames_->current().has_value();
 }
 
-std::optional<QPixmap> Image::pixmapOrLoad() const
+std::optional<QPixmap> Image::pixmapOrLoad(ImagePriority priority) const
 {
     assertInGuiThread();
 
@@ -467,12 +549,12 @@ std::optional<QPixmap> Image::pixmapOrLoad() const
     // See src/messages/layouts/MessageLayoutElement.cpp ImageLayoutElement::paint, for example.
     this->lastUsed_ = std::chrono::steady_clock::now();
 
-    this->load();
+    this->load(priority);
 
     return this->frames_->current();
 }
 
-void Image::load() const
+void Image::load(ImagePriority priority) const
 {
     assertInGuiThread();
 
@@ -480,18 +562,117 @@ void Image::load() const
     {
         Image *this2 = const_cast<Image *>(this);
         this2->shouldLoad_ = false;
+        this2->priority_.store(priority, std::memory_order_relaxed);
         this2->actuallyLoad();
 #ifndef DISABLE_IMAGE_EXPIRATION_POOL
         ImageExpirationPool::instance().addImagePtr(this2->shared_from_this());
 #endif
+        return;
+    }
+
+    // Only raise the priority of a pending decode if the image is requested
+    // with a higher priority than before. This runs on every paint, so it
+    // should be cheap.
+    if (priority < this->priority_.load(std::memory_order_relaxed))
+    {
+        this->priority_.store(priority, std::memory_order_relaxed);
+        ImageDecodeScheduler::instance().raise(this, priority);
+    }
+}
+
+void Image::requestDisplayScale(qreal factor)
+{
+    assertInGuiThread();
+
+    factor = std::min<qreal>(factor, 1);
+    if (factor <= this->displayScale_.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    this->displayScale_.store(factor, std::memory_order_relaxed);
+    this->updateDecodedScale();
+}
+
+void Image::acquireNativeScale()
+{
+    assertInGuiThread();
+
+    if (this->nativeScaleRequests_.fetch_add(1, std::memory_order_relaxed) ==
+        0)
+    {
+        this->updateDecodedScale();
+    }
+}
+
+void Image::releaseNativeScale()
+{
+    assertInGuiThread();
+
+    auto previous =
+        this->nativeScaleRequests_.fetch_sub(1, std::memory_order_relaxed);
+    assert(previous > 0);
+    if (previous == 1)
+    {
+        this->updateDecodedScale();
     }
 }
 
+qreal Image::targetDisplayScale() const
+{
+    if (this->nativeScaleRequests_.load(std::memory_order_relaxed) > 0)
+    {
+        return 1;
+    }
+    return this->displayScale_.load(std::memory_order_relaxed);
+}
+
+void Image::updateDecodedScale()
+{
+    assertInGuiThread();
+
+    // Images that are still loading pick up the new scale once they're
+    // decoded. Images without a URL can't be decoded again.
+    if (this->shouldLoad_ || this->redecodePending_ || !this->frames_ ||
+        this->url_.string.isEmpty())
+    {
+        return;
+    }
+    auto current = this->frames_->first();
+    auto sourceSize = this->frames_->sourceSize();
+    if (!current || !sourceSize)
+    {
+        return;
+    }
+
+    auto decoded = current->devicePixelRatio();
+    auto target = detail::decodedDevicePixelRatio(*sourceSize,
+                                                  this->targetDisplayScale());
+    if (std::max(decoded, target) <
+        std::min(decoded, target) * IMAGE_REDECODE_GROWTH)
+    {
+        return;
+    }
+
+    // The current frames stay until the new ones are decoded
+    this->redecodePending_ = true;
+    this->actuallyLoad();
+}
+
 qreal Image::scale() const
 {
     return this->scale_;
 }
 
+QSize Image::expectedSize() const
+{
+    return this->expectedSize_;
+}
+
+std::optional<uint16_t> Image::autoScale() const
+{
+    return this->autoScale_;
+}
+
 bool Image::isEmpty() const
 {
     return this->empty_;
@@ -524,9 +705,9 @@ int Image::width() const
         return 0;
     }
 
-    if (auto pixmap = this->frames_->first())
+    if (auto sourceSize = this->frames_->sourceSize())
     {
-        return static_cast<int>(pixmap->width() * this->scale_);
+        return static_cast<int>(sourceSize->width() * this->scale_);
     }
 
     // No frames loaded, use the expected size
@@ -542,9 +723,9 @@ int Image::height() const
         return 0;
     }
 
-    if (auto pixmap = this->frames_->first())
+    if (auto sourceSize = this->frames_->sourceSize())
     {
-        return static_cast<int>(pixmap->height() * this->scale_);
+        return static_cast<int>(sourceSize->height() * this->scale_);
     }
 
     // No frames loaded, use the expected size
@@ -560,72 +741,127 @@ QSizeF Image::size() const
         return {0, 0};
     }
 
-    if (auto pixmap = this->frames_->first())
+    if (auto sourceSize = this->frames_->sourceSize())
     {
-        return pixmap->size().toSizeF() * this->scale_;
+        return sourceSize->toSizeF() * this->scale_;
     }
 
     // No frames loaded, use the expected size
     return this->expectedSize_.toSizeF() * this->scale_;
 }
 
-void Image::actuallyLoad()
+bool Image::decode(const std::weak_ptr<Image> &weak, const QByteArray &data,
+                   bool redecode)
 {
-    auto weak = weakOf(this);
-    auto onSuccess = [weak](const auto &result) {
-        auto shared = weak.lock();
-        if (!shared)
-        {
-            return;
-        }
+    auto shared = weak.lock();
+    if (!shared)
+    {
+        return false;
+    }
 
-        assert(!isAppAboutToQuit());
+    QBuffer buffer;
+    buffer.setData(data);
+    QImageReader reader(&buffer);
 
-        QBuffer buffer;
-        buffer.setData(result.getData());
-        QImageReader reader(&buffer);
+    if (!reader.canRead())
+    {
+        qCDebug(chatterinoImage)
+            << "Error: image cant be read " << shared->url().string;
+        shared->loadFailed(redecode);
+        return true;
+    }
 
-        if (!reader.canRead())
-        {
-            qCDebug(chatterinoImage)
-                << "Error: image cant be read " << shared->url().string;
-            shared->empty_ = true;
-            return;
-        }
+    const auto size = reader.size();
+    if (size.isEmpty())
+    {
+        shared->loadFailed(redecode);
+        return true;
+    }
 
-        const auto size = reader.size();
-        if (size.isEmpty())
-        {
-            shared->empty_ = true;
-            return;
-        }
+    // returns 1 for non-animated formats
+    const auto imageCount = reader.imageCount();
+    if (imageCount <= 0)
+    {
+        qCDebug(chatterinoImage)
+            << "Error: image has less than 1 frame " << shared->url().string
+            << ": " << reader.errorString();
+        shared->loadFailed(redecode);
+        return true;
+    }
 
-        // returns 1 for non-animated formats
-        if (reader.imageCount() <= 0)
-        {
-            qCDebug(chatterinoImage)
-                << "Error: image has less than 1 frame " << shared->url().string
-                << ": " << reader.errorString();
-            shared->empty_ = true;
-            return;
-        }
+    // use "double" to prevent int overflows
+    if (double(size.width()) * double(size.height()) * double(imageCount) *
+            4.0 >
+        double(Image::maxBytesRam))
+    {
+        qCDebug(chatterinoImage) << "image too large in RAM";
 
-        // use "double" to prevent int overflows
-        if (double(size.width()) * double(size.height()) *
-                double(reader.imageCount()) * 4.0 >
-            double(Image::maxBytesRam))
-        {
-            qCDebug(chatterinoImage) << "image too large in RAM";
+        shared->loadFailed(redecode);
+        return true;
+    }
+
+    // Decode straight to the size the image is drawn at, instead of scaling
+    // the frames on every paint. QImageReader uses a smooth filter for
+    // formats that can't decode to a smaller size themselves.
+    const auto displayScale = shared->targetDisplayScale();
+    const auto devicePixelRatio =
+        detail::decodedDevicePixelRatio(size, displayScale);
+    if (devicePixelRatio < 1)
+    {
+        reader.setScaledSize(
+            (size.toSizeF() * displayScale).toSize().expandedTo({1, 1}));
+    }
+
+    const auto url = shared->url();
+    // Don't keep the image alive while decoding, so we notice if it goes away
+    shared.reset();
+
+    bool cancelled = false;
+    auto parsed = detail::readFrames(
+        reader, url, devicePixelRatio,
+        [&](const QList<detail::Frame> &frames) {
+            if (weak.expired())
+            {
+                cancelled = true;
+                return false;
+            }
+            if (frames.size() == 1 && imageCount > 1)
+            {
+                // Show the first frame of animated images while the rest
+                // is decoded.
+                detail::assignFrames(weak, frames, size);
+            }
+            return true;
+        });
+    if (cancelled)
+    {
+        return false;
+    }
 
-            shared->empty_ = true;
+    detail::assignFrames(weak, parsed, size);
+    return true;
+}
+
+void Image::actuallyLoad()
+{
+    auto weak = weakOf(this);
+    const bool redecode = this->redecodePending_;
+    auto onSuccess = [weak, redecode](const auto &result) {
+        auto shared = weak.lock();
+        if (!shared)
+        {
             return;
         }
 
-        auto parsed = detail::readFrames(reader, shared->url());
+        assert(!isAppAboutToQuit());
 
-        assignFrames(shared, parsed);
+        ImageDecodeScheduler::instance().schedule(
+            weak, shared->priority_.load(std::memory_order_relaxed),
+            [weak, redecode, data = result.getData()] {
+                return Image::decode(weak, data, redecode);
+            });
     };
-    auto onError = [weak](const auto & /*result*/) {
+    auto onError = [weak, redecode](const auto & /*result*/) {
         auto shared = weak.lock();
         if (!shared)
         {
@@ -633,7 +869,7 @@ void Image::actuallyLoad()
         }
 
         // fourtf: is this the right thing to do?
-        shared->empty_ = true;
+        shared->loadFailed(redecode);
 
         return true;
     };
@@ -675,6 +911,24 @@ void Image::actuallyLoad()
     }
 }
 
+void Image::loadFailed(bool redecode)
+{
+    if (!redecode)
+    {
+        this->empty_ = true;
+        return;
+    }
+
+    // The frames that are shown already are still fine, only the new scale
+    // couldn't be decoded.
+    runInGuiThread([weak = weakOf(this)] {
+        if (auto shared = weak.lock())
+        {
+            shared->redecodePending_ = false;
+        }
+    });
+}
+
 void Image::expireFrames()
 {
     assertInGuiThread();
@@ -689,25 +943,179 @@ void Image::expireFrames()
 
 #ifndef DISABLE_IMAGE_EXPIRATION_POOL
 
+namespace detail {
+
+struct ImagePoolShard {
+    explicit ImagePoolShard(QString provider)
+        : provider(std::move(provider))
+    {
+    }
+
+    struct Slot {
+        Image *image;
+        std::weak_ptr<Image> weak;
+
+        // usage of this image that's accounted in the counters below
+        int64_t bytes = 0;
+        bool loaded = false;
+        bool animated = false;
+    };
+
+    const QString provider;
+
+    std::mutex mutex;
+    std::vector<Slot> slots;
+    std::unordered_map<Image *, size_t> indices;
+    /// Index of the next slot to visit when sweeping
+    size_t hand = 0;
+
+    // These can be read without holding the mutex
+    std::atomic<int64_t> bytes{0};
+    std::atomic<int64_t> loadedImages{0};
+    std::atomic<int64_t> animatedImages{0};
+    std::atomic<int64_t> trackedImages{0};
+
+    /// Sets the accounted usage of `slot`. Must hold the mutex.
+    void account(Slot &slot, int64_t newBytes, bool loaded, bool animated)
+    {
+        this->bytes.fetch_add(newBytes - slot.bytes, std::memory_order_relaxed);
+        this->loadedImages.fetch_add(int64_t{loaded} - int64_t{slot.loaded},
+                                     std::memory_order_relaxed);
+        this->animatedImages.fetch_add(
+            int64_t{animated} - int64_t{slot.animated},
+            std::memory_order_relaxed);
+        slot.bytes = newBytes;
+        slot.loaded = loaded;
+        slot.animated = animated;
+    }
+
+    /// Removes the slot at `idx` by moving the last slot into its place.
+    /// Must hold the mutex.
+    void removeAt(size_t idx)
+    {
+        auto &slot = this->slots[idx];
+        this->account(slot, 0, false, false);
+        slot.image->poolShard_.store(nullptr, std::memory_order_relaxed);
+        this->indices.erase(slot.image);
+
+        auto last = this->slots.size() - 1;
+        if (idx != last)
+        {
+            slot = std::move(this->slots[last]);
+            this->indices[slot.image] = idx;
+        }
+        this->slots.pop_back();
+        this->trackedImages.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
+}  // namespace detail
+
+namespace {
+
+QString providerForUrl(const QString &url)
+{
+    if (url.isEmpty())
+    {
+        return u"internal"_s;
+    }
+    if (url.startsWith(u":/"))
+    {
+        return u"resources"_s;
+    }
+
+    const QUrl parsed(url);
+    auto host = parsed.host().toLower();
+    const auto path = parsed.path().toLower();
+    if (host.isEmpty())
+    {
+        return u"unknown"_s;
+    }
+
+    if (host.contains(u"chatterinohomies.com") || host == u"itzalex.github.io")
+    {
+        return u"Homies"_s;
+    }
+    if (host.contains(u"7tv"))
+    {
+        if (path.contains(u"/emote/"))
+        {
+            return u"7TV emotes"_s;
+        }
+        if (path.contains(u"/paint/"))
+        {
+            return u"7TV paints"_s;
+        }
+        if (path.contains(u"/badge/"))
+        {
+            return u"7TV badges"_s;
+        }
+        if (path.contains(u"/cosmetic/"))
+        {
+            return u"7TV cosmetics"_s;
+        }
+        return u"7TV"_s;
+    }
+    if (host.contains(u"jtvnw.net") || host.contains(u"ttvnw.net") ||
+        host.contains(u"twitch.tv"))
+    {
+        return u"Twitch"_s;
+    }
+    if (host.contains(u"betterttv") || host.contains(u"bttv"))
+    {
+        return u"BTTV"_s;
+    }
+    if (host.contains(u"frankerfacez") || host.contains(u"ffzap"))
+    {
+        return u"FFZ"_s;
+    }
+    if (host.contains(u"chatterino"))
+    {
+        return u"Chatterino"_s;
+    }
+
+    return host;
+}
+
+bool isExpired(int64_t customLifetimeMs,
+               std::chrono::steady_clock::duration sinceLastUse)
+{
+    const auto lifetime =
+        customLifetimeMs > 0
+            ? std::chrono::milliseconds{customLifetimeMs}
+            : std::chrono::duration_cast<std::chrono::milliseconds>(
+                  IMAGE_POOL_IMAGE_LIFETIME);
+    return sinceLastUse > lifetime;
+}
+
+}  // namespace
+
 ImageExpirationPool::ImageExpirationPool()
     : freeTimer_(new QTimer)
 {
     QObject::connect(this->freeTimer_, &QTimer::timeout, [this] {
+        auto sweep = [this] {
+            this->sweep(IMAGE_POOL_SWEEP_MAX_IMAGES,
+                        IMAGE_POOL_SWEEP_TIME_BUDGET);
+        };
         if (isGuiThread())
         {
-            this->freeOld();
+            sweep();
         }
         else
         {
-            postToThread([this] {
-                this->freeOld();
-            });
+            postToThread(sweep);
         }
     });
 
     this->freeTimer_->start(
         std::chrono::duration_cast<std::chrono::milliseconds>(
-            IMAGE_POOL_CLEANUP_INTERVAL));
+            IMAGE_POOL_SWEEP_INTERVAL));
+}
+
+ImageExpirationPool::~ImageExpirationPool()
+{
+    delete this->freeTimer_;
 }
 
 ImageExpirationPool &ImageExpirationPool::instance()
@@ -716,203 +1124,307 @@ ImageExpirationPool &ImageExpirationPool::instance()
     return *instance;
 }
 
+detail::ImagePoolShard &ImageExpirationPool::shardFor(const QString &provider)
+{
+    std::lock_guard<std::mutex> lock(this->shardsMutex_);
+    auto it = this->shardsByProvider_.find(provider);
+    if (it != this->shardsByProvider_.end())
+    {
+        return *it->second;
+    }
+
+    auto *shard = this->shards_
+                      .emplace_back(
+                          std::make_unique<detail::ImagePoolShard>(provider))
+                      .get();
+    this->shardsByProvider_.emplace(provider, shard);
+    return *shard;
+}
+
+std::vector<detail::ImagePoolShard *> ImageExpirationPool::shards()
+{
+    // Shards are never removed, so the pointers stay valid
+    std::lock_guard<std::mutex> lock(this->shardsMutex_);
+    std::vector<detail::ImagePoolShard *> shards;
+    shards.reserve(this->shards_.size());
+    for (const auto &shard : this->shards_)
+    {
+        shards.push_back(shard.get());
+    }
+    return shards;
+}
+
 void ImageExpirationPool::addImagePtr(ImagePtr imgPtr)
 {
-    std::lock_guard<std::mutex> lock(this->mutex_);
-    this->allImages_.emplace(imgPtr.get(), std::weak_ptr<Image>(imgPtr));
+    assertInGuiThread();
+
+    auto &shard = this->shardFor(providerForUrl(imgPtr->url_.string));
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.indices.contains(imgPtr.get()))
+    {
+        return;
+    }
+
+    shard.indices.emplace(imgPtr.get(), shard.slots.size());
+    auto &slot = shard.slots.emplace_back(detail::ImagePoolShard::Slot{
+        .image = imgPtr.get(),
+        .weak = imgPtr,
+    });
+    shard.trackedImages.fetch_add(1, std::memory_order_relaxed);
+    imgPtr->poolShard_.store(&shard, std::memory_order_relaxed);
+
+    // Images can already have frames when they're added
+    if (imgPtr->frames_)
+    {
+        shard.account(slot, imgPtr->frames_->memoryUsage(),
+                      !imgPtr->frames_->empty(), imgPtr->frames_->animated());
+    }
 }
 
 void ImageExpirationPool::removeImagePtr(Image *rawPtr)
 {
-    std::lock_guard<std::mutex> lock(this->mutex_);
-    this->allImages_.erase(rawPtr);
+    auto *shard = rawPtr->poolShard_.load(std::memory_order_relaxed);
+    if (shard == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    auto it = shard->indices.find(rawPtr);
+    if (it != shard->indices.end())
+    {
+        shard->removeAt(it->second);
+    }
+}
+
+void ImageExpirationPool::updateUsage(Image *image)
+{
+    assertInGuiThread();
+
+    auto *shard = image->poolShard_.load(std::memory_order_relaxed);
+    if (shard == nullptr || !image->frames_)
+    {
+        return;
+    }
+
+    const auto bytes = image->frames_->memoryUsage();
+    const auto loaded = !image->frames_->empty();
+    const auto animated = image->frames_->animated();
+
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    auto it = shard->indices.find(image);
+    if (it != shard->indices.end())
+    {
+        shard->account(shard->slots[it->second], bytes, loaded, animated);
+    }
 }
 
 void ImageExpirationPool::freeAll()
 {
+    assertInGuiThread();
+
+    for (auto *shard : this->shards())
     {
-        std::lock_guard<std::mutex> lock(this->mutex_);
-        for (auto it = this->allImages_.begin(); it != this->allImages_.end();)
+        // Images must be released after the lock is released, as their
+        // destructor removes them from the pool.
+        std::vector<ImagePtr> images;
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        images.reserve(shard->slots.size());
+        while (!shard->slots.empty())
         {
-            auto img = it->second.lock();
-            img->expireFrames();
-            it = this->allImages_.erase(it);
+            auto img = shard->slots.back().weak.lock();
+            if (img)
+            {
+                img->expireFrames();
+                images.emplace_back(std::move(img));
+            }
+            shard->removeAt(shard->slots.size() - 1);
         }
+        shard->hand = 0;
     }
-    this->freeOld();
+    this->currentShard_ = 0;
+    this->cycleStats_ = {};
+    this->publishStats();
 }
 
-void ImageExpirationPool::freeOld()
+bool ImageExpirationPool::sweepShard(detail::ImagePoolShard &shard,
+                                     size_t maxImages,
+                                     std::chrono::steady_clock::time_point now,
+                                     size_t &visited)
 {
-    std::lock_guard<std::mutex> lock(this->mutex_);
+    // Images must be released after the lock is released, as their
+    // destructor removes them from the pool.
+    std::vector<ImagePtr> keepAlive;
+    std::lock_guard<std::mutex> lock(shard.mutex);
 
-    size_t numExpired = 0;
-    size_t eligible = 0;
-
-    auto now = std::chrono::steady_clock::now();
-    for (auto it = this->allImages_.begin(); it != this->allImages_.end();)
+    while (visited < maxImages && shard.hand < shard.slots.size())
     {
-        auto img = it->second.lock();
+        ++visited;
+        auto &slot = shard.slots[shard.hand];
+        auto img = slot.weak.lock();
         if (!img)
         {
             // This can only really happen from a race condition because ~Image
             // should remove itself from the ImageExpirationPool automatically.
-            it = this->allImages_.erase(it);
+            shard.removeAt(shard.hand);
             continue;
         }
 
-        if (img->frames_->empty())
+        if (!img->frames_ || img->frames_->empty())
         {
             // No frame data, nothing to do
-            ++it;
+            ++shard.hand;
+            keepAlive.emplace_back(std::move(img));
             continue;
         }
 
-        ++eligible;
+        ++this->cycleStats_.eligible;
 
-        const auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - img->lastUsed_);
-        const auto customLifetimeMs =
+        const auto lifetimeMs =
             img->frameCacheLifetimeMs_.load(std::memory_order_relaxed);
-        const auto lifetime =
-            customLifetimeMs > 0
-                ? std::chrono::milliseconds{customLifetimeMs}
-                : std::chrono::duration_cast<std::chrono::milliseconds>(
-                      IMAGE_POOL_IMAGE_LIFETIME);
-        if (diff > lifetime)
+        if (isExpired(lifetimeMs, now - img->lastUsed_))
         {
-            ++numExpired;
+            ++this->cycleStats_.expired;
             img->expireFrames();
-            // erase without mutex locking issue
-            it = this->allImages_.erase(it);
-            continue;
+            // The image is added back once it's loaded again. This moves the
+            // last slot to the hand, so it's visited next.
+            shard.removeAt(shard.hand);
         }
-
-        ++it;
+        else
+        {
+            ++shard.hand;
+        }
+        keepAlive.emplace_back(std::move(img));
     }
 
-#    ifndef NDEBUG
-    qCDebug(chatterinoImage) << "freed frame data for" << numExpired << "/"
-                             << eligible << "eligible images";
-#    endif
-    DebugCount::set(DebugObject::LastImageGcExpired,
-                    static_cast<int64_t>(numExpired));
-    DebugCount::set(DebugObject::LastImageGcEligible,
-                    static_cast<int64_t>(eligible));
-    DebugCount::set(DebugObject::LastImageGcLeft,
-                    static_cast<int64_t>(this->allImages_.size()));
+    if (shard.hand >= shard.slots.size())
+    {
+        shard.hand = 0;
+        return true;
+    }
+    return false;
 }
 
-std::vector<ImageExpirationPool::ProviderUsage>
-    ImageExpirationPool::getProviderUsageSnapshot()
+void ImageExpirationPool::sweep(size_t maxImages,
+                                std::chrono::microseconds budget)
 {
-    const auto providerForUrl = [](const QString &url) {
-        if (url.isEmpty())
-        {
-            return u"internal"_s;
-        }
-        if (url.startsWith(u":/"))
-        {
-            return u"resources"_s;
-        }
+    assertInGuiThread();
 
-        const QUrl parsed(url);
-        auto host = parsed.host().toLower();
-        const auto path = parsed.path().toLower();
-        if (host.isEmpty())
-        {
-            return u"unknown"_s;
-        }
+    auto shards = this->shards();
+    if (shards.empty())
+    {
+        return;
+    }
 
-        if (host.contains(u"chatterinohomies.com") ||
-            host == u"itzalex.github.io")
-        {
-            return u"Homies"_s;
-        }
-        if (host.contains(u"7tv"))
+    QElapsedTimer timer;
+    timer.start();
+    const auto now = std::chrono::steady_clock::now();
+    const auto budgetNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(budget).count();
+
+    size_t visited = 0;
+    // Visit every shard at most once per call, so an almost empty pool
+    // doesn't keep us spinning.
+    for (size_t i = 0; i < shards.size() && visited < maxImages; i++)
+    {
+        this->currentShard_ %= shards.size();
+        auto *shard = shards[this->currentShard_];
+
+        // Sweep in small steps to be able to check the time budget
+        bool wrapped = false;
+        while (!wrapped && visited < maxImages)
         {
-            if (path.contains(u"/emote/"))
+            wrapped = this->sweepShard(
+                *shard, std::min(maxImages, visited + IMAGE_POOL_SWEEP_STEP),
+                now, visited);
+            if (timer.nsecsElapsed() > budgetNs)
             {
-                return u"7TV emotes"_s;
+                break;
             }
-            if (path.contains(u"/paint/"))
-            {
-                return u"7TV paints"_s;
-            }
-            if (path.contains(u"/badge/"))
-            {
-                return u"7TV badges"_s;
-            }
-            if (path.contains(u"/cosmetic/"))
-            {
-                return u"7TV cosmetics"_s;
-            }
-            return u"7TV"_s;
-        }
-        if (host.contains(u"jtvnw.net") || host.contains(u"ttvnw.net") ||
-            host.contains(u"twitch.tv"))
-        {
-            return u"Twitch"_s;
-        }
-        if (host.contains(u"betterttv") || host.contains(u"bttv"))
-        {
-            return u"BTTV"_s;
         }
-        if (host.contains(u"frankerfacez") || host.contains(u"ffzap"))
+
+        if (wrapped)
         {
-            return u"FFZ"_s;
+            this->currentShard_ = (this->currentShard_ + 1) % shards.size();
+            if (this->currentShard_ == 0)
+            {
+                // We've visited every image once
+                this->publishStats();
+                this->cycleStats_ = {};
+            }
         }
-        if (host.contains(u"chatterino"))
+
+        if (timer.nsecsElapsed() > budgetNs)
         {
-            return u"Chatterino"_s;
+            break;
         }
+    }
+}
 
-        return host;
-    };
-
-    std::map<QString, ProviderUsage> providers;
+void ImageExpirationPool::freeOld()
+{
+    assertInGuiThread();
 
-    std::scoped_lock lock(this->mutex_);
-    for (auto it = this->allImages_.begin(); it != this->allImages_.end();)
+    // Start a new pass, so every image is visited exactly once
+    this->cycleStats_ = {};
+    const auto now = std::chrono::steady_clock::now();
+    for (auto *shard : this->shards())
     {
-        auto img = it->second.lock();
-        if (!img)
         {
-            it = this->allImages_.erase(it);
-            continue;
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->hand = 0;
         }
+        size_t visited = 0;
+        this->sweepShard(*shard, std::numeric_limits<size_t>::max(), now,
+                         visited);
+    }
+    this->currentShard_ = 0;
 
-        if (img->frames_->empty())
-        {
-            ++it;
-            continue;
-        }
+    this->publishStats();
+    this->cycleStats_ = {};
+}
+
+void ImageExpirationPool::publishStats()
+{
+    int64_t left = 0;
+    for (auto *shard : this->shards())
+    {
+        left += shard->trackedImages.load(std::memory_order_relaxed);
+    }
 
-        const auto bytes = img->frames_->memoryUsage();
+#    ifndef NDEBUG
+    qCDebug(chatterinoImage)
+        << "freed frame data for" << this->cycleStats_.expired << "/"
+        << this->cycleStats_.eligible << "eligible images";
+#    endif
+    DebugCount::set(DebugObject::LastImageGcExpired,
+                    static_cast<int64_t>(this->cycleStats_.expired));
+    DebugCount::set(DebugObject::LastImageGcEligible,
+                    static_cast<int64_t>(this->cycleStats_.eligible));
+    DebugCount::set(DebugObject::LastImageGcLeft, left);
+}
+
+std::vector<ImageExpirationPool::ProviderUsage>
+    ImageExpirationPool::getProviderUsageSnapshot()
+{
+    std::vector<ProviderUsage> result;
+    for (auto *shard : this->shards())
+    {
+        const auto bytes = shard->bytes.load(std::memory_order_relaxed);
         if (bytes <= 0)
         {
-            ++it;
             continue;
         }
 
-        const auto provider = providerForUrl(img->url_.string);
-        auto &usage = providers[provider];
-        usage.provider = provider;
-        usage.bytes += bytes;
-        usage.images += 1;
-        if (img->frames_->animated())
-        {
-            usage.animatedImages += 1;
-        }
-
-        ++it;
-    }
-
-    std::vector<ProviderUsage> result;
-    result.reserve(providers.size());
-    for (auto &[_, usage] : providers)
-    {
-        result.push_back(std::move(usage));
+        result.push_back({
+            .provider = shard->provider,
+            .bytes = bytes,
+            .images = static_cast<size_t>(
+                shard->loadedImages.load(std::memory_order_relaxed)),
+            .animatedImages = static_cast<size_t>(
+                shard->animatedImages.load(std::memory_order_relaxed)),
+        });
     }
 
     std::ranges::sort(result, [](const auto &a, const auto &b) {
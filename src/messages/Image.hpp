@@ -5,6 +5,7 @@
 #pragma once
 
 #include "common/Aliases.hpp"
+#include "messages/ImageDecodeScheduler.hpp"
 #include "util/DebugCount.hpp"
 
 #include <pajlada/signals/signal.hpp>
@@ -16,21 +17,29 @@
 
 #include <atomic>
 #include <chrono>
-#include <map>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace chatterino {
 
 class Image;
 class ImageExpirationPool;
+class ImageTestAccess;
 
 }  // namespace chatterino
 
 namespace chatterino::detail {
 
+struct ImagePoolShard;
+
+}  // namespace chatterino::detail
+
+namespace chatterino::detail {
+
 struct Frame {
     QPixmap image;
     int duration;
@@ -40,7 +49,9 @@ class Frames
 {
 public:
     Frames();
-    Frames(QList<Frame> &&frames);
+    /// `sourceSize` is the size of the image the frames were decoded from.
+    /// It defaults to the pixel size of the first frame.
+    Frames(QList<Frame> &&frames, QSize sourceSize = {});
     ~Frames();
 
     Frames(const Frames &) = delete;
@@ -55,6 +66,8 @@ public:
     void advance();
     std::optional<QPixmap> current() const;
     std::optional<QPixmap> first() const;
+    /// Size of the frames before they were scaled down for display
+    std::optional<QSize> sourceSize() const;
 
 private:
     friend class chatterino::ImageExpirationPool;
@@ -62,13 +75,26 @@ private:
     int64_t memoryUsage() const;
     void processOffset();
     QList<Frame> items_;
+    QSize sourceSize_;
     QList<Frame>::size_type index_{0};
     int durationOffset_{0};
     pajlada::Signals::Connection gifTimerConnection_;
 };
 
-QList<Frame> readFrames(QImageReader &reader, const Url &url);
-void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed);
+/// Reads all frames from `reader`.
+///
+/// The frames get `devicePixelRatio` assigned, which should be set if the
+/// reader scales the image down.
+/// If `onFrame` is set, it's called with the frames read so far after every
+/// frame. Reading stops early if it returns false.
+QList<Frame> readFrames(
+    QImageReader &reader, const Url &url, qreal devicePixelRatio = 1,
+    const std::function<bool(const QList<Frame> &)> &onFrame = {});
+void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed,
+                  QSize sourceSize = {});
+/// Returns the device pixel ratio frames of `sourceSize` are decoded at when
+/// they're drawn at `displayScale` (0 = not requested).
+qreal decodedDevicePixelRatio(QSize sourceSize, qreal displayScale);
 
 }  // namespace chatterino::detail
 
@@ -102,9 +128,31 @@ public:
     const Url &url() const;
     bool loaded() const;
     // either returns the current pixmap, or triggers loading it (lazy loading)
-    std::optional<QPixmap> pixmapOrLoad() const;
-    void load() const;
+    std::optional<QPixmap> pixmapOrLoad(
+        ImagePriority priority = ImagePriority::Visible) const;
+    void load(ImagePriority priority = ImagePriority::Offscreen) const;
+    /// Requests the frames to be decoded for being drawn at `factor` device
+    /// pixels per pixel of the source image (1 = native size).
+    ///
+    /// Frames are decoded at the largest factor requested so far, but never
+    /// above their native size. If the loaded frames are too small for a
+    /// new factor, the image is decoded again.
+    void requestDisplayScale(qreal factor);
+    /// Requests the frames at their native size until
+    /// `releaseNativeScale()` is called, e.g. while the image is shown in a
+    /// tooltip.
+    ///
+    /// Every call has to be paired with a call to `releaseNativeScale()`.
+    /// Once all requests are released, the image is decoded again at the
+    /// scale requested through `requestDisplayScale()`.
+    void acquireNativeScale();
+    void releaseNativeScale();
     qreal scale() const;
+    /// The size this image was expected to have when it was created
+    QSize expectedSize() const;
+    /// The size this image is scaled to if it was created through
+    /// fromAutoscaledUrl. It's set on the GUI thread.
+    std::optional<uint16_t> autoScale() const;
     bool isEmpty() const;
     int width() const;
     int height() const;
@@ -120,7 +168,27 @@ private:
     Image(qreal scale);
 
     void setPixmap(const QPixmap &pixmap);
+    /// Replaces the frames and updates the usage accounted in the
+    /// ImageExpirationPool. Must be ran in the GUI thread.
+    void setFrames(std::unique_ptr<detail::Frames> frames);
     void actuallyLoad();
+    /// Decodes `data` into frames and assigns them to `weak`.
+    /// Returns false if the image went away while decoding.
+    ///
+    /// `redecode` is set if the image already has frames, which are kept if
+    /// decoding fails.
+    static bool decode(const std::weak_ptr<Image> &weak,
+                       const QByteArray &data, bool redecode);
+    /// Marks the image as empty, unless it failed to be decoded again at a
+    /// different scale. In that case, the current frames are kept.
+    void loadFailed(bool redecode);
+    /// The display scale the frames should be decoded at
+    qreal targetDisplayScale() const;
+    /// Decodes the frames again if they were decoded at a different scale
+    /// than `targetDisplayScale()`. Must be ran in the GUI thread.
+    void updateDecodedScale();
+    /// Frees the frames. This doesn't update the usage accounted in the
+    /// ImageExpirationPool, the caller has to remove the image from it.
     void expireFrames();
 
     const Url url_{};
@@ -134,6 +202,14 @@ private:
     std::atomic_bool empty_{false};
 
     bool shouldLoad_{false};
+    /// Highest priority this image was requested with since it started loading
+    mutable std::atomic<ImagePriority> priority_{ImagePriority::Offscreen};
+    /// Largest display scale requested through requestDisplayScale (0 if none)
+    std::atomic<qreal> displayScale_{0};
+    /// Number of unreleased calls to acquireNativeScale
+    std::atomic<int> nativeScaleRequests_{0};
+    /// Set while the image is decoded again for a different display scale
+    bool redecodePending_{false};  // gui thread only
 
     /// Size this image should take when loaded (in both dimensions).
     ///
@@ -150,9 +226,14 @@ private:
     // gui thread only
     std::unique_ptr<detail::Frames> frames_;
 
+    /// The shard of the ImageExpirationPool this image is tracked in (if any)
+    std::atomic<detail::ImagePoolShard *> poolShard_{nullptr};
+
     friend class ImageExpirationPool;
+    friend class ImageTestAccess;
+    friend struct detail::ImagePoolShard;
     friend void detail::assignFrames(std::weak_ptr<Image>,
-                                     QList<detail::Frame>);
+                                     QList<detail::Frame>, QSize);
 };
 
 // forward-declarable function that calls Image::getEmpty() under the hood.
@@ -171,19 +252,41 @@ public:
     };
 
     ImageExpirationPool();
+    ~ImageExpirationPool();
     static ImageExpirationPool &instance();
 
+    ImageExpirationPool(const ImageExpirationPool &) = delete;
+    ImageExpirationPool(ImageExpirationPool &&) = delete;
+    ImageExpirationPool &operator=(const ImageExpirationPool &) = delete;
+    ImageExpirationPool &operator=(ImageExpirationPool &&) = delete;
+
     void addImagePtr(ImagePtr imgPtr);
     void removeImagePtr(Image *rawPtr);
 
+    /**
+     * @brief Frees frame data for images that haven't been used for a while,
+     * visiting at most `maxImages` images or running for at most `budget`.
+     *
+     * Images are tracked in one shard per provider. Each call continues where
+     * the previous one stopped, like the hand of a clock, so a full pass over
+     * all images is spread over many calls.
+     * Must be ran in the GUI thread.
+     */
+    void sweep(size_t maxImages, std::chrono::microseconds budget);
+
     /**
      * @brief Frees frame data for all images that ImagePool deems to have expired.
      *
      * Expiration is based on last accessed time of the Image, stored in Image::lastUsed_.
+     * Unlike sweep(), this visits every image at once.
      * Must be ran in the GUI thread.
      */
     void freeOld();
 
+    /// Returns the memory used by loaded images per provider.
+    ///
+    /// This only reads counters maintained by the pool, it doesn't visit
+    /// any images.
     std::vector<ProviderUsage> getProviderUsageSnapshot();
 
     /*
@@ -192,10 +295,38 @@ public:
      */
     void freeAll();
 
-    // Timer to periodically run freeOld()
+private:
+    struct SweepStats {
+        size_t expired = 0;
+        size_t eligible = 0;
+    };
+
+    detail::ImagePoolShard &shardFor(const QString &provider);
+    std::vector<detail::ImagePoolShard *> shards();
+
+    /// Updates the usage counters of the shard `image` is tracked in after
+    /// its frames changed. Must be ran in the GUI thread.
+    static void updateUsage(Image *image);
+
+    /// Returns true if the shard's hand wrapped around
+    bool sweepShard(detail::ImagePoolShard &shard, size_t maxImages,
+                    std::chrono::steady_clock::time_point now,
+                    size_t &visited);
+
+    void publishStats();
+
+    // Timer to periodically run sweep()
     QTimer *freeTimer_;
-    std::map<Image *, std::weak_ptr<Image>> allImages_;
-    std::mutex mutex_;
+
+    std::mutex shardsMutex_;
+    std::vector<std::unique_ptr<detail::ImagePoolShard>> shards_;
+    std::unordered_map<QString, detail::ImagePoolShard *> shardsByProvider_;
+
+    // gui thread only
+    size_t currentShard_ = 0;
+    SweepStats cycleStats_;
+
+    friend class Image;
 };
 
 #endif
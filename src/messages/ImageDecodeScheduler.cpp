@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/ImageDecodeScheduler.hpp"
+
+#include <QThread>
+
+#include <algorithm>
+
+namespace {
+
+using namespace chatterino;
+
+size_t indexOf(ImagePriority priority)
+{
+    return static_cast<size_t>(priority);
+}
+
+// Weight of a new sample in the latency moving average (1/n)
+constexpr int LATENCY_SMOOTHING = 16;
+
+}  // namespace
+
+namespace chatterino {
+
+// Leave some room for the network and other workers
+ImageDecodeScheduler::ImageDecodeScheduler()
+    : ImageDecodeScheduler(std::max(1, QThread::idealThreadCount() / 2))
+{
+}
+
+ImageDecodeScheduler::ImageDecodeScheduler(int maxThreadCount)
+{
+    this->pool_.setMaxThreadCount(std::max(1, maxThreadCount));
+    this->pool_.setObjectName("ImageDecodeScheduler");
+}
+
+ImageDecodeScheduler::~ImageDecodeScheduler()
+{
+    // Runs access the queues, so they must finish before those are destroyed
+    this->pool_.waitForDone();
+}
+
+ImageDecodeScheduler &ImageDecodeScheduler::instance()
+{
+    // Leaked on purpose: decodes might still be running during shutdown
+    static auto *instance = new ImageDecodeScheduler;
+    return *instance;
+}
+
+void ImageDecodeScheduler::schedule(std::weak_ptr<Image> image,
+                                    ImagePriority priority, DecodeFn decode)
+{
+    auto job = std::make_shared<Job>();
+    job->key = image.lock().get();
+    job->image = std::move(image);
+    job->priority = priority;
+    job->decode = std::move(decode);
+    job->queuedFor.start();
+
+    if (job->key == nullptr)
+    {
+        std::lock_guard lock(this->mutex_);
+        this->cancelled_++;
+        return;
+    }
+
+    {
+        std::lock_guard lock(this->mutex_);
+        this->queues_[indexOf(priority)].push_back(job);
+        this->queued_[indexOf(priority)]++;
+        this->pending_[job->key] = job;
+    }
+
+    // Every scheduled job starts exactly one run - the run picks whatever
+    // job has the highest priority at that point.
+    this->pool_.start([this] {
+        this->runNext();
+    });
+}
+
+void ImageDecodeScheduler::raise(const Image *image, ImagePriority priority)
+{
+    std::lock_guard lock(this->mutex_);
+    auto it = this->pending_.find(image);
+    if (it == this->pending_.end())
+    {
+        return;
+    }
+
+    auto &job = it->second;
+    if (job->taken || job->priority <= priority)
+    {
+        return;
+    }
+
+    this->queued_[indexOf(job->priority)]--;
+    this->queued_[indexOf(priority)]++;
+    job->priority = priority;
+    // The entry in the old queue is skipped once it's reached
+    this->queues_[indexOf(priority)].push_back(job);
+}
+
+std::shared_ptr<ImageDecodeScheduler::Job> ImageDecodeScheduler::takeNext()
+{
+    std::lock_guard lock(this->mutex_);
+    for (auto &queue : this->queues_)
+    {
+        while (!queue.empty())
+        {
+            auto job = std::move(queue.front());
+            queue.pop_front();
+            if (job->taken)
+            {
+                continue;
+            }
+
+            job->taken = true;
+            this->queued_[indexOf(job->priority)]--;
+            auto it = this->pending_.find(job->key);
+            if (it != this->pending_.end() && it->second == job)
+            {
+                this->pending_.erase(it);
+            }
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void ImageDecodeScheduler::runNext()
+{
+    auto job = this->takeNext();
+    if (!job)
+    {
+        return;
+    }
+
+    bool completed = false;
+    if (!job->image.expired())
+    {
+        completed = job->decode();
+    }
+
+    std::lock_guard lock(this->mutex_);
+    if (!completed)
+    {
+        this->cancelled_++;
+        return;
+    }
+
+    this->decoded_++;
+    auto sample = std::chrono::microseconds(job->queuedFor.nsecsElapsed() /
+                                            1000);
+    auto &latency = this->latency_[indexOf(job->priority)];
+    if (latency.count() == 0)
+    {
+        latency = sample;
+    }
+    else
+    {
+        latency += (sample - latency) / LATENCY_SMOOTHING;
+    }
+}
+
+ImageDecodeScheduler::Stats ImageDecodeScheduler::stats() const
+{
+    std::lock_guard lock(this->mutex_);
+    return {
+        .queued = this->queued_,
+        .averageLatency = this->latency_,
+        .decoded = this->decoded_,
+        .cancelled = this->cancelled_,
+    };
+}
+
+void ImageDecodeScheduler::waitForDone()
+{
+    this->pool_.waitForDone();
+}
+
+}  // namespace chatterino
@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <magic_enum/magic_enum.hpp>
+#include <QElapsedTimer>
+#include <QThreadPool>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace chatterino {
+
+class Image;
+
+/// Priority of an image decode. Lower values are decoded first.
+enum class ImagePriority : uint8_t {
+    /// The image is painted in a visible view
+    Visible,
+    /// The image is shown in a tooltip
+    Tooltip,
+    /// The image is part of a layout, but wasn't painted yet
+    Offscreen,
+};
+
+/// Decodes downloaded images on a dedicated thread pool.
+///
+/// Decodes are served in order of their priority. Requesting a higher
+/// priority for an image that's still queued moves it up. Decodes for images
+/// that were destroyed before they were picked up are dropped.
+///
+/// This class is thread safe.
+class ImageDecodeScheduler
+{
+public:
+    static constexpr size_t PRIORITY_COUNT =
+        magic_enum::enum_count<ImagePriority>();
+
+    struct Stats {
+        std::array<size_t, PRIORITY_COUNT> queued{};
+        std::array<std::chrono::microseconds, PRIORITY_COUNT>
+            averageLatency{};
+        size_t decoded = 0;
+        size_t cancelled = 0;
+    };
+
+    /// Decodes the image. Returns false if it was cancelled half-way.
+    using DecodeFn = std::function<bool()>;
+
+    ImageDecodeScheduler();
+    explicit ImageDecodeScheduler(int maxThreadCount);
+    /// Waits for running decodes
+    ~ImageDecodeScheduler();
+    static ImageDecodeScheduler &instance();
+
+    ImageDecodeScheduler(const ImageDecodeScheduler &) = delete;
+    ImageDecodeScheduler(ImageDecodeScheduler &&) = delete;
+    ImageDecodeScheduler &operator=(const ImageDecodeScheduler &) = delete;
+    ImageDecodeScheduler &operator=(ImageDecodeScheduler &&) = delete;
+
+    /// Queues `decode` for `image`. It's only run if `image` is still alive
+    /// once a worker picks it up.
+    void schedule(std::weak_ptr<Image> image, ImagePriority priority,
+                  DecodeFn decode);
+
+    /// Moves a queued decode for `image` to `priority` if that's higher than
+    /// its current one. Does nothing if no decode is queued.
+    void raise(const Image *image, ImagePriority priority);
+
+    Stats stats() const;
+
+    /// Blocks until all queued decodes ran
+    /// NOTE: This function is only meant to be used in tests and benchmarks
+    void waitForDone();
+
+private:
+    struct Job {
+        const Image *key;
+        std::weak_ptr<Image> image;
+        ImagePriority priority;
+        DecodeFn decode;
+        QElapsedTimer queuedFor;
+        bool taken = false;
+    };
+
+    void runNext();
+    std::shared_ptr<Job> takeNext();
+
+    QThreadPool pool_;
+
+    mutable std::mutex mutex_;
+    /// One queue per priority. A job can be in multiple queues if its
+    /// priority was raised, it's only run once.
+    std::array<std::deque<std::shared_ptr<Job>>, PRIORITY_COUNT> queues_;
+    std::unordered_map<const Image *, std::shared_ptr<Job>> pending_;
+
+    std::array<size_t, PRIORITY_COUNT> queued_{};
+    /// Moving average of the time from queueing to decoded
+    std::array<std::chrono::microseconds, PRIORITY_COUNT> latency_{};
+    size_t decoded_ = 0;
+    size_t cancelled_ = 0;
+};
+
+}  // namespace chatterino
@@ -4,24 +4,37 @@
 
 #pragma once
 
-#include <boost/circular_buffer.hpp>
+#include "messages/LimitedQueueSnapshot.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <span>
 #include <utility>
 #include <vector>
 
 namespace chatterino {
 
+/// A queue that holds at most `limit` items, dropping the oldest ones when
+/// new ones are pushed to the back.
+///
+/// The items are stored contiguously in storage that has room for more items
+/// than the limit. Pushing to the back appends to the storage and dropping
+/// from the front moves the start forward, only when the storage is full are
+/// the items moved into new storage. This way snapshots can share the
+/// storage (see LimitedQueueSnapshot): any change that would be visible to a
+/// snapshot first moves the items into new storage if a snapshot holds the
+/// current one.
 template <typename T>
 class LimitedQueue
 {
 public:
     LimitedQueue(size_t limit = 1000)
         : limit_(limit)
-        , buffer_(limit)
     {
     }
 
@@ -34,7 +47,48 @@ private:
      */
     [[nodiscard]] size_t space() const
     {
-        return this->limit() - this->buffer_.size();
+        return this->limit() - this->count();
+    }
+
+    /**
+     * @brief Return the number of items in the buffer
+     *
+     * This does not lock
+     */
+    [[nodiscard]] size_t count() const
+    {
+        return this->items_ ? this->items_->size() - this->offset_ : 0;
+    }
+
+    /**
+     * @brief Return the item at the given index
+     *
+     * This does not lock
+     */
+    [[nodiscard]] T &at(size_t index)
+    {
+        assert(index < this->count());
+        return (*this->items_)[this->offset_ + index];
+    }
+
+    [[nodiscard]] const T &at(size_t index) const
+    {
+        assert(index < this->count());
+        return (*this->items_)[this->offset_ + index];
+    }
+
+    /**
+     * @brief Return a view of the items in the buffer
+     *
+     * This does not lock
+     */
+    [[nodiscard]] std::span<const T> view() const
+    {
+        if (!this->items_)
+        {
+            return {};
+        }
+        return std::span<const T>(*this->items_).subspan(this->offset_);
     }
 
 public:
@@ -53,7 +107,7 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        return this->buffer_.empty();
+        return this->count() == 0;
     }
 
     /// Number of items in this container
@@ -61,7 +115,7 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        return this->buffer_.size();
+        return this->count();
     }
 
     /// Value Accessors
@@ -77,12 +131,12 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        if (index >= this->buffer_.size())
+        if (index >= this->count())
         {
             return std::nullopt;
         }
 
-        return this->buffer_[index];
+        return this->at(index);
     }
 
     /**
@@ -94,12 +148,12 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        if (this->buffer_.empty())
+        if (this->count() == 0)
         {
             return std::nullopt;
         }
 
-        return this->buffer_.front();
+        return this->at(0);
     }
 
     /**
@@ -111,22 +165,47 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        if (this->buffer_.empty())
+        if (this->count() == 0)
         {
             return std::nullopt;
         }
 
-        return this->buffer_.back();
+        return this->items_->back();
     }
 
     /// Modifiers
 
+    /**
+     * @brief Change the limit of the queue
+     *
+     * If the queue holds more items than the new limit, the oldest ones are
+     * dropped.
+     *
+     * @param limit the new limit
+     * @return the number of items that were dropped
+     */
+    size_t setLimit(size_t limit)
+    {
+        std::unique_lock lock(this->mutex_);
+
+        this->limit_ = limit;
+        size_t dropped = 0;
+        while (this->count() > this->limit_)
+        {
+            this->popFront();
+            dropped++;
+        }
+        return dropped;
+    }
+
     // Clear the buffer
     void clear()
     {
         std::unique_lock lock(this->mutex_);
 
-        this->buffer_.clear();
+        this->items_.reset();
+        this->offset_ = 0;
+        this->released_ = 0;
     }
 
     /**
@@ -140,12 +219,13 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        bool full = this->buffer_.full();
+        bool full = this->space() == 0;
         if (full)
         {
-            deleted = this->buffer_.front();
+            deleted = this->at(0);
+            this->popFront();
         }
-        this->buffer_.push_back(item);
+        this->append(item);
         return full;
     }
 
@@ -159,8 +239,12 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        bool full = this->buffer_.full();
-        this->buffer_.push_back(item);
+        bool full = this->space() == 0;
+        if (full)
+        {
+            this->popFront();
+        }
+        this->append(item);
         return full;
     }
 
@@ -168,15 +252,24 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        while (!this->buffer_.full())
+        // Collected newest first
+        std::vector<T> items;
+        while (items.size() < this->space())
         {
             auto item = next();
             if (!item)
             {
                 break;
             }
-            this->buffer_.push_front(std::move(item));
+            items.push_back(std::move(item));
         }
+        if (items.empty())
+        {
+            return;
+        }
+
+        std::ranges::reverse(items);
+        this->prepend(std::move(items));
     }
 
     /**
@@ -194,15 +287,10 @@ public:
         std::unique_lock lock(this->mutex_);
 
         size_t numToPush = std::min(items.size(), this->space());
-        std::vector<T> pushed;
-        pushed.reserve(numToPush);
-
-        size_t f = items.size() - numToPush;
-        size_t b = items.size() - 1;
-        for (; f < items.size(); ++f, --b)
+        std::vector<T> pushed(items.end() - numToPush, items.end());
+        if (!pushed.empty())
         {
-            this->buffer_.push_front(items[b]);
-            pushed.push_back(items[f]);
+            this->prepend(pushed);
         }
 
         return pushed;
@@ -222,11 +310,13 @@ public:
         std::unique_lock lock(this->mutex_);
 
         Equals eq;
-        for (size_t i = 0; i < this->buffer_.size(); ++i)
+        const auto view = this->view();
+        for (size_t i = 0; i < view.size(); ++i)
         {
-            if (eq(this->buffer_[i], needle))
+            if (eq(view[i], needle))
             {
-                this->buffer_[i] = replacement;
+                this->detach();
+                this->at(i) = replacement;
                 return static_cast<int>(i);
             }
         }
@@ -245,18 +335,19 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        if (index >= this->buffer_.size())
+        if (index >= this->count())
         {
             return false;
         }
 
+        this->detach();
         if (prev)
         {
-            *prev = std::exchange(this->buffer_[index], replacement);
+            *prev = std::exchange(this->at(index), replacement);
         }
         else
         {
-            this->buffer_[index] = replacement;
+            this->at(index) = replacement;
         }
         return true;
     }
@@ -273,17 +364,20 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        if (hint < this->buffer_.size() && this->buffer_[hint] == needle)
+        const auto view = this->view();
+        if (hint < view.size() && view[hint] == needle)
         {
-            this->buffer_[hint] = replacement;
+            this->detach();
+            this->at(hint) = replacement;
             return static_cast<int>(hint);
         }
 
-        for (size_t i = 0; i < this->buffer_.size(); ++i)
+        for (size_t i = 0; i < view.size(); ++i)
         {
-            if (this->buffer_[i] == needle)
+            if (view[i] == needle)
             {
-                this->buffer_[i] = replacement;
+                this->detach();
+                this->at(i) = replacement;
                 return static_cast<int>(i);
             }
         }
@@ -304,11 +398,12 @@ public:
         std::unique_lock lock(this->mutex_);
 
         Equals eq;
-        for (auto it = this->buffer_.begin(); it != this->buffer_.end(); ++it)
+        const auto view = this->view();
+        for (size_t i = 0; i < view.size(); ++i)
         {
-            if (eq(*it, needle))
+            if (eq(view[i], needle))
             {
-                this->buffer_.insert(it, item);
+                this->insert(i, item);
                 return true;
             }
         }
@@ -330,12 +425,12 @@ public:
         std::unique_lock lock(this->mutex_);
 
         Equals eq;
-        for (auto it = this->buffer_.begin(); it != this->buffer_.end(); ++it)
+        const auto view = this->view();
+        for (size_t i = 0; i < view.size(); ++i)
         {
-            if (eq(*it, needle))
+            if (eq(view[i], needle))
             {
-                ++it;  // advance to insert after it
-                this->buffer_.insert(it, item);
+                this->insert(i + 1, item);
                 return true;
             }
         }
@@ -343,40 +438,39 @@ public:
         return false;
     }
 
-    [[nodiscard]] std::vector<T> getSnapshot() const
+    /**
+     * @brief Returns a snapshot of all items
+     *
+     * This doesn't copy the items, the snapshot shares them with the queue.
+     */
+    [[nodiscard]] LimitedQueueSnapshot<T> getSnapshot() const
     {
         std::shared_lock lock(this->mutex_);
-        return {this->buffer_.begin(), this->buffer_.end()};
+        return this->snapshot(0, this->count());
     }
 
-    [[nodiscard]] std::vector<T> lastN(size_t nItems) const
+    [[nodiscard]] LimitedQueueSnapshot<T> lastN(size_t nItems) const
     {
         std::shared_lock lock(this->mutex_);
-        return {
-            this->buffer_.end() - std::min(nItems, this->buffer_.size()),
-            this->buffer_.end(),
-        };
+        auto n = std::min(nItems, this->count());
+        return this->snapshot(this->count() - n, n);
     }
 
     template <typename U>
     [[nodiscard]] std::vector<U> lastNBy(size_t nItems, auto &&cb) const
     {
-        std::shared_lock lock(this->mutex_);
+        auto items = this->lastN(nItems);
         std::vector<U> vec;
-        std::transform(
-            this->buffer_.end() - std::min(nItems, this->buffer_.size()),
-            this->buffer_.end(), std::back_inserter(vec),
-            std::forward<decltype(cb)>(cb));
+        vec.reserve(items.size());
+        std::transform(items.begin(), items.end(), std::back_inserter(vec),
+                       std::forward<decltype(cb)>(cb));
         return vec;
     }
 
-    [[nodiscard]] std::vector<T> firstN(size_t nItems) const
+    [[nodiscard]] LimitedQueueSnapshot<T> firstN(size_t nItems) const
     {
         std::shared_lock lock(this->mutex_);
-        return {
-            this->buffer_.begin(),
-            this->buffer_.begin() + std::min(nItems, this->buffer_.size()),
-        };
+        return this->snapshot(0, std::min(nItems, this->count()));
     }
 
     // Actions
@@ -397,11 +491,12 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        for (const auto &item : this->buffer_)
+        const auto view = this->view();
+        for (size_t i = 0; i < view.size(); ++i)
         {
-            if (pred(item))
+            if (pred(view[i]))
             {
-                return item;
+                return view[i];
             }
         }
 
@@ -419,16 +514,17 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        if (hint < this->buffer_.size() && predicate(this->buffer_[hint]))
+        const auto view = this->view();
+        if (hint < view.size() && predicate(view[hint]))
         {
-            return std::pair{hint, this->buffer_[hint]};
+            return std::pair{hint, view[hint]};
         };
 
-        for (size_t i = 0; i < this->buffer_.size(); i++)
+        for (size_t i = 0; i < view.size(); i++)
         {
-            if (predicate(this->buffer_[i]))
+            if (predicate(view[i]))
             {
-                return std::pair{i, this->buffer_[i]};
+                return std::pair{i, view[i]};
             }
         }
         return std::nullopt;
@@ -450,7 +546,8 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        for (auto it = this->buffer_.rbegin(); it != this->buffer_.rend(); ++it)
+        const auto view = this->view();
+        for (auto it = view.rbegin(); it != view.rend(); ++it)
         {
             if (pred(*it))
             {
@@ -462,10 +559,156 @@ public:
     }
 
 private:
+    /// Storage never holds less than this many items
+    static constexpr size_t MIN_CAPACITY = 64;
+
+    // All of the following need a unique lock, except for `snapshot`, which
+    // needs at least a shared one.
+
+    [[nodiscard]] LimitedQueueSnapshot<T> snapshot(size_t index,
+                                                   size_t n) const
+    {
+        if (!this->items_)
+        {
+            return {};
+        }
+        return {this->items_, this->offset_ + index, n};
+    }
+
+    /// Returns true if a snapshot might see the current storage
+    [[nodiscard]] bool shared() const
+    {
+        // No snapshot can be taken while we hold the unique lock, so the
+        // count can only drop concurrently. use_count() is a relaxed load:
+        // the fence makes the reads of a snapshot released on another
+        // thread happen before we change the items in place.
+        if (this->items_.use_count() > 1)
+        {
+            return true;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return false;
+    }
+
+    /// Returns empty storage with room for at least `n` items. Room for
+    /// twice the limit means the items are moved at most once per `limit`
+    /// pushes.
+    [[nodiscard]] std::shared_ptr<std::vector<T>> allocate(size_t n) const
+    {
+        auto capacity = std::min(std::max(2 * n, MIN_CAPACITY),
+                                 2 * this->limit_);
+        capacity = std::max(capacity, n);
+        auto items = std::make_shared<std::vector<T>>();
+        items->reserve(capacity);
+        return items;
+    }
+
+    /// Appends the items in [first, last) to `storage`. The items are moved
+    /// if no snapshot can see them.
+    void transfer(std::vector<T> &storage, size_t first, size_t last)
+    {
+        if (first >= last)
+        {
+            return;
+        }
+
+        auto begin = this->items_->begin() + (this->offset_ + first);
+        auto end = this->items_->begin() + (this->offset_ + last);
+        if (this->shared())
+        {
+            storage.insert(storage.end(), begin, end);
+        }
+        else
+        {
+            storage.insert(storage.end(), std::make_move_iterator(begin),
+                           std::make_move_iterator(end));
+        }
+    }
+
+    /// Moves the items into new storage with room for `extra` more items
+    void reallocate(size_t extra)
+    {
+        auto items = this->allocate(this->count() + extra);
+        this->transfer(*items, 0, this->count());
+        this->items_ = std::move(items);
+        this->offset_ = 0;
+        this->released_ = 0;
+    }
+
+    /// Makes sure no snapshot can see the items before changing them in place
+    void detach()
+    {
+        if (this->shared())
+        {
+            this->reallocate(0);
+        }
+    }
+
+    void append(const T &item)
+    {
+        if (!this->items_ || this->items_->size() == this->items_->capacity())
+        {
+            this->reallocate(1);
+        }
+        // Snapshots only see items before the end, so appending doesn't
+        // change them.
+        this->items_->push_back(item);
+    }
+
+    void popFront()
+    {
+        assert(this->count() > 0);
+        this->offset_++;
+        if (!this->shared())
+        {
+            // Release the dropped items now instead of when the storage is
+            // replaced, including the ones a snapshot saw until now
+            for (; this->released_ < this->offset_; this->released_++)
+            {
+                (*this->items_)[this->released_] = T{};
+            }
+        }
+    }
+
+    /// Adds `items` to the front. They must fit into the queue.
+    void prepend(const std::vector<T> &items)
+    {
+        assert(items.size() <= this->space());
+
+        auto storage = this->allocate(this->count() + items.size());
+        storage->insert(storage->end(), items.begin(), items.end());
+        this->transfer(*storage, 0, this->count());
+        this->items_ = std::move(storage);
+        this->offset_ = 0;
+        this->released_ = 0;
+    }
+
+    /// Inserts `item` before the item at `index`. If the queue is full, the
+    /// first item is dropped to make room.
+    void insert(size_t index, const T &item)
+    {
+        auto storage = this->allocate(this->count() + 1);
+        this->transfer(*storage, 0, index);
+        storage->push_back(item);
+        this->transfer(*storage, index, this->count());
+        this->items_ = std::move(storage);
+        this->offset_ = 0;
+        this->released_ = 0;
+
+        if (this->count() > this->limit_)
+        {
+            this->popFront();
+        }
+    }
+
     mutable std::shared_mutex mutex_;
 
-    const size_t limit_;
-    boost::circular_buffer<T> buffer_;
+    size_t limit_;
+    /// The items are stored at [offset_, items_->size())
+    std::shared_ptr<std::vector<T>> items_;
+    size_t offset_ = 0;
+    /// The dropped items before this were released
+    size_t released_ = 0;
 };
 
 }  // namespace chatterino
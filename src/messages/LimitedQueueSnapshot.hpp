@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+template <typename T>
+class LimitedQueue;
+
+/// An immutable view of the items of a LimitedQueue at the time the snapshot
+/// was taken.
+///
+/// The snapshot shares the storage of the queue instead of copying the
+/// items. The queue only ever appends to storage that's visible to a
+/// snapshot and moves to new storage for any other change, so the items of a
+/// snapshot never change and the snapshot can be used from any thread. The
+/// items are contiguous, so a snapshot can be viewed as a `std::span`.
+///
+/// While a snapshot is alive, the queue can't release the items it drops,
+/// so snapshots shouldn't be kept longer than needed.
+template <typename T>
+class LimitedQueueSnapshot
+{
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using const_reference = const T &;
+    using const_iterator = const T *;
+    using iterator = const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using reverse_iterator = const_reverse_iterator;
+
+    LimitedQueueSnapshot() = default;
+
+    [[nodiscard]] size_t size() const
+    {
+        return this->size_;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return this->size_ == 0;
+    }
+
+    [[nodiscard]] const T &operator[](size_t index) const
+    {
+        assert(index < this->size_);
+        return this->data_[index];
+    }
+
+    [[nodiscard]] const T &front() const
+    {
+        assert(!this->empty());
+        return this->data_[0];
+    }
+
+    [[nodiscard]] const T &back() const
+    {
+        assert(!this->empty());
+        return this->data_[this->size_ - 1];
+    }
+
+    [[nodiscard]] const T *data() const
+    {
+        return this->data_;
+    }
+
+    [[nodiscard]] const_iterator begin() const
+    {
+        return this->data_;
+    }
+
+    [[nodiscard]] const_iterator end() const
+    {
+        return this->data_ + this->size_;
+    }
+
+    [[nodiscard]] const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(this->end());
+    }
+
+    [[nodiscard]] const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(this->begin());
+    }
+
+private:
+    LimitedQueueSnapshot(std::shared_ptr<const std::vector<T>> storage,
+                         size_t offset, size_t size)
+        : storage_(std::move(storage))
+        , data_(this->storage_->data() + offset)
+        , size_(size)
+    {
+        assert(offset + size <= this->storage_->size());
+    }
+
+    /// Keeps the items alive
+    std::shared_ptr<const std::vector<T>> storage_;
+    const T *data_ = nullptr;
+    size_t size_ = 0;
+
+    friend class LimitedQueue<T>;
+};
+
+}  // namespace chatterino
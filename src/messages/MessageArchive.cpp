@@ -0,0 +1,438 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/MessageArchive.hpp"
+
+#include "messages/Link.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "messages/MessageColor.hpp"
+#include "messages/MessageElement.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+#include "singletons/Fonts.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QDataStream>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+using namespace chatterino;
+
+// Stand-in for messages without a valid receive time
+constexpr qint64 NO_TIME = std::numeric_limits<qint64>::min();
+
+void writeMessage(QDataStream &stream, const Message &message)
+{
+    stream << message.id
+           << (message.serverReceivedTime.isValid()
+                   ? message.serverReceivedTime.toMSecsSinceEpoch()
+                   : NO_TIME)
+           << static_cast<qint32>(message.parseTime.msecsSinceStartOfDay())
+           << static_cast<qint64>(message.flags.value())
+           << static_cast<quint8>(message.platform) << message.loginName
+           << message.displayName << message.userID << message.timeoutUser
+           << message.channelName << message.usernameColor
+           << message.messageText << message.searchText;
+
+    stream << static_cast<quint32>(message.twitchBadges.size());
+    for (const auto &badge : message.twitchBadges)
+    {
+        stream << badge.key_ << badge.value_;
+    }
+}
+
+void readMessage(QDataStream &stream, Message &message)
+{
+    qint64 time = 0;
+    qint32 parseTime = 0;
+    qint64 flags = 0;
+    quint8 platform = 0;
+    stream >> message.id >> time >> parseTime >> flags >> platform >>
+        message.loginName >> message.displayName >> message.userID >>
+        message.timeoutUser >> message.channelName >> message.usernameColor >>
+        message.messageText >> message.searchText;
+
+    quint32 badgeCount = 0;
+    stream >> badgeCount;
+    message.twitchBadges.clear();
+    for (quint32 i = 0; i < badgeCount && stream.status() == QDataStream::Ok;
+         i++)
+    {
+        QString key;
+        QString value;
+        stream >> key >> value;
+        message.twitchBadges.emplace_back(std::move(key), std::move(value));
+    }
+
+    message.serverReceivedTime =
+        time == NO_TIME ? QDateTime() : QDateTime::fromMSecsSinceEpoch(time);
+    message.parseTime = QTime::fromMSecsSinceStartOfDay(parseTime);
+    message.flags = MessageFlags(static_cast<MessageFlag>(flags));
+    message.platform = static_cast<MessagePlatform>(platform);
+}
+
+/// Builds a displayable message from the fields of an archived one
+MessagePtr rebuild(const Message &fields)
+{
+    MessageBuilder builder;
+    builder->flags = fields.flags;
+    builder->flags.set(MessageFlag::DoNotLog,
+                       MessageFlag::DoNotTriggerNotification);
+    builder->parseTime = fields.parseTime;
+    builder->id = fields.id;
+    builder->searchText = fields.searchText;
+    builder->messageText = fields.messageText;
+    builder->loginName = fields.loginName;
+    builder->displayName = fields.displayName;
+    builder->userID = fields.userID;
+    builder->timeoutUser = fields.timeoutUser;
+    builder->channelName = fields.channelName;
+    builder->usernameColor = fields.usernameColor;
+    builder->serverReceivedTime = fields.serverReceivedTime;
+    builder->twitchBadges = fields.twitchBadges;
+    builder->platform = fields.platform;
+
+    builder.emplace<TimestampElement>(
+        fields.serverReceivedTime.isValid()
+            ? fields.serverReceivedTime.toLocalTime().time()
+            : fields.parseTime);
+
+    if (fields.loginName.isEmpty() || fields.flags.has(MessageFlag::System))
+    {
+        builder.appendOrEmplaceText(fields.messageText, MessageColor::System);
+        return builder.release();
+    }
+
+    auto userColor = fields.usernameColor.isValid()
+                         ? MessageColor(fields.usernameColor)
+                         : MessageColor(MessageColor::Text);
+    auto name = fields.displayName.isEmpty() ? fields.loginName
+                                             : fields.displayName;
+    builder
+        .emplace<TextElement>(name + u":"_s, MessageElementFlag::Username,
+                              userColor, FontStyle::ChatMediumBold)
+        ->setLink({Link::UserInfo, fields.loginName});
+    builder.appendOrEmplaceText(fields.messageText, MessageColor::Text);
+
+    return builder.release();
+}
+
+}  // namespace
+
+namespace chatterino {
+
+MessageArchive::MessageArchive(size_t limit)
+    : limit_(limit)
+{
+}
+
+MessageArchive::~MessageArchive()
+{
+    // The blocks being compressed refer to this archive
+    this->waitForDone();
+    this->clear();
+}
+
+void MessageArchive::add(MessagePtr message)
+{
+    if (this->limit_ == 0 || !message)
+    {
+        return;
+    }
+
+    std::lock_guard lock(this->mutex_);
+
+    if (!message->loginName.isEmpty())
+    {
+        this->open_.users.insert(message->loginName.toLower());
+    }
+    if (!message->timeoutUser.isEmpty())
+    {
+        this->open_.users.insert(message->timeoutUser.toLower());
+    }
+    if (message->loginName.isEmpty() &&
+        message->flags.has(MessageFlag::Subscription))
+    {
+        // Subscription messages start with the name of the user
+        this->open_.users.insert(
+            message->messageText.section(u' ', 0, 0).toLower());
+    }
+
+    if (this->open_.count == 0)
+    {
+        this->open_.first = this->nextPosition_;
+    }
+    this->open_.messages.push_back(std::move(message));
+    this->open_.count++;
+    this->nextPosition_++;
+    this->size_++;
+    DebugCount::increase(DebugObject::ArchivedMessage);
+
+    if (this->open_.count >= std::min(BLOCK_SIZE, this->limit_))
+    {
+        this->sealOpenBlock();
+    }
+}
+
+void MessageArchive::clear()
+{
+    std::lock_guard lock(this->mutex_);
+
+    DebugCount::decrease(DebugObject::ArchivedMessage,
+                         static_cast<int64_t>(this->size_));
+    DebugCount::decrease(DebugObject::BytesArchivedMessages,
+                         static_cast<int64_t>(this->bytes_));
+    this->blocks_.clear();
+    this->open_ = {};
+    this->size_ = 0;
+    this->bytes_ = 0;
+}
+
+size_t MessageArchive::size() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->size_;
+}
+
+size_t MessageArchive::limit() const
+{
+    return this->limit_;
+}
+
+size_t MessageArchive::memoryUsage() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->bytes_;
+}
+
+uint64_t MessageArchive::beginPosition() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->beginPositionImpl();
+}
+
+uint64_t MessageArchive::endPosition() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->nextPosition_;
+}
+
+std::vector<MessagePtr> MessageArchive::find(const Predicate &predicate) const
+{
+    return this->findImpl(std::nullopt, predicate);
+}
+
+std::vector<MessagePtr> MessageArchive::findByUser(
+    const QString &login, const Predicate &predicate) const
+{
+    return this->findImpl(login.toLower(), predicate);
+}
+
+void MessageArchive::waitForDone() const
+{
+    std::unique_lock lock(this->mutex_);
+    this->blockFinished_.wait(lock, [this] {
+        return this->pendingBlocks_ == 0;
+    });
+}
+
+std::vector<MessagePtr> MessageArchive::findImpl(
+    const std::optional<QString> &login, const Predicate &predicate) const
+{
+    // Copy the blocks (their data is implicitly shared), so the archive isn't
+    // locked while decompressing.
+    std::vector<Block> blocks;
+    {
+        std::lock_guard lock(this->mutex_);
+        blocks.reserve(this->blocks_.size() + 1);
+        for (const auto &block : this->blocks_)
+        {
+            if (!login || block.users.contains(*login))
+            {
+                blocks.push_back(block);
+            }
+        }
+        if (this->open_.count > 0 &&
+            (!login || this->open_.users.contains(*login)))
+        {
+            blocks.push_back(this->open_);
+        }
+    }
+
+    std::vector<MessagePtr> result;
+    for (const auto &block : blocks)
+    {
+        readBlock(block, [&](uint64_t /*position*/, const Message &fields) {
+            if (predicate(fields))
+            {
+                result.push_back(rebuild(fields));
+            }
+        });
+    }
+
+    return result;
+}
+
+MessageArchive::Page MessageArchive::findBefore(
+    uint64_t before, size_t count, const Predicate &predicate) const
+{
+    std::vector<Block> blocks;
+    Page page;
+    {
+        std::lock_guard lock(this->mutex_);
+        page.start = this->beginPositionImpl();
+        for (const auto &block : this->blocks_)
+        {
+            if (block.first < before)
+            {
+                blocks.push_back(block);
+            }
+        }
+        if (this->open_.count > 0 && this->open_.first < before)
+        {
+            blocks.push_back(this->open_);
+        }
+    }
+
+    // Newest first
+    std::vector<std::pair<uint64_t, MessagePtr>> found;
+    for (auto it = blocks.rbegin(); it != blocks.rend() && found.size() < count;
+         it++)
+    {
+        std::vector<std::pair<uint64_t, MessagePtr>> matches;
+        readBlock(*it, [&](uint64_t position, const Message &fields) {
+            if (position < before && predicate(fields))
+            {
+                matches.emplace_back(position, rebuild(fields));
+            }
+        });
+        for (auto match = matches.rbegin();
+             match != matches.rend() && found.size() < count; match++)
+        {
+            found.push_back(std::move(*match));
+        }
+    }
+
+    if (found.size() >= count && !found.empty())
+    {
+        page.start = found.back().first;
+    }
+    page.messages.reserve(found.size());
+    for (auto it = found.rbegin(); it != found.rend(); it++)
+    {
+        page.messages.push_back(std::move(it->second));
+    }
+    return page;
+}
+
+void MessageArchive::readBlock(
+    const Block &block,
+    const std::function<void(uint64_t, const Message &)> &fn)
+{
+    // Blocks that aren't compressed yet still have their messages
+    if (!block.messages.empty())
+    {
+        for (size_t i = 0; i < block.messages.size(); i++)
+        {
+            fn(block.first + i, *block.messages[i]);
+        }
+        return;
+    }
+
+    // Archived messages are read into this one first, so only the
+    // matching ones are rebuilt.
+    Message fields;
+    auto data = qUncompress(block.data);
+    QDataStream stream(data);
+    for (size_t i = 0; i < block.count; i++)
+    {
+        readMessage(stream, fields);
+        if (stream.status() != QDataStream::Ok)
+        {
+            break;
+        }
+
+        fn(block.first + i, fields);
+    }
+}
+
+uint64_t MessageArchive::beginPositionImpl() const
+{
+    if (!this->blocks_.empty())
+    {
+        return this->blocks_.front().first;
+    }
+    if (this->open_.count > 0)
+    {
+        return this->open_.first;
+    }
+    return this->nextPosition_;
+}
+
+void MessageArchive::sealOpenBlock()
+{
+    auto &block = this->blocks_.emplace_back(std::exchange(this->open_, {}));
+    block.id = this->nextBlockID_++;
+    this->pendingBlocks_++;
+
+    // Writing and compressing a block takes a while, so it's done in the
+    // background. The archive waits for this in its destructor.
+    QThreadPool::globalInstance()->start(
+        [this, id = block.id, messages = block.messages] {
+            QByteArray data;
+            {
+                QDataStream stream(&data, QIODevice::WriteOnly);
+                for (const auto &message : messages)
+                {
+                    writeMessage(stream, *message);
+                }
+            }
+            this->finishBlock(id, qCompress(data));
+        });
+
+    while (this->size_ > this->limit_ && !this->blocks_.empty())
+    {
+        this->dropOldest();
+    }
+}
+
+void MessageArchive::finishBlock(uint64_t id, QByteArray data)
+{
+    std::lock_guard lock(this->mutex_);
+
+    // The block might've been dropped in the meantime
+    auto it = std::ranges::find(this->blocks_, id, &Block::id);
+    if (it != this->blocks_.end())
+    {
+        this->bytes_ += static_cast<size_t>(data.size());
+        DebugCount::increase(DebugObject::BytesArchivedMessages, data.size());
+        it->data = std::move(data);
+        it->messages.clear();
+    }
+
+    // Notify with the lock held, the archive might be destroyed right after
+    this->pendingBlocks_--;
+    this->blockFinished_.notify_all();
+}
+
+void MessageArchive::dropOldest()
+{
+    auto &oldest = this->blocks_.front();
+    this->size_ -= oldest.count;
+    this->bytes_ -= static_cast<size_t>(oldest.data.size());
+    DebugCount::decrease(DebugObject::ArchivedMessage,
+                         static_cast<int64_t>(oldest.count));
+    DebugCount::decrease(DebugObject::BytesArchivedMessages,
+                         oldest.data.size());
+    this->blocks_.pop_front();
+}
+
+}  // namespace chatterino
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QByteArray>
+#include <QSet>
+#include <QString>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/// Keeps messages that were evicted from a channel's message buffer.
+///
+/// Only the fields of a message are kept (not its elements). Messages are
+/// collected in blocks of BLOCK_SIZE messages. Once a block is full, it's
+/// written and compressed on the global thread pool - until then, the block
+/// keeps the messages themselves. When the archive is queried, blocks are
+/// decompressed one by one and only matching messages are rebuilt - as plain
+/// text messages.
+///
+/// Once the archive holds more than `limit` messages, the oldest block is
+/// dropped.
+///
+/// Messages are numbered in the order they're archived (their position), so
+/// views can page through the archive with findBefore().
+///
+/// This class is thread safe.
+class MessageArchive
+{
+public:
+    /// Decides if an archived message should be returned. The message only
+    /// has its fields set, it doesn't have any elements.
+    using Predicate = std::function<bool(const Message &)>;
+
+    /// Number of messages in one compressed block
+    static constexpr size_t BLOCK_SIZE = 256;
+
+    struct Page {
+        /// Oldest first
+        std::vector<MessagePtr> messages;
+        /// Position to continue at with the next (older) page
+        uint64_t start = 0;
+    };
+
+    /// A `limit` of 0 disables the archive
+    explicit MessageArchive(size_t limit);
+    /// Waits for the blocks that are being compressed
+    ~MessageArchive();
+
+    MessageArchive(const MessageArchive &) = delete;
+    MessageArchive(MessageArchive &&) = delete;
+    MessageArchive &operator=(const MessageArchive &) = delete;
+    MessageArchive &operator=(MessageArchive &&) = delete;
+
+    void add(MessagePtr message);
+    void clear();
+
+    /// Number of archived messages
+    size_t size() const;
+    size_t limit() const;
+    /// Bytes used by the compressed blocks
+    size_t memoryUsage() const;
+
+    /// Position of the oldest archived message
+    uint64_t beginPosition() const;
+    /// Position the next archived message will get
+    uint64_t endPosition() const;
+
+    /// Returns all archived messages `predicate` applies to, oldest first
+    std::vector<MessagePtr> find(const Predicate &predicate) const;
+
+    /// Same as find(), but only looks at blocks with messages from, or about,
+    /// the user with the login `login`.
+    std::vector<MessagePtr> findByUser(const QString &login,
+                                       const Predicate &predicate) const;
+
+    /// Returns the newest `count` messages before the position `before` that
+    /// `predicate` applies to. If there are fewer, the page starts at
+    /// beginPosition().
+    Page findBefore(uint64_t before, size_t count,
+                    const Predicate &predicate) const;
+
+    /// Waits until all full blocks are compressed.
+    ///
+    /// NOTE: This function is only meant to be used in tests and benchmarks
+    void waitForDone() const;
+
+private:
+    struct Block {
+        /// Sequence number, used to find the block once it's compressed
+        uint64_t id = 0;
+        /// Position of the first message
+        uint64_t first = 0;
+        /// The messages of this block until it's compressed
+        std::vector<MessagePtr> messages;
+        QByteArray data;
+        size_t count = 0;
+        /// Lowercase logins mentioned in this block (author or target)
+        QSet<QString> users;
+    };
+
+    std::vector<MessagePtr> findImpl(const std::optional<QString> &login,
+                                     const Predicate &predicate) const;
+    /// Calls `fn` with the position and fields of each message in `block`
+    static void readBlock(
+        const Block &block,
+        const std::function<void(uint64_t, const Message &)> &fn);
+    /// Needs the lock
+    uint64_t beginPositionImpl() const;
+
+    /// Moves the open block to the full ones, starts compressing it and
+    /// drops old blocks. Needs the lock.
+    void sealOpenBlock();
+    /// Stores the compressed data of the block `id` (if it's still there)
+    void finishBlock(uint64_t id, QByteArray data);
+    void dropOldest();
+
+    const size_t limit_;
+
+    mutable std::mutex mutex_;
+    /// Notified when a block finished compressing
+    mutable std::condition_variable blockFinished_;
+    std::deque<Block> blocks_;
+    Block open_;
+    uint64_t nextBlockID_ = 0;
+    uint64_t nextPosition_ = 0;
+    /// Number of blocks that are being compressed
+    size_t pendingBlocks_ = 0;
+    size_t size_ = 0;
+    size_t bytes_ = 0;
+};
+
+}  // namespace chatterino
@@ -45,6 +45,7 @@
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "providers/twitch/TwitchUsers.hpp"
 #include "providers/twitch/UserColor.hpp"
+#include "providers/UserMetadataStore.hpp"
 #include "singletons/Resources.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/StreamerMode.hpp"
@@ -52,6 +53,7 @@
 #include "singletons/WindowManager.hpp"
 #include "util/BajerinoHelpers.hpp"
 #include "util/Crypto.hpp"
+#include "util/DebugCount.hpp"
 #include "util/FormatTime.hpp"
 #include "util/Helpers.hpp"
 #include "util/IrcHelpers.hpp"
@@ -1916,6 +1918,7 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
     const QString::size_type messageOffset,
     const std::shared_ptr<MessageThread> &thread, const MessagePtr &parent)
 {
+    DebugStageTimer timer(DebugStage::MessageBuild);
     assert(ircMessage != nullptr);
     assert(channel != nullptr);
 
@@ -2359,6 +2362,15 @@ void MessageBuilder::parseUsername(const Communi::IrcMessage *ircMessage,
     if (twitchChannel != nullptr)
     {
         twitchChannel->setUserColor(userName, this->message_->usernameColor);
+
+        // Keep the color for mentions after a restart
+        auto color = ircMessage->tag("color").toString();
+        auto *userMetadata = getApp()->getUserMetadata();
+        if (!color.isEmpty() && userMetadata != nullptr)
+        {
+            userMetadata->set(ircMessage->tag("user-id").toString(), userName,
+                              UserMetadataStore::Field::Color, color);
+        }
     }
 
     // Update current user color if this is our message
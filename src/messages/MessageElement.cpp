@@ -58,6 +58,21 @@ QSizeF getBoundingBoxSize(const std::vector<ImagePtr> &images)
     return {width, height};
 }
 
+// Tells `image` how large it's drawn, so it can decode its frames at that size.
+// `scale` is the factor the size of the image is multiplied with in the layout.
+void requestDisplayScale(Image &image, const MessageLayoutContainer &container,
+                         qreal scale)
+{
+    if (image.isEmpty() || container.getScale() <= 0)
+    {
+        return;
+    }
+
+    // The image scale includes the device pixel ratio, the scale doesn't
+    auto devicePixelRatio = container.getImageScale() / container.getScale();
+    image.requestDisplayScale(image.scale() * scale * devicePixelRatio);
+}
+
 EmotePtr getKickBadge()
 {
     static EmotePtr ptr = std::make_shared<const Emote>(Emote{
@@ -323,6 +338,15 @@ void EmoteElement::addToContainer(MessageLayoutContainer &container,
             auto emoteScale = getSettings()->emoteScale.getValue();
             auto size = image->size() * scale * emoteScale;
 
+            requestDisplayScale(*image, container, scale * emoteScale);
+            // The image we got might be a fallback while the proper one loads
+            const auto &target =
+                this->emote_->images.getImage(container.getImageScale());
+            if (target != image)
+            {
+                requestDisplayScale(*target, container, scale * emoteScale);
+            }
+
             container.addElement(this->makeImageLayoutElement(image, size));
             return;
         }
@@ -426,6 +450,7 @@ void LayeredEmoteElement::addToContainer(MessageLayoutContainer &container,
             for (const auto &img : images)
             {
                 individualSizes.push_back(img->size() * scale * emoteScale);
+                requestDisplayScale(*img, container, scale * emoteScale);
             }
 
             container.addElement(this->makeImageLayoutElement(
@@ -6,6 +6,7 @@
 
 #include "Application.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "messages/LimitedQueueSnapshot.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "singletons/Settings.hpp"
 
@@ -118,5 +119,7 @@ void setSimilarityFlags(const MessagePtr &message, const T &messages)
 
 template void setSimilarityFlags<std::vector<MessagePtr>>(
     const MessagePtr &msg, const std::vector<MessagePtr> &messages);
+template void setSimilarityFlags<LimitedQueueSnapshot<MessagePtr>>(
+    const MessagePtr &msg, const LimitedQueueSnapshot<MessagePtr> &messages);
 
 }  // namespace chatterino
@@ -5,6 +5,7 @@
 #include "messages/layouts/MessageLayout.hpp"
 
 #include "Application.hpp"
+#include "messages/layouts/MessageLayoutCache.hpp"
 #include "messages/layouts/MessageLayoutContainer.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
@@ -36,10 +37,22 @@ QColor blendColors(const QColor &base, const QColor &apply)
                    base.blueF() * (1 - alpha) + apply.blueF() * alpha);
     return result;
 }
+
+/// Used by layouts that weren't laid out yet or whose cache was deleted
+const std::shared_ptr<const MessageLayoutContainer> &emptyContainer()
+{
+    // Leaked on purpose, containers can't be destroyed after DebugCount
+    static const auto *container =
+        new std::shared_ptr<const MessageLayoutContainer>(
+            std::make_shared<MessageLayoutContainer>());
+    return *container;
+}
+
 }  // namespace
 
 MessageLayout::MessageLayout(MessagePtr message)
     : message_(std::move(message))
+    , container_(emptyContainer())
 {
     DebugCount::increase(DebugObject::MessageLayout);
 }
@@ -62,22 +75,23 @@ const MessagePtr &MessageLayout::getMessagePtr() const
 // Height
 int MessageLayout::getHeight() const
 {
-    return static_cast<int>(this->container_.getHeight());
+    // Not taken from the container, the height is kept after deleteCache()
+    return static_cast<int>(this->height_);
 }
 
 int MessageLayout::getFirstLineHeight() const
 {
-    return this->container_.getFirstLineHeight();
+    return this->container_->getFirstLineHeight();
 }
 
 int MessageLayout::getWidth() const
 {
-    return static_cast<int>(this->container_.getWidth());
+    return static_cast<int>(this->container_->getWidth());
 }
 
 size_t MessageLayout::getLineCount() const
 {
-    return this->container_.getLineCount();
+    return this->container_->getLineCount();
 }
 
 // Layout
@@ -135,9 +149,9 @@ bool MessageLayout::layout(const MessageLayoutContext &ctx,
         return false;
     }
 
-    qreal oldHeight = this->container_.getHeight();
+    qreal oldHeight = this->height_;
     this->actuallyLayout(ctx);
-    if (widthChanged || this->container_.getHeight() != oldHeight)
+    if (widthChanged || this->height_ != oldHeight)
     {
         this->deleteBuffer();
     }
@@ -148,9 +162,7 @@ bool MessageLayout::layout(const MessageLayoutContext &ctx,
 
 void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
 {
-#ifdef FOURTF
-    this->layoutCount_++;
-#endif
+    DebugStageTimer timer(DebugStage::Layout);
 
     auto messageFlags = this->message_->flags;
 
@@ -161,59 +173,93 @@ void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
         messageFlags.unset(MessageFlag::Collapsed);
     }
 
-    bool hideModerated = getSettings()->hideModerated;
-    bool hideModerationActions = getSettings()->hideModerationActions;
-    bool hideBlockedTermAutomodMessages =
-        getSettings()->showBlockedTermAutomodMessages.getEnum() ==
-        ShowModerationState::Never;
-    bool hideSimilar = getSettings()->hideSimilar;
-    bool hideReplies = !ctx.flags.has(MessageElementFlag::RepliedMessage);
-
-    this->container_.beginLayout(ctx.width, this->scale_, this->imageScale_,
-                                 this->emoteScale_, this->badgeScale_,
-                                 this->centerBadges_, messageFlags);
+    MessageLayoutKey key{
+        .message = this->message_.get(),
+        .messageFlags = messageFlags,
+        .elementFlags = ctx.flags,
+        .selectedChannel = ctx.selectedChannel,
+        .width = ctx.width,
+        .generation = this->layoutState_,
+        .scale = this->scale_,
+        .imageScale = this->imageScale_,
+        .emoteScale = this->emoteScale_,
+        .badgeScale = this->badgeScale_,
+        .centerBadges = this->centerBadges_,
+        .hideModerated = getSettings()->hideModerated &&
+                         this->message_->flags.has(MessageFlag::Disabled),
+        .hideModerationActions =
+            this->message_->flags.has(MessageFlag::ModerationAction) &&
+            (getSettings()->hideModerationActions ||
+             getApp()->getStreamerMode()->shouldHideModActions()),
+        .hideBlockedTermAutomodMessages =
+            getSettings()->showBlockedTermAutomodMessages.getEnum() ==
+                ShowModerationState::Never &&
+            this->message_->flags.has(MessageFlag::AutoModBlockedTerm),
+        .hideSimilar = getSettings()->hideSimilar &&
+                       this->message_->flags.has(MessageFlag::Similar),
+        .hideRestrictedUsers =
+            this->message_->flags.has(MessageFlag::RestrictedMessage) &&
+            getApp()->getStreamerMode()->shouldHideRestrictedUsers(),
+        .regularText = ctx.messageColors.regularText.rgba(),
+        .systemText = ctx.messageColors.systemText.rgba(),
+        .linkText = ctx.messageColors.linkText.rgba(),
+    };
+
+    auto &cache = MessageLayoutCache::instance();
+    auto container = cache.find(key);
+    if (container == nullptr)
+    {
+        container = this->layoutContainer(key, ctx);
+        cache.insert(key, container);
+    }
+    this->container_ = std::move(container);
 
-    for (const auto &element : this->message_->elements)
+    if (this->height_ != this->container_->getHeight())
     {
-        if (hideModerated && this->message_->flags.has(MessageFlag::Disabled))
-        {
-            continue;
-        }
+        this->deleteBuffer();
+    }
+    this->height_ = this->container_->getHeight();
 
-        if (hideBlockedTermAutomodMessages &&
-            this->message_->flags.has(MessageFlag::AutoModBlockedTerm))
-        {
-            // NOTE: This hides the message but it will make the message re-appear if moderation message hiding is no longer active, and the layout is re-laid-out.
-            // This is only the case for the moderation messages that don't get filtered during creation.
-            // We should decide which is the correct method & apply that everywhere
-            continue;
-        }
+    // collapsed state
+    this->flags.unset(MessageLayoutFlag::Collapsed);
+    if (this->container_->isCollapsed())
+    {
+        this->flags.set(MessageLayoutFlag::Collapsed);
+    }
+}
 
-        if (this->message_->flags.has(MessageFlag::RestrictedMessage))
-        {
-            if (getApp()->getStreamerMode()->shouldHideRestrictedUsers())
-            {
-                // Message is being hidden because the source is a
-                // restricted user
-                continue;
-            }
-        }
+std::shared_ptr<const MessageLayoutContainer> MessageLayout::layoutContainer(
+    const MessageLayoutKey &key, const MessageLayoutContext &ctx)
+{
+#ifdef FOURTF
+    this->layoutCount_++;
+#endif
 
-        if (this->message_->flags.has(MessageFlag::ModerationAction))
-        {
-            if (hideModerationActions ||
-                getApp()->getStreamerMode()->shouldHideModActions())
-            {
-                // Message is being hidden because we consider the message
-                // a moderation action (something a streamer is unlikely to
-                // want to share if they briefly show their chat on stream)
-                continue;
-            }
-        }
+    // Containers can be shared, so a new one is laid out every time
+    auto container = std::make_shared<MessageLayoutContainer>();
+    container->beginLayout(ctx.width, this->scale_, this->imageScale_,
+                           this->emoteScale_, this->badgeScale_,
+                           this->centerBadges_, key.messageFlags);
+
+    // NOTE: Hiding blocked term AutoMod messages makes them re-appear if
+    // moderation message hiding is no longer active, and the layout is
+    // re-laid-out. This is only the case for the moderation messages that
+    // don't get filtered during creation. We should decide which is the
+    // correct method & apply that everywhere.
+    //
+    // Restricted users are hidden in streamer mode, moderation actions are
+    // something a streamer is unlikely to want to share if they briefly show
+    // their chat on stream.
+    bool hideMessage = key.hideModerated || key.hideModerationActions ||
+                       key.hideBlockedTermAutomodMessages || key.hideSimilar ||
+                       key.hideRestrictedUsers;
+    bool hideReplies = !ctx.flags.has(MessageElementFlag::RepliedMessage);
 
-        if (hideSimilar && this->message_->flags.has(MessageFlag::Similar))
+    for (const auto &element : this->message_->elements)
+    {
+        if (hideMessage)
         {
-            continue;
+            break;
         }
 
         if (hideReplies &&
@@ -222,23 +268,11 @@ void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
             continue;
         }
 
-        element->addToContainer(this->container_, ctx);
-    }
-
-    if (this->height_ != this->container_.getHeight())
-    {
-        this->deleteBuffer();
+        element->addToContainer(*container, ctx);
     }
 
-    this->container_.endLayout();
-    this->height_ = this->container_.getHeight();
-
-    // collapsed state
-    this->flags.unset(MessageLayoutFlag::Collapsed);
-    if (this->container_.isCollapsed())
-    {
-        this->flags.set(MessageLayoutFlag::Collapsed);
-    }
+    container->endLayout();
+    return container;
 }
 
 // Painting
@@ -246,25 +280,41 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
 {
     MessagePaintResult result;
 
+    // Timestamps are only taken while profiling
+    auto now = [&ctx] {
+        return ctx.profile ? std::chrono::steady_clock::now()
+                           : std::chrono::steady_clock::time_point{};
+    };
+
     QPixmap *pixmap = this->ensureBuffer(ctx.painter, ctx.canvasWidth,
                                          ctx.messageColors.hasTransparency);
 
     if (!this->bufferValid_)
     {
+        auto start = now();
         if (ctx.messageColors.hasTransparency)
         {
             pixmap->fill(Qt::transparent);
         }
         this->updateBuffer(pixmap, ctx);
+        result.renderedBuffer = true;
+        result.bufferTime = now() - start;
     }
 
+    auto blitStart = now();
+
     // draw on buffer
     ctx.painter.drawPixmap(QPoint{0, ctx.y}, *pixmap);
 
+    auto emoteStart = now();
+    result.blitTime = emoteStart - blitStart;
+
     // draw gif emotes
-    result.hasAnimatedElements = this->container_.paintAnimatedElements(
+    result.hasAnimatedElements = this->container_->paintAnimatedElements(
         ctx.painter, ctx.y, ctx.isCollapsed);
 
+    result.emoteTime = now() - emoteStart;
+
     // draw disabled
     if (this->message_->flags.has(MessageFlag::Disabled))
     {
@@ -309,8 +359,10 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
     // draw selection
     if (!ctx.selection.isEmpty())
     {
-        this->container_.paintSelection(ctx.painter, ctx.messageIndex,
+        auto start = now();
+        this->container_->paintSelection(ctx.painter, ctx.messageIndex,
                                         ctx.selection, ctx.y);
+        result.selectionTime = now() - start;
     }
 
     // draw message seperation line
@@ -320,7 +372,7 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
             QRectF{
                 0.0,
                 static_cast<qreal>(ctx.y),
-                this->container_.getWidth() + 64,
+                this->container_->getWidth() + 64,
                 1.0,
             },
             ctx.messageColors.messageSeperator);
@@ -346,7 +398,7 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
         ctx.painter.fillRect(
             QRectF{
                 0,
-                ctx.y + this->container_.getHeight() - 1,
+                ctx.y + this->container_->getHeight() - 1,
                 static_cast<qreal>(pixmap->width()),
                 1,
             },
@@ -368,7 +420,7 @@ QPixmap *MessageLayout::ensureBuffer(QPainter &painter, qreal width, bool clear)
     // Create new buffer
     this->buffer_ = std::make_unique<QPixmap>(
         static_cast<int>(width * painter.device()->devicePixelRatioF()),
-        static_cast<int>(this->container_.getHeight() *
+        static_cast<int>(this->container_->getHeight() *
                          painter.device()->devicePixelRatioF()));
     this->buffer_->setDevicePixelRatio(painter.device()->devicePixelRatioF());
 
@@ -517,7 +569,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
     painter.fillRect(buffer->rect(), backgroundColor);
 
     // draw message
-    this->container_.paintElements(painter, ctx);
+    this->container_->paintElements(painter, ctx);
 
 #ifdef FOURTF
     // debug
@@ -528,7 +580,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer,
     QTextOption option;
     option.setAlignment(Qt::AlignRight | Qt::AlignTop);
 
-    painter.drawText(QRectF(1, 1, this->container_.getWidth() - 3, 1000),
+    painter.drawText(QRectF(1, 1, this->container_->getWidth() - 3, 1000),
                      QString::number(this->layoutCount_) + ", " +
                          QString::number(++this->bufferUpdatedCount_),
                      option);
@@ -553,10 +605,13 @@ void MessageLayout::deleteBuffer()
 void MessageLayout::deleteCache()
 {
     this->deleteBuffer();
+    // Other layouts might still use the container, it's freed once the last
+    // one lets go of it.
+    this->container_ = emptyContainer();
 
-#ifdef XD
-    this->container_.clear();
-#endif
+    // The height is kept for scrolling, the elements are recreated once the
+    // message is laid out again.
+    this->flags.set(MessageLayoutFlag::RequiresLayout);
 }
 
 // Elements
@@ -568,7 +623,7 @@ void MessageLayout::deleteCache()
 const MessageLayoutElement *MessageLayout::getElementAt(QPointF point) const
 {
     // go through all words and return the first one that contains the point.
-    return this->container_.getElementAt(point);
+    return this->container_->getElementAt(point);
 }
 
 std::pair<int, int> MessageLayout::getWordBounds(
@@ -578,7 +633,7 @@ std::pair<int, int> MessageLayout::getWordBounds(
     // elements in the container
     if (hoveredElement->getWordId() != -1)
     {
-        return this->container_.getWordBounds(hoveredElement);
+        return this->container_->getWordBounds(hoveredElement);
     }
 
     const auto wordStart = this->getSelectionIndex(relativePos) -
@@ -592,23 +647,23 @@ std::pair<int, int> MessageLayout::getWordBounds(
 
 size_t MessageLayout::getLastCharacterIndex() const
 {
-    return this->container_.getLastCharacterIndex();
+    return this->container_->getLastCharacterIndex();
 }
 
 size_t MessageLayout::getFirstMessageCharacterIndex() const
 {
-    return this->container_.getFirstMessageCharacterIndex();
+    return this->container_->getFirstMessageCharacterIndex();
 }
 
 size_t MessageLayout::getSelectionIndex(QPointF position) const
 {
-    return this->container_.getSelectionIndex(position);
+    return this->container_->getSelectionIndex(position);
 }
 
 void MessageLayout::addSelectionText(QString &str, uint32_t from, uint32_t to,
                                      CopyMode copymode)
 {
-    this->container_.addSelectionText(str, from, to, copymode);
+    this->container_->addSelectionText(str, from, to, copymode);
 }
 
 }  // namespace chatterino
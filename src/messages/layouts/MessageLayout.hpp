@@ -10,6 +10,7 @@
 
 #include <QPixmap>
 
+#include <chrono>
 #include <cinttypes>
 #include <memory>
 
@@ -23,6 +24,7 @@ struct MessageLayoutContainer;
 class MessageLayoutElement;
 struct MessagePaintContext;
 struct MessageLayoutContext;
+struct MessageLayoutKey;
 
 enum class MessageElementFlag : int64_t;
 using MessageElementFlags = FlagsEnum<MessageElementFlag>;
@@ -39,6 +41,16 @@ using MessageLayoutFlags = FlagsEnum<MessageLayoutFlag>;
 
 struct MessagePaintResult {
     bool hasAnimatedElements = false;
+    /// Whether the buffer had to be rendered before it was drawn
+    bool renderedBuffer = false;
+
+    // Only measured if MessagePaintContext::profile is set
+    std::chrono::nanoseconds bufferTime{};
+    /// Drawing the buffer
+    std::chrono::nanoseconds blitTime{};
+    /// Drawing the animated elements on top of the buffer
+    std::chrono::nanoseconds emoteTime{};
+    std::chrono::nanoseconds selectionTime{};
 };
 
 class MessageLayout
@@ -120,6 +132,8 @@ public:
 private:
     // methods
     void actuallyLayout(const MessageLayoutContext &ctx);
+    std::shared_ptr<const MessageLayoutContainer> layoutContainer(
+        const MessageLayoutKey &key, const MessageLayoutContext &ctx);
     void updateBuffer(QPixmap *buffer, const MessagePaintContext &ctx);
 
     // Create new buffer if required, returning the buffer
@@ -127,7 +141,9 @@ private:
 
     // variables
     const MessagePtr message_;
-    MessageLayoutContainer container_;
+    /// Shared with other layouts of this message that were laid out with the
+    /// same key (see MessageLayoutCache), so it must not be modified.
+    std::shared_ptr<const MessageLayoutContainer> container_;
     std::unique_ptr<QPixmap> buffer_;
     bool bufferValid_ = false;
 
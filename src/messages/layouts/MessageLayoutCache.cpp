@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/layouts/MessageLayoutCache.hpp"
+
+#include "messages/layouts/MessageLayoutContainer.hpp"
+#include "messages/MessageElement.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+
+namespace chatterino {
+
+size_t MessageLayoutKeyHash::operator()(const MessageLayoutKey &key) const
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, key.message);
+    boost::hash_combine(seed, key.messageFlags.value());
+    boost::hash_combine(seed, key.elementFlags.value());
+    boost::hash_combine(seed, key.selectedChannel);
+    boost::hash_combine(seed, key.width);
+    boost::hash_combine(seed, key.generation);
+    boost::hash_combine(seed, key.scale);
+    boost::hash_combine(seed, key.imageScale);
+    boost::hash_combine(seed, key.emoteScale);
+    boost::hash_combine(seed, key.badgeScale);
+    boost::hash_combine(seed, key.centerBadges);
+    boost::hash_combine(seed, key.hideModerated);
+    boost::hash_combine(seed, key.hideModerationActions);
+    boost::hash_combine(seed, key.hideBlockedTermAutomodMessages);
+    boost::hash_combine(seed, key.hideSimilar);
+    boost::hash_combine(seed, key.hideRestrictedUsers);
+    boost::hash_combine(seed, key.regularText);
+    boost::hash_combine(seed, key.systemText);
+    boost::hash_combine(seed, key.linkText);
+    return seed;
+}
+
+MessageLayoutCache &MessageLayoutCache::instance()
+{
+    static MessageLayoutCache cache;
+    return cache;
+}
+
+std::shared_ptr<const MessageLayoutContainer> MessageLayoutCache::find(
+    const MessageLayoutKey &key)
+{
+    auto it = this->containers_.find(key);
+    if (it == this->containers_.end())
+    {
+        return nullptr;
+    }
+
+    // A live container keeps its layouts' message alive, so the message
+    // pointer in the key can't have been reused yet.
+    auto container = it->second.lock();
+    if (container == nullptr)
+    {
+        this->containers_.erase(it);
+    }
+    return container;
+}
+
+void MessageLayoutCache::insert(
+    const MessageLayoutKey &key,
+    std::shared_ptr<const MessageLayoutContainer> container)
+{
+    this->containers_.insert_or_assign(key, std::move(container));
+
+    if (this->containers_.size() >= this->cleanupAt_)
+    {
+        this->removeExpired();
+        this->cleanupAt_ =
+            std::max(MIN_CLEANUP_SIZE, this->containers_.size() * 2);
+    }
+}
+
+size_t MessageLayoutCache::size() const
+{
+    return this->containers_.size();
+}
+
+void MessageLayoutCache::removeExpired()
+{
+    std::erase_if(this->containers_, [](const auto &entry) {
+        return entry.second.expired();
+    });
+}
+
+}  // namespace chatterino
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "common/FlagsEnum.hpp"
+#include "messages/MessageFlag.hpp"
+
+#include <QRgb>
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+namespace chatterino {
+
+struct Message;
+struct MessageLayoutContainer;
+class Channel;
+
+enum class MessageElementFlag : int64_t;
+using MessageElementFlags = FlagsEnum<MessageElementFlag>;
+
+/// Everything the elements of a laid out message depend on
+struct MessageLayoutKey {
+    const Message *message = nullptr;
+    /// Flags of the message, with `Collapsed` unset for expanded layouts
+    MessageFlags messageFlags;
+    MessageElementFlags elementFlags;
+    /// Only used for platform badges
+    const Channel *selectedChannel = nullptr;
+
+    int width = 0;
+    int generation = 0;
+    float scale = 1;
+    float imageScale = 1;
+    float emoteScale = 1;
+    float badgeScale = 1;
+    bool centerBadges = false;
+
+    // Settings that hide the whole message
+    bool hideModerated = false;
+    bool hideModerationActions = false;
+    bool hideBlockedTermAutomodMessages = false;
+    bool hideSimilar = false;
+    bool hideRestrictedUsers = false;
+
+    // Colors that are baked into text elements
+    QRgb regularText = 0;
+    QRgb systemText = 0;
+    QRgb linkText = 0;
+
+    bool operator==(const MessageLayoutKey &other) const = default;
+};
+
+struct MessageLayoutKeyHash {
+    size_t operator()(const MessageLayoutKey &key) const;
+};
+
+/// Laid out containers of messages, shared by all layouts of the same message
+/// with the same key (e.g. a split and its popout, or a split and the
+/// mentions).
+///
+/// The cache only holds weak references, a container is freed once the last
+/// layout using it is gone. Shared containers are never laid out again,
+/// layouts with a different key get a new container instead. This is only
+/// used from the GUI thread.
+class MessageLayoutCache
+{
+public:
+    static MessageLayoutCache &instance();
+
+    /// Returns the container laid out for `key` if a layout still uses it
+    std::shared_ptr<const MessageLayoutContainer> find(
+        const MessageLayoutKey &key);
+
+    void insert(const MessageLayoutKey &key,
+                std::shared_ptr<const MessageLayoutContainer> container);
+
+    /// The number of keys, including the ones whose container was freed
+    /// since the last cleanup
+    size_t size() const;
+
+private:
+    void removeExpired();
+
+    static constexpr size_t MIN_CLEANUP_SIZE = 1024;
+
+    std::unordered_map<MessageLayoutKey,
+                       std::weak_ptr<const MessageLayoutContainer>,
+                       MessageLayoutKeyHash>
+        containers_;
+    size_t cleanupAt_ = MIN_CLEANUP_SIZE;
+};
+
+}  // namespace chatterino
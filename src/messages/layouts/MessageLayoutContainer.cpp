@@ -13,6 +13,7 @@
 #include "singletons/Fonts.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
+#include "util/DebugCount.hpp"
 #include "util/Helpers.hpp"
 
 #include <QDebug>
@@ -39,6 +40,16 @@ int maxUncollapsedLines()
 
 namespace chatterino {
 
+MessageLayoutContainer::MessageLayoutContainer()
+{
+    DebugCount::increase(DebugObject::MessageLayoutContainer);
+}
+
+MessageLayoutContainer::~MessageLayoutContainer()
+{
+    DebugCount::decrease(DebugObject::MessageLayoutContainer);
+}
+
 void MessageLayoutContainer::beginLayout(qreal width, float scale,
                                          float imageScale, float emoteScale,
                                          float badgeScale, bool centerBadges,
@@ -34,7 +34,13 @@ struct Selection;
 struct MessagePaintContext;
 
 struct MessageLayoutContainer {
-    MessageLayoutContainer() = default;
+    MessageLayoutContainer();
+    ~MessageLayoutContainer();
+
+    MessageLayoutContainer(const MessageLayoutContainer &) = delete;
+    MessageLayoutContainer &operator=(const MessageLayoutContainer &) = delete;
+    MessageLayoutContainer(MessageLayoutContainer &&) = delete;
+    MessageLayoutContainer &operator=(MessageLayoutContainer &&) = delete;
 
     /**
      * Begin the layout process of this message
@@ -98,6 +98,9 @@ struct MessagePaintContext {
 
     bool isLastReadMessage{};
     bool isCollapsed{};
+
+    // whether the paint result should contain the time spent in each step
+    bool profile{};
 };
 
 struct MessageLayoutContext {
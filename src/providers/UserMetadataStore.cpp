@@ -0,0 +1,438 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/UserMetadataStore.hpp"
+
+#include "common/QLogging.hpp"
+#include "util/Backup.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QDataStream>
+#include <QFile>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+using namespace chatterino;
+
+// "CUMD" - Chatterino User MetaData
+constexpr quint32 MAGIC = 0x43554D44;
+
+void prepare(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_6_0);
+}
+
+bool isFresh(qint64 updatedAt, UserMetadataStore::Field field, qint64 now)
+{
+    return updatedAt != 0 &&
+           now - updatedAt < UserMetadataStore::ttl(field).count();
+}
+
+}  // namespace
+
+namespace chatterino {
+
+UserMetadataStore::UserMetadataStore(Clock clock)
+    : clock_(clock != nullptr ? clock : &QDateTime::currentMSecsSinceEpoch)
+{
+}
+
+UserMetadataStore::UserMetadataStore(QString path, Clock clock)
+    : UserMetadataStore(clock)
+{
+    this->path_ = std::move(path);
+
+    QObject::connect(&this->saveTimer_, &QTimer::timeout, [this] {
+        this->save();
+    });
+    this->saveTimer_.start(SAVE_INTERVAL);
+
+    auto *threadPool = QThreadPool::globalInstance();
+    if (threadPool == nullptr)
+    {
+        return;
+    }
+
+    threadPool->start([this, path = this->path_,
+                       alive = std::weak_ptr<bool>(this->lifetime_)] {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return;
+        }
+
+        std::optional<Users> users;
+        auto size = file.size();
+        if (auto *mapped = file.map(0, size))
+        {
+            users = deserialize(QByteArrayView(mapped, size));
+            file.unmap(mapped);
+        }
+        else
+        {
+            users = deserialize(file.readAll());
+        }
+
+        if (!users)
+        {
+            qCWarning(chatterinoCache)
+                << "Ignoring invalid user metadata" << path;
+            return;
+        }
+        qCDebug(chatterinoCache)
+            << "Loaded metadata of" << users->size() << "users from" << path;
+
+        // The store is destroyed in the GUI thread, so it can't go away
+        // while this runs.
+        postToThread([this, alive, users = std::move(*users)] {
+            if (!alive.lock())
+            {
+                return;  // the store was destroyed in the meantime
+            }
+            this->mergeUsers(users);
+        });
+    });
+}
+
+std::chrono::seconds UserMetadataStore::ttl(Field field)
+{
+    using namespace std::chrono_literals;
+
+    switch (field)
+    {
+        case Field::Login:
+        case Field::DisplayName:
+            // Names can only be changed every 60 days
+            return std::chrono::days(7);
+        case Field::ProfilePictureUrl:
+            return std::chrono::days(3);
+        case Field::Color:
+            // Only a fallback until the user chats again
+            return std::chrono::days(7);
+        case Field::Pronouns:
+            return std::chrono::days(1);
+    }
+    return 0s;
+}
+
+std::optional<QString> UserMetadataStore::get(const QString &userID,
+                                              Field field) const
+{
+    std::shared_lock lock(this->mutex_);
+    const auto *value = this->find(userID, field);
+    if (value == nullptr)
+    {
+        return std::nullopt;
+    }
+    return value->value;
+}
+
+std::optional<QString> UserMetadataStore::getByLogin(const QString &login,
+                                                     Field field) const
+{
+    std::shared_lock lock(this->mutex_);
+    auto it = this->logins_.find(login.toLower());
+    if (it == this->logins_.end())
+    {
+        return std::nullopt;
+    }
+
+    const auto *value = this->find(*it, field);
+    if (value == nullptr)
+    {
+        return std::nullopt;
+    }
+    return value->value;
+}
+
+void UserMetadataStore::set(const QString &userID, const QString &login,
+                            Field field, const QString &value,
+                            const QDateTime &updatedAt)
+{
+    if (userID.isEmpty())
+    {
+        return;
+    }
+
+    auto time =
+        updatedAt.isValid() ? updatedAt.toSecsSinceEpoch() : this->now();
+    std::unique_lock lock(this->mutex_);
+    if (!login.isEmpty() && field != Field::Login)
+    {
+        this->setValue(userID, Field::Login, {login.toLower(), time});
+    }
+    this->setValue(userID, field,
+                   {
+                       field == Field::Login ? value.toLower() : value,
+                       time,
+                   });
+}
+
+void UserMetadataStore::save()
+{
+    this->prune();
+
+    if (this->path_.isEmpty())
+    {
+        return;
+    }
+
+    auto now = this->now();
+    Users users;
+    {
+        std::shared_lock lock(this->mutex_);
+        // Implicitly shared, this doesn't copy the users
+        users = this->users_;
+    }
+
+    backup::saveAsync(this->path_, [users = std::move(users), now] {
+        return serialize(users, now);
+    });
+}
+
+void UserMetadataStore::prune()
+{
+    auto now = this->now();
+
+    std::unique_lock lock(this->mutex_);
+
+    // The time the user was last updated at, for the ones that are kept
+    std::vector<std::pair<qint64, QString>> kept;
+    kept.reserve(static_cast<size_t>(this->users_.size()));
+    for (auto it = this->users_.begin(); it != this->users_.end();)
+    {
+        qint64 lastUpdate = 0;
+        bool fresh = false;
+        for (size_t i = 0; i < FIELD_COUNT; i++)
+        {
+            const auto &value = it.value()[i];
+            fresh |= isFresh(value.updatedAt, static_cast<Field>(i), now);
+            lastUpdate = std::max(lastUpdate, value.updatedAt);
+        }
+
+        if (fresh)
+        {
+            kept.emplace_back(lastUpdate, it.key());
+            it++;
+        }
+        else
+        {
+            it = this->erase(it);
+        }
+    }
+
+    if (kept.size() <= MAX_USERS)
+    {
+        return;
+    }
+
+    // Moves the users that were updated the longest time ago to the front
+    const auto excess = kept.size() - MAX_USERS;
+    std::ranges::nth_element(
+        kept, kept.begin() + static_cast<std::ptrdiff_t>(excess));
+    for (size_t i = 0; i < excess; i++)
+    {
+        auto it = this->users_.find(kept[i].second);
+        if (it != this->users_.end())
+        {
+            this->erase(it);
+        }
+    }
+}
+
+QByteArray UserMetadataStore::serialize() const
+{
+    std::shared_lock lock(this->mutex_);
+    return serialize(this->users_, this->now());
+}
+
+bool UserMetadataStore::merge(QByteArrayView data)
+{
+    auto users = deserialize(data);
+    if (!users)
+    {
+        return false;
+    }
+    this->mergeUsers(*users);
+    return true;
+}
+
+size_t UserMetadataStore::size() const
+{
+    std::shared_lock lock(this->mutex_);
+    return static_cast<size_t>(this->users_.size());
+}
+
+qint64 UserMetadataStore::now() const
+{
+    return this->clock_() / 1000;
+}
+
+QByteArray UserMetadataStore::serialize(const Users &users, qint64 now)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    prepare(stream);
+
+    std::vector<std::pair<quint8, const Value *>> fresh;
+    fresh.reserve(FIELD_COUNT);
+
+    // The count is only known after skipping expired users
+    quint32 count = 0;
+    stream << MAGIC << VERSION << count;
+    for (auto it = users.begin(); it != users.end(); it++)
+    {
+        fresh.clear();
+        for (size_t i = 0; i < FIELD_COUNT; i++)
+        {
+            const auto &value = it.value()[i];
+            if (isFresh(value.updatedAt, static_cast<Field>(i), now))
+            {
+                fresh.emplace_back(static_cast<quint8>(i), &value);
+            }
+        }
+        if (fresh.empty())
+        {
+            continue;
+        }
+
+        stream << it.key() << static_cast<quint8>(fresh.size());
+        for (const auto &[field, value] : fresh)
+        {
+            stream << field << value->value << value->updatedAt;
+        }
+        count++;
+    }
+
+    stream.device()->seek(2 * sizeof(quint32));
+    stream << count;
+
+    return data;
+}
+
+std::optional<UserMetadataStore::Users> UserMetadataStore::deserialize(
+    QByteArrayView data)
+{
+    // The stream only reads from `data`, it doesn't need a copy
+    auto raw = QByteArray::fromRawData(data.data(), data.size());
+    QDataStream stream(raw);
+    prepare(stream);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    stream >> magic >> version >> count;
+    // Every user takes more than one byte, so this also rejects counts from
+    // corrupted files before reserving space for them.
+    if (stream.status() != QDataStream::Ok || magic != MAGIC ||
+        version != VERSION || count > static_cast<quint32>(data.size()))
+    {
+        return std::nullopt;
+    }
+
+    Users users;
+    users.reserve(count);
+    for (quint32 i = 0; i < count; i++)
+    {
+        QString id;
+        quint8 fieldCount = 0;
+        stream >> id >> fieldCount;
+
+        Fields fields;
+        for (quint8 j = 0; j < fieldCount; j++)
+        {
+            quint8 field = 0;
+            Value value;
+            stream >> field >> value.value >> value.updatedAt;
+            if (field < FIELD_COUNT)
+            {
+                fields[field] = std::move(value);
+            }
+        }
+        if (stream.status() != QDataStream::Ok)
+        {
+            return std::nullopt;
+        }
+
+        users.insert(id, std::move(fields));
+    }
+
+    return users;
+}
+
+void UserMetadataStore::mergeUsers(const Users &users)
+{
+    std::unique_lock lock(this->mutex_);
+    for (auto it = users.begin(); it != users.end(); it++)
+    {
+        for (size_t i = 0; i < FIELD_COUNT; i++)
+        {
+            const auto &value = it.value()[i];
+            if (value.updatedAt != 0)
+            {
+                this->setValue(it.key(), static_cast<Field>(i), value);
+            }
+        }
+    }
+}
+
+const UserMetadataStore::Value *UserMetadataStore::find(const QString &userID,
+                                                        Field field) const
+{
+    auto it = this->users_.find(userID);
+    if (it == this->users_.end())
+    {
+        return nullptr;
+    }
+
+    const auto &value = (*it)[static_cast<size_t>(field)];
+    if (!isFresh(value.updatedAt, field, this->now()))
+    {
+        return nullptr;
+    }
+    return &value;
+}
+
+UserMetadataStore::Users::iterator UserMetadataStore::erase(Users::iterator it)
+{
+    const auto &login = it.value()[static_cast<size_t>(Field::Login)].value;
+    auto loginIt = this->logins_.find(login);
+    if (loginIt != this->logins_.end() && *loginIt == it.key())
+    {
+        this->logins_.erase(loginIt);
+    }
+    return this->users_.erase(it);
+}
+
+void UserMetadataStore::setValue(const QString &userID, Field field,
+                                 Value value)
+{
+    auto &current = this->users_[userID][static_cast<size_t>(field)];
+    if (value.updatedAt < current.updatedAt)
+    {
+        return;  // we already know something newer
+    }
+
+    if (field == Field::Login && current.value != value.value)
+    {
+        auto old = this->logins_.find(current.value);
+        if (old != this->logins_.end() && *old == userID)
+        {
+            this->logins_.erase(old);
+        }
+        if (!value.value.isEmpty())
+        {
+            this->logins_.insert(value.value, userID);
+        }
+    }
+    current = std::move(value);
+}
+
+}  // namespace chatterino
@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <magic_enum/magic_enum.hpp>
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <QTimer>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+
+namespace chatterino {
+
+/// Caches metadata of users (names, profile pictures, colors, pronouns)
+/// across restarts.
+///
+/// Users are keyed by their ID, with a secondary index on their login. Each
+/// field has its own TTL (see `ttl()`), expired fields are treated as
+/// missing and aren't saved again.
+///
+/// The store is loaded from the cache directory in the background and saved
+/// periodically and when the app quits. All functions are thread safe.
+class UserMetadataStore
+{
+public:
+    enum class Field : uint8_t {
+        Login,
+        DisplayName,
+        ProfilePictureUrl,
+        Color,
+        Pronouns,
+    };
+
+    /// Increase this when changing the format
+    static constexpr quint32 VERSION = 1;
+
+    static constexpr std::chrono::minutes SAVE_INTERVAL{5};
+
+    /// Maximum number of users kept after pruning
+    static constexpr size_t MAX_USERS = 100'000;
+
+    /// Returns the current time in milliseconds since the epoch
+    using Clock = qint64 (*)();
+
+    /// Creates an empty store that's not backed by a file. Uses the wall
+    /// clock if `clock` is null.
+    explicit UserMetadataStore(Clock clock = nullptr);
+    /// Creates a store that's loaded from and saved to `path`
+    explicit UserMetadataStore(QString path, Clock clock = nullptr);
+
+    UserMetadataStore(const UserMetadataStore &) = delete;
+    UserMetadataStore(UserMetadataStore &&) = delete;
+    UserMetadataStore &operator=(const UserMetadataStore &) = delete;
+    UserMetadataStore &operator=(UserMetadataStore &&) = delete;
+
+    /// How long a value of `field` is used after it was set
+    static std::chrono::seconds ttl(Field field);
+
+    /// Returns the value of `field` for the user with the ID `userID` if it
+    /// was set and hasn't expired yet
+    std::optional<QString> get(const QString &userID, Field field) const;
+
+    /// Like `get()`, but looks the user up by their login
+    std::optional<QString> getByLogin(const QString &login, Field field) const;
+
+    /// Sets `field` of the user with the ID `userID`. If `login` isn't empty,
+    /// the user's login is updated as well. An invalid `updatedAt` means
+    /// now, according to the store's clock.
+    void set(const QString &userID, const QString &login, Field field,
+             const QString &value, const QDateTime &updatedAt = {});
+
+    /// Prunes the store and writes it to its file in the background
+    void save();
+
+    /// Drops users whose fields all expired. If more than MAX_USERS are
+    /// left, the ones that were updated the longest time ago are dropped.
+    void prune();
+
+    /// Serializes all fields that haven't expired
+    QByteArray serialize() const;
+
+    /// Merges the users from `data` into the store. Fields that were set more
+    /// recently are kept. Returns false if `data` isn't a valid store of this
+    /// version.
+    bool merge(QByteArrayView data);
+
+    /// The number of users in the store
+    size_t size() const;
+
+private:
+    struct Value {
+        QString value;
+        /// Seconds since epoch, 0 if the value was never set
+        qint64 updatedAt = 0;
+    };
+    static constexpr size_t FIELD_COUNT = magic_enum::enum_count<Field>();
+    using Fields = std::array<Value, FIELD_COUNT>;
+    /// User ID -> fields
+    using Users = QHash<QString, Fields>;
+
+    /// Seconds since epoch, according to `clock_`
+    qint64 now() const;
+
+    static QByteArray serialize(const Users &users, qint64 now);
+    static std::optional<Users> deserialize(QByteArrayView data);
+    void mergeUsers(const Users &users);
+
+    /// Needs at least a shared lock
+    const Value *find(const QString &userID, Field field) const;
+    /// Needs a unique lock
+    void setValue(const QString &userID, Field field, Value value);
+    /// Removes the user `it` points to. Needs a unique lock.
+    Users::iterator erase(Users::iterator it);
+
+    Clock clock_;
+    QString path_;
+    QTimer saveTimer_;
+    /// Only referenced weakly by the loader, to tell if the store is alive
+    std::shared_ptr<bool> lifetime_ = std::make_shared<bool>(true);
+
+    mutable std::shared_mutex mutex_;
+    Users users_;
+    /// Lowercase login -> user ID
+    QHash<QString, QString> logins_;
+};
+
+}  // namespace chatterino
@@ -9,6 +9,7 @@
 #include "common/Outcome.hpp"
 #include "common/QLogging.hpp"
 #include "messages/Emote.hpp"
+#include "messages/EmoteSnapshot.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
 #include "messages/MessageBuilder.hpp"
@@ -238,36 +239,40 @@ void BttvEmotes::loadEmotes()
         return;
     }
 
-    readProviderEmotesCache("global", "betterttv", [this](const auto &jsonDoc) {
-        auto emotes = this->global_.get();
-        auto pair = parseGlobalEmotes(jsonDoc.array(), *emotes);
-        if (pair.first)
+    // Revalidate once the snapshot is in, so it can't replace newer emotes
+    emotesnapshot::read("global", "betterttv", [this](auto snapshot) {
+        if (snapshot)
         {
-            this->setEmotes(std::make_shared<EmoteMap>(std::move(pair.second)));
+            this->setEmotes(std::make_shared<EmoteMap>(std::move(*snapshot)));
         }
-    });
 
-    NetworkRequest(QString(globalEmoteApiUrl))
-        .timeout(30000)
-        .onSuccess([this](auto result) {
-            writeProviderEmotesCache("global", "betterttv", result.getData());
-            auto emotes = this->global_.get();
-            auto pair = parseGlobalEmotes(result.parseJsonArray(), *emotes);
-            if (pair.first)
-            {
-                this->setEmotes(
-                    std::make_shared<EmoteMap>(std::move(pair.second)));
-            }
-        })
-        .onError([](auto result) {
-            qCWarning(chatterinoBttv) << "Failed to fetch global BTTV emotes. "
-                                      << result.formatError();
-        })
-        .execute();
+        NetworkRequest(QString(globalEmoteApiUrl))
+            .timeout(30000)
+            .onSuccess([this](auto result) {
+                auto emotes = this->global_.get();
+                auto pair = parseGlobalEmotes(result.parseJsonArray(), *emotes);
+                if (pair.first)
+                {
+                    emotesnapshot::write("global", "betterttv", pair.second);
+                    this->setEmotes(
+                        std::make_shared<EmoteMap>(std::move(pair.second)));
+                }
+            })
+            .onError([](auto result) {
+                qCWarning(chatterinoBttv)
+                    << "Failed to fetch global BTTV emotes. "
+                    << result.formatError();
+            })
+            .execute();
+    });
 }
 
 void BttvEmotes::setEmotes(std::shared_ptr<const EmoteMap> emotes)
 {
+    if (sameEmotes(*this->global_.get(), *emotes))
+    {
+        return;
+    }
     this->global_.set(std::move(emotes));
 }
 
@@ -284,7 +289,7 @@ void BttvEmotes::loadChannel(std::weak_ptr<Channel> channel,
             auto emotes =
                 parseChannelEmotes(result.parseJson(), channelDisplayName);
             bool hasEmotes = !emotes.empty();
-            writeProviderEmotesCache(channelId, "betterttv", result.getData());
+            emotesnapshot::write(channelId, "betterttv", emotes);
             callback(std::move(emotes));
 
             if (auto shared = channel.lock(); manualRefresh)
@@ -158,17 +158,28 @@ QString getToneNames(const QString &tones)
 
 namespace chatterino {
 
-void Emojis::load()
+void Emojis::loadData()
 {
-    if (this->loaded_)
+    if (this->dataLoaded_)
     {
         return;
     }
-    this->loaded_ = true;
+    this->dataLoaded_ = true;
 
     this->loadEmojis();
 
     this->sortEmojis();
+}
+
+void Emojis::load()
+{
+    if (this->loaded_)
+    {
+        return;
+    }
+    this->loaded_ = true;
+
+    this->loadData();
 
     this->loadEmojiSet();
 }
@@ -64,6 +64,11 @@ public:
 class Emojis : public IEmojis
 {
 public:
+    /// Parses the bundled emoji data. This doesn't need the GUI thread, so it
+    /// can run on a worker before load(), but not at the same time.
+    void loadData();
+    /// Loads the emoji data if that didn't happen yet and creates the emotes
+    /// of the selected emoji set
     void load();
     std::vector<std::variant<EmotePtr, QStringView>> parse(
         QStringView text) const override;
@@ -91,6 +96,7 @@ private:
     // possible emojis
     QMap<QChar, QVector<std::shared_ptr<EmojiData>>> emojiFirstByte_;
 
+    bool dataLoaded_ = false;
     bool loaded_ = false;
 };
 
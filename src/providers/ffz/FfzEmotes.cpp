@@ -8,6 +8,7 @@
 #include "common/network/NetworkResult.hpp"
 #include "common/QLogging.hpp"
 #include "messages/Emote.hpp"
+#include "messages/EmoteSnapshot.hpp"
 #include "messages/Image.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/ffz/FfzUtil.hpp"
@@ -242,31 +243,38 @@ void FfzEmotes::loadEmotes()
         return;
     }
 
-    readProviderEmotesCache("global", "frankerfacez", [this](auto jsonDoc) {
-        auto parsedSet = parseGlobalEmotes(jsonDoc.object());
-        this->setEmotes(std::make_shared<EmoteMap>(std::move(parsedSet)));
-    });
+    // Revalidate once the snapshot is in, so it can't replace newer emotes
+    emotesnapshot::read("global", "frankerfacez", [this](auto snapshot) {
+        if (snapshot)
+        {
+            this->setEmotes(std::make_shared<EmoteMap>(std::move(*snapshot)));
+        }
 
-    QString url("https://api.frankerfacez.com/v1/set/global");
+        QString url("https://api.frankerfacez.com/v1/set/global");
 
-    NetworkRequest(url)
-        .timeout(30000)
-        .onSuccess([this](auto result) {
-            writeProviderEmotesCache("global", "frankerfacez",
-                                     result.getData());
-            auto parsedSet = parseGlobalEmotes(result.parseJson());
-            this->setEmotes(std::make_shared<EmoteMap>(std::move(parsedSet)));
-        })
-        .onError([](auto result) {
-            qCWarning(chatterinoFfzemotes)
-                << "Failed to fetch global FFZ emotes. "
-                << result.formatError();
-        })
-        .execute();
+        NetworkRequest(url)
+            .timeout(30000)
+            .onSuccess([this](auto result) {
+                auto parsedSet = parseGlobalEmotes(result.parseJson());
+                emotesnapshot::write("global", "frankerfacez", parsedSet);
+                this->setEmotes(
+                    std::make_shared<EmoteMap>(std::move(parsedSet)));
+            })
+            .onError([](auto result) {
+                qCWarning(chatterinoFfzemotes)
+                    << "Failed to fetch global FFZ emotes. "
+                    << result.formatError();
+            })
+            .execute();
+    });
 }
 
 void FfzEmotes::setEmotes(std::shared_ptr<const EmoteMap> emotes)
 {
+    if (sameEmotes(*this->global_.get(), *emotes))
+    {
+        return;
+    }
     this->global_.set(std::move(emotes));
 }
 
@@ -288,11 +296,10 @@ void FfzEmotes::loadChannel(
                     vipBadgeCallback = std::move(vipBadgeCallback),
                     channelBadgesCallback = std::move(channelBadgesCallback),
                     channel, channelID, manualRefresh](const auto &result) {
-            writeProviderEmotesCache(channelID, "frankerfacez",
-                                     result.getData());
             const auto json = result.parseJson();
 
             auto emoteMap = parseChannelEmotes(json);
+            emotesnapshot::write(channelID, "frankerfacez", emoteMap);
             auto modBadge = parseAuthorityBadge(
                 json["room"]["mod_urls"].toObject(), "Moderator");
             auto vipBadge = parseAuthorityBadge(
@@ -64,7 +64,7 @@ void KickAccountData::save() const
     QStringSetting::set(basePath + "/refreshToken", this->refreshToken);
     QStringSetting::set(basePath + "/expiresAt",
                         this->expiresAt.toString(Qt::ISODate));
-    std::ignore = getSettings()->requestSave();
+    getSettings()->queueSave();
 }
 
 KickAccount::KickAccount(const KickAccountData &args)
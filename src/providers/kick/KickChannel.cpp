@@ -6,6 +6,7 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/emotes/EmoteController.hpp"
 #include "messages/Emote.hpp"
+#include "messages/EmoteSnapshot.hpp"
 #include "messages/Link.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
@@ -113,34 +114,50 @@ std::pair<std::shared_ptr<MessageThread>, MessagePtr>
 
 void KickChannel::reloadSeventvEmotes(bool manualRefresh)
 {
-    bool cacheHit = readProviderEmotesCache(
+    // Revalidate once the snapshot is in, so it can't replace newer emotes
+    emotesnapshot::read(
         u"kick." % QString::number(this->userID()), "seventv",
-        [this](const auto &jsonDoc) {
-            const auto json = jsonDoc.object();
-            const auto emoteSet = json["emote_set"].toObject();
-            const auto parsedEmotes = emoteSet["emotes"].toArray();
-            auto emoteMap = seventv::detail::parseEmotes(
-                parsedEmotes, SeventvEmoteSetKind::Channel);
-            this->seventvEmotes_.set(
-                std::make_shared<const EmoteMap>(emoteMap));
-        });
-
-    SeventvEmotes::loadKickChannelEmotes(
-        this->weakFromThis(), this->userID(),
-        [weak = this->weakFromThis()](EmoteMap &&emotes,
-                                      const SeventvEmotes::ChannelInfo &info) {
+        [weak = this->weakFromThis(), manualRefresh](auto snapshot) {
             auto self = weak.lock();
             if (!self)
             {
                 return;
             }
 
-            self->seventvEmotes_.set(
-                std::make_shared<const EmoteMap>(std::move(emotes)));
-            self->seventvKickConnectionIndex_ = info.twitchConnectionIndex;
-            self->updateSeventvData(info.userID, info.emoteSetID);
-        },
-        manualRefresh, cacheHit);
+            bool cacheHit = snapshot.has_value();
+            if (snapshot)
+            {
+                self->setSeventvEmotes(
+                    std::make_shared<const EmoteMap>(std::move(*snapshot)));
+            }
+
+            SeventvEmotes::loadKickChannelEmotes(
+                weak, self->userID(),
+                [weak](EmoteMap &&emotes,
+                       const SeventvEmotes::ChannelInfo &info) {
+                    auto self = weak.lock();
+                    if (!self)
+                    {
+                        return;
+                    }
+
+                    self->setSeventvEmotes(
+                        std::make_shared<const EmoteMap>(std::move(emotes)));
+                    self->seventvKickConnectionIndex_ =
+                        info.twitchConnectionIndex;
+                    self->updateSeventvData(info.userID, info.emoteSetID);
+                },
+                manualRefresh, cacheHit);
+        });
+}
+
+void KickChannel::setSeventvEmotes(std::shared_ptr<const EmoteMap> &&map)
+{
+    if (sameEmotes(*this->seventvEmotes_.get(), *map))
+    {
+        return;
+    }
+    this->seventvEmotes_.set(std::move(map));
 }
 
 std::shared_ptr<const EmoteMap> KickChannel::seventvEmotes() const
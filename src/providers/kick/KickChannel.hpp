@@ -167,6 +167,8 @@ private:
 
     void addLoginMessage();
 
+    /// Replaces the 7TV emotes unless they're the same
+    void setSeventvEmotes(std::shared_ptr<const EmoteMap> &&map);
     void updateSeventvData(const QString &newUserID,
                            const QString &newEmoteSetID);
     void addOrReplaceSeventvAddRemove(bool isEmoteAdd, const QString &actor,
@@ -8,6 +8,7 @@
 #include "providers/kick/KickApi.hpp"
 #include "providers/kick/KickEmotes.hpp"
 #include "providers/kick/KickMessageBuilder.hpp"
+#include "providers/kick/KickPusherEvent.hpp"
 #include "providers/seventv/eventapi/Dispatch.hpp"
 #include "providers/seventv/SeventvEventAPI.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
@@ -23,24 +24,6 @@ namespace {
 
 using namespace Qt::Literals;
 
-// fallback case
-template <typename T>
-T stringSwitch(std::string_view /* provided */)
-{
-    return {};
-}
-
-template <typename T>
-T stringSwitch(std::string_view provided, std::string_view match, T &&value,
-               auto &&...rest)
-{
-    if (provided == match)
-    {
-        return std::forward<T>(value);
-    }
-    return stringSwitch<T>(provided, std::forward<decltype(rest)>(rest)...);
-}
-
 }  // namespace
 
 namespace chatterino {
@@ -182,42 +165,64 @@ std::shared_ptr<Channel> KickChatServer::getOrCreate(
     return chan;
 }
 
-bool KickChatServer::onAppEvent(uint64_t roomID, uint64_t channelID,
-                                std::string_view event, BoostJsonObject data)
+bool KickChatServer::onAppEvent(const KickPusherEvent &event)
 {
+    using Type = KickPusherEvent::Type;
     using Fn = void (KickChatServer::*)(KickChannel *, BoostJsonObject);
-    auto fn = stringSwitch<Fn>(
-        event,                                                      //
-        "ChatMessageEvent", &KickChatServer::onChatMessage,         //
-        "MessageDeletedEvent", &KickChatServer::onMessageDeleted,   //
-        "ChatroomClearEvent", &KickChatServer::onChatroomClear,     //
-        "UserBannedEvent", &KickChatServer::onUserBanned,           //
-        "UserUnbannedEvent", &KickChatServer::onUserUnbanned,       //
-        "SubscriptionEvent", &KickChatServer::onSubscriptionEvent,  //
-        "GiftedSubscriptionsEvent",
-        &KickChatServer::onGiftedSubscriptionEvent,  //
-        "PinnedMessageCreatedEvent",
-        &KickChatServer::onPinnedMessageCreatedEvent,  //
-        "PinnedMessageDeletedEvent",
-        &KickChatServer::onPinnedMessageDeletedEvent,                     //
-        "RewardRedeemedEvent", &KickChatServer::onRewardRedeemedEvent,    //
-        "KicksGifted", &KickChatServer::onKicksGiftedEvent,               //
-        "StreamHostEvent", &KickChatServer::onStreamHostEvent,            //
-        "ChatroomUpdatedEvent", &KickChatServer::onChatroomUpdatedEvent,  //
-
-        // ignored
-        "KicksLeaderboardUpdated", &KickChatServer::onKnownIgnoredMessage,  //
-        "GiftsLeaderboardUpdated", &KickChatServer::onKnownIgnoredMessage,  //
-        "PredictionUpdated", &KickChatServer::onKnownIgnoredMessage,        //
-        // old sub events
-        "ChannelSubscriptionEvent", &KickChatServer::onKnownIgnoredMessage,  //
-        "LuckyUsersWhoGotGiftSubscriptionsEvent",
-        &KickChatServer::onKnownIgnoredMessage,  //
-        // v1 stream host event
-        "StreamHostedEvent", &KickChatServer::onKnownIgnoredMessage,  //
-        // seems to be for subscriptions too
-        "ChatMessageSentEvent", &KickChatServer::onKnownIgnoredMessage  //
-    );
+
+    Fn fn = nullptr;
+    switch (event.type)
+    {
+        case Type::ChatMessage:
+            fn = &KickChatServer::onChatMessage;
+            break;
+        case Type::MessageDeleted:
+            fn = &KickChatServer::onMessageDeleted;
+            break;
+        case Type::ChatroomClear:
+            fn = &KickChatServer::onChatroomClear;
+            break;
+        case Type::UserBanned:
+            fn = &KickChatServer::onUserBanned;
+            break;
+        case Type::UserUnbanned:
+            fn = &KickChatServer::onUserUnbanned;
+            break;
+        case Type::Subscription:
+            fn = &KickChatServer::onSubscriptionEvent;
+            break;
+        case Type::GiftedSubscriptions:
+            fn = &KickChatServer::onGiftedSubscriptionEvent;
+            break;
+        case Type::PinnedMessageCreated:
+            fn = &KickChatServer::onPinnedMessageCreatedEvent;
+            break;
+        case Type::PinnedMessageDeleted:
+            fn = &KickChatServer::onPinnedMessageDeletedEvent;
+            break;
+        case Type::RewardRedeemed:
+            fn = &KickChatServer::onRewardRedeemedEvent;
+            break;
+        case Type::KicksGifted:
+            fn = &KickChatServer::onKicksGiftedEvent;
+            break;
+        case Type::StreamHost:
+            fn = &KickChatServer::onStreamHostEvent;
+            break;
+        case Type::ChatroomUpdated:
+            fn = &KickChatServer::onChatroomUpdatedEvent;
+            break;
+        case Type::Ignored:
+            fn = &KickChatServer::onKnownIgnoredMessage;
+            break;
+
+        case Type::Unknown:
+        case Type::Pong:
+        case Type::SubscriptionSucceeded:
+        case Type::SubscriptionError:
+        case Type::ConnectionEstablished:
+            break;
+    }
 
     if (!fn)
     {
@@ -225,23 +230,23 @@ bool KickChatServer::onAppEvent(uint64_t roomID, uint64_t channelID,
     }
 
     std::shared_ptr<KickChannel> channel;
-    if (roomID != 0)
+    if (event.roomID != 0)
     {
-        channel = this->findByRoomID(roomID);
+        channel = this->findByRoomID(event.roomID);
     }
     else
     {
-        channel = this->findByChannelID(channelID);
+        channel = this->findByChannelID(event.channelID);
     }
 
     if (!channel)
     {
-        qCWarning(chatterinoKick)
-            << "No channel found for room" << roomID << "channel" << channelID;
+        qCWarning(chatterinoKick) << "No channel found for room" << event.roomID
+                                  << "channel" << event.channelID;
         return true;  // technically it's handled, we just don't have a channel
     }
 
-    (this->*fn)(channel.get(), data);
+    (this->*fn)(channel.get(), BoostJsonValue(event.data).toObject());
     return true;
 }
 
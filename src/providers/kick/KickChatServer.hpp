@@ -16,6 +16,7 @@ namespace chatterino {
 
 class BoostJsonObject;
 class KickLiveUpdates;
+struct KickPusherEvent;
 class SeventvEventAPI;
 
 class KickChatServer : public QObject
@@ -42,8 +43,9 @@ public:
     std::shared_ptr<Channel> getOrCreate(
         const QString &slug, const KickChannel::UserInit &init = {});
 
-    bool onAppEvent(uint64_t roomID, uint64_t channelID, std::string_view event,
-                    BoostJsonObject data);
+    /// Handles an app event (e.g. a chat message). Returns false if there's
+    /// no handler for the event.
+    bool onAppEvent(const KickPusherEvent &event);
 
     void onJoin(uint64_t roomID) const;
 
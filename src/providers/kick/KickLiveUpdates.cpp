@@ -4,16 +4,19 @@
 #include "common/Env.hpp"
 #include "common/QLogging.hpp"
 #include "providers/kick/KickChatServer.hpp"
+#include "providers/kick/KickPusherEvent.hpp"
 #include "providers/liveupdates/BasicPubSubClient.hpp"
 #include "providers/liveupdates/BasicPubSubManager.hpp"
 #include "providers/NetworkConfigurationProvider.hpp"
 #include "util/BoostJsonWrap.hpp"
+#include "util/PostToThread.hpp"
 
 #include <boost/json.hpp>
 #include <QPointer>
 
-#include <charconv>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 using namespace Qt::Literals;
 
@@ -23,55 +26,6 @@ constexpr std::chrono::seconds MAX_HEARTBEAT_INTERVAL{20};
 const QString WS_URL =
     u"wss://ws-us2.pusher.com/app/32cbd69e4b950bf97679?protocol=7&client=js&version=8.4.0&flash=false"_s;
 
-bool stripPrefix(std::string_view &str, std::string_view prefix)
-{
-    if (str.starts_with(prefix))
-    {
-        str = str.substr(prefix.size());
-        return true;
-    }
-    return false;
-}
-
-bool stripSuffix(std::string_view &str, std::string_view suffix)
-{
-    if (str.ends_with(suffix))
-    {
-        str = str.substr(0, str.size() - suffix.size());
-        return true;
-    }
-    return false;
-}
-
-struct IDs {
-    uint64_t roomID = 0;
-    uint64_t channelID = 0;
-};
-
-IDs parseIDs(std::string_view channel)
-{
-    bool isChannel = false;
-    if (stripPrefix(channel, "chatrooms.") || stripPrefix(channel, "chatroom_"))
-    {
-        stripSuffix(channel, ".v2");
-    }
-    else if (stripPrefix(channel, "channel_") ||
-             stripPrefix(channel, "channel.") ||
-             stripPrefix(channel, "predictions-channel-"))
-    {
-        isChannel = true;
-    }
-
-    uint64_t v = 0;
-    std::from_chars(channel.data(), channel.data() + channel.size(), v);
-
-    if (isChannel)
-    {
-        return IDs{.channelID = v};
-    }
-    return IDs{.roomID = v};
-}
-
 }  // namespace
 
 namespace chatterino {
@@ -113,96 +67,118 @@ public:
     QByteArray encodeUnsubscription(const Subscription &subscription);
 
 private:
-    void onMessageUi(const QByteArray &msg);
+    void onEvents();
+    void onEvent(const KickPusherEvent &event);
 
     std::chrono::steady_clock::time_point lastHeartbeat_;
     std::chrono::milliseconds heartbeatInterval_;
     QPointer<KickChatServer> chatServer_;
+
+    /// Events decoded on the websocket thread that the GUI thread hasn't
+    /// handled yet
+    std::vector<KickPusherEvent> pendingEvents_;
+    std::mutex pendingMutex_;
 };
 
 void KickLiveUpdatesClient::onMessage(const QByteArray &msg)
 {
-    runInGuiThread([weak = this->weak_from_this(), msg] {
-        auto self = weak.lock();
-        if (self)
-        {
-            self->onMessageUi(msg);
-        }
-    });
-}
-
-void KickLiveUpdatesClient::onMessageUi(const QByteArray &msg)
-{
-    boost::system::error_code ec;
-    auto rootJv =
-        boost::json::parse(std::string_view(msg.data(), msg.size()), ec);
-    if (ec)
+    auto event =
+        KickPusherEvent::decode(std::string_view(msg.data(), msg.size()));
+    if (!event)
     {
-        qCWarning(chatterinoKick) << "Failed to parse message:" << ec.message();
+        qCWarning(chatterinoKick) << "Failed to parse message:" << msg;
         return;
     }
-    BoostJsonValue rootRef(rootJv);
-    auto rootObj = rootRef.toObject();
-    auto event = rootObj["event"].toStringView();
-
-    auto dataStr = rootObj["data"].toStringView();
-    BoostJsonValue data;
-    boost::json::value dataJv;
-    if (!dataStr.empty() && dataStr != "{}")
-    {
-        dataJv = boost::json::parse(dataStr, ec);
-        data = BoostJsonValue(dataJv);
-    }
 
-    if (event == "pusher:pong")
+    bool wasEmpty = false;
     {
-        this->lastHeartbeat_ = std::chrono::steady_clock::now();
+        std::lock_guard lock(this->pendingMutex_);
+        wasEmpty = this->pendingEvents_.empty();
+        this->pendingEvents_.emplace_back(std::move(*event));
     }
-    else if (event == "pusher_internal:subscription_succeeded")
+
+    // Events arriving before the GUI thread got to the last ones are handled
+    // together with them
+    if (wasEmpty)
     {
-        auto channel = rootObj["channel"].toStdString();
-        // that's the main chat subscription
-        if (channel.starts_with("chatrooms.") && channel.ends_with(".v2"))
-        {
-            auto ids = parseIDs(channel);
-            if (this->chatServer_ && ids.roomID > 0)
+        runInGuiThread([weak = this->weak_from_this()] {
+            auto self = weak.lock();
+            if (self)
             {
-                this->chatServer_->onJoin(ids.roomID);
+                self->onEvents();
             }
-        }
+        });
     }
-    else if (event == "pusher:subscription_error")
+}
+
+void KickLiveUpdatesClient::onEvents()
+{
+    std::vector<KickPusherEvent> events;
     {
-        qCWarning(chatterinoKick) << "Failed to subscribe" << msg;
+        std::lock_guard lock(this->pendingMutex_);
+        events.swap(this->pendingEvents_);
     }
-    else if (event == "pusher:connection_established")
+
+    for (const auto &event : events)
     {
-        std::chrono::seconds activityTimeout{
-            data["activity_timeout"].toInt64()};
-        if (activityTimeout.count() > 2 &&
-            activityTimeout < this->heartbeatInterval_)
-        {
-            this->heartbeatInterval_ = activityTimeout;
-        }
+        this->onEvent(event);
     }
-    else
+}
+
+void KickLiveUpdatesClient::onEvent(const KickPusherEvent &event)
+{
+    using Type = KickPusherEvent::Type;
+
+    switch (event.type)
     {
-        bool isApp = stripPrefix(event, "App\\Events\\");
-
-        auto channel = rootObj["channel"].toStringView();
-        auto ids = parseIDs(channel);
-        if (this->chatServer_ && (ids.roomID > 0 || ids.channelID > 0))
-        {
-            bool handled = this->chatServer_->onAppEvent(
-                ids.roomID, ids.channelID, event, data.toObject());
-            if (!handled)
+        case Type::Pong:
+            this->lastHeartbeat_ = std::chrono::steady_clock::now();
+            break;
+
+        case Type::SubscriptionSucceeded: {
+            auto channel = event.channel();
+            // that's the main chat subscription
+            if (channel.starts_with("chatrooms.") && channel.ends_with(".v2"))
+            {
+                if (this->chatServer_ && event.roomID > 0)
+                {
+                    this->chatServer_->onJoin(event.roomID);
+                }
+            }
+        }
+        break;
+
+        case Type::SubscriptionError:
+            qCWarning(chatterinoKick).noquote()
+                << "Failed to subscribe" << event.channel()
+                << "data:" << event.rawData();
+            break;
+
+        case Type::ConnectionEstablished: {
+            std::chrono::seconds activityTimeout{
+                BoostJsonValue(event.data)["activity_timeout"].toInt64()};
+            if (activityTimeout.count() > 2 &&
+                activityTimeout < this->heartbeatInterval_)
+            {
+                this->heartbeatInterval_ = activityTimeout;
+            }
+        }
+        break;
+
+        default: {
+            if (this->chatServer_ && (event.roomID > 0 || event.channelID > 0))
             {
-                qCWarning(chatterinoKick).noquote()
-                    << "Unknown event" << event << "isApp:" << isApp
-                    << "channel:" << rootObj["channel"].toStringView()
-                    << "data:" << dataStr;
+                bool handled = this->chatServer_->onAppEvent(event);
+                if (!handled)
+                {
+                    qCWarning(chatterinoKick).noquote()
+                        << "Unknown event" << event.event()
+                        << "channel:" << event.channel()
+                        << "data:" << event.rawData();
+                }
             }
         }
+        break;
     }
 }
 
@@ -0,0 +1,235 @@
+#include "providers/kick/KickPusherEvent.hpp"
+
+#include <boost/json/monotonic_resource.hpp>
+#include <boost/json/parser.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <utility>
+
+namespace {
+
+using namespace chatterino;
+using Type = KickPusherEvent::Type;
+
+// fallback case
+template <typename T>
+T stringSwitch(std::string_view /* provided */)
+{
+    return {};
+}
+
+template <typename T>
+T stringSwitch(std::string_view provided, std::string_view match, T &&value,
+               auto &&...rest)
+{
+    if (provided == match)
+    {
+        return std::forward<T>(value);
+    }
+    return stringSwitch<T>(provided, std::forward<decltype(rest)>(rest)...);
+}
+
+bool stripPrefix(std::string_view &str, std::string_view prefix)
+{
+    if (str.starts_with(prefix))
+    {
+        str = str.substr(prefix.size());
+        return true;
+    }
+    return false;
+}
+
+bool stripSuffix(std::string_view &str, std::string_view suffix)
+{
+    if (str.ends_with(suffix))
+    {
+        str = str.substr(0, str.size() - suffix.size());
+        return true;
+    }
+    return false;
+}
+
+void parseIDs(std::string_view channel, KickPusherEvent &event)
+{
+    bool isChannel = false;
+    if (stripPrefix(channel, "chatrooms.") || stripPrefix(channel, "chatroom_"))
+    {
+        stripSuffix(channel, ".v2");
+    }
+    else if (stripPrefix(channel, "channel_") ||
+             stripPrefix(channel, "channel.") ||
+             stripPrefix(channel, "predictions-channel-"))
+    {
+        isChannel = true;
+    }
+
+    uint64_t v = 0;
+    std::from_chars(channel.data(), channel.data() + channel.size(), v);
+
+    if (isChannel)
+    {
+        event.channelID = v;
+    }
+    else
+    {
+        event.roomID = v;
+    }
+}
+
+Type appEventType(std::string_view event)
+{
+    stripPrefix(event, "App\\Events\\");
+
+    return stringSwitch<Type>(
+        event,                                                     //
+        "ChatMessageEvent", Type::ChatMessage,                     //
+        "MessageDeletedEvent", Type::MessageDeleted,               //
+        "ChatroomClearEvent", Type::ChatroomClear,                 //
+        "UserBannedEvent", Type::UserBanned,                       //
+        "UserUnbannedEvent", Type::UserUnbanned,                   //
+        "SubscriptionEvent", Type::Subscription,                   //
+        "GiftedSubscriptionsEvent", Type::GiftedSubscriptions,     //
+        "PinnedMessageCreatedEvent", Type::PinnedMessageCreated,   //
+        "PinnedMessageDeletedEvent", Type::PinnedMessageDeleted,   //
+        "RewardRedeemedEvent", Type::RewardRedeemed,               //
+        "KicksGifted", Type::KicksGifted,                          //
+        "StreamHostEvent", Type::StreamHost,                       //
+        "ChatroomUpdatedEvent", Type::ChatroomUpdated,             //
+
+        // ignored
+        "KicksLeaderboardUpdated", Type::Ignored,  //
+        "GiftsLeaderboardUpdated", Type::Ignored,  //
+        "PredictionUpdated", Type::Ignored,        //
+        // old sub events
+        "ChannelSubscriptionEvent", Type::Ignored,                //
+        "LuckyUsersWhoGotGiftSubscriptionsEvent", Type::Ignored,  //
+        // v1 stream host event
+        "StreamHostedEvent", Type::Ignored,  //
+        // seems to be for subscriptions too
+        "ChatMessageSentEvent", Type::Ignored  //
+    );
+}
+
+Type eventType(std::string_view event)
+{
+    auto type = stringSwitch<Type>(
+        event,                                                          //
+        "pusher:pong", Type::Pong,                                      //
+        "pusher_internal:subscription_succeeded",                       //
+        Type::SubscriptionSucceeded,                                    //
+        "pusher:subscription_error", Type::SubscriptionError,           //
+        "pusher:connection_established", Type::ConnectionEstablished  //
+    );
+    if (type != Type::Unknown)
+    {
+        return type;
+    }
+    return appEventType(event);
+}
+
+}  // namespace
+
+namespace chatterino {
+
+KickPusherEvent::KickPusherEvent(boost::json::value envelope,
+                                 boost::json::value data)
+    : data(std::move(data))
+    , envelope_(std::move(envelope))
+{
+}
+
+std::optional<KickPusherEvent> KickPusherEvent::decode(std::string_view frame)
+{
+    // The arena is freed with the last value using it. Most frames fit into
+    // its first block.
+    auto storage =
+        boost::json::make_shared_resource<boost::json::monotonic_resource>(
+            std::max<size_t>(2 * frame.size(), 1024));
+
+    // Each websocket thread reuses its parser (and its temporary buffers)
+    thread_local boost::json::parser parser;
+
+    boost::system::error_code ec;
+    parser.reset(storage);
+    parser.write(frame, ec);
+    if (ec)
+    {
+        parser.reset();
+        return std::nullopt;
+    }
+
+    auto envelope = parser.release();
+    const auto *envelopeObj = envelope.if_object();
+    if (!envelopeObj)
+    {
+        parser.reset();
+        return std::nullopt;
+    }
+
+    std::string_view rawData;
+    if (const auto *it = envelopeObj->if_contains("data"))
+    {
+        if (const auto *str = it->if_string())
+        {
+            rawData = *str;
+        }
+    }
+
+    bool hasData = false;
+    if (!rawData.empty() && rawData != "{}")
+    {
+        parser.reset(storage);
+        parser.write(rawData, ec);
+        hasData = !ec;
+    }
+    auto data = hasData ? parser.release() : boost::json::value(storage);
+    // Don't keep the arena alive until the next frame
+    parser.reset();
+
+    // Values are only moved if they use the same storage, otherwise they're
+    // copied. Assigning to a default constructed event would copy them out
+    // of the arena.
+    KickPusherEvent event(std::move(envelope), std::move(data));
+    event.type = eventType(event.event());
+    parseIDs(event.channel(), event);
+
+    return event;
+}
+
+std::string_view KickPusherEvent::event() const
+{
+    return this->field("event");
+}
+
+std::string_view KickPusherEvent::channel() const
+{
+    return this->field("channel");
+}
+
+std::string_view KickPusherEvent::rawData() const
+{
+    return this->field("data");
+}
+
+std::string_view KickPusherEvent::field(std::string_view key) const
+{
+    const auto *obj = this->envelope_.if_object();
+    if (!obj)
+    {
+        return {};
+    }
+    const auto *value = obj->if_contains(key);
+    if (!value)
+    {
+        return {};
+    }
+    const auto *str = value->if_string();
+    if (!str)
+    {
+        return {};
+    }
+    return *str;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <boost/json/value.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace chatterino {
+
+/// A decoded frame from Kick's Pusher websocket.
+///
+/// Frames are decoded on the websocket thread. Pusher sends the payload of
+/// an event as a JSON encoded string inside the JSON envelope. Both are
+/// parsed into one arena that's owned by the event, so decoding a frame
+/// only allocates a few blocks instead of every string, array and object.
+struct KickPusherEvent {
+    enum class Type : uint8_t {
+        /// An app event that has no handler
+        Unknown,
+
+        // Pusher protocol events
+        Pong,
+        SubscriptionSucceeded,
+        SubscriptionError,
+        ConnectionEstablished,
+
+        // App events
+        ChatMessage,
+        MessageDeleted,
+        ChatroomClear,
+        UserBanned,
+        UserUnbanned,
+        Subscription,
+        GiftedSubscriptions,
+        PinnedMessageCreated,
+        PinnedMessageDeleted,
+        RewardRedeemed,
+        KicksGifted,
+        StreamHost,
+        ChatroomUpdated,
+        /// An app event that's known but not shown
+        Ignored,
+    };
+
+    // Copying would copy the whole payload out of the arena. Assigning a
+    // JSON value that uses a different storage copies it, so events can
+    // only be move constructed.
+    KickPusherEvent(const KickPusherEvent &) = delete;
+    KickPusherEvent &operator=(const KickPusherEvent &) = delete;
+    KickPusherEvent(KickPusherEvent &&) = default;
+    KickPusherEvent &operator=(KickPusherEvent &&) = delete;
+
+    /// Decodes a frame. Returns std::nullopt if the frame isn't a JSON
+    /// object.
+    static std::optional<KickPusherEvent> decode(std::string_view frame);
+
+    /// The name of the event (e.g. `App\Events\ChatMessageEvent`)
+    std::string_view event() const;
+    /// The Pusher channel the event was sent on (e.g. `chatrooms.42.v2`)
+    std::string_view channel() const;
+    /// The payload as it was sent, for logging
+    std::string_view rawData() const;
+
+    Type type = Type::Unknown;
+    /// Set for events on chatroom channels
+    uint64_t roomID = 0;
+    /// Set for events on channel channels
+    uint64_t channelID = 0;
+    /// The decoded payload, null if there's none
+    boost::json::value data;
+
+private:
+    KickPusherEvent(boost::json::value envelope, boost::json::value data);
+
+    std::string_view field(std::string_view key) const;
+
+    boost::json::value envelope_;
+};
+
+}  // namespace chatterino
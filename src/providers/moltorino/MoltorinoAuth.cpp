@@ -174,7 +174,7 @@ void saveAccounts(const std::vector<MoltorinoAuthAccount> &accounts)
     auto json =
         QString::fromUtf8(QJsonDocument(array).toJson(QJsonDocument::Compact));
     getSettings()->moltorinoAuthAccounts = json;
-    getSettings()->requestSave();
+    getSettings()->queueSave();
 }
 
 bool sameAccount(const MoltorinoAuthAccount &account, const QString &userId,
@@ -994,7 +994,7 @@ void removeAccount(const QString &userId, const QString &token)
     if (!normalizedToken.isEmpty() && legacyToken() == normalizedToken)
     {
         getSettings()->customPinAuthToken = "";
-        getSettings()->requestSave();
+        getSettings()->queueSave();
     }
 }
 
@@ -8,6 +8,7 @@
 #include "common/QLogging.hpp"
 #include "providers/pronouns/alejo/PronounsAlejoApi.hpp"
 #include "providers/pronouns/UserPronouns.hpp"
+#include "providers/UserMetadataStore.hpp"
 
 #include <mutex>
 #include <unordered_map>
@@ -22,23 +23,49 @@ const auto &LOG = chatterinoPronouns;
 namespace chatterino::pronouns {
 
 void Pronouns::getUserPronoun(
-    const QString &username,
+    const QString &userID, const QString &username,
     const std::function<void(UserPronouns)> &callbackSuccess,
     const std::function<void()> &callbackFail)
 {
-    // Only fetch pronouns if we haven't fetched before.
-    auto cachedPronoun = this->getCachedUserPronoun(username);
-    if (cachedPronoun.has_value())
+    using Field = UserMetadataStore::Field;
+
+    // Only fetch pronouns if we haven't fetched them recently.
+    auto *userMetadata = getApp()->getUserMetadata();
+    if (userMetadata != nullptr)
     {
-        callbackSuccess(*cachedPronoun);
-        return;
+        if (auto cached = userMetadata->get(userID, Field::Pronouns))
+        {
+            callbackSuccess(UserPronouns(*cached));
+            return;
+        }
     }
 
-    this->alejoApi.fetch(username, [this, callbackSuccess, callbackFail,
+    {
+        std::unique_lock lock(this->mutex);
+        auto &waiting = this->pending[username];
+        waiting.push_back({callbackSuccess, callbackFail});
+        if (waiting.size() > 1)
+        {
+            // Already fetching
+            return;
+        }
+    }
+
+    this->alejoApi.fetch(username, [this, userMetadata, userID,
                                     username](const auto &oUserPronoun) {
+        std::vector<Callbacks> waiting;
+        {
+            std::unique_lock lock(this->mutex);
+            waiting = std::move(this->pending[username]);
+            this->pending.erase(username);
+        }
+
         if (!oUserPronoun.has_value())
         {
-            callbackFail();
+            for (const auto &callbacks : waiting)
+            {
+                callbacks.fail();
+            }
             return;
         }
 
@@ -46,25 +73,19 @@ void Pronouns::getUserPronoun(
 
         qCDebug(LOG) << "Caching pronoun" << userPronoun.format() << "for user"
                      << username;
+        if (userMetadata != nullptr)
         {
-            std::unique_lock lock(this->mutex);
-            this->saved[username] = userPronoun;
+            userMetadata->set(userID, username, Field::Pronouns,
+                              userPronoun.isUnspecified()
+                                  ? QString()
+                                  : userPronoun.format());
         }
 
-        callbackSuccess(userPronoun);
+        for (const auto &callbacks : waiting)
+        {
+            callbacks.success(userPronoun);
+        }
     });
 }
 
-std::optional<UserPronouns> Pronouns::getCachedUserPronoun(
-    const QString &username)
-{
-    std::shared_lock lock(this->mutex);
-    auto it = this->saved.find(username);
-    if (it != this->saved.end())
-    {
-        return {it->second};
-    }
-    return {};
-}
-
 }  // namespace chatterino::pronouns
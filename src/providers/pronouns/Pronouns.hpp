@@ -8,28 +8,36 @@
 #include "providers/pronouns/UserPronouns.hpp"
 
 #include <functional>
-#include <optional>
-#include <shared_mutex>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace chatterino::pronouns {
 
 class Pronouns
 {
 public:
+    /// Get the pronouns of a user
+    ///
+    /// Pronouns are cached in the UserMetadataStore. Requests for a user
+    /// whose pronouns are already being fetched wait for that request.
+    ///
+    /// The callbacks can be invoked from any thread.
     void getUserPronoun(
-        const QString &username,
+        const QString &userID, const QString &username,
         const std::function<void(UserPronouns)> &callbackSuccess,
         const std::function<void()> &callbackFail);
 
 private:
-    // Retrieve cached pronouns for user.
-    std::optional<UserPronouns> getCachedUserPronoun(const QString &username);
-
-    // mutex for editing the saved map.
-    std::shared_mutex mutex;
-    // Login name -> Pronouns
-    std::unordered_map<QString, UserPronouns> saved;
+    struct Callbacks {
+        std::function<void(UserPronouns)> success;
+        std::function<void()> fail;
+    };
+
+    // mutex for editing the pending map.
+    std::mutex mutex;
+    // Login name -> Callbacks waiting for the request of that user
+    std::unordered_map<QString, std::vector<Callbacks>> pending;
     AlejoApi alejoApi;
 };
 
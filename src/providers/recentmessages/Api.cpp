@@ -8,6 +8,7 @@
 #include "common/network/NetworkRequest.hpp"
 #include "common/network/NetworkResult.hpp"
 #include "common/QLogging.hpp"
+#include "debug/StartupTrace.hpp"
 #include "providers/recentmessages/Impl.hpp"
 #include "util/PostToThread.hpp"
 
@@ -37,6 +38,7 @@ void load(
         constructRecentMessagesUrl(channelName, limit, after, before);
 
     const long delayMs = jitter ? std::rand() % 100 : 0;
+    const auto traceBegin = StartupTrace::now();
     QTimer::singleShot(delayMs, [=] {
         if (isAppAboutToQuit())
         {
@@ -44,7 +46,7 @@ void load(
         }
 
         NetworkRequest(url)
-            .onSuccess([channelPtr, onLoaded](const auto &result) {
+            .onSuccess([channelPtr, onLoaded, traceBegin](const auto &result) {
                 assert(!isAppAboutToQuit());
 
                 auto shared = channelPtr.lock();
@@ -56,16 +58,22 @@ void load(
                 qCDebug(LOG) << "Successfully loaded recent messages for"
                              << shared->getName();
 
+                auto buildBegin = StartupTrace::now();
                 auto root = result.parseJson();
                 auto parsedMessages = parseRecentMessages(root);
 
                 // build the Communi messages into chatterino messages
                 auto builtMessages =
                     buildRecentMessages(parsedMessages, shared.get());
+                StartupTrace::complete(
+                    "recent messages", "build recent messages", buildBegin,
+                    {{"channel", shared->getName()},
+                     {"messages", QString::number(builtMessages.size())}});
 
                 postToThread(
                     [shared = std::move(shared), root = std::move(root),
-                     messages = std::move(builtMessages), onLoaded]() mutable {
+                     messages = std::move(builtMessages), onLoaded,
+                     traceBegin]() mutable {
                         assert(!isAppAboutToQuit());
 
                         // Notify user about a possible gap in logs if it returned some messages
@@ -89,6 +97,12 @@ void load(
                         }
 
                         onLoaded(messages);
+                        // Channels only load their recent messages once
+                        // at a time
+                        StartupTrace::async(
+                            "recent messages", "load recent messages",
+                            reinterpret_cast<quintptr>(shared.get()),
+                            traceBegin, {{"channel", shared->getName()}});
                     });
             })
             .onError([channelPtr, onError](const NetworkResult &result) {
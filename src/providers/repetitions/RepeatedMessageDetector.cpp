@@ -9,18 +9,23 @@
 #include <QDateTime>
 
 #include <algorithm>
+#include <cassert>
+#include <limits>
 
 namespace chatterino {
 
 namespace {
 
 constexpr qint64 CACHE_TTL_MS = static_cast<const qint64>(5 * 60 * 1000);
-constexpr qsizetype MAX_SEEN_MESSAGE_IDS_PER_USER = 16;
-constexpr qsizetype MAX_USERS_PER_CHANNEL = 2048;
+constexpr size_t MAX_USERS_PER_CHANNEL = 2048;
 constexpr qsizetype MAX_NORMALIZED_CHARS = 512;
 constexpr int MAX_REPEAT_COUNT = 999;
 constexpr int MAX_ACTIVE_STREAK_MISSES = 3;
+/// Channels without new messages are only checked for expired users this
+/// often
 constexpr int CLEANUP_INTERVAL_CHECKS = 128;
+/// Granularity of the timing wheel, users expire up to one tick late
+constexpr qint64 TICK_MS = 5 * 1000;
 
 char32_t codePointAt(const QString &text, qsizetype index, qsizetype &next)
 {
@@ -45,8 +50,24 @@ bool isDuplicateBypassCodePoint(char32_t codePoint)
            (codePoint >= 0xE0000 && codePoint <= 0xE007F);
 }
 
+/// The finalizer of SplitMix64
+uint64_t mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
 }  // namespace
 
+RepeatedMessageDetector::RepeatedMessageDetector(Clock clock)
+    : clock_(clock != nullptr ? clock : &QDateTime::currentMSecsSinceEpoch)
+{
+}
+
 std::optional<int> RepeatedMessageDetector::check(
     const RepeatedMessageCheck &check)
 {
@@ -85,16 +106,15 @@ std::optional<int> RepeatedMessageDetector::check(
         return std::nullopt;
     }
 
-    const auto now = QDateTime::currentMSecsSinceEpoch();
+    const auto now = this->clock_();
 
     if (++this->checksSinceCleanup_ >= CLEANUP_INTERVAL_CHECKS)
     {
         this->checksSinceCleanup_ = 0;
         for (auto it = this->channels_.begin(); it != this->channels_.end();)
         {
-            chatterino::RepeatedMessageDetector::cleanupChannel(it.value(),
-                                                                now);
-            if (it.value().isEmpty())
+            it->advance(now);
+            if (it->index.isEmpty())
             {
                 it = this->channels_.erase(it);
             }
@@ -106,31 +126,53 @@ std::optional<int> RepeatedMessageDetector::check(
     }
 
     auto &channel = this->channels_[check.channelID];
-    auto &user = channel[check.userID];
-    user.lastSeenAt = now;
-    chatterino::RepeatedMessageDetector::cleanupUser(user, now);
+    channel.advance(now);
+    auto &user = channel.acquire(hash(check.userID), now);
+    cleanupUser(user, now);
 
-    if (hasSeenMessageID(user, check.messageID))
+    const auto messageKey = hash(check.messageID);
+    if (hasSeenMessageID(user, messageKey))
     {
         return std::nullopt;
     }
-    rememberMessageID(user, check.messageID, now);
+    rememberMessageID(user, messageKey);
 
     const int sensitivityPercent =
         sensitivityToPercent(settings->repeatedMessagesSensitivity);
     const int visibleThreshold =
         std::max(2, settings->repeatedMessagesRepetitionThreshold.getValue());
 
-    if (user.active && messagesMatch(normalized, user.active->normalizedMessage,
-                                     sensitivityPercent))
+    // The sketch is only built once an exact match failed
+    Sketch sketch{.fingerprint = hash(normalized)};
+    bool hasMinHashes = false;
+    auto ensureMinHashes = [&] {
+        if (!hasMinHashes)
+        {
+            addMinHashes(sketch, normalized);
+            hasMinHashes = true;
+        }
+    };
+    auto matches = [&](const Entry &entry) {
+        if (entry.sketch.fingerprint == sketch.fingerprint)
+        {
+            return true;
+        }
+        if (sensitivityPercent >= 100)
+        {
+            return false;
+        }
+        ensureMinHashes();
+        const auto threshold = static_cast<double>(sensitivityPercent) / 100.0;
+        return estimate(sketch, entry.sketch) >= threshold;
+    };
+
+    if (user.active && matches(*user.active))
     {
         user.active->repeatCount =
             std::min(user.active->repeatCount + 1, MAX_REPEAT_COUNT);
-        user.active->messageID = check.messageID;
         user.active->missesSinceMatch = 0;
         user.active->expiresAt = now + CACHE_TTL_MS;
         user.candidate = user.active;
-        chatterino::RepeatedMessageDetector::enforceChannelLimit(channel);
         if (user.active->repeatCount >= visibleThreshold)
         {
             return user.active->repeatCount;
@@ -147,29 +189,25 @@ std::optional<int> RepeatedMessageDetector::check(
         }
     }
 
-    if (user.candidate &&
-        messagesMatch(normalized, user.candidate->normalizedMessage,
-                      sensitivityPercent))
+    if (user.candidate && matches(*user.candidate))
     {
         user.candidate->repeatCount =
             std::min(user.candidate->repeatCount + 1, MAX_REPEAT_COUNT);
-        user.candidate->messageID = check.messageID;
         user.candidate->expiresAt = now + CACHE_TTL_MS;
     }
     else
     {
-        user.candidate = makeEntry(normalized, check.messageID, now);
+        ensureMinHashes();
+        user.candidate = makeEntry(sketch, now);
     }
 
     if (user.candidate->repeatCount >= visibleThreshold)
     {
         user.candidate->missesSinceMatch = 0;
         user.active = user.candidate;
-        chatterino::RepeatedMessageDetector::enforceChannelLimit(channel);
         return user.active->repeatCount;
     }
 
-    chatterino::RepeatedMessageDetector::enforceChannelLimit(channel);
     return std::nullopt;
 }
 
@@ -179,6 +217,163 @@ void RepeatedMessageDetector::clear()
     this->checksSinceCleanup_ = 0;
 }
 
+size_t RepeatedMessageDetector::trackedUsers() const
+{
+    size_t count = 0;
+    for (const auto &channel : this->channels_)
+    {
+        count += static_cast<size_t>(channel.index.size());
+    }
+    return count;
+}
+
+RepeatedMessageDetector::Slot &RepeatedMessageDetector::Slab::acquire(
+    uint64_t userKey, qint64 now)
+{
+    uint32_t slot = NO_SLOT;
+    auto it = this->index.find(userKey);
+    if (it != this->index.end())
+    {
+        slot = *it;
+    }
+    else
+    {
+        if (this->freeSlots.empty())
+        {
+            if (this->slots.size() < MAX_USERS_PER_CHANNEL)
+            {
+                this->slots.emplace_back();
+                this->freeSlots.push_back(
+                    static_cast<uint32_t>(this->slots.size() - 1));
+            }
+            else
+            {
+                this->release(this->oldestSlot());
+            }
+        }
+        slot = this->freeSlots.back();
+        this->freeSlots.pop_back();
+
+        this->slots[slot] = Slot{.userKey = userKey};
+        this->index.insert(userKey, slot);
+    }
+
+    this->slots[slot].lastSeenAt = now;
+    this->touch(slot, now);
+    return this->slots[slot];
+}
+
+void RepeatedMessageDetector::Slab::advance(qint64 now)
+{
+    const auto nowTick = now / TICK_MS;
+    if (this->tick == 0)
+    {
+        this->tick = nowTick;
+        return;
+    }
+
+    // Every bucket only holds slots of a single tick, all of them expired
+    // once that tick is over. Each bucket is visited at most once.
+    const auto end =
+        std::min(nowTick, this->tick + static_cast<qint64>(WHEEL_SIZE));
+    for (; this->tick < end; this->tick++)
+    {
+        const auto &bucket = this->wheel[this->tick % WHEEL_SIZE];
+        while (bucket.head != NO_SLOT)
+        {
+            this->release(bucket.head);
+        }
+    }
+    this->tick = std::max(this->tick, nowTick);
+}
+
+void RepeatedMessageDetector::Slab::touch(uint32_t slot, qint64 now)
+{
+    static_assert(CACHE_TTL_MS / TICK_MS < WHEEL_SIZE,
+                  "The wheel must cover the whole TTL");
+
+    const auto expiryTick = (now + CACHE_TTL_MS) / TICK_MS;
+    auto &user = this->slots[slot];
+    if (user.expiryTick == expiryTick)
+    {
+        return;
+    }
+    if (user.expiryTick != 0)
+    {
+        this->unlink(slot);
+    }
+    user.expiryTick = expiryTick;
+    this->link(slot);
+}
+
+void RepeatedMessageDetector::Slab::link(uint32_t slot)
+{
+    auto &user = this->slots[slot];
+    auto &bucket = this->wheel[user.expiryTick % WHEEL_SIZE];
+    user.prev = bucket.tail;
+    user.next = NO_SLOT;
+    if (bucket.tail == NO_SLOT)
+    {
+        bucket.head = slot;
+    }
+    else
+    {
+        this->slots[bucket.tail].next = slot;
+    }
+    bucket.tail = slot;
+}
+
+void RepeatedMessageDetector::Slab::unlink(uint32_t slot)
+{
+    auto &user = this->slots[slot];
+    auto &bucket = this->wheel[user.expiryTick % WHEEL_SIZE];
+    if (user.prev == NO_SLOT)
+    {
+        bucket.head = user.next;
+    }
+    else
+    {
+        this->slots[user.prev].next = user.next;
+    }
+    if (user.next == NO_SLOT)
+    {
+        bucket.tail = user.prev;
+    }
+    else
+    {
+        this->slots[user.next].prev = user.prev;
+    }
+    user.prev = NO_SLOT;
+    user.next = NO_SLOT;
+    user.expiryTick = 0;
+}
+
+void RepeatedMessageDetector::Slab::release(uint32_t slot)
+{
+    this->unlink(slot);
+
+    auto &user = this->slots[slot];
+    this->index.remove(user.userKey);
+    user.active.reset();
+    user.candidate.reset();
+    this->freeSlots.push_back(slot);
+}
+
+uint32_t RepeatedMessageDetector::Slab::oldestSlot() const
+{
+    for (size_t i = 0; i < WHEEL_SIZE; i++)
+    {
+        const auto &bucket = this->wheel[(this->tick + i) % WHEEL_SIZE];
+        if (bucket.head != NO_SLOT)
+        {
+            return bucket.head;
+        }
+    }
+
+    assert(false && "A full slab must have linked slots");
+    return 0;
+}
+
 QString RepeatedMessageDetector::normalizeMessage(const QString &message)
 {
     QString normalized;
@@ -216,72 +411,83 @@ QString RepeatedMessageDetector::normalizeMessage(const QString &message)
     return normalized;
 }
 
-double RepeatedMessageDetector::compare(const QString &first,
-                                        const QString &second)
+uint64_t RepeatedMessageDetector::hash(const QString &text)
 {
-    if (first.isEmpty() && second.isEmpty())
-    {
-        return 1.0;
-    }
-    if (first.isEmpty() || second.isEmpty())
-    {
-        return 0.0;
-    }
-    if (first == second)
+    // FNV-1a over the UTF-16 code units, qHash is only 32 bit on some
+    // platforms
+    uint64_t value = 0xCBF29CE484222325ULL;
+    for (auto c : text)
     {
-        return 1.0;
-    }
-    if (first.size() == 1 && second.size() == 1)
-    {
-        return first == second ? 1.0 : 0.0;
+        value ^= c.unicode();
+        value *= 0x100000001B3ULL;
     }
-    if (first.size() < 2 || second.size() < 2)
+    return mix(value);
+}
+
+void RepeatedMessageDetector::addMinHashes(Sketch &sketch,
+                                           const QString &normalizedMessage)
+{
+    if (normalizedMessage.size() < 2)
     {
-        return 0.0;
+        return;
     }
 
-    QHash<quint32, int> firstBigrams;
-    firstBigrams.reserve(first.size() - 1);
-    for (qsizetype i = 0; i < first.size() - 1; ++i)
+    // Sorted, so repeated bigrams are next to each other
+    std::vector<uint32_t> bigrams;
+    bigrams.reserve(normalizedMessage.size() - 1);
+    for (qsizetype i = 0; i < normalizedMessage.size() - 1; ++i)
     {
-        const auto key = (static_cast<quint32>(first.at(i).unicode()) << 16U) |
-                         static_cast<quint32>(first.at(i + 1).unicode());
-        firstBigrams[key] = firstBigrams.value(key) + 1;
+        bigrams.push_back(
+            (static_cast<uint32_t>(normalizedMessage.at(i).unicode()) << 16U) |
+            static_cast<uint32_t>(normalizedMessage.at(i + 1).unicode()));
     }
+    std::ranges::sort(bigrams);
 
-    int intersectionSize = 0;
-    for (qsizetype i = 0; i < second.size() - 1; ++i)
+    std::array<uint64_t, MINHASH_SIZE> minimums;
+    minimums.fill(std::numeric_limits<uint64_t>::max());
+    uint64_t occurrence = 0;
+    for (size_t i = 0; i < bigrams.size(); ++i)
     {
-        const auto key = (static_cast<quint32>(second.at(i).unicode()) << 16U) |
-                         static_cast<quint32>(second.at(i + 1).unicode());
-        auto count = firstBigrams.value(key);
-        if (count > 0)
+        occurrence = i > 0 && bigrams[i] == bigrams[i - 1] ? occurrence + 1 : 0;
+        const auto base =
+            mix(static_cast<uint64_t>(bigrams[i]) | (occurrence << 32U));
+        for (size_t j = 0; j < MINHASH_SIZE; j++)
         {
-            firstBigrams[key] = count - 1;
-            intersectionSize++;
+            minimums[j] = std::min(
+                minimums[j], mix(base + (j + 1) * 0x9E3779B97F4A7C15ULL));
         }
     }
 
-    return (2.0 * intersectionSize) /
-           static_cast<double>(first.size() + second.size() - 2);
+    for (size_t j = 0; j < MINHASH_SIZE; j++)
+    {
+        sketch.minHashes[j] = static_cast<uint16_t>(minimums[j]);
+    }
+    sketch.hasBigrams = true;
 }
 
-bool RepeatedMessageDetector::messagesMatch(const QString &first,
-                                            const QString &second,
-                                            int sensitivityPercent)
+double RepeatedMessageDetector::estimate(const Sketch &first,
+                                         const Sketch &second)
 {
-    if (first == second)
+    if (first.fingerprint == second.fingerprint)
     {
-        return true;
+        return 1.0;
     }
-
-    if (sensitivityPercent >= 100)
+    if (!first.hasBigrams || !second.hasBigrams)
     {
-        return false;
+        return 0.0;
     }
 
-    return compare(first, second) >=
-           static_cast<double>(sensitivityPercent) / 100.0;
+    // The share of equal minimums estimates the Jaccard index of the bigram
+    // multisets. Unrelated 16 bit minimums are only equal by chance (1 in
+    // 65536).
+    size_t equal = 0;
+    for (size_t j = 0; j < MINHASH_SIZE; j++)
+    {
+        equal += first.minHashes[j] == second.minHashes[j] ? 1 : 0;
+    }
+    const auto jaccard =
+        static_cast<double>(equal) / static_cast<double>(MINHASH_SIZE);
+    return (2.0 * jaccard) / (1.0 + jaccard);
 }
 
 int RepeatedMessageDetector::sensitivityToPercent(int sensitivity)
@@ -303,39 +509,31 @@ int RepeatedMessageDetector::sensitivityToPercent(int sensitivity)
 }
 
 RepeatedMessageDetector::Entry RepeatedMessageDetector::makeEntry(
-    const QString &normalizedMessage, const QString &messageID, qint64 now)
+    const Sketch &sketch, qint64 now)
 {
     return {
-        .normalizedMessage = normalizedMessage,
-        .messageID = messageID,
+        .sketch = sketch,
         .repeatCount = 1,
         .missesSinceMatch = 0,
         .expiresAt = now + CACHE_TTL_MS,
     };
 }
 
-bool RepeatedMessageDetector::hasSeenMessageID(const UserCache &user,
-                                               const QString &messageID)
+bool RepeatedMessageDetector::hasSeenMessageID(const Slot &user,
+                                               uint64_t messageKey)
 {
-    return std::ranges::any_of(user.seenMessages,
-                               [&messageID](const SeenMessage &seen) {
-                                   return seen.messageID == messageID;
-                               });
+    return std::ranges::find(user.seenMessages, messageKey) !=
+           user.seenMessages.end();
 }
 
-void RepeatedMessageDetector::rememberMessageID(UserCache &user,
-                                                const QString &messageID,
-                                                qint64 now)
+void RepeatedMessageDetector::rememberMessageID(Slot &user, uint64_t messageKey)
 {
-    user.seenMessages.push_back(
-        {.messageID = messageID, .expiresAt = now + CACHE_TTL_MS});
-    while (user.seenMessages.size() > MAX_SEEN_MESSAGE_IDS_PER_USER)
-    {
-        user.seenMessages.pop_front();
-    }
+    user.seenMessages[user.nextSeenMessage] = messageKey;
+    user.nextSeenMessage =
+        static_cast<uint8_t>((user.nextSeenMessage + 1) % SEEN_MESSAGE_IDS);
 }
 
-void RepeatedMessageDetector::cleanupUser(UserCache &user, qint64 now)
+void RepeatedMessageDetector::cleanupUser(Slot &user, qint64 now)
 {
     if (user.active && user.active->expiresAt <= now)
     {
@@ -345,48 +543,6 @@ void RepeatedMessageDetector::cleanupUser(UserCache &user, qint64 now)
     {
         user.candidate.reset();
     }
-
-    user.seenMessages.erase(
-        std::ranges::remove_if(user.seenMessages,
-                               [now](const SeenMessage &seen) {
-                                   return seen.expiresAt <= now;
-                               })
-            .begin(),
-        user.seenMessages.end());
-}
-
-void RepeatedMessageDetector::cleanupChannel(ChannelCache &channel, qint64 now)
-{
-    for (auto it = channel.begin(); it != channel.end();)
-    {
-        chatterino::RepeatedMessageDetector::cleanupUser(it.value(), now);
-
-        if (!it.value().active && !it.value().candidate &&
-            it.value().seenMessages.isEmpty())
-        {
-            it = channel.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
-    }
-}
-
-void RepeatedMessageDetector::enforceChannelLimit(ChannelCache &channel)
-{
-    while (channel.size() > MAX_USERS_PER_CHANNEL)
-    {
-        auto oldest = channel.begin();
-        for (auto it = channel.begin(); it != channel.end(); ++it)
-        {
-            if (it.value().lastSeenAt < oldest.value().lastSeenAt)
-            {
-                oldest = it;
-            }
-        }
-        channel.erase(oldest);
-    }
 }
 
 }  // namespace chatterino
@@ -6,9 +6,11 @@
 
 #include <QHash>
 #include <QString>
-#include <QVector>
 
+#include <array>
+#include <cstdint>
 #include <optional>
+#include <vector>
 
 namespace chatterino {
 
@@ -25,55 +27,120 @@ struct RepeatedMessageCheck {
     bool senderIsVip = false;
 };
 
+/// Detects users repeating the same (or a similar) message.
+///
+/// Messages aren't kept, only a fingerprint of the normalized message for
+/// exact matches and a MinHash sketch of its bigrams for similar ones.
+/// Similarity is estimated from the sketches alone, so an entry has the same
+/// size no matter how long the message was. Users are kept in a slab of fixed
+/// maximum size per channel and expire through a timing wheel, so neither the
+/// memory nor the cost of a check grows with the number of chatters.
 class RepeatedMessageDetector final
 {
 public:
-    RepeatedMessageDetector() = default;
+    /// Returns the current time in milliseconds since the epoch
+    using Clock = qint64 (*)();
+
+    /// Uses the wall clock if `clock` is null
+    explicit RepeatedMessageDetector(Clock clock = nullptr);
 
     std::optional<int> check(const RepeatedMessageCheck &check);
 
     void clear();
 
+    /// The number of users tracked across all channels
+    size_t trackedUsers() const;
+
 private:
+    /// With 128 hash functions, the standard error of the estimated score
+    /// is about 0.03 at the default threshold (0.8) and 0.045 at the lowest
+    /// one (0.6).
+    static constexpr size_t MINHASH_SIZE = 128;
+
+    struct Sketch {
+        /// Hash of the whole normalized message
+        uint64_t fingerprint = 0;
+        /// The lower 16 bits of the minimum hash of the message's bigrams,
+        /// for each hash function. Repeated bigrams are hashed with their
+        /// occurrence, so this estimates the similarity of the multisets.
+        std::array<uint16_t, MINHASH_SIZE> minHashes{};
+        /// Messages with less than two characters have no bigrams and are
+        /// only matched exactly
+        bool hasBigrams = false;
+    };
+
     struct Entry {
-        QString normalizedMessage;
-        QString messageID;
+        Sketch sketch;
         int repeatCount = 1;
         int missesSinceMatch = 0;
         qint64 expiresAt = 0;
     };
 
-    struct SeenMessage {
-        QString messageID;
-        qint64 expiresAt = 0;
-    };
+    static constexpr size_t SEEN_MESSAGE_IDS = 16;
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
 
-    struct UserCache {
+    struct Slot {
+        uint64_t userKey = 0;
+        qint64 lastSeenAt = 0;
         std::optional<Entry> active;
         std::optional<Entry> candidate;
-        QVector<SeenMessage> seenMessages;
-        qint64 lastSeenAt = 0;
+        /// Ring buffer of message ID hashes
+        std::array<uint64_t, SEEN_MESSAGE_IDS> seenMessages{};
+        uint8_t nextSeenMessage = 0;
+
+        // Position in the timing wheel
+        qint64 expiryTick = 0;
+        uint32_t prev = NO_SLOT;
+        uint32_t next = NO_SLOT;
     };
 
-    using ChannelCache = QHash<QString, UserCache>;
+    static constexpr size_t WHEEL_SIZE = 64;
+
+    /// The users of one channel
+    struct Slab {
+        std::vector<Slot> slots;
+        std::vector<uint32_t> freeSlots;
+        QHash<uint64_t, uint32_t> index;
+
+        /// Slots expiring in each tick, oldest first
+        struct Bucket {
+            uint32_t head = NO_SLOT;
+            uint32_t tail = NO_SLOT;
+        };
+        std::array<Bucket, WHEEL_SIZE> wheel;
+        /// Everything before this tick is expired
+        qint64 tick = 0;
+
+        /// Returns the slot of `userKey`, reusing the slot that expires
+        /// first if the slab is full
+        Slot &acquire(uint64_t userKey, qint64 now);
+        /// Frees all slots that expired before `now`
+        void advance(qint64 now);
+        /// Moves the slot to the bucket of its new expiry
+        void touch(uint32_t slot, qint64 now);
+
+    private:
+        void link(uint32_t slot);
+        void unlink(uint32_t slot);
+        void release(uint32_t slot);
+        uint32_t oldestSlot() const;
+    };
 
     static QString normalizeMessage(const QString &message);
-    static double compare(const QString &first, const QString &second);
-    static bool messagesMatch(const QString &first, const QString &second,
-                              int sensitivityPercent);
+    static uint64_t hash(const QString &text);
+    static void addMinHashes(Sketch &sketch,
+                             const QString &normalizedMessage);
+    /// Estimates the similarity of two messages from their MinHash sketches
+    /// as the Sørensen–Dice coefficient of their bigrams
+    static double estimate(const Sketch &first, const Sketch &second);
     static int sensitivityToPercent(int sensitivity);
-    static Entry makeEntry(const QString &normalizedMessage,
-                           const QString &messageID, qint64 now);
-    static bool hasSeenMessageID(const UserCache &user,
-                                 const QString &messageID);
-    static void rememberMessageID(UserCache &user, const QString &messageID,
-                                  qint64 now);
-
-    static void cleanupUser(UserCache &user, qint64 now);
-    static void cleanupChannel(ChannelCache &channel, qint64 now);
-    static void enforceChannelLimit(ChannelCache &channel);
-
-    QHash<QString, ChannelCache> channels_;
+    static Entry makeEntry(const Sketch &sketch, qint64 now);
+    static bool hasSeenMessageID(const Slot &user, uint64_t messageKey);
+    static void rememberMessageID(Slot &user, uint64_t messageKey);
+    static void cleanupUser(Slot &user, qint64 now);
+
+    Clock clock_;
+    QHash<QString, Slab> channels_;
     int checksSinceCleanup_ = 0;
 };
 
@@ -9,6 +9,7 @@
 #include "common/network/NetworkResult.hpp"
 #include "common/QLogging.hpp"
 #include "messages/Emote.hpp"
+#include "messages/EmoteSnapshot.hpp"
 #include "messages/Image.hpp"
 #include "messages/ImageSet.hpp"
 #include "messages/MessageBuilder.hpp"
@@ -304,36 +305,42 @@ void SeventvEmotes::loadGlobalEmotes()
         return;
     }
 
-    readProviderEmotesCache("global", "seventv", [this](auto jsonDoc) {
-        auto emoteMap = parseEmotes(jsonDoc.object()["emotes"].toArray(),
-                                    SeventvEmoteSetKind::Global);
-        this->setGlobalEmotes(std::make_shared<EmoteMap>(std::move(emoteMap)));
-    });
+    // Revalidate once the snapshot is in, so it can't replace newer emotes
+    emotesnapshot::read("global", "seventv", [this](auto snapshot) {
+        if (snapshot)
+        {
+            this->setGlobalEmotes(
+                std::make_shared<EmoteMap>(std::move(*snapshot)));
+        }
 
-    qCDebug(chatterinoSeventv) << "Loading 7TV Global Emotes";
+        qCDebug(chatterinoSeventv) << "Loading 7TV Global Emotes";
 
-    getApp()->getSeventvAPI()->getEmoteSet(
-        u"global"_s,
-        [this](const auto &json) {
-            writeProviderEmotesCache("global", "seventv",
-                                     QJsonDocument(json).toJson());
-            QJsonArray parsedEmotes = json["emotes"].toArray();
-
-            auto emoteMap =
-                parseEmotes(parsedEmotes, SeventvEmoteSetKind::Global);
-            qCDebug(chatterinoSeventv)
-                << "Loaded" << emoteMap.size() << "7TV Global Emotes";
-            this->setGlobalEmotes(
-                std::make_shared<EmoteMap>(std::move(emoteMap)));
-        },
-        [](const auto &result) {
-            qCWarning(chatterinoSeventv)
-                << "Couldn't load 7TV global emotes" << result.getData();
-        });
+        getApp()->getSeventvAPI()->getEmoteSet(
+            u"global"_s,
+            [this](const auto &json) {
+                QJsonArray parsedEmotes = json["emotes"].toArray();
+
+                auto emoteMap =
+                    parseEmotes(parsedEmotes, SeventvEmoteSetKind::Global);
+                qCDebug(chatterinoSeventv)
+                    << "Loaded" << emoteMap.size() << "7TV Global Emotes";
+                emotesnapshot::write("global", "seventv", emoteMap);
+                this->setGlobalEmotes(
+                    std::make_shared<EmoteMap>(std::move(emoteMap)));
+            },
+            [](const auto &result) {
+                qCWarning(chatterinoSeventv)
+                    << "Couldn't load 7TV global emotes" << result.getData();
+            });
+    });
 }
 
 void SeventvEmotes::setGlobalEmotes(std::shared_ptr<const EmoteMap> emotes)
 {
+    if (sameEmotes(*this->global_.get(), *emotes))
+    {
+        return;
+    }
     this->global_.set(std::move(emotes));
 }
 
@@ -357,13 +364,12 @@ void SeventvEmotes::loadChannelEmotes(
                 auto cleanup = qScopeGuard([loadAttempt] {
                     *loadAttempt = {};
                 });
-                writeProviderEmotesCache(channelId, "seventv",
-                                         QJsonDocument(json).toJson());
                 const auto emoteSet = json["emote_set"].toObject();
                 const auto parsedEmotes = emoteSet["emotes"].toArray();
 
                 auto emoteMap =
                     parseEmotes(parsedEmotes, SeventvEmoteSetKind::Channel);
+                emotesnapshot::write(channelId, "seventv", emoteMap);
                 bool hasEmotes = !emoteMap.empty();
 
                 qCDebug(chatterinoSeventv)
@@ -490,14 +496,13 @@ void SeventvEmotes::loadKickChannelEmotes(
                 auto cleanup = qScopeGuard([loadAttempt] {
                     *loadAttempt = {};
                 });
-                writeProviderEmotesCache(u"kick." % QString::number(userID),
-                                         "seventv",
-                                         QJsonDocument(json).toJson());
                 const auto emoteSet = json["emote_set"].toObject();
                 const auto parsedEmotes = emoteSet["emotes"].toArray();
 
                 auto emoteMap =
                     parseEmotes(parsedEmotes, SeventvEmoteSetKind::Channel);
+                emotesnapshot::write(u"kick." % QString::number(userID),
+                                     "seventv", emoteMap);
                 bool hasEmotes = !emoteMap.empty();
 
                 qCDebug(chatterinoSeventv)
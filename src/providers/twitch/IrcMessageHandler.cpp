@@ -28,6 +28,7 @@
 #include "singletons/Settings.hpp"
 #include "singletons/StreamerMode.hpp"
 #include "singletons/WindowManager.hpp"
+#include "util/DebugCount.hpp"
 #include "util/FormatTime.hpp"
 #include "util/Helpers.hpp"
 #include "util/IrcHelpers.hpp"
@@ -501,6 +502,8 @@ void IrcMessageHandler::parsePrivMessageInto(
     Communi::IrcPrivateMessage *message, MessageSink &sink,
     TwitchChannel *channel)
 {
+    DebugStageTimer timer(DebugStage::IrcMessage);
+
     auto currentUser = getApp()->getAccounts()->twitch.getCurrent();
     if (message->tag("user-id") == currentUser->getUserId())
     {
@@ -848,6 +851,7 @@ void IrcMessageHandler::parseUserNoticeMessageInto(Communi::IrcMessage *message,
                                                    MessageSink &sink,
                                                    TwitchChannel *channel)
 {
+    DebugStageTimer timer(DebugStage::IrcMessage);
     assert(channel != nullptr);
 
     const auto *userDataController = getApp()->getUserData();
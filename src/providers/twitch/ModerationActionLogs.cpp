@@ -1,7 +1,18 @@
 #include "providers/twitch/ModerationActionLogs.hpp"
 
+#include "Application.hpp"
+#include "common/QLogging.hpp"
+#include "singletons/Paths.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QDataStream>
+#include <QFile>
 #include <QPointer>
+#include <QSaveFile>
+#include <QStringBuilder>
+#include <QThreadPool>
 #include <QTimer>
+#include <QTimeZone>
 
 #include <algorithm>
 #include <utility>
@@ -53,6 +64,39 @@ QString normalized(const QString &value)
     return value.trimmed().toLower();
 }
 
+// "CMAL" - Chatterino Moderation Action Log
+constexpr quint32 MAGIC = 0x434D414C;
+
+QString cachePath(const QString &channelId)
+{
+    return getApp()->getPaths().cacheFilePath(channelId % u".modlogs");
+}
+
+/// Reads and writes of the cache files run on this pool. Its only thread
+/// keeps the order in which they were started, so an append can't race a
+/// replace of the same file and a load sees all earlier writes.
+QThreadPool &cacheThreadPool()
+{
+    static auto *pool = [] {
+        auto *pool = new QThreadPool;
+        pool->setMaxThreadCount(1);
+        pool->setExpiryTimeout(5000);
+        return pool;
+    }();
+    return *pool;
+}
+
+void prepare(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_6_0);
+}
+
+qint64 createdAtMs(const GqlModerationActionLogEntry &action)
+{
+    return action.createdAt.isValid() ? action.createdAt.toMSecsSinceEpoch()
+                                      : 0;
+}
+
 }  // namespace
 
 int ModerationActionLogCounts::countedTotal() const
@@ -93,6 +137,238 @@ bool moderationActionKindCounts(GqlModerationActionKind kind)
            kind == GqlModerationActionKind::Timeout;
 }
 
+bool ModerationActionLogCoverage::isEmpty() const
+{
+    return this->newest == 0;
+}
+
+bool ModerationActionLogCoverage::contains(qint64 createdAt) const
+{
+    return !this->isEmpty() && createdAt >= this->oldest &&
+           createdAt <= this->newest;
+}
+
+void ModerationActionLogCoverage::include(qint64 createdAt)
+{
+    if (createdAt == 0)
+    {
+        return;
+    }
+    this->newest = std::max(this->newest, createdAt);
+    this->oldest =
+        this->oldest == 0 ? createdAt : std::min(this->oldest, createdAt);
+}
+
+QByteArray ModerationActionLogCache::serializeHeader()
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    prepare(stream);
+    stream << MAGIC << VERSION;
+    return data;
+}
+
+QByteArray ModerationActionLogCache::serializeChunk(
+    const QVector<GqlModerationActionLogEntry> &actions,
+    const ModerationActionLogCoverage &coverage)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    prepare(stream);
+
+    stream << static_cast<quint32>(actions.size());
+    for (const auto &action : actions)
+    {
+        stream << action.id << createdAtMs(action)
+               << static_cast<quint8>(action.kind) << action.moderatorId
+               << action.moderatorLogin << action.moderatorDisplayName;
+    }
+    stream << coverage.newest << coverage.oldest << coverage.oldestCursor
+           << coverage.reachedEnd;
+
+    return data;
+}
+
+std::optional<ModerationActionLogCache> ModerationActionLogCache::deserialize(
+    QByteArrayView data)
+{
+    // The stream only reads from `data`, it doesn't need a copy
+    auto raw = QByteArray::fromRawData(data.data(), data.size());
+    QDataStream stream(raw);
+    prepare(stream);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != MAGIC ||
+        version != VERSION)
+    {
+        return std::nullopt;
+    }
+
+    ModerationActionLogCache cache;
+    QHash<QString, GqlModerationActionLogEntry> actions;
+    qsizetype records = 0;
+    while (!stream.atEnd())
+    {
+        quint32 count = 0;
+        stream >> count;
+        // Every action takes more than one byte, so this also rejects counts
+        // from corrupted files before reserving space for them.
+        if (stream.status() != QDataStream::Ok ||
+            count > static_cast<quint32>(data.size()))
+        {
+            cache.compact = true;
+            break;
+        }
+
+        QVector<GqlModerationActionLogEntry> chunk;
+        chunk.reserve(count);
+        for (quint32 i = 0; i < count; i++)
+        {
+            GqlModerationActionLogEntry action;
+            qint64 createdAt = 0;
+            quint8 kind = 0;
+            stream >> action.id >> createdAt >> kind >> action.moderatorId >>
+                action.moderatorLogin >> action.moderatorDisplayName;
+            if (createdAt != 0)
+            {
+                action.createdAt =
+                    QDateTime::fromMSecsSinceEpoch(createdAt, QTimeZone::utc());
+            }
+            action.kind = static_cast<GqlModerationActionKind>(std::min(
+                kind, static_cast<quint8>(GqlModerationActionKind::Other)));
+            chunk.push_back(std::move(action));
+        }
+
+        ModerationActionLogCoverage coverage;
+        stream >> coverage.newest >> coverage.oldest >> coverage.oldestCursor >>
+            coverage.reachedEnd;
+        if (stream.status() != QDataStream::Ok)
+        {
+            // An append was interrupted, everything before it is still
+            // valid. Appending after it would make the new chunks unreadable.
+            cache.compact = true;
+            break;
+        }
+
+        records += chunk.size();
+        for (auto &action : chunk)
+        {
+            actions.insert(action.id, std::move(action));
+        }
+        cache.coverage = std::move(coverage);
+    }
+
+    for (const auto &action : actions)
+    {
+        if (cache.coverage.contains(createdAtMs(action)))
+        {
+            cache.ids.insert(action.id);
+            cache.actions.push_back(action);
+        }
+    }
+    if (records - cache.actions.size() > cache.actions.size())
+    {
+        cache.compact = true;
+    }
+
+    return cache;
+}
+
+void ModerationActionLogCache::load(
+    const QString &channelId,
+    std::function<void(ModerationActionLogCache)> callback)
+{
+    if (channelId.isEmpty())
+    {
+        callback({});
+        return;
+    }
+
+    cacheThreadPool().start([path = cachePath(channelId),
+                             callback = std::move(callback)]() mutable {
+        std::optional<ModerationActionLogCache> cache;
+
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly))
+        {
+            auto size = file.size();
+            if (auto *mapped = file.map(0, size))
+            {
+                cache = deserialize(QByteArrayView(mapped, size));
+                file.unmap(mapped);
+            }
+            else
+            {
+                cache = deserialize(file.readAll());
+            }
+
+            if (cache)
+            {
+                qCDebug(chatterinoCache)
+                    << "Loaded moderation action log cache" << path
+                    << cache->actions.size();
+            }
+            else
+            {
+                qCWarning(chatterinoCache)
+                    << "Ignoring invalid moderation action log cache" << path;
+                cache.emplace();
+                cache->compact = true;
+            }
+        }
+
+        postToThread([callback = std::move(callback),
+                      cache = std::move(cache)]() mutable {
+            callback(cache ? std::move(*cache) : ModerationActionLogCache{});
+        });
+    });
+}
+
+void ModerationActionLogCache::append(const QString &channelId,
+                                      QByteArray chunk)
+{
+    cacheThreadPool().start([path = cachePath(channelId),
+                             chunk = std::move(chunk)]() mutable {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Append))
+        {
+            qCWarning(chatterinoCache)
+                << "Failed to open moderation action log cache" << path
+                << file.errorString();
+            return;
+        }
+
+        if (file.size() == 0)
+        {
+            chunk.prepend(serializeHeader());
+        }
+        if (file.write(chunk) != chunk.size())
+        {
+            qCWarning(chatterinoCache)
+                << "Failed to append to moderation action log cache" << path
+                << file.errorString();
+        }
+    });
+}
+
+void ModerationActionLogCache::replace(const QString &channelId,
+                                       QByteArray data)
+{
+    cacheThreadPool().start([path = cachePath(channelId),
+                             data = std::move(data)] {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly) ||
+            file.write(data) != data.size() || !file.commit())
+        {
+            qCWarning(chatterinoCache)
+                << "Failed to write moderation action log cache" << path
+                << file.errorString();
+        }
+    });
+}
+
 ModerationActionLogScanner::ModerationActionLogScanner(
     ModerationActionLogScanRequest request, QObject *parent)
     : QObject(parent)
@@ -114,7 +390,16 @@ void ModerationActionLogScanner::start()
 
     this->running_ = true;
     this->cancelled_ = false;
-    this->fetchNext();
+
+    const QPointer<ModerationActionLogScanner> self(this);
+    ModerationActionLogCache::load(
+        this->request_.channelId, [self](ModerationActionLogCache cache) {
+            if (!self)
+            {
+                return;
+            }
+            self->resume(std::move(cache));
+        });
 }
 
 void ModerationActionLogScanner::cancel()
@@ -144,6 +429,32 @@ ModerationActionLogScanSnapshot ModerationActionLogScanner::snapshot() const
     return snapshot;
 }
 
+void ModerationActionLogScanner::resume(ModerationActionLogCache cache)
+{
+    if (!this->running_)
+    {
+        return;
+    }
+
+    this->cache_ = std::move(cache);
+    for (const auto &action : this->cache_.actions)
+    {
+        if (this->request_.cutoffUtc.isValid() &&
+            action.createdAt < this->request_.cutoffUtc)
+        {
+            continue;
+        }
+        this->processAction(action);
+        this->snapshot_.cachedActions++;
+    }
+    if (this->snapshot_.cachedActions > 0)
+    {
+        this->emitProgress();
+    }
+
+    this->fetchNext();
+}
+
 void ModerationActionLogScanner::fetchNext()
 {
     if (!this->running_ || this->cancelled_)
@@ -176,6 +487,13 @@ void ModerationActionLogScanner::fetchNext()
         });
 }
 
+void ModerationActionLogScanner::fetchNextLater()
+{
+    QTimer::singleShot(this->request_.pageDelayMs, this, [this] {
+        this->fetchNext();
+    });
+}
+
 void ModerationActionLogScanner::processPage(
     const GqlModerationActionLogPage &page)
 {
@@ -188,22 +506,60 @@ void ModerationActionLogScanner::processPage(
     this->snapshot_.rawActionsSeen += static_cast<int>(page.actions.size());
 
     bool stopForCutoff = false;
+    bool reachedCache = false;
     for (const auto &action : page.actions)
     {
+        if (this->phase_ == Phase::Newest && this->isCached(action))
+        {
+            reachedCache = true;
+            break;
+        }
+        // Pages shift when new actions come in while scanning, and the
+        // cached cursor might point into the cache
+        if (this->seen_.contains(action.id) ||
+            this->cache_.ids.contains(action.id))
+        {
+            continue;
+        }
+        this->seen_.insert(action.id);
+
+        // Actions past the cutoff are still cached, so the coverage always
+        // ends at a page boundary
+        this->coverage_.include(createdAtMs(action));
+        if (isShownModerationAction(action.kind))
+        {
+            this->fetched_.push_back(action);
+        }
+
         if (action.createdAt.isValid())
         {
-            this->snapshot_.oldestSeen = action.createdAt;
+            if (!stopForCutoff)
+            {
+                this->snapshot_.oldestSeen = action.createdAt;
+            }
             if (this->request_.cutoffUtc.isValid() &&
                 action.createdAt < this->request_.cutoffUtc)
             {
                 stopForCutoff = true;
-                break;
             }
         }
-        this->processAction(action);
+        if (!stopForCutoff)
+        {
+            this->processAction(action);
+        }
     }
 
     this->snapshot_.lastCursor = page.nextCursor;
+    if (reachedCache)
+    {
+        this->connectToCache();
+    }
+    else
+    {
+        this->coverage_.oldestCursor = page.nextCursor;
+        this->coverage_.reachedEnd =
+            !page.hasNextPage || page.nextCursor.isEmpty();
+    }
     this->emitProgress();
 
     if (this->cancelled_)
@@ -211,6 +567,26 @@ void ModerationActionLogScanner::processPage(
         this->finish();
         return;
     }
+    if (reachedCache)
+    {
+        const auto &cached = this->cache_.coverage;
+        if (this->request_.cutoffUtc.isValid() &&
+            cached.oldest <= this->request_.cutoffUtc.toMSecsSinceEpoch())
+        {
+            this->snapshot_.reachedCutoff = true;
+            this->finish();
+            return;
+        }
+        if (cached.reachedEnd || cached.oldestCursor.isEmpty())
+        {
+            this->finish();
+            return;
+        }
+
+        this->cursor_ = cached.oldestCursor;
+        this->fetchNextLater();
+        return;
+    }
     if (stopForCutoff)
     {
         this->snapshot_.reachedCutoff = true;
@@ -229,9 +605,67 @@ void ModerationActionLogScanner::processPage(
     }
 
     this->cursor_ = page.nextCursor;
-    QTimer::singleShot(this->request_.pageDelayMs, this, [this] {
-        this->fetchNext();
-    });
+    this->fetchNextLater();
+}
+
+bool ModerationActionLogScanner::isCached(
+    const GqlModerationActionLogEntry &action) const
+{
+    const auto &cached = this->cache_.coverage;
+    if (cached.isEmpty())
+    {
+        return false;
+    }
+
+    const auto createdAt = createdAtMs(action);
+    return this->cache_.ids.contains(action.id) ||
+           (createdAt != 0 && createdAt < cached.newest);
+}
+
+void ModerationActionLogScanner::connectToCache()
+{
+    const auto &cached = this->cache_.coverage;
+    this->coverage_.newest = std::max(this->coverage_.newest, cached.newest);
+    this->coverage_.oldest = cached.oldest;
+    this->coverage_.oldestCursor = cached.oldestCursor;
+    this->coverage_.reachedEnd = cached.reachedEnd;
+    this->connected_ = true;
+    this->phase_ = Phase::Older;
+}
+
+void ModerationActionLogScanner::save() const
+{
+    if (this->request_.channelId.isEmpty() || this->coverage_.isEmpty())
+    {
+        return;
+    }
+    if (this->fetched_.isEmpty() && this->coverage_ == this->cache_.coverage)
+    {
+        return;  // nothing new
+    }
+
+    // Without reaching the cache, there's a gap between the fetched actions
+    // and the cached ones, so the cached ones are dropped.
+    if (this->cache_.compact ||
+        (!this->cache_.coverage.isEmpty() && !this->connected_))
+    {
+        auto actions = this->fetched_;
+        if (this->connected_)
+        {
+            actions += this->cache_.actions;
+        }
+        ModerationActionLogCache::replace(
+            this->request_.channelId,
+            ModerationActionLogCache::serializeHeader() +
+                ModerationActionLogCache::serializeChunk(actions,
+                                                         this->coverage_));
+        return;
+    }
+
+    ModerationActionLogCache::append(
+        this->request_.channelId,
+        ModerationActionLogCache::serializeChunk(this->fetched_,
+                                                 this->coverage_));
 }
 
 void ModerationActionLogScanner::processAction(
@@ -285,6 +719,7 @@ void ModerationActionLogScanner::finish(bool truncated)
         return;
     }
     this->running_ = false;
+    this->save();
     this->snapshot_.cancelled = this->cancelled_;
     this->snapshot_.truncated = truncated;
     this->snapshot_.complete = true;
@@ -301,6 +736,7 @@ void ModerationActionLogScanner::fail(const QString &message)
         return;
     }
     this->running_ = false;
+    this->save();
     if (this->onError)
     {
         this->onError(message);
@@ -2,16 +2,22 @@
 
 #include "providers/twitch/api/TwitchGql.hpp"
 
+#include <QByteArray>
+#include <QByteArrayView>
 #include <QDateTime>
 #include <QHash>
 #include <QObject>
+#include <QSet>
 #include <QString>
 #include <QVector>
 
 #include <functional>
+#include <optional>
 
 namespace chatterino {
 
+class ModerationActionLogScannerTestAccess;
+
 struct ModerationActionLogCounts {
     int bans = 0;
     int timeouts = 0;
@@ -47,6 +53,9 @@ struct ModerationActionLogScanSnapshot {
     bool truncated = false;
     bool complete = false;
     bool cancelled = false;
+    /// Actions in the range that were read from the local cache instead of
+    /// being fetched again
+    int cachedActions = 0;
     QString lastCursor;
     QDateTime oldestSeen;
 };
@@ -54,6 +63,71 @@ struct ModerationActionLogScanSnapshot {
 QString moderationActionKindText(GqlModerationActionKind kind);
 bool moderationActionKindCounts(GqlModerationActionKind kind);
 
+/// The part of a channel's action log that was scanned without gaps
+struct ModerationActionLogCoverage {
+    /// Milliseconds since epoch of the newest and oldest scanned action,
+    /// 0 if nothing was scanned yet
+    qint64 newest = 0;
+    qint64 oldest = 0;
+    /// Cursor of the page following the oldest scanned action
+    QString oldestCursor;
+    /// True if the start of the log was reached
+    bool reachedEnd = false;
+
+    [[nodiscard]] bool isEmpty() const;
+    [[nodiscard]] bool contains(qint64 createdAt) const;
+    void include(qint64 createdAt);
+
+    bool operator==(const ModerationActionLogCoverage &other) const = default;
+};
+
+/// Bans and timeouts of a channel from previous scans, stored in the cache
+/// directory as `<channelId>.modlogs`.
+///
+/// The file is append-only: every scan appends the actions it fetched
+/// followed by the part of the log that is covered now. The last coverage
+/// wins, duplicates and actions outside of it are dropped when loading.
+struct ModerationActionLogCache {
+    /// Increase this when changing the format
+    static constexpr quint32 VERSION = 1;
+
+    /// Actions inside of `coverage`, in no particular order
+    QVector<GqlModerationActionLogEntry> actions;
+    QSet<QString> ids;
+    ModerationActionLogCoverage coverage;
+    /// Set if the file should be rewritten instead of appended to, because
+    /// it's invalid or mostly contains dropped actions
+    bool compact = false;
+
+    static QByteArray serializeHeader();
+    static QByteArray serializeChunk(
+        const QVector<GqlModerationActionLogEntry> &actions,
+        const ModerationActionLogCoverage &coverage);
+    /// Returns std::nullopt if `data` doesn't start with a header of this
+    /// version. A truncated last chunk is ignored.
+    static std::optional<ModerationActionLogCache> deserialize(
+        QByteArrayView data);
+
+    /// Reads the cache of `channelId` on a worker thread and calls
+    /// `callback` with it on the GUI thread. The cache is empty if there's
+    /// no valid file.
+    ///
+    /// Loads, appends and replaces share one worker thread, so they run in
+    /// the order they were called in.
+    static void load(const QString &channelId,
+                     std::function<void(ModerationActionLogCache)> callback);
+    /// Appends `chunk` to the file of `channelId` on a worker thread
+    static void append(const QString &channelId, QByteArray chunk);
+    /// Replaces the file of `channelId` with `data` on a worker thread
+    static void replace(const QString &channelId, QByteArray data);
+};
+
+/// Counts bans and timeouts per moderator in a channel's action log.
+///
+/// Actions from previous scans are read from the `ModerationActionLogCache`,
+/// so only pages newer than the cached ones are fetched, followed by the
+/// pages older than the cache if it doesn't reach back to the cutoff.
+/// `onProgress` is called after the cache was read and after every page.
 class ModerationActionLogScanner : public QObject
 {
 public:
@@ -70,13 +144,27 @@ public:
     std::function<void(const QString &)> onError;
 
 private:
+    friend class ModerationActionLogScannerTestAccess;
+
     struct Accumulator {
         ModerationActionLogModeratorSummary summary;
     };
 
+    enum class Phase {
+        /// Fetching the actions newer than the cache
+        Newest,
+        /// Fetching the actions older than the cache
+        Older,
+    };
+
+    void resume(ModerationActionLogCache cache);
     void fetchNext();
+    void fetchNextLater();
     void processPage(const GqlModerationActionLogPage &page);
     void processAction(const GqlModerationActionLogEntry &action);
+    bool isCached(const GqlModerationActionLogEntry &action) const;
+    void connectToCache();
+    void save() const;
     void emitProgress() const;
     void finish(bool truncated = false);
     void fail(const QString &message);
@@ -88,6 +176,16 @@ private:
     ModerationActionLogScanSnapshot snapshot_;
     QHash<QString, Accumulator> moderators_;
     QString cursor_;
+    Phase phase_ = Phase::Newest;
+
+    ModerationActionLogCache cache_;
+    /// The coverage of the cache after this scan
+    ModerationActionLogCoverage coverage_;
+    bool connected_ = false;
+    /// Fetched actions that weren't cached yet
+    QVector<GqlModerationActionLogEntry> fetched_;
+    QSet<QString> seen_;
+
     bool running_ = false;
     bool cancelled_ = false;
 };
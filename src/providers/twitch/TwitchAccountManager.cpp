@@ -84,7 +84,7 @@ void checkMissingScopes(const std::shared_ptr<TwitchAccount> &account)
                 {
                     manager.currentUsername = currentUsername;
                 }
-                getSettings()->requestSave();
+                getSettings()->queueSave();
                 app->getAccounts()->twitch.currentUserNameChanged.invoke();
             }
 
@@ -383,7 +383,8 @@ void TwitchAccountManager::load()
         {
             qCDebug(chatterinoTwitch)
                 << "Twitch user updated to" << newUsername;
-            getHelix()->update(user->getOAuthClient(), user->getOAuthToken());
+            getHelix()->update(user->getOAuthClient(), user->getUserId(),
+                               user->getOAuthToken());
             this->currentUser_ = user;
         }
         else
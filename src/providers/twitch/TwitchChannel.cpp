@@ -17,6 +17,7 @@
 #include "controllers/twitch/LiveController.hpp"
 #include "debug/AssertInGuiThread.hpp"
 #include "messages/Emote.hpp"
+#include "messages/EmoteSnapshot.hpp"
 #include "messages/Image.hpp"
 #include "messages/Link.hpp"
 #include "messages/Message.hpp"
@@ -1201,26 +1202,34 @@ void TwitchChannel::refreshBTTVChannelEmotes(bool manualRefresh)
         return;
     }
 
-    bool cacheHit = readProviderEmotesCache(
+    // Revalidate once the snapshot is in, so it can't replace newer emotes
+    emotesnapshot::read(
         this->roomId(), "betterttv",
-        [this, weak = weakOf<Channel>(this)](const auto &jsonDoc) {
-            if (auto shared = weak.lock())
+        [this, weak = weakOf<Channel>(this), manualRefresh](auto snapshot) {
+            auto shared = weak.lock();
+            if (!shared)
             {
-                auto emoteMap = bttv::detail::parseChannelEmotes(
-                    jsonDoc.object(), this->getLocalizedName());
-                this->setBttvEmotes(std::make_shared<const EmoteMap>(emoteMap));
+                return;
             }
-        });
 
-    BttvEmotes::loadChannel(
-        weakOf<Channel>(this), this->roomId(), this->getLocalizedName(),
-        [this, weak = weakOf<Channel>(this)](auto &&emoteMap) {
-            if (auto shared = weak.lock())
+            bool cacheHit = snapshot.has_value();
+            if (snapshot)
             {
-                this->setBttvEmotes(std::make_shared<const EmoteMap>(emoteMap));
+                this->setBttvEmotes(
+                    std::make_shared<const EmoteMap>(std::move(*snapshot)));
             }
-        },
-        manualRefresh, cacheHit);
+
+            BttvEmotes::loadChannel(
+                weak, this->roomId(), this->getLocalizedName(),
+                [this, weak](auto &&emoteMap) {
+                    if (auto shared = weak.lock())
+                    {
+                        this->setBttvEmotes(
+                            std::make_shared<const EmoteMap>(emoteMap));
+                    }
+                },
+                manualRefresh, cacheHit);
+        });
 }
 
 void TwitchChannel::refreshFFZChannelEmotes(bool manualRefresh)
@@ -1231,43 +1240,57 @@ void TwitchChannel::refreshFFZChannelEmotes(bool manualRefresh)
         return;
     }
 
-    bool cacheHit = readProviderEmotesCache(
-        this->roomId(), "frankerfacez", [this](const auto &jsonDoc) {
-            auto emoteMap = ffz::detail::parseChannelEmotes(jsonDoc.object());
-            this->setFfzEmotes(std::make_shared<const EmoteMap>(emoteMap));
-        });
-
-    FfzEmotes::loadChannel(
-        weakOf<Channel>(this), this->roomId(),
-        [this, weak = weakOf<Channel>(this)](auto &&emoteMap) {
-            if (auto shared = weak.lock())
-            {
-                this->setFfzEmotes(std::make_shared<const EmoteMap>(emoteMap));
-            }
-        },
-        [this, weak = weakOf<Channel>(this)](auto &&modBadge) {
-            if (auto shared = weak.lock())
-            {
-                this->ffzCustomModBadge_.set(
-                    std::forward<decltype(modBadge)>(modBadge));
-            }
-        },
-        [this, weak = weakOf<Channel>(this)](auto &&vipBadge) {
-            if (auto shared = weak.lock())
+    // Revalidate once the snapshot is in, so it can't replace newer emotes
+    emotesnapshot::read(
+        this->roomId(), "frankerfacez",
+        [this, weak = weakOf<Channel>(this), manualRefresh](auto snapshot) {
+            auto shared = weak.lock();
+            if (!shared)
             {
-                this->ffzCustomVipBadge_.set(
-                    std::forward<decltype(vipBadge)>(vipBadge));
+                return;
             }
-        },
-        [this, weak = weakOf<Channel>(this)](auto &&channelBadges) {
-            if (auto shared = weak.lock())
+
+            bool cacheHit = snapshot.has_value();
+            if (snapshot)
             {
-                this->tgFfzChannelBadges_.guard();
-                this->ffzChannelBadges_ =
-                    std::forward<decltype(channelBadges)>(channelBadges);
+                this->setFfzEmotes(
+                    std::make_shared<const EmoteMap>(std::move(*snapshot)));
             }
-        },
-        manualRefresh, cacheHit);
+
+            FfzEmotes::loadChannel(
+                weak, this->roomId(),
+                [this, weak](auto &&emoteMap) {
+                    if (auto shared = weak.lock())
+                    {
+                        this->setFfzEmotes(
+                            std::make_shared<const EmoteMap>(emoteMap));
+                    }
+                },
+                [this, weak](auto &&modBadge) {
+                    if (auto shared = weak.lock())
+                    {
+                        this->ffzCustomModBadge_.set(
+                            std::forward<decltype(modBadge)>(modBadge));
+                    }
+                },
+                [this, weak](auto &&vipBadge) {
+                    if (auto shared = weak.lock())
+                    {
+                        this->ffzCustomVipBadge_.set(
+                            std::forward<decltype(vipBadge)>(vipBadge));
+                    }
+                },
+                [this, weak](auto &&channelBadges) {
+                    if (auto shared = weak.lock())
+                    {
+                        this->tgFfzChannelBadges_.guard();
+                        this->ffzChannelBadges_ =
+                            std::forward<decltype(channelBadges)>(
+                                channelBadges);
+                    }
+                },
+                manualRefresh, cacheHit);
+        });
 }
 
 void TwitchChannel::refreshSevenTVChannelEmotes(bool manualRefresh)
@@ -1278,45 +1301,64 @@ void TwitchChannel::refreshSevenTVChannelEmotes(bool manualRefresh)
         return;
     }
 
-    bool cacheHit = readProviderEmotesCache(
-        this->roomId(), "seventv", [this](const auto &jsonDoc) {
-            const auto json = jsonDoc.object();
-            const auto emoteSet = json["emote_set"].toObject();
-            const auto parsedEmotes = emoteSet["emotes"].toArray();
-            auto emoteMap = seventv::detail::parseEmotes(
-                parsedEmotes, SeventvEmoteSetKind::Channel);
-            this->setSeventvEmotes(std::make_shared<const EmoteMap>(emoteMap));
-        });
+    // Revalidate once the snapshot is in, so it can't replace newer emotes
+    emotesnapshot::read(
+        this->roomId(), "seventv",
+        [this, weak = weakOf<Channel>(this), manualRefresh](auto snapshot) {
+            auto shared = weak.lock();
+            if (!shared)
+            {
+                return;
+            }
 
-    SeventvEmotes::loadChannelEmotes(
-        weakOf<Channel>(this), this->roomId(),
-        [this, weak = weakOf<Channel>(this)](auto &&emoteMap,
-                                             const auto &channelInfo) {
-            if (auto shared = weak.lock())
+            bool cacheHit = snapshot.has_value();
+            if (snapshot)
             {
                 this->setSeventvEmotes(
-                    std::make_shared<const EmoteMap>(emoteMap));
-                this->updateSeventvData(channelInfo.userID,
-                                        channelInfo.emoteSetID);
-                this->seventvUserTwitchConnectionIndex_ =
-                    channelInfo.twitchConnectionIndex;
+                    std::make_shared<const EmoteMap>(std::move(*snapshot)));
             }
-        },
-        manualRefresh, cacheHit);
+
+            SeventvEmotes::loadChannelEmotes(
+                weak, this->roomId(),
+                [this, weak](auto &&emoteMap, const auto &channelInfo) {
+                    if (auto shared = weak.lock())
+                    {
+                        this->setSeventvEmotes(
+                            std::make_shared<const EmoteMap>(emoteMap));
+                        this->updateSeventvData(channelInfo.userID,
+                                                channelInfo.emoteSetID);
+                        this->seventvUserTwitchConnectionIndex_ =
+                            channelInfo.twitchConnectionIndex;
+                    }
+                },
+                manualRefresh, cacheHit);
+        });
 }
 
 void TwitchChannel::setBttvEmotes(std::shared_ptr<const EmoteMap> &&map)
 {
+    if (sameEmotes(*this->bttvEmotes_.get(), *map))
+    {
+        return;
+    }
     this->bttvEmotes_.set(std::move(map));
 }
 
 void TwitchChannel::setFfzEmotes(std::shared_ptr<const EmoteMap> &&map)
 {
+    if (sameEmotes(*this->ffzEmotes_.get(), *map))
+    {
+        return;
+    }
     this->ffzEmotes_.set(std::move(map));
 }
 
 void TwitchChannel::setSeventvEmotes(std::shared_ptr<const EmoteMap> &&map)
 {
+    if (sameEmotes(*this->seventvEmotes_.get(), *map))
+    {
+        return;
+    }
     this->seventvEmotes_.set(std::move(map));
 }
 
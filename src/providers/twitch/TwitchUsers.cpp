@@ -4,9 +4,11 @@
 
 #include "providers/twitch/TwitchUsers.hpp"
 
+#include "Application.hpp"
 #include "common/QLogging.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "providers/twitch/TwitchUser.hpp"
+#include "providers/UserMetadataStore.hpp"
 
 #include <boost/unordered/unordered_flat_map.hpp>
 #include <QStringList>
@@ -94,6 +96,21 @@ std::shared_ptr<TwitchUser> TwitchUsersPrivate::makeUnresolved(const UserId &id)
         return ptr;
     }
 
+    if (auto *userMetadata = getApp()->getUserMetadata())
+    {
+        using Field = UserMetadataStore::Field;
+        auto login = userMetadata->get(id.string, Field::Login);
+        auto displayName = userMetadata->get(id.string, Field::DisplayName);
+        auto picture = userMetadata->get(id.string, Field::ProfilePictureUrl);
+        if (login && displayName && picture)
+        {
+            ptr->name = *login;
+            ptr->displayName = *displayName;
+            ptr->profilePictureUrl = *picture;
+            return ptr;
+        }
+    }
+
     this->unresolved.append(id.string);
     if (!this->isResolving && !this->nextBatchTimer.isActive())
     {
@@ -147,6 +164,18 @@ void TwitchUsersPrivate::updateUsers(const std::vector<HelixUser> &users)
         }
         cached->second->update(user);
     }
+
+    if (auto *userMetadata = getApp()->getUserMetadata())
+    {
+        using Field = UserMetadataStore::Field;
+        for (const auto &user : users)
+        {
+            userMetadata->set(user.id, user.login, Field::DisplayName,
+                              user.displayName);
+            userMetadata->set(user.id, user.login, Field::ProfilePictureUrl,
+                              user.profileImageUrl);
+        }
+    }
 }
 
 }  // namespace chatterino
@@ -0,0 +1,227 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/twitch/api/GqlBatcher.hpp"
+
+#include "common/network/NetworkResult.hpp"
+#include "common/QLogging.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QJsonDocument>
+
+#include <utility>
+
+namespace {
+
+using namespace chatterino;
+
+QVariant statusVariant(const NetworkResult &result)
+{
+    if (auto status = result.status())
+    {
+        return *status;
+    }
+    return {};
+}
+
+}  // namespace
+
+namespace chatterino {
+
+GqlBatcher::GqlBatcher(Send send)
+    : GqlBatcher(std::move(send), Options{})
+{
+}
+
+GqlBatcher::GqlBatcher(Send send, Options options)
+    : send_(std::move(send))
+    , options_(options)
+{
+    this->flushTimer_.setSingleShot(true);
+    QObject::connect(&this->flushTimer_, &QTimer::timeout, [this] {
+        this->flush();
+    });
+}
+
+GqlBatcher::~GqlBatcher() = default;
+
+void GqlBatcher::add(Operation operation)
+{
+    DebugCount::increase(DebugObject::GqlOperation);
+
+    std::unique_lock lock(this->mutex_);
+    if (!this->pending_.empty() &&
+        this->pending_.front().token != operation.token)
+    {
+        Batch batch;
+        batch.swap(this->pending_);
+        this->pending_.emplace_back(std::move(operation));
+        lock.unlock();
+        // The timer that's already running flushes the new operation
+        this->send(std::move(batch));
+        return;
+    }
+    this->pending_.emplace_back(std::move(operation));
+
+    if (std::cmp_greater_equal(this->pending_.size(),
+                               this->options_.maxBatchSize))
+    {
+        Batch batch;
+        batch.swap(this->pending_);
+        lock.unlock();
+        this->send(std::move(batch));
+        return;
+    }
+
+    if (this->pending_.size() == 1)
+    {
+        // The timer can only be started from its own thread
+        QMetaObject::invokeMethod(&this->flushTimer_, [this] {
+            if (!this->flushTimer_.isActive())
+            {
+                this->flushTimer_.start(this->options_.latencyBudget);
+            }
+        });
+    }
+}
+
+void GqlBatcher::flush()
+{
+    Batch batch;
+    {
+        std::lock_guard lock(this->mutex_);
+        batch.swap(this->pending_);
+    }
+
+    if (!batch.empty())
+    {
+        this->send(std::move(batch));
+    }
+}
+
+size_t GqlBatcher::pending() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->pending_.size();
+}
+
+void GqlBatcher::send(Batch batch)
+{
+    DebugCount::increase(DebugObject::GqlRoundTrip);
+
+    QJsonArray payload;
+    for (const auto &operation : batch)
+    {
+        payload.append(operation.payload);
+    }
+
+    auto token = batch.front().token;
+    auto shared = std::make_shared<Batch>(std::move(batch));
+    this->send_(token, payload,
+                [shared](bool ok, const NetworkResult &result) {
+                    deliver(*shared, ok, result);
+                });
+}
+
+void GqlBatcher::deliver(Batch &batch, bool ok, const NetworkResult &result)
+{
+    if (!ok)
+    {
+        for (auto &operation : batch)
+        {
+            if (operation.onError)
+            {
+                operation.onError(result);
+            }
+        }
+        return;
+    }
+
+    auto root = result.parseJsonValue();
+    if (!root.isArray())
+    {
+        // Errors about the whole request (e.g. a bad token) come as one
+        // object, which every operation can handle on its own.
+        for (auto &operation : batch)
+        {
+            if (operation.onSuccess)
+            {
+                operation.onSuccess(result);
+            }
+        }
+        return;
+    }
+
+    auto responses = root.toArray();
+    if (responses.size() != static_cast<qsizetype>(batch.size()))
+    {
+        qCWarning(chatterinoTwitch)
+            << "GQL batch of" << batch.size() << "operations got"
+            << responses.size() << "responses";
+    }
+
+    auto status = statusVariant(result);
+    for (qsizetype i = 0; std::cmp_less(i, batch.size()); i++)
+    {
+        auto &operation = batch[static_cast<size_t>(i)];
+        if (i >= responses.size())
+        {
+            if (operation.onError)
+            {
+                operation.onError(NetworkResult(
+                    NetworkResult::NetworkError::UnknownContentError, status,
+                    {}));
+            }
+            continue;
+        }
+
+        QJsonDocument document;
+        if (operation.wrapInArray)
+        {
+            document.setArray(QJsonArray{responses.at(i)});
+        }
+        else
+        {
+            document.setObject(responses.at(i).toObject());
+        }
+
+        if (operation.onSuccess)
+        {
+            operation.onSuccess(NetworkResult(
+                NetworkResult::NetworkError::NoError, status,
+                document.toJson(QJsonDocument::Compact)));
+        }
+    }
+}
+
+BatchedGqlRequest::BatchedGqlRequest(std::shared_ptr<GqlBatcher> batcher,
+                                     QString token, QJsonObject payload,
+                                     bool wrapInArray)
+    : batcher_(std::move(batcher))
+    , operation_{
+          .payload = std::move(payload),
+          .wrapInArray = wrapInArray,
+          .token = std::move(token),
+      }
+{
+}
+
+BatchedGqlRequest BatchedGqlRequest::onSuccess(NetworkSuccessCallback cb) &&
+{
+    this->operation_.onSuccess = std::move(cb);
+    return std::move(*this);
+}
+
+BatchedGqlRequest BatchedGqlRequest::onError(NetworkErrorCallback cb) &&
+{
+    this->operation_.onError = std::move(cb);
+    return std::move(*this);
+}
+
+void BatchedGqlRequest::execute() &&
+{
+    this->batcher_->add(std::move(this->operation_));
+}
+
+}  // namespace chatterino
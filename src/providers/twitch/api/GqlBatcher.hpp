@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "common/network/NetworkCommon.hpp"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <QTimer>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+
+class NetworkResult;
+
+/// Combines GQL operations into batched requests.
+///
+/// GQL accepts an array of operations in one POST and answers with an array
+/// of the same length. Operations added within the latency budget are sent
+/// together, and each callback gets its own part of the response as if the
+/// operation had been sent alone. Only operations with the same token are
+/// sent together.
+class GqlBatcher
+{
+public:
+    struct Options {
+        /// The maximum number of operations in one request
+        qsizetype maxBatchSize = 20;
+        /// How long the first operation of a batch waits for others
+        std::chrono::milliseconds latencyBudget{10};
+    };
+
+    /// Called with the response to a batch. `ok` is false if the request
+    /// failed.
+    using Done = std::function<void(bool ok, const NetworkResult &result)>;
+    /// Sends `payload` with `token` and calls `done` with the response
+    using Send = std::function<void(const QString &token,
+                                    const QJsonArray &payload, Done done)>;
+
+    struct Operation {
+        QJsonObject payload;
+        /// Whether the caller expects an array with one response instead of
+        /// the response object
+        bool wrapInArray = true;
+        NetworkSuccessCallback onSuccess;
+        NetworkErrorCallback onError;
+        /// The token the operation is sent with
+        QString token;
+    };
+
+    explicit GqlBatcher(Send send);
+    GqlBatcher(Send send, Options options);
+    ~GqlBatcher();
+
+    GqlBatcher(const GqlBatcher &) = delete;
+    GqlBatcher(GqlBatcher &&) = delete;
+    GqlBatcher &operator=(const GqlBatcher &) = delete;
+    GqlBatcher &operator=(GqlBatcher &&) = delete;
+
+    /// Queues `operation` for the next batch. Can be called from any thread.
+    ///
+    /// If the pending operations use a different token, they're sent first.
+    void add(Operation operation);
+
+    /// Sends the queued operations now
+    void flush();
+
+    /// The number of operations waiting for their batch to be sent
+    size_t pending() const;
+
+private:
+    using Batch = std::vector<Operation>;
+
+    void send(Batch batch);
+    static void deliver(Batch &batch, bool ok, const NetworkResult &result);
+
+    const Send send_;
+    const Options options_;
+
+    mutable std::mutex mutex_;
+    Batch pending_;
+
+    /// Flushes the pending batch once the latency budget is used up. Lives
+    /// on the thread the batcher was created on.
+    QTimer flushTimer_;
+};
+
+/// A GQL operation that's sent in a batch once it's executed.
+///
+/// This mirrors the builder interface of NetworkRequest.
+class BatchedGqlRequest
+{
+public:
+    BatchedGqlRequest(std::shared_ptr<GqlBatcher> batcher, QString token,
+                      QJsonObject payload, bool wrapInArray = true);
+
+    BatchedGqlRequest onSuccess(NetworkSuccessCallback cb) &&;
+    BatchedGqlRequest onError(NetworkErrorCallback cb) &&;
+    void execute() &&;
+
+private:
+    std::shared_ptr<GqlBatcher> batcher_;
+    GqlBatcher::Operation operation_;
+};
+
+}  // namespace chatterino
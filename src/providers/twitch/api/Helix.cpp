@@ -9,6 +9,7 @@
 #include "common/Literals.hpp"
 #include "common/network/NetworkRequest.hpp"
 #include "common/network/NetworkResult.hpp"
+#include "common/network/RequestScheduler.hpp"
 #include "common/QLogging.hpp"
 #include "util/CancellationToken.hpp"
 #include "util/QMagicEnum.hpp"
@@ -25,6 +26,30 @@ constexpr auto NUM_MODERATORS_TO_FETCH_PER_REQUEST = 100;
 
 constexpr auto NUM_CHATTERS_TO_FETCH = 1000;
 
+/// Twitch limits requests per client and user, so refreshed tokens share the
+/// scheduler (and its bucket) of the previous one
+std::shared_ptr<RequestScheduler> makeScheduler(const QString &clientID,
+                                                const QString &userID)
+{
+    return RequestScheduler::forKey(u"helix:" % clientID % u':' % userID, {});
+}
+
+RequestPriority requestPriority(const QString &url, NetworkRequestType type)
+{
+    // Polled regularly, nobody is waiting for these
+    if (type == NetworkRequestType::Get &&
+        (url == u"streams" || url == u"chat/chatters"))
+    {
+        return RequestPriority::Background;
+    }
+    if (type == NetworkRequestType::Get || url == u"eventsub/subscriptions")
+    {
+        return RequestPriority::Visible;
+    }
+    // Moderation and other actions
+    return RequestPriority::Interactive;
+}
+
 }  // namespace
 
 namespace chatterino {
@@ -4072,7 +4097,13 @@ NetworkRequest Helix::makeRequest(const QString &url, const QUrlQuery &urlQuery,
 
     fullUrl.setQuery(urlQuery);
 
+    if (!this->scheduler)
+    {
+        this->scheduler = makeScheduler(this->clientId, this->userId);
+    }
+
     return NetworkRequest(fullUrl, type)
+        .scheduler(this->scheduler, requestPriority(url, type))
         .useProxy()
         .timeout(5 * 1000)
         .header("Accept", "application/json")
@@ -4169,10 +4200,12 @@ void Helix::paginate(
         .execute();
 }
 
-void Helix::update(QString clientId, QString oauthToken)
+void Helix::update(QString clientId, QString userId, QString oauthToken)
 {
     this->clientId = std::move(clientId);
+    this->userId = std::move(userId);
     this->oauthToken = std::move(oauthToken);
+    this->scheduler = makeScheduler(this->clientId, this->userId);
 }
 
 void Helix::initialize()
@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <unordered_set>
 #include <vector>
@@ -34,6 +35,7 @@ template <typename... T>
 using ResultCallback = std::function<void(T...)>;
 
 class CancellationToken;
+class RequestScheduler;
 
 struct HelixUser {
     QString id;
@@ -1156,7 +1158,8 @@ public:
         const QString &messageID, ResultCallback<> successCallback,
         FailureCallback<HelixUnpinMessageError, QString> failureCallback) = 0;
 
-    virtual void update(QString clientId, QString oauthToken) = 0;
+    virtual void update(QString clientId, QString userId,
+                        QString oauthToken) = 0;
 
 protected:
     // https://dev.twitch.tv/docs/api/reference#update-chat-settings
@@ -1585,7 +1588,7 @@ public:
         const QString &messageID, ResultCallback<> successCallback,
         FailureCallback<HelixUnpinMessageError, QString> failureCallback) final;
 
-    void update(QString clientId, QString oauthToken) final;
+    void update(QString clientId, QString userId, QString oauthToken) final;
 
     static void initialize();
 
@@ -1646,7 +1649,9 @@ private:
                   CancellationToken &&token);
 
     QString clientId;
+    QString userId;
     QString oauthToken;
+    std::shared_ptr<RequestScheduler> scheduler;
 };
 
 // initializeHelix sets the helix instance to _instance
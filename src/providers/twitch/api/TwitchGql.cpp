@@ -6,7 +6,9 @@
 
 #include "common/network/NetworkRequest.hpp"
 #include "common/network/NetworkResult.hpp"
+#include "common/network/RequestScheduler.hpp"
 #include "common/QLogging.hpp"
+#include "providers/twitch/api/GqlBatcher.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "util/Helpers.hpp"
 #include "util/RapidjsonHelpers.hpp"
@@ -20,6 +22,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <initializer_list>
 #include <limits>
 #include <utility>
@@ -117,6 +120,14 @@ constexpr auto TWITCH_GQL_TV_ORIGIN = "https://android.tv.twitch.tv";
 constexpr auto TWITCH_GQL_TV_REFERER = "https://android.tv.twitch.tv/";
 constexpr int TWITCH_GQL_TIMEOUT_MS = 15 * 1000;
 
+/// GQL doesn't send rate limit headers, this only bounds the requests in
+/// flight and backs off after a 429.
+std::shared_ptr<RequestScheduler> gqlScheduler()
+{
+    static auto scheduler = RequestScheduler::forKey(u"gql"_s, {});
+    return scheduler;
+}
+
 NetworkRequest makeGqlRequest(const char *query, const QJsonObject &variables,
                               const std::shared_ptr<TwitchAccount> &account)
 {
@@ -126,6 +137,7 @@ NetworkRequest makeGqlRequest(const char *query, const QJsonObject &variables,
 
     auto request =
         NetworkRequest("https://gql.twitch.tv/gql", NetworkRequestType::Post)
+            .scheduler(gqlScheduler(), RequestPriority::Visible)
             .useProxy()
             .timeout(TWITCH_GQL_TIMEOUT_MS)
             .header("Client-Id", "kimne78kx3ncx6br8ac4cd5ao176ut")
@@ -144,37 +156,9 @@ NetworkRequest makeGqlRequest(const char *query, const QJsonObject &variables,
     return request;
 }
 
-NetworkRequest makeGqlRequest(const char *query, const QJsonObject &variables,
-                              const QString &oauthToken)
-{
-    QJsonObject payload;
-    payload.insert("query", query);
-    payload.insert("variables", variables);
-
-    auto request =
-        NetworkRequest("https://gql.twitch.tv/gql", NetworkRequestType::Post)
-            .useProxy()
-            .timeout(TWITCH_GQL_TIMEOUT_MS)
-            .header("Client-Id", "kimne78kx3ncx6brgo4mv6wki5h1ko")
-            .header("Client-Session-Id", twitchGqlSessionId())
-            .header("Client-Version", TWITCH_GQL_BROWSER_CLIENT_VERSION)
-            .header("User-Agent", TWITCH_GQL_BROWSER_USER_AGENT)
-            .header("X-Device-Id", twitchGqlDeviceId())
-            .json(payload);
-
-    const auto normalizedToken = normalizeCustomTwitchAuthToken(oauthToken);
-    if (!normalizedToken.isEmpty())
-    {
-        request = std::move(request).header("Authorization",
-                                            "OAuth " + normalizedToken);
-    }
-
-    return request;
-}
-
-NetworkRequest makePersistedGqlRequest(
-    const QString &operationName, const QString &sha256Hash,
-    const QJsonObject &variables, const std::shared_ptr<TwitchAccount> &account)
+QJsonObject persistedPayload(const QString &operationName,
+                             const QJsonObject &variables,
+                             const QString &sha256Hash)
 {
     QJsonObject payload;
     payload.insert("operationName", operationName);
@@ -187,68 +171,45 @@ NetworkRequest makePersistedGqlRequest(
     QJsonObject extensions;
     extensions.insert("persistedQuery", persistedQuery);
     payload.insert("extensions", extensions);
+    return payload;
+}
 
-    QJsonArray payloadArray;
-    payloadArray.append(payload);
+enum class GqlClient : uint8_t {
+    Web,
+    Tv,
+};
 
+NetworkRequest makeGqlBatchRequest(GqlClient client,
+                                   const QJsonArray &payloadArray,
+                                   const QString &normalizedToken)
+{
     auto request =
         NetworkRequest("https://gql.twitch.tv/gql", NetworkRequestType::Post)
+            .scheduler(gqlScheduler(), RequestPriority::Visible)
             .useProxy()
             .timeout(TWITCH_GQL_TIMEOUT_MS)
-            .header(
-                "Client-Id",
-                "kimne78kx3ncx6brgo4mv6wki5h1ko")  // Web client ID required for these endpoints
             .header("Client-Session-Id", twitchGqlSessionId())
             .header("Client-Version", TWITCH_GQL_BROWSER_CLIENT_VERSION)
-            .header("User-Agent", TWITCH_GQL_BROWSER_USER_AGENT)
             .header("X-Device-Id", twitchGqlDeviceId())
             .json(payloadArray);
 
-    if (account)
+    switch (client)
     {
-        const auto &token = account->getOAuthToken();
-        if (!token.isEmpty())
-        {
-            request =
-                std::move(request).header("Authorization", "OAuth " + token);
-        }
+        case GqlClient::Web:
+            // Web client ID required for these endpoints
+            request = std::move(request)
+                          .header("Client-Id", "kimne78kx3ncx6brgo4mv6wki5h1ko")
+                          .header("User-Agent", TWITCH_GQL_BROWSER_USER_AGENT);
+            break;
+        case GqlClient::Tv:
+            request = std::move(request)
+                          .header("Client-Id", TWITCH_GQL_TV_CLIENT_ID)
+                          .header("Origin", TWITCH_GQL_TV_ORIGIN)
+                          .header("Referer", TWITCH_GQL_TV_REFERER)
+                          .header("User-Agent", TWITCH_GQL_TV_USER_AGENT);
+            break;
     }
 
-    return request;
-}
-
-NetworkRequest makePersistedGqlRequest(const QString &operationName,
-                                       const QString &sha256Hash,
-                                       const QJsonObject &variables,
-                                       const QString &oauthToken)
-{
-    QJsonObject payload;
-    payload.insert("operationName", operationName);
-    payload.insert("variables", variables);
-
-    QJsonObject persistedQuery;
-    persistedQuery.insert("version", 1);
-    persistedQuery.insert("sha256Hash", sha256Hash);
-
-    QJsonObject extensions;
-    extensions.insert("persistedQuery", persistedQuery);
-    payload.insert("extensions", extensions);
-
-    QJsonArray payloadArray;
-    payloadArray.append(payload);
-
-    auto request =
-        NetworkRequest("https://gql.twitch.tv/gql", NetworkRequestType::Post)
-            .useProxy()
-            .timeout(TWITCH_GQL_TIMEOUT_MS)
-            .header("Client-Id", "kimne78kx3ncx6brgo4mv6wki5h1ko")
-            .header("Client-Session-Id", twitchGqlSessionId())
-            .header("Client-Version", TWITCH_GQL_BROWSER_CLIENT_VERSION)
-            .header("User-Agent", TWITCH_GQL_BROWSER_USER_AGENT)
-            .header("X-Device-Id", twitchGqlDeviceId())
-            .json(payloadArray);
-
-    const auto normalizedToken = normalizeCustomTwitchAuthToken(oauthToken);
     if (!normalizedToken.isEmpty())
     {
         request = std::move(request).header("Authorization",
@@ -258,113 +219,123 @@ NetworkRequest makePersistedGqlRequest(const QString &operationName,
     return request;
 }
 
-NetworkRequest makeTvPersistedGqlRequest(const QString &operationName,
-                                         const QString &sha256Hash,
-                                         const QJsonObject &variables,
-                                         const QString &oauthToken)
+NetworkRequest makeTvPersistedGqlBatchRequest(const QJsonArray &payloadArray,
+                                              const QString &oauthToken)
 {
-    QJsonObject payload;
-    payload.insert("operationName", operationName);
-    payload.insert("variables", variables);
-
-    QJsonObject persistedQuery;
-    persistedQuery.insert("version", 1);
-    persistedQuery.insert("sha256Hash", sha256Hash);
-
-    QJsonObject extensions;
-    extensions.insert("persistedQuery", persistedQuery);
-    payload.insert("extensions", extensions);
-
-    QJsonArray payloadArray;
-    payloadArray.append(payload);
-
-    auto request =
-        NetworkRequest("https://gql.twitch.tv/gql", NetworkRequestType::Post)
-            .useProxy()
-            .timeout(TWITCH_GQL_TIMEOUT_MS)
-            .header("Client-Id", TWITCH_GQL_TV_CLIENT_ID)
-            .header("Client-Session-Id", twitchGqlSessionId())
-            .header("Client-Version", TWITCH_GQL_BROWSER_CLIENT_VERSION)
-            .header("Origin", TWITCH_GQL_TV_ORIGIN)
-            .header("Referer", TWITCH_GQL_TV_REFERER)
-            .header("User-Agent", TWITCH_GQL_TV_USER_AGENT)
-            .header("X-Device-Id", twitchGqlDeviceId())
-            .json(payloadArray);
+    return makeGqlBatchRequest(GqlClient::Tv, payloadArray,
+                               normalizeCustomTwitchAuthToken(oauthToken));
+}
 
-    const auto normalizedToken = normalizeCustomTwitchAuthToken(oauthToken);
-    if (!normalizedToken.isEmpty())
-    {
-        request = std::move(request).header("Authorization",
-                                            "OAuth " + normalizedToken);
-    }
+std::shared_ptr<GqlBatcher> makeGqlBatcher(GqlClient client)
+{
+    return std::make_shared<GqlBatcher>([client](const QString &token,
+                                                 const QJsonArray &payload,
+                                                 GqlBatcher::Done done) {
+        auto shared = std::make_shared<GqlBatcher::Done>(std::move(done));
+        makeGqlBatchRequest(client, payload, token)
+            .onSuccess([shared](const NetworkResult &result) {
+                (*shared)(true, result);
+            })
+            .onError([shared](const NetworkResult &result) {
+                (*shared)(false, result);
+            })
+            .execute();
+    });
+}
 
-    return request;
+/// Operations made with the same client and token within a few milliseconds
+/// are sent in one request. The token is part of each operation, so there's
+/// one batcher per client no matter how often tokens are refreshed.
+std::shared_ptr<GqlBatcher> gqlBatcher(GqlClient client)
+{
+    // Leaked on purpose: the batchers own timers, which must not be
+    // destroyed after the application.
+    static auto *web =
+        new std::shared_ptr<GqlBatcher>(makeGqlBatcher(GqlClient::Web));
+    static auto *tv =
+        new std::shared_ptr<GqlBatcher>(makeGqlBatcher(GqlClient::Tv));
+
+    return client == GqlClient::Tv ? *tv : *web;
 }
 
-NetworkRequest makeInlineGqlRequest(const char *query,
-                                    const QJsonObject &variables,
-                                    const QString &oauthToken)
+BatchedGqlRequest makeGqlRequest(const char *query,
+                                 const QJsonObject &variables,
+                                 const QString &oauthToken)
 {
     QJsonObject payload;
     payload.insert("query", query);
     payload.insert("variables", variables);
 
-    QJsonArray payloadArray;
-    payloadArray.append(payload);
+    // Callers expect the response object, not an array
+    return {
+        gqlBatcher(GqlClient::Web),
+        normalizeCustomTwitchAuthToken(oauthToken),
+        payload,
+        false,
+    };
+}
 
-    auto request =
-        NetworkRequest("https://gql.twitch.tv/gql", NetworkRequestType::Post)
-            .useProxy()
-            .timeout(TWITCH_GQL_TIMEOUT_MS)
-            .header("Client-Id", "kimne78kx3ncx6brgo4mv6wki5h1ko")
-            .header("Client-Session-Id", twitchGqlSessionId())
-            .header("Client-Version", TWITCH_GQL_BROWSER_CLIENT_VERSION)
-            .header("User-Agent", TWITCH_GQL_BROWSER_USER_AGENT)
-            .header("X-Device-Id", twitchGqlDeviceId())
-            .json(payloadArray);
+BatchedGqlRequest makePersistedGqlRequest(const QString &operationName,
+                                          const QString &sha256Hash,
+                                          const QJsonObject &variables,
+                                          const QString &oauthToken)
+{
+    return {
+        gqlBatcher(GqlClient::Web),
+        normalizeCustomTwitchAuthToken(oauthToken),
+        persistedPayload(operationName, variables, sha256Hash),
+    };
+}
 
-    const auto normalizedToken = normalizeCustomTwitchAuthToken(oauthToken);
-    if (!normalizedToken.isEmpty())
-    {
-        request = std::move(request).header("Authorization",
-                                            "OAuth " + normalizedToken);
-    }
+BatchedGqlRequest makePersistedGqlRequest(
+    const QString &operationName, const QString &sha256Hash,
+    const QJsonObject &variables, const std::shared_ptr<TwitchAccount> &account)
+{
+    return makePersistedGqlRequest(operationName, sha256Hash, variables,
+                                   account ? account->getOAuthToken()
+                                           : QString());
+}
 
-    return request;
+BatchedGqlRequest makeTvPersistedGqlRequest(const QString &operationName,
+                                            const QString &sha256Hash,
+                                            const QJsonObject &variables,
+                                            const QString &oauthToken)
+{
+    return {
+        gqlBatcher(GqlClient::Tv),
+        normalizeCustomTwitchAuthToken(oauthToken),
+        persistedPayload(operationName, variables, sha256Hash),
+    };
 }
 
-NetworkRequest makeTvInlineGqlRequest(const char *query,
-                                      const QJsonObject &variables,
-                                      const QString &oauthToken)
+BatchedGqlRequest makeInlineGqlRequest(const char *query,
+                                       const QJsonObject &variables,
+                                       const QString &oauthToken)
 {
     QJsonObject payload;
     payload.insert("query", query);
     payload.insert("variables", variables);
 
-    QJsonArray payloadArray;
-    payloadArray.append(payload);
-
-    auto request =
-        NetworkRequest("https://gql.twitch.tv/gql", NetworkRequestType::Post)
-            .useProxy()
-            .timeout(TWITCH_GQL_TIMEOUT_MS)
-            .header("Client-Id", TWITCH_GQL_TV_CLIENT_ID)
-            .header("Client-Session-Id", twitchGqlSessionId())
-            .header("Client-Version", TWITCH_GQL_BROWSER_CLIENT_VERSION)
-            .header("Origin", TWITCH_GQL_TV_ORIGIN)
-            .header("Referer", TWITCH_GQL_TV_REFERER)
-            .header("User-Agent", TWITCH_GQL_TV_USER_AGENT)
-            .header("X-Device-Id", twitchGqlDeviceId())
-            .json(payloadArray);
+    return {
+        gqlBatcher(GqlClient::Web),
+        normalizeCustomTwitchAuthToken(oauthToken),
+        payload,
+    };
+}
 
-    const auto normalizedToken = normalizeCustomTwitchAuthToken(oauthToken);
-    if (!normalizedToken.isEmpty())
-    {
-        request = std::move(request).header("Authorization",
-                                            "OAuth " + normalizedToken);
-    }
+BatchedGqlRequest makeTvInlineGqlRequest(const char *query,
+                                         const QJsonObject &variables,
+                                         const QString &oauthToken)
+{
+    QJsonObject payload;
+    payload.insert("query", query);
+    payload.insert("variables", variables);
 
-    return request;
+    return {
+        gqlBatcher(GqlClient::Tv),
+        normalizeCustomTwitchAuthToken(oauthToken),
+        payload,
+    };
 }
 
 QString extractFirstGqlErrorMessage(const rapidjson::Document &doc)
@@ -531,50 +502,6 @@ QJsonObject payloadDataObjectForOperation(const QJsonValue &value,
     return payloadDataObject(value);
 }
 
-QJsonObject persistedPayload(const QString &operationName,
-                             const QJsonObject &variables,
-                             const QString &sha256Hash)
-{
-    QJsonObject payload;
-    payload.insert("operationName", operationName);
-    payload.insert("variables", variables);
-
-    QJsonObject persistedQuery;
-    persistedQuery.insert("version", 1);
-    persistedQuery.insert("sha256Hash", sha256Hash);
-
-    QJsonObject extensions;
-    extensions.insert("persistedQuery", persistedQuery);
-    payload.insert("extensions", extensions);
-    return payload;
-}
-
-NetworkRequest makeTvPersistedGqlBatchRequest(const QJsonArray &payloadArray,
-                                              const QString &oauthToken)
-{
-    auto request =
-        NetworkRequest("https://gql.twitch.tv/gql", NetworkRequestType::Post)
-            .useProxy()
-            .timeout(TWITCH_GQL_TIMEOUT_MS)
-            .header("Client-Id", TWITCH_GQL_TV_CLIENT_ID)
-            .header("Client-Session-Id", twitchGqlSessionId())
-            .header("Client-Version", TWITCH_GQL_BROWSER_CLIENT_VERSION)
-            .header("Origin", TWITCH_GQL_TV_ORIGIN)
-            .header("Referer", TWITCH_GQL_TV_REFERER)
-            .header("User-Agent", TWITCH_GQL_TV_USER_AGENT)
-            .header("X-Device-Id", twitchGqlDeviceId())
-            .json(payloadArray);
-
-    const auto normalizedToken = normalizeCustomTwitchAuthToken(oauthToken);
-    if (!normalizedToken.isEmpty())
-    {
-        request = std::move(request).header("Authorization",
-                                            "OAuth " + normalizedToken);
-    }
-
-    return request;
-}
-
 void sendTerminatePollRequest(
     const QString &pollId, const QString &currentUserId,
     const QString &oauthToken, const std::function<void()> &successCallback,
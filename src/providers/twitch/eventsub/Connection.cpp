@@ -178,6 +178,12 @@ void Connection::onSessionWelcome(
     qCDebug(LOG) << "On session welcome:" << payload.id.c_str();
 
     this->sessionID = QString::fromStdString(payload.id);
+
+    auto *app = tryGetApp();
+    if (app)
+    {
+        app->getEventSub()->connectionReady();
+    }
 }
 
 void Connection::onNotification(const lib::messages::Metadata &metadata,
@@ -22,6 +22,7 @@
 #include <QNetworkProxy>
 #include <twitch-eventsub-ws/session.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -45,6 +46,9 @@ std::tuple<std::string, std::string, std::string> getEventSubHost()
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 const auto &LOG = chatterinoTwitchEventSub;
 
+/// Subscription requests that are sent to Helix at once
+constexpr size_t MAX_SUBSCRIBES_IN_FLIGHT = 10;
+
 std::optional<chatterino::eventsub::lib::ProxyOptions> eventSubProxyOptions(
     const std::string &host)
 {
@@ -100,6 +104,7 @@ std::optional<chatterino::eventsub::lib::ProxyOptions> eventSubProxyOptions(
 namespace chatterino::eventsub {
 
 using namespace std::literals::chrono_literals;
+using namespace Qt::StringLiterals;
 
 class QLogProxy : public lib::Logger
 {
@@ -170,6 +175,7 @@ Controller::~Controller()
         std::lock_guard lock(this->subscriptionsMutex);
         this->subscriptions.clear();
     }
+    this->pumpTimer.reset();
 
     this->work.reset();
 
@@ -343,10 +349,22 @@ void Controller::reconnectConnection(
         qCDebug(chatterinoTwitchEventSub) << "Using reconnect URL to reconnect";
         // this is epic
         QUrl url(QString::fromStdString(*reconnectURL));
-        this->createConnection(url.host(QUrl::FullyEncoded).toStdString(),
-                               std::to_string(url.port(443)),
-                               url.path(QUrl::FullyEncoded).toStdString(),
-                               std::move(connection));
+        auto session = this->createConnection(
+            url.host(QUrl::FullyEncoded).toStdString(),
+            std::to_string(url.port(443)),
+            url.path(QUrl::FullyEncoded).toStdString(), std::move(connection));
+
+        // Twitch moves the subscriptions to the new session, so they don't
+        // need to be requested again
+        std::lock_guard g(this->subscriptionsMutex);
+        for (const auto &sub : subs)
+        {
+            auto it = this->subscriptions.find(sub);
+            if (it != this->subscriptions.end())
+            {
+                it->second.connection = session;
+            }
+        }
         return;
     }
 
@@ -354,27 +372,42 @@ void Controller::reconnectConnection(
     // but first, clear the subscriptions
     qCDebug(chatterinoTwitchEventSub)
         << "Resubscribing to topics after connection failure";
+    std::vector<SubscriptionRequest> resubscribe;
     {
         std::lock_guard g(this->subscriptionsMutex);
         for (const auto &sub : subs)
         {
             auto it = this->subscriptions.find(sub);
-            if (it != this->subscriptions.end())
+            if (it == this->subscriptions.end() ||
+                it->second.state != Subscription::State::Subscribed)
             {
-                qCDebug(chatterinoTwitchEventSub) << "Resetting" << it->first;
-                it->second.connection = {};
-                it->second.backoff.reset();
-                it->second.state = Subscription::State::Subscribing;
+                // Requests in any other state are already being handled
+                continue;
             }
+
+            qCDebug(chatterinoTwitchEventSub) << "Resetting" << it->first;
+            it->second.connection = {};
+            it->second.subscriptionID.clear();
+            it->second.backoff.reset();
+            it->second.state = Subscription::State::Subscribing;
+            resubscribe.emplace_back(sub);
         }
     }
 
-    for (const auto &sub : subs)
+    // The requests are packed onto as few new connections as possible
+    for (const auto &sub : resubscribe)
     {
-        this->subscribe(sub, false);
+        this->queueSubscription(sub);
     }
 }
 
+void Controller::connectionReady()
+{
+    boost::asio::post(this->ioContext, [this] {
+        this->schedulePump();
+    });
+}
+
 void Controller::debug()
 {
     std::lock_guard g(this->subscriptionsMutex);
@@ -406,6 +439,29 @@ void Controller::debug()
     }
 
     boost::asio::post(this->ioContext, [this] {
+        std::vector<std::shared_ptr<lib::Session>> sessions;
+        std::vector<SessionLoad> loads;
+        SessionLimits limits;
+        {
+            std::lock_guard g(this->subscriptionsMutex);
+            loads = this->collectSessionLoads(sessions);
+            limits = this->sessionLimits;
+        }
+
+        qCInfo(LOG).noquote().nospace()
+            << this->queuedRequests.size() << " queued, "
+            << this->requestsInFlight << " in flight";
+        for (const auto &load : loads)
+        {
+            qCInfo(LOG).noquote().nospace()
+                << (load.isReady() ? load.sessionID : u"(connecting)"_s)
+                << ": " << load.subscriptions << "/"
+                << limits.maxSubscriptions << " subscriptions, cost "
+                << load.cost << "/" << limits.maxTotalCost << ", user "
+                << (load.ownerTwitchUserID.isEmpty() ? u"-"_s
+                                                     : load.ownerTwitchUserID);
+        }
+
         for (const auto &weakConnection : this->connections)
         {
             auto connection = weakConnection.lock();
@@ -430,9 +486,6 @@ void Controller::debug()
 
 void Controller::subscribe(const SubscriptionRequest &request, bool isRetry)
 {
-    // 1. Flush dead connections (maybe this should not be done here)
-    // TODO: implement
-
     {
         std::lock_guard lock(this->subscriptionsMutex);
         auto &subscription = this->subscriptions[request];
@@ -452,140 +505,289 @@ void Controller::subscribe(const SubscriptionRequest &request, bool isRetry)
         assert(subscription.retryTimer == nullptr);
     }
 
-    uint32_t openButNotReadyConnections = 0;
+    this->queueSubscription(request);
+}
 
-    // 2. Check if any currently open connection can handle this subscription
-    auto viableConnection = this->getViableConnection(
-        request.ownerTwitchUserID, openButNotReadyConnections);
+void Controller::queueSubscription(const SubscriptionRequest &request)
+{
+    this->threadGuard->guard();
 
-    if (viableConnection.has_value())
+    if (std::ranges::find(this->queuedRequests, request) ==
+        this->queuedRequests.end())
     {
-        const auto &connection = *viableConnection;
-        auto *listener = dynamic_cast<Connection *>(connection->getListener());
+        this->queuedRequests.emplace_back(request);
+    }
+    this->schedulePump();
+}
 
-        assert(listener != nullptr && "Something goofy has gone wrong, Session "
-                                      "listener must be our Connection type");
-
-        qCDebug(LOG) << "Make helix request for" << request;
-        getHelix()->createEventSubSubscription(
-            request, listener->getSessionID(),
-            [this, request,
-             weakConnection{std::weak_ptr<lib::Session>(connection)}](
-                const auto &res) {
-                qCDebug(LOG) << "Subscription success" << request;
-                this->markRequestSubscribed(request, weakConnection,
-                                            res.subscriptionID);
-            },
-            [this, request](const auto &error, const auto &errorString) {
-                using Error = HelixCreateEventSubSubscriptionError;
+void Controller::schedulePump()
+{
+    this->threadGuard->guard();
 
-                bool retry = false;
-                switch (error)
-                {
-                    case Error::BadRequest:
-                        qCDebug(LOG) << "Bad request" << errorString << request;
-                        break;
-
-                    case Error::Unauthorized:
-                        qCDebug(LOG)
-                            << "Unauthorized" << errorString << request;
-                        break;
-
-                    case Error::Forbidden:
-                        qCDebug(LOG) << "Forbidden" << errorString << request;
-                        break;
-
-                    case Error::Conflict:
-                        // This session ID is already subscribed to this request, some logic of ours is wrong
-                        qCWarning(LOG) << "Conflict" << errorString << request;
-                        break;
-
-                    case Error::Ratelimited:
-                        qCDebug(LOG) << "Ratelimited" << errorString << request;
-                        break;
-
-                    case Error::NoSession:
-                        qCDebug(LOG) << "Session expired, retrying"
-                                     << errorString << request;
-                        retry = true;
-                        break;
-
-                    case Error::Forwarded:
-                    default:
-                        qCWarning(LOG) << "Unhandled error, retrying "
-                                          "subscription"
-                                       << errorString << request;
-                        retry = true;
-                        break;
-                }
+    if (this->pumpScheduled)
+    {
+        return;
+    }
 
-                if (retry)
-                {
-                    boost::asio::post(this->ioContext, [this, request] {
-                        this->retrySubscription(request);
-                    });
-                }
-                else
-                {
-                    this->markRequestFailed(request);
-                }
-            });
+    // Requests that are queued in the same run of the event loop (e.g. when
+    // joining many channels) are planned together.
+    this->pumpScheduled = true;
+    boost::asio::post(this->ioContext, [this] {
+        this->pumpSubscriptions();
+    });
+}
+
+void Controller::pumpSubscriptions()
+{
+    this->threadGuard->guard();
+    this->pumpScheduled = false;
 
+    if (this->quitting || isAppAboutToQuit())
+    {
         return;
     }
 
-    if (openButNotReadyConnections == 0)
+    std::vector<std::pair<SubscriptionRequest, std::shared_ptr<lib::Session>>>
+        starts;
+    size_t newSessions = 0;
+    {
+        std::lock_guard lock(this->subscriptionsMutex);
+
+        std::vector<SubscriptionRequest> requests;
+        for (auto &request : this->queuedRequests)
+        {
+            auto it = this->subscriptions.find(request);
+            if (it == this->subscriptions.end())
+            {
+                continue;
+            }
+
+            auto &subscription = it->second;
+            if (subscription.refCount == 0)
+            {
+                qCDebug(LOG)
+                    << "No one is interested in this subscription anymore, "
+                       "dropping it"
+                    << request << "from state"
+                    << qmagicenum::enumName(subscription.state);
+                this->subscriptions.erase(it);
+                continue;
+            }
+
+            if (subscription.state != Subscription::State::Subscribing &&
+                subscription.state != Subscription::State::Retrying)
+            {
+                continue;
+            }
+
+            requests.emplace_back(std::move(request));
+        }
+        this->queuedRequests.clear();
+
+        std::vector<std::shared_ptr<lib::Session>> sessions;
+        auto loads = this->collectSessionLoads(sessions);
+        auto plan = planSubscriptions(std::move(requests), std::move(loads),
+                                      this->sessionLimits, this->costByType);
+
+        auto room = MAX_SUBSCRIBES_IN_FLIGHT -
+                    std::min(this->requestsInFlight, MAX_SUBSCRIBES_IN_FLIGHT);
+        for (auto &assignment : plan.assignments)
+        {
+            if (starts.size() >= room)
+            {
+                this->queuedRequests.emplace_back(
+                    std::move(assignment.request));
+                continue;
+            }
+
+            const auto &connection = sessions[assignment.session];
+            // Claim the slot on the connection for the next plans
+            this->subscriptions[assignment.request].connection = connection;
+            starts.emplace_back(std::move(assignment.request), connection);
+        }
+
+        for (auto &request : plan.deferred)
+        {
+            this->queuedRequests.emplace_back(std::move(request));
+        }
+        newSessions = plan.newSessions;
+    }
+
+    for (const auto &[request, connection] : starts)
+    {
+        this->requestsInFlight++;
+        this->startSubscription(request, connection);
+    }
+
+    for (size_t i = 0; i < newSessions; i++)
     {
-        // No connection was available to handle this subscription request, create a new connection
         this->createConnection();
     }
-    else if (openButNotReadyConnections > 1)
+
+    if (!starts.empty())
     {
-        // There should only ever be 0 or 1
-        qCWarning(LOG) << "We have" << openButNotReadyConnections
-                       << "open but no ready connections";
+        this->pumpBackoff.reset();
     }
 
-    this->retrySubscription(request);
+    if (this->queuedRequests.empty() || this->requestsInFlight > 0)
+    {
+        // Finished requests and welcomed connections pump again
+        this->pumpTimer.reset();
+        return;
+    }
+
+    this->pumpTimer =
+        std::make_unique<boost::asio::system_timer>(this->ioContext);
+    this->pumpTimer->expires_after(this->pumpBackoff.next());
+    this->pumpTimer->async_wait([this](const auto &ec) {
+        if (!ec && !isAppAboutToQuit())
+        {
+            this->pumpSubscriptions();
+        }
+    });
 }
 
-std::optional<std::shared_ptr<lib::Session>> Controller::getViableConnection(
-    const QString &ownerTwitchUserID, uint32_t &openButNotReadyConnections)
+void Controller::startSubscription(
+    const SubscriptionRequest &request,
+    const std::shared_ptr<lib::Session> &connection)
 {
+    auto *listener = dynamic_cast<Connection *>(connection->getListener());
+
+    assert(listener != nullptr && "Something goofy has gone wrong, Session "
+                                  "listener must be our Connection type");
+
+    qCDebug(LOG) << "Make helix request for" << request;
+    getHelix()->createEventSubSubscription(
+        request, listener->getSessionID(),
+        [this, request,
+         weakConnection{std::weak_ptr<lib::Session>(connection)}](
+            const auto &res) {
+            qCDebug(LOG) << "Subscription success" << request;
+            this->markRequestSubscribed(request, weakConnection, res);
+            boost::asio::post(this->ioContext, [this] {
+                this->subscriptionRequestFinished();
+            });
+        },
+        [this, request](const auto &error, const auto &errorString) {
+            using Error = HelixCreateEventSubSubscriptionError;
+
+            bool retry = false;
+            switch (error)
+            {
+                case Error::BadRequest:
+                    qCDebug(LOG) << "Bad request" << errorString << request;
+                    break;
+
+                case Error::Unauthorized:
+                    qCDebug(LOG) << "Unauthorized" << errorString << request;
+                    break;
+
+                case Error::Forbidden:
+                    qCDebug(LOG) << "Forbidden" << errorString << request;
+                    break;
+
+                case Error::Conflict:
+                    // This session ID is already subscribed to this request, some logic of ours is wrong
+                    qCWarning(LOG) << "Conflict" << errorString << request;
+                    break;
+
+                case Error::Ratelimited:
+                    qCDebug(LOG) << "Ratelimited" << errorString << request;
+                    break;
+
+                case Error::NoSession:
+                    qCDebug(LOG) << "Session expired, retrying" << errorString
+                                 << request;
+                    retry = true;
+                    break;
+
+                case Error::Forwarded:
+                default:
+                    qCWarning(LOG) << "Unhandled error, retrying "
+                                      "subscription"
+                                   << errorString << request;
+                    retry = true;
+                    break;
+            }
+
+            if (retry)
+            {
+                boost::asio::post(this->ioContext, [this, request] {
+                    this->retrySubscription(request);
+                });
+            }
+            else
+            {
+                this->markRequestFailed(request);
+            }
+            boost::asio::post(this->ioContext, [this] {
+                this->subscriptionRequestFinished();
+            });
+        });
+}
+
+void Controller::subscriptionRequestFinished()
+{
+    this->threadGuard->guard();
+
+    assert(this->requestsInFlight > 0);
+    this->requestsInFlight--;
+    if (!this->queuedRequests.empty())
+    {
+        this->schedulePump();
+    }
+}
+
+std::vector<SessionLoad> Controller::collectSessionLoads(
+    std::vector<std::shared_ptr<lib::Session>> &sessions) const
+{
+    std::vector<SessionLoad> loads;
     for (const auto &weakConnection : this->connections)
     {
         auto connection = weakConnection.lock();
         if (!connection)
         {
-            // TODO: remove it here?
             continue;
         }
 
         auto *listener = dynamic_cast<Connection *>(connection->getListener());
-
         if (!listener)
         {
             continue;  // dead connection
         }
 
-        if (listener->getSessionID().isEmpty())
+        sessions.emplace_back(std::move(connection));
+        loads.push_back({.sessionID = listener->getSessionID()});
+    }
+
+    for (const auto &[request, subscription] : this->subscriptions)
+    {
+        if (subscription.state != Subscription::State::Subscribing &&
+            subscription.state != Subscription::State::Retrying &&
+            subscription.state != Subscription::State::Subscribed)
         {
-            // This connection is open but it's not ready (i.e. no welcome has been posted yet)
-            ++openButNotReadyConnections;
             continue;
         }
 
-        if (!listener->canHandleSubscriptionFrom(ownerTwitchUserID))
+        auto connection = subscription.connection.lock();
+        if (!connection)
         {
-            continue;  // Connection is active with another Twitch User's subscriptions
+            continue;
         }
 
-        // TODO: Check if this listener has room for another subscription
+        auto it = std::ranges::find(sessions, connection);
+        if (it == sessions.end())
+        {
+            continue;
+        }
 
-        return connection;
+        auto &load = loads[static_cast<size_t>(it - sessions.begin())];
+        load.ownerTwitchUserID = request.ownerTwitchUserID;
+        load.subscriptions++;
+        load.cost += this->costByType.value(request.subscriptionType);
     }
 
-    return {};
+    return loads;
 }
 
 void Controller::createConnection()
@@ -594,9 +796,9 @@ void Controller::createConnection()
                            this->eventSubPath, std::make_unique<Connection>());
 }
 
-void Controller::createConnection(std::string host, std::string port,
-                                  std::string path,
-                                  std::unique_ptr<lib::Listener> listener)
+std::shared_ptr<lib::Session> Controller::createConnection(
+    std::string host, std::string port, std::string path,
+    std::unique_ptr<lib::Listener> listener)
 {
     qCDebug(LOG) << "Create EventSub connection";
 
@@ -625,11 +827,13 @@ void Controller::createConnection(std::string host, std::string port,
         auto proxy = eventSubProxyOptions(host);
         connection->run(std::move(host), std::move(port), std::move(path),
                         this->userAgent, std::move(proxy));
+        return connection;
     }
     catch (std::exception &e)
     {
         qCWarning(LOG) << "Error in EventSub run thread" << e.what();
     }
+    return nullptr;
 }
 
 void Controller::registerConnection(std::weak_ptr<lib::Session> &&connection)
@@ -670,6 +874,8 @@ void Controller::retrySubscription(const SubscriptionRequest &request)
         qCDebug(LOG) << "Set state to retrying" << request;
         subscription.state = Subscription::State::Retrying;
     }
+    // Free the slot on the connection until the retry is planned
+    subscription.connection = {};
 
     // we don't need a strong RNG here
     // NOLINTNEXTLINE(cert-*)
@@ -711,9 +917,9 @@ void Controller::retrySubscription(const SubscriptionRequest &request)
     subscription.retryTimer = std::move(retryTimer);
 }
 
-void Controller::markRequestSubscribed(const SubscriptionRequest &request,
-                                       std::weak_ptr<lib::Session> connection,
-                                       const QString &subscriptionID)
+void Controller::markRequestSubscribed(
+    const SubscriptionRequest &request, std::weak_ptr<lib::Session> connection,
+    const HelixCreateEventSubSubscriptionResponse &response)
 {
     if (this->quitting)
     {
@@ -722,6 +928,12 @@ void Controller::markRequestSubscribed(const SubscriptionRequest &request,
 
     std::lock_guard lock(this->subscriptionsMutex);
 
+    this->costByType[request.subscriptionType] = response.subscriptionCost;
+    if (response.maxTotalCost > 0)
+    {
+        this->sessionLimits.maxTotalCost = response.maxTotalCost;
+    }
+
     auto strong = connection.lock();
     if (!strong)
     {
@@ -744,7 +956,7 @@ void Controller::markRequestSubscribed(const SubscriptionRequest &request,
            "or Retrying state");
 
     subscription.connection = std::move(connection);
-    subscription.subscriptionID = subscriptionID;
+    subscription.subscriptionID = response.subscriptionID;
     qCDebug(LOG) << "Set state to subscribed" << request;
     subscription.state = Subscription::State::Subscribed;
     subscription.backoff.reset();
@@ -765,6 +977,7 @@ void Controller::markRequestFailed(const SubscriptionRequest &request)
 
     qCDebug(LOG) << "Set state to failed" << request;
     subscription.state = Subscription::State::Failed;
+    subscription.connection = {};
 }
 
 void Controller::markRequestUnsubscribed(const SubscriptionRequest &request)
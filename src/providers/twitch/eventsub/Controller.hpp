@@ -5,6 +5,7 @@
 #pragma once
 
 #include "providers/twitch/eventsub/SubscriptionHandle.hpp"
+#include "providers/twitch/eventsub/SubscriptionPlanner.hpp"
 #include "providers/twitch/eventsub/SubscriptionRequest.hpp"
 #include "twitch-eventsub-ws/logger.hpp"
 #include "twitch-eventsub-ws/session.hpp"
@@ -14,7 +15,9 @@
 
 #include <boost/asio/executor_work_guard.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/system_timer.hpp>
 #include <boost/functional/hash.hpp>
+#include <QHash>
 #include <QJsonObject>
 #include <QString>
 
@@ -25,6 +28,13 @@
 #include <string>
 #include <thread>
 #include <unordered_set>
+#include <vector>
+
+namespace chatterino {
+
+struct HelixCreateEventSubSubscriptionResponse;
+
+}  // namespace chatterino
 
 namespace chatterino::eventsub {
 
@@ -49,7 +59,7 @@ public:
     /// If this subscription already exists, this call is a no-op.
     ///
     /// If no open connection has room for this subscription, this function will
-    /// create a new connection and queue up the subscription to run again after X seconds.
+    /// create a new connection and queue up the subscription until it's ready.
     [[nodiscard]] virtual SubscriptionHandle subscribe(
         const SubscriptionRequest &request) = 0;
 
@@ -58,6 +68,10 @@ public:
         const std::optional<std::string> &reconnectURL,
         const std::unordered_set<SubscriptionRequest> &subs) = 0;
 
+    /// Called by a connection once it has been welcomed and can take
+    /// subscriptions
+    virtual void connectionReady() = 0;
+
     virtual void debug() = 0;
 };
 
@@ -79,21 +93,40 @@ public:
         const std::optional<std::string> &reconnectURL,
         const std::unordered_set<SubscriptionRequest> &subs) override;
 
+    void connectionReady() override;
+
     void debug() override;
 
 private:
     void subscribe(const SubscriptionRequest &request, bool isRetry);
 
+    /// Queues `request` for the next pumpSubscriptions()
+    void queueSubscription(const SubscriptionRequest &request);
+    void schedulePump();
+    /// Distributes the queued requests over the connections and makes as
+    /// many of them as allowed. Opens new connections if there's no room.
+    void pumpSubscriptions();
+    void startSubscription(const SubscriptionRequest &request,
+                           const std::shared_ptr<lib::Session> &connection);
+    void subscriptionRequestFinished();
+
+    /// The load of each connection in `sessions`.
+    /// The subscriptionsMutex must be held.
+    std::vector<SessionLoad> collectSessionLoads(
+        std::vector<std::shared_ptr<lib::Session>> &sessions) const;
+
     void createConnection();
-    void createConnection(std::string host, std::string port, std::string path,
-                          std::unique_ptr<lib::Listener> listener);
+    std::shared_ptr<lib::Session> createConnection(
+        std::string host, std::string port, std::string path,
+        std::unique_ptr<lib::Listener> listener);
     void registerConnection(std::weak_ptr<lib::Session> &&connection);
 
     void retrySubscription(const SubscriptionRequest &request);
 
-    void markRequestSubscribed(const SubscriptionRequest &request,
-                               std::weak_ptr<lib::Session> connection,
-                               const QString &subscriptionID);
+    void markRequestSubscribed(
+        const SubscriptionRequest &request,
+        std::weak_ptr<lib::Session> connection,
+        const HelixCreateEventSubSubscriptionResponse &response);
 
     void markRequestFailed(const SubscriptionRequest &request);
 
@@ -117,9 +150,15 @@ private:
 
     std::vector<std::weak_ptr<lib::Session>> connections;
 
-    [[nodiscard]] std::optional<std::shared_ptr<lib::Session>>
-        getViableConnection(const QString &ownerTwitchUserID,
-                            uint32_t &openButNotReadyConnections);
+    // Only accessed from the EventSub thread
+    std::vector<SubscriptionRequest> queuedRequests;
+    bool pumpScheduled = false;
+    size_t requestsInFlight = 0;
+    /// Pumps again if queued requests couldn't be made and nothing else
+    /// will trigger a pump (e.g. a connection failed to open)
+    std::unique_ptr<boost::asio::system_timer> pumpTimer;
+    // 500ms to 16s backoff
+    ExponentialBackoff<6> pumpBackoff{std::chrono::milliseconds{500}};
 
     struct Subscription {
         enum class State : uint8_t {
@@ -144,6 +183,7 @@ private:
         } state = State::Unsubscribed;
 
         int32_t refCount = 0;
+        /// The connection the subscription was made on or is being made on
         std::weak_ptr<lib::Session> connection;
 
         /// The ID of the subscription the Twitch Helix API has given us
@@ -157,6 +197,10 @@ private:
 
     std::mutex subscriptionsMutex;
     std::unordered_map<SubscriptionRequest, Subscription> subscriptions;
+    /// Updated from the responses to subscription requests
+    SessionLimits sessionLimits;
+    /// The cost of each subscription type, as reported by Twitch
+    QHash<QString, int> costByType;
 
     std::atomic<bool> quitting = false;
     OnceFlag stoppedFlag;
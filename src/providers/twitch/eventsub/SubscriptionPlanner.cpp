@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/twitch/eventsub/SubscriptionPlanner.hpp"
+
+#include <algorithm>
+#include <optional>
+
+namespace {
+
+using namespace chatterino::eventsub;
+
+/// Whether `candidate` is a better session for a request from `owner` than
+/// `current`
+bool isBetterSession(const SessionLoad &candidate, const SessionLoad &current,
+                     const QString &owner)
+{
+    // Keep sessions without an owner free for other users
+    bool candidateOwned = candidate.ownerTwitchUserID == owner;
+    bool currentOwned = current.ownerTwitchUserID == owner;
+    if (candidateOwned != currentOwned)
+    {
+        return candidateOwned;
+    }
+    return candidate.subscriptions < current.subscriptions;
+}
+
+}  // namespace
+
+namespace chatterino::eventsub {
+
+SubscriptionPlan planSubscriptions(std::vector<SubscriptionRequest> requests,
+                                   std::vector<SessionLoad> sessions,
+                                   const SessionLimits &limits,
+                                   const QHash<QString, int> &costByType)
+{
+    SubscriptionPlan plan;
+
+    QHash<QString, int> costByUser;
+    QHash<QString, size_t> sessionsByUser;
+    // Room on sessions that aren't ready yet
+    size_t pendingRoom = 0;
+    for (const auto &session : sessions)
+    {
+        if (!session.ownerTwitchUserID.isEmpty())
+        {
+            costByUser[session.ownerTwitchUserID] += session.cost;
+            sessionsByUser[session.ownerTwitchUserID]++;
+        }
+        if (!session.isReady())
+        {
+            pendingRoom += limits.maxSubscriptions -
+                           std::min(session.subscriptions,
+                                    limits.maxSubscriptions);
+        }
+    }
+
+    QHash<QString, size_t> roomNeededByUser;
+    for (auto &request : requests)
+    {
+        const auto &owner = request.ownerTwitchUserID;
+        auto cost = costByType.value(request.subscriptionType);
+        auto &userCost = costByUser[owner];
+        if (userCost + cost > limits.maxTotalCost)
+        {
+            // More sessions won't help, this has to wait until other
+            // subscriptions of the user are removed.
+            plan.deferred.emplace_back(std::move(request));
+            continue;
+        }
+
+        std::optional<size_t> best;
+        for (size_t i = 0; i < sessions.size(); i++)
+        {
+            const auto &session = sessions[i];
+            if (!session.isReady() ||
+                session.subscriptions >= limits.maxSubscriptions ||
+                (!session.ownerTwitchUserID.isEmpty() &&
+                 session.ownerTwitchUserID != owner))
+            {
+                continue;
+            }
+
+            if (!best || isBetterSession(session, sessions[*best], owner))
+            {
+                best = i;
+            }
+        }
+
+        if (!best)
+        {
+            roomNeededByUser[owner]++;
+            plan.deferred.emplace_back(std::move(request));
+            continue;
+        }
+
+        auto &session = sessions[*best];
+        if (session.ownerTwitchUserID.isEmpty())
+        {
+            session.ownerTwitchUserID = owner;
+            sessionsByUser[owner]++;
+        }
+        session.subscriptions++;
+        session.cost += cost;
+        userCost += cost;
+        plan.assignments.push_back({
+            .session = *best,
+            .request = std::move(request),
+        });
+    }
+
+    for (auto it = roomNeededByUser.cbegin(); it != roomNeededByUser.cend();
+         ++it)
+    {
+        auto needed = it.value();
+        auto fromPending = std::min(needed, pendingRoom);
+        pendingRoom -= fromPending;
+        needed -= fromPending;
+        if (needed == 0)
+        {
+            continue;
+        }
+
+        auto wanted = (needed + limits.maxSubscriptions - 1) /
+                      std::max<size_t>(limits.maxSubscriptions, 1);
+        auto open = std::min(sessionsByUser.value(it.key()),
+                             limits.maxSessionsPerUser);
+        plan.newSessions +=
+            std::min(wanted, limits.maxSessionsPerUser - open);
+    }
+
+    return plan;
+}
+
+}  // namespace chatterino::eventsub
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "providers/twitch/eventsub/SubscriptionRequest.hpp"
+
+#include <QHash>
+#include <QString>
+
+#include <cstddef>
+#include <vector>
+
+namespace chatterino::eventsub {
+
+/// The limits Twitch puts on websocket sessions
+struct SessionLimits {
+    /// Enabled subscriptions per session
+    size_t maxSubscriptions = 300;
+    /// Sessions a single user can have open at once
+    size_t maxSessionsPerUser = 3;
+    /// The total cost of all subscriptions of a user. This is updated from
+    /// the responses to subscription requests.
+    int maxTotalCost = 10;
+};
+
+/// The load of an open session
+struct SessionLoad {
+    /// Empty if the session hasn't been welcomed yet
+    QString sessionID;
+    /// The user whose subscriptions are on this session. Empty if the
+    /// session can take subscriptions from any user.
+    QString ownerTwitchUserID;
+    /// Subscriptions that were made or are being made on this session
+    size_t subscriptions = 0;
+    int cost = 0;
+
+    bool isReady() const
+    {
+        return !this->sessionID.isEmpty();
+    }
+};
+
+struct SubscriptionPlan {
+    struct Assignment {
+        /// The index of the session in the loads passed to the planner
+        size_t session = 0;
+        SubscriptionRequest request;
+    };
+
+    /// Requests that fit on a ready session
+    std::vector<Assignment> assignments;
+    /// Requests that have to wait for a new session or for room to free up
+    std::vector<SubscriptionRequest> deferred;
+    /// The number of sessions to open for the deferred requests
+    size_t newSessions = 0;
+};
+
+/// Distributes `requests` over the open sessions.
+///
+/// Each request goes to the least loaded session of its user that's below
+/// the limits, so subscriptions are spread evenly. Sessions that aren't
+/// ready yet are counted as room for the deferred requests before new
+/// sessions are planned. `costByType` is the cost of a subscription type
+/// (zero if unknown).
+SubscriptionPlan planSubscriptions(std::vector<SubscriptionRequest> requests,
+                                   std::vector<SessionLoad> sessions,
+                                   const SessionLimits &limits,
+                                   const QHash<QString, int> &costByType);
+
+}  // namespace chatterino::eventsub
@@ -16,6 +16,7 @@
 #include "debug/Benchmark.hpp"
 #include "pajlada/settings/signalargs.hpp"
 #include "util/Backup.hpp"
+#include "util/PostToThread.hpp"
 #include "util/WindowsHelper.hpp"
 
 #include <pajlada/signals/scoped-connection.hpp>
@@ -447,6 +448,11 @@ Settings::Settings(const Args &args, const QString &settingsDirectory,
         static_cast<uint64_t>(
             pajlada::Settings::SettingManager::SaveMethod::OnlySaveIfChanged));
 
+    this->saveTimer_.setSingleShot(true);
+    QObject::connect(&this->saveTimer_, &QTimer::timeout, [this] {
+        this->requestSave();
+    });
+
     initializeSignalVector(this->signalHolder, this->highlightedMessagesSetting,
                            this->highlightedMessages);
     initializeSignalVector(this->signalHolder, this->highlightedUsersSetting,
@@ -496,8 +502,11 @@ Settings::~Settings()
     Settings::instance_ = this->prevInstance_;
 }
 
-pajlada::Settings::SettingManager::SaveResult Settings::requestSave() const
+pajlada::Settings::SettingManager::SaveResult Settings::requestSave()
 {
+    // This save includes everything a queued save would've saved
+    this->saveTimer_.stop();
+
     if (this->disableSaving)
     {
         return pajlada::Settings::SettingManager::SaveResult::Skipped;
@@ -506,6 +515,24 @@ pajlada::Settings::SettingManager::SaveResult Settings::requestSave() const
     return pajlada::Settings::SettingManager::gSave();
 }
 
+void Settings::queueSave()
+{
+    if (!isGuiThread())
+    {
+        postToThread([this] {
+            this->queueSave();
+        });
+        return;
+    }
+
+    if (this->disableSaving || this->saveTimer_.isActive())
+    {
+        return;
+    }
+
+    this->saveTimer_.start(SAVE_DELAY);
+}
+
 void Settings::saveSnapshot()
 {
     BenchmarkGuard benchmark("Settings::saveSnapshot");
@@ -579,6 +606,7 @@ void Settings::restoreSnapshot()
 void Settings::disableSave()
 {
     this->disableSaving = true;
+    this->saveTimer_.stop();
 }
 
 bool Settings::shouldSendHelixChat() const
@@ -33,7 +33,9 @@
 #include <pajlada/settings/settingmanager.hpp>
 #include <pajlada/signals/signalholder.hpp>
 #include <QHash>
+#include <QTimer>
 
+#include <chrono>
 #include <optional>
 #include <string_view>
 
@@ -145,7 +147,17 @@ public:
     /// Depending on the launch options, a save might end up not happening
     ///
     /// Returns the result from the save, or Skipped if disableSave has been called
-    pajlada::Settings::SettingManager::SaveResult requestSave() const;
+    pajlada::Settings::SettingManager::SaveResult requestSave();
+
+    /// Request the settings to be saved within `SAVE_DELAY`
+    ///
+    /// Requests made before the save happens are coalesced into one save, so
+    /// token refreshes and settings that change in quick succession don't
+    /// write the file every time. A queued save is written when the app
+    /// quits. Can be called from any thread.
+    void queueSave();
+
+    static constexpr std::chrono::seconds SAVE_DELAY{2};
 
     void saveSnapshot();
     void restoreSnapshot();
@@ -788,6 +800,19 @@ public:
         "/misc/scrollback/usercardLimit",
         1000,
     };
+    /// Messages that no longer fit in a split are archived (compressed) up
+    /// to this limit, so they can still be searched. Splits load them again
+    /// when scrolled to the top. 0 disables the archive.
+    IntSetting scrollbackArchiveLimit = {
+        "/misc/scrollback/archiveLimit",
+        20000,
+    };
+    /// Splits that stay hidden for this many minutes free their message
+    /// layouts until they're shown again. 0 disables this.
+    IntSetting hibernateHiddenSplitsAfter = {
+        "/misc/scrollback/hibernateHiddenSplitsAfter",
+        10,
+    };
     BoolSetting displaySevenTVAnimatedProfile = {
         "/misc/displaySevenTVAnimatedProfile", false};
 
@@ -1160,6 +1185,8 @@ private:
 
     std::unique_ptr<rapidjson::Document> snapshot_;
 
+    QTimer saveTimer_;
+
     pajlada::Signals::SignalHolder signalHolder;
 };
 
@@ -20,8 +20,8 @@
 #include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
+#include "util/Backup.hpp"
 #include "util/CombinePath.hpp"
-#include "util/FilesystemHelpers.hpp"
 #include "util/MultiChannel.hpp"
 #include "util/SignalListener.hpp"
 #include "widgets/AccountSwitchPopup.hpp"
@@ -34,7 +34,6 @@
 #include "widgets/splits/SplitContainer.hpp"
 #include "widgets/Window.hpp"
 
-#include <pajlada/settings/backup.hpp>
 #include <QApplication>
 #include <QColor>
 #include <QDebug>
@@ -43,7 +42,6 @@
 #include <QJsonObject>
 #include <QMessageBox>
 #include <QPointer>
-#include <QSaveFile>
 #include <QScreen>
 #include <QTimer>
 
@@ -850,34 +848,11 @@ void WindowManager::save()
     obj.insert("windows", windowArr);
     document.setObject(obj);
 
-    // save file
-    std::error_code ec;
-    pajlada::Settings::Backup::saveWithBackup(
-        qStringToStdPath(this->windowLayoutFilePath),
-        {.enabled = true, .numSlots = 9},
-        [&](const auto &path, auto &ec) {
-            QSaveFile file(stdPathToQString(path));
-            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
-            {
-                ec = std::make_error_code(std::errc::io_error);
-                return;
-            }
-
-            file.write(document.toJson(QJsonDocument::Indented));
-            if (!file.commit() || file.error() != QFile::NoError)
-            {
-                ec = std::make_error_code(std::errc::io_error);
-            }
-        },
-        ec);
-
-    if (ec)
-    {
-        // TODO(Qt 6.5): drop fromStdString
-        qCWarning(chatterinoWindowmanager)
-            << "Failed to save windowlayout"
-            << QString::fromStdString(ec.message());
-    }
+    // The document is a cheap copy, converting it to JSON and writing it
+    // happens in the background.
+    backup::saveWithBackupsAsync(this->windowLayoutFilePath, [document] {
+        return document.toJson(QJsonDocument::Indented);
+    });
 }
 
 void WindowManager::sendAlert()
@@ -127,6 +127,8 @@ public:
 
     // Set up some final signals & actually show the windows
     void initialize();
+    /// Serializes the window layout and writes it in the background
+    /// (see backup::saveWithBackupsAsync)
     void save();
     void closeAll();
 
@@ -9,11 +9,16 @@
 #include "util/FilesystemHelpers.hpp"
 #include "widgets/dialogs/RestoreBackupsDialog.hpp"
 
+#include <pajlada/settings/backup.hpp>
 #include <pajlada/settings/settingmanager.hpp>
 #include <QDir>
+#include <QHash>
 #include <QRegularExpression>
+#include <QSaveFile>
+#include <QThreadPool>
 
 #include <algorithm>
+#include <mutex>
 
 namespace {
 
@@ -38,6 +43,95 @@ bool anyBackupsOf(const QString &directory, const QString &filename)
                                });
 }
 
+struct PendingSave {
+    std::function<QByteArray()> serialize;
+    bool keepBackups = true;
+};
+
+struct PendingSaves {
+    std::mutex mutex;
+    QHash<QString, PendingSave> saves;
+    /// Runs one save at a time, so saves of a file happen in order
+    QThreadPool pool;
+
+    PendingSaves()
+    {
+        this->pool.setMaxThreadCount(1);
+        // Saves are rare, don't keep the thread around
+        this->pool.setExpiryTimeout(5000);
+    }
+};
+
+PendingSaves &pendingSaves()
+{
+    // Leaked on purpose: saves are flushed during shutdown
+    static auto *saves = new PendingSaves;
+    return *saves;
+}
+
+void writeWithBackups(const QString &path, const QByteArray &data,
+                      bool keepBackups)
+{
+    using namespace chatterino;
+
+    std::error_code ec;
+    pajlada::Settings::Backup::saveWithBackup(
+        qStringToStdPath(path), {.enabled = keepBackups, .numSlots = 9},
+        [&](const auto &dst, auto &ec) {
+            QSaveFile file(stdPathToQString(dst));
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            {
+                ec = std::make_error_code(std::errc::io_error);
+                return;
+            }
+
+            file.write(data);
+            if (!file.commit() || file.error() != QFile::NoError)
+            {
+                ec = std::make_error_code(std::errc::io_error);
+            }
+        },
+        ec);
+
+    if (ec)
+    {
+        // TODO(Qt 6.5): drop fromStdString
+        qCWarning(chatterinoSettings) << "Failed to save" << path
+                                      << QString::fromStdString(ec.message());
+        return;
+    }
+    qCDebug(chatterinoSettings) << "Saved" << path;
+}
+
+void enqueueSave(const QString &path, PendingSave save)
+{
+    auto &pending = pendingSaves();
+    {
+        std::lock_guard lock(pending.mutex);
+        auto it = pending.saves.find(path);
+        if (it != pending.saves.end())
+        {
+            // The queued save will pick this up
+            *it = std::move(save);
+            return;
+        }
+        pending.saves.insert(path, std::move(save));
+    }
+
+    pending.pool.start([path] {
+        auto &pending = pendingSaves();
+        PendingSave save;
+        {
+            std::lock_guard lock(pending.mutex);
+            save = pending.saves.take(path);
+        }
+        if (save.serialize)
+        {
+            writeWithBackups(path, save.serialize(), save.keepBackups);
+        }
+    });
+}
+
 }  // namespace
 
 namespace chatterino::backup {
@@ -137,4 +231,21 @@ void loadWithBackups(const FileData &fileData,
     }
 }
 
+void saveWithBackupsAsync(const QString &path,
+                          std::function<QByteArray()> serialize)
+{
+    enqueueSave(path, {.serialize = std::move(serialize), .keepBackups = true});
+}
+
+void saveAsync(const QString &path, std::function<QByteArray()> serialize)
+{
+    enqueueSave(path,
+                {.serialize = std::move(serialize), .keepBackups = false});
+}
+
+void flushPendingSaves()
+{
+    pendingSaves().pool.waitForDone();
+}
+
 }  // namespace chatterino::backup
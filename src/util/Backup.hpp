@@ -6,10 +6,12 @@
 
 #include "util/Expected.hpp"
 
+#include <QByteArray>
 #include <QDateTime>
 #include <QString>
 
 #include <filesystem>
+#include <functional>
 #include <vector>
 
 class QJsonValue;
@@ -59,6 +61,25 @@ std::vector<BackupFile> findBackupsFor(const QString &directory,
 void loadWithBackups(const FileData &fileData,
                      const std::function<ExpectedStr<void>()> &load);
 
+/// Save the result of `serialize` to `path` on a background thread, keeping
+/// the same backups as `loadWithBackups` looks for.
+///
+/// The file is written to a temporary file first and then renamed, so it's
+/// never half-written. Saves of the same path are coalesced: if a save is
+/// still pending, its `serialize` is replaced and only the latest state is
+/// written.
+///
+/// `serialize` runs on the background thread, so it must only capture
+/// copies of the state it writes.
+void saveWithBackupsAsync(const QString &path,
+                          std::function<QByteArray()> serialize);
+
+/// Like `saveWithBackupsAsync`, but without keeping backups (e.g. for caches)
+void saveAsync(const QString &path, std::function<QByteArray()> serialize);
+
+/// Block until all pending saves are written.
+void flushPendingSaves();
+
 }  // namespace chatterino::backup
 
 Q_DECLARE_METATYPE(chatterino::backup::BackupFile);
@@ -6,6 +6,7 @@
 
 #include "common/UniqueAccess.hpp"
 #include "messages/Image.hpp"
+#include "messages/ImageDecodeScheduler.hpp"
 #include "util/QMagicEnum.hpp"
 
 #include <magic_enum/magic_enum.hpp>
@@ -14,6 +15,9 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
 #include <numeric>
 
 using namespace Qt::StringLiterals;
@@ -39,12 +43,118 @@ constexpr bool isBytes(DebugObject target)
         case DebugObject::BytesImageCurrent:
         case DebugObject::BytesImageLoaded:
         case DebugObject::BytesImageUnloaded:
+        case DebugObject::BytesArchivedMessages:
             return true;
     }
 }
 
+// Latencies are kept in log-linear buckets like in HdrHistogram. Values below
+// SUB_BUCKETS nanoseconds get a bucket each, larger values are split into
+// SUB_BUCKETS buckets per power of two, so a bucket's lower bound is within
+// 1/SUB_BUCKETS of any value in it.
+constexpr uint32_t SUB_BUCKET_BITS = 4;
+constexpr uint32_t SUB_BUCKETS = 1U << SUB_BUCKET_BITS;
+// 2^36 ns are about 69 s, anything slower lands in the last bucket
+constexpr uint32_t MAX_EXPONENT = 36;
+constexpr size_t BUCKET_COUNT =
+    size_t{MAX_EXPONENT - SUB_BUCKET_BITS + 2} * SUB_BUCKETS;
+
+constexpr size_t bucketIndex(uint64_t nanoseconds)
+{
+    if (nanoseconds < SUB_BUCKETS)
+    {
+        return nanoseconds;
+    }
+
+    auto exponent = static_cast<uint32_t>(std::bit_width(nanoseconds) - 1);
+    if (exponent > MAX_EXPONENT)
+    {
+        return BUCKET_COUNT - 1;
+    }
+    auto sub =
+        (nanoseconds >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return (size_t{exponent - SUB_BUCKET_BITS} + 1) * SUB_BUCKETS + sub;
+}
+
+constexpr uint64_t bucketLowerBound(size_t index)
+{
+    if (index < SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    auto exponent = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    auto sub = uint64_t{index % SUB_BUCKETS};
+    return (uint64_t{1} << exponent) | (sub << (exponent - SUB_BUCKET_BITS));
+}
+
+static_assert(bucketIndex(15) == 15);
+static_assert(bucketLowerBound(bucketIndex(1000)) <= 1000);
+static_assert(bucketLowerBound(bucketIndex(1000) + 1) > 1000);
+static_assert(bucketIndex(uint64_t{1} << 40) == BUCKET_COUNT - 1);
+
+struct StageHistogram {
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<uint64_t> maxNanoseconds{0};
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::array<StageHistogram, static_cast<size_t>(DebugStage::Count)> HISTOGRAMS;
+
+#ifdef CHATTERINO_DEBUG_STAGE_ALLOCATIONS
+/// Allocations of all samples per stage, reset with the histograms
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::array<std::atomic<uint64_t>, static_cast<size_t>(DebugStage::Count)>
+    STAGE_ALLOCATIONS{};
+
+// Looking up a dynamic TLS variable may call malloc itself
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+[[gnu::tls_model("initial-exec")]] thread_local uint64_t
+    threadAllocationCount = 0;
+#endif
+
+QString formatNanoseconds(uint64_t nanoseconds)
+{
+    auto milliseconds = static_cast<double>(nanoseconds) / 1'000'000.0;
+    return QString::number(milliseconds, 'f', 3) % u" ms"_s;
+}
+
 }  // namespace
 
+#ifdef CHATTERINO_DEBUG_STAGE_ALLOCATIONS
+
+// glibc's allocator is interposed to count the allocations of each thread.
+// operator new and Qt's containers both end up here.
+// NOLINTBEGIN(bugprone-reserved-identifier,readability-identifier-naming)
+extern "C" {
+
+void *__libc_malloc(size_t size) noexcept;
+void *__libc_calloc(size_t count, size_t size) noexcept;
+void *__libc_realloc(void *ptr, size_t size) noexcept;
+
+void *malloc(size_t size) noexcept
+{
+    threadAllocationCount++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) noexcept
+{
+    threadAllocationCount++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) noexcept
+{
+    threadAllocationCount++;
+    return __libc_realloc(ptr, size);
+}
+
+}  // extern "C"
+// NOLINTEND(bugprone-reserved-identifier,readability-identifier-naming)
+
+#endif
+
 namespace chatterino {
 
 void DebugCount::set(DebugObject target, int64_t amount)
@@ -71,6 +181,13 @@ void DebugCount::decrease(DebugObject target, int64_t amount)
     it.value -= amount;
 }
 
+int64_t DebugCount::get(DebugObject target)
+{
+    auto counts = COUNTS.access();
+
+    return counts->at(static_cast<size_t>(target)).value;
+}
+
 QString DebugCount::getDebugText()
 {
     static const QLocale locale(QLocale::English);
@@ -100,6 +217,27 @@ QString DebugCount::getDebugText()
         }
     }
 
+    const auto decodeStats = ImageDecodeScheduler::instance().stats();
+    text += u"\nimage decoding: "_s %
+            locale.toString(static_cast<qlonglong>(decodeStats.decoded)) %
+            u" decoded, "_s %
+            locale.toString(static_cast<qlonglong>(decodeStats.cancelled)) %
+            u" cancelled\n"_s;
+    for (size_t i = 0; i < ImageDecodeScheduler::PRIORITY_COUNT; i++)
+    {
+        text += u"  "_s %
+                qmagicenum::enumName(static_cast<ImagePriority>(i)) % u": "_s %
+                locale.toString(static_cast<qlonglong>(decodeStats.queued[i])) %
+                u" queued, "_s %
+                QString::number(
+                    static_cast<double>(decodeStats.averageLatency[i].count()) /
+                        1000.0,
+                    'f', 1) %
+                u" ms avg latency\n"_s;
+    }
+
+    text += u"\n"_s % DebugCount::getLatencyText();
+
 #ifndef DISABLE_IMAGE_EXPIRATION_POOL
     const auto providerUsage =
         ImageExpirationPool::instance().getProviderUsageSnapshot();
@@ -141,4 +279,118 @@ QString DebugCount::getDebugText()
     return text;
 }
 
+void DebugCount::recordLatency(DebugStage stage,
+                               std::chrono::nanoseconds elapsed)
+{
+    auto &histogram = HISTOGRAMS.at(static_cast<size_t>(stage));
+    auto nanoseconds = static_cast<uint64_t>(std::max<int64_t>(
+        0, static_cast<int64_t>(elapsed.count())));
+
+    histogram.buckets[bucketIndex(nanoseconds)].fetch_add(
+        1, std::memory_order_relaxed);
+
+    auto max = histogram.maxNanoseconds.load(std::memory_order_relaxed);
+    while (nanoseconds > max &&
+           !histogram.maxNanoseconds.compare_exchange_weak(
+               max, nanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+void DebugCount::resetLatencies()
+{
+    for (auto &histogram : HISTOGRAMS)
+    {
+        for (auto &bucket : histogram.buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        histogram.maxNanoseconds.store(0, std::memory_order_relaxed);
+    }
+#ifdef CHATTERINO_DEBUG_STAGE_ALLOCATIONS
+    for (auto &allocations : STAGE_ALLOCATIONS)
+    {
+        allocations.store(0, std::memory_order_relaxed);
+    }
+#endif
+}
+
+#ifdef CHATTERINO_DEBUG_STAGE_ALLOCATIONS
+uint64_t DebugCount::threadAllocations()
+{
+    return threadAllocationCount;
+}
+
+void DebugCount::recordAllocations(DebugStage stage, uint64_t count)
+{
+    STAGE_ALLOCATIONS.at(static_cast<size_t>(stage))
+        .fetch_add(count, std::memory_order_relaxed);
+}
+#endif
+
+QString DebugCount::getLatencyText()
+{
+    static const QLocale locale(QLocale::English);
+
+    // The stages nest, see DebugStage
+    QString text = u"stage latencies (inclusive, IrcMessage contains "
+                   u"MessageBuild, which contains Highlight):\n"_s;
+    for (size_t stage = 0; stage < HISTOGRAMS.size(); stage++)
+    {
+        const auto &histogram = HISTOGRAMS.at(stage);
+
+        // Other threads might record while this runs, so the snapshot can be
+        // slightly inconsistent
+        std::array<uint64_t, BUCKET_COUNT> buckets{};
+        uint64_t total = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++)
+        {
+            buckets[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+            total += buckets[i];
+        }
+
+        text += u"  "_s % qmagicenum::enumName(static_cast<DebugStage>(stage)) %
+                u": "_s % locale.toString(static_cast<qulonglong>(total)) %
+                u" samples"_s;
+        if (total == 0)
+        {
+            text += u'\n';
+            continue;
+        }
+
+        auto percentile = [&](double p) {
+            auto target = static_cast<uint64_t>(
+                std::ceil(p * static_cast<double>(total)));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKET_COUNT; i++)
+            {
+                seen += buckets[i];
+                if (seen >= target)
+                {
+                    return bucketLowerBound(i);
+                }
+            }
+            return bucketLowerBound(BUCKET_COUNT - 1);
+        };
+
+        text += u", p50 "_s % formatNanoseconds(percentile(0.5)) %
+                u", p99 "_s % formatNanoseconds(percentile(0.99)) %
+                u", max "_s %
+                formatNanoseconds(histogram.maxNanoseconds.load(
+                    std::memory_order_relaxed));
+#ifdef CHATTERINO_DEBUG_STAGE_ALLOCATIONS
+        auto allocations =
+            STAGE_ALLOCATIONS.at(stage).load(std::memory_order_relaxed);
+        text += u", "_s %
+                QString::number(static_cast<double>(allocations) /
+                                    static_cast<double>(total),
+                                'f', 1) %
+                u" allocs/sample"_s;
+#endif
+        text += u'\n';
+    }
+
+    return text;
+}
+
 }  // namespace chatterino
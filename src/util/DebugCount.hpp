@@ -9,7 +9,9 @@
 #include <magic_enum/magic_enum.hpp>
 #include <QString>
 
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 
 namespace chatterino {
 
@@ -27,6 +29,8 @@ enum class DebugObject : size_t {
     HTTPRequestStarted,
     HTTPRequestSuccess,
     NetworkData,
+    GqlOperation,
+    GqlRoundTrip,
 
     // images
     Image,
@@ -48,9 +52,12 @@ enum class DebugObject : size_t {
     MessageDrawingBuffer,
     MessageElement,
     MessageLayout,
+    MessageLayoutContainer,
     MessageLayoutElement,
     MessageThread,
     Message,
+    ArchivedMessage,
+    BytesArchivedMessages,
 
     // Chatterino7
     SeventvPersonalEmoteSets,
@@ -61,6 +68,28 @@ enum class DebugObject : size_t {
     Count,
 };
 
+/// Hot paths whose latency is recorded in a histogram.
+///
+/// Stages are timed inclusively. A PRIVMSG's IrcMessage sample contains its
+/// MessageBuild sample, which contains its Highlight sample.
+enum class DebugStage : uint8_t {
+    /// Parsing a PRIVMSG or USERNOTICE in IrcMessageHandler, including
+    /// building the message
+    IrcMessage,
+    /// MessageBuilder::makeIrcMessage, including checking highlights
+    MessageBuild,
+    /// HighlightController::check
+    Highlight,
+    /// FilterSet::filter
+    Filter,
+    /// MessageLayout::layout, only if a layout was required
+    Layout,
+    /// ChannelView::drawMessages
+    Paint,
+
+    Count,
+};
+
 class DebugCount
 {
 public:
@@ -78,7 +107,66 @@ public:
         DebugCount::decrease(target, 1);
     }
 
+    static int64_t get(DebugObject target);
+
     static QString getDebugText();
+
+    /// Adds a sample to the latency histogram of `stage`.
+    /// This doesn't lock and can be called from any thread.
+    static void recordLatency(DebugStage stage,
+                              std::chrono::nanoseconds elapsed);
+    static void resetLatencies();
+
+#ifdef CHATTERINO_DEBUG_STAGE_ALLOCATIONS
+    /// The number of malloc, calloc and realloc calls of the calling thread
+    static uint64_t threadAllocations();
+    /// Adds the allocations of one sample of `stage`
+    static void recordAllocations(DebugStage stage, uint64_t count);
+#endif
+
+    /// Returns the sample count, p50, p99 and max latency of each stage. If
+    /// allocations are counted, their average per sample is included.
+    static QString getLatencyText();
+};
+
+/// Records the time between its construction and destruction in the latency
+/// histogram of a stage
+class DebugStageTimer
+{
+public:
+    explicit DebugStageTimer(DebugStage stage)
+        : stage_(stage)
+        , start_(std::chrono::steady_clock::now())
+#ifdef CHATTERINO_DEBUG_STAGE_ALLOCATIONS
+        , allocationsAtStart_(DebugCount::threadAllocations())
+#endif
+    {
+    }
+
+    ~DebugStageTimer()
+    {
+        DebugCount::recordLatency(
+            this->stage_,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - this->start_));
+#ifdef CHATTERINO_DEBUG_STAGE_ALLOCATIONS
+        DebugCount::recordAllocations(this->stage_,
+                                      DebugCount::threadAllocations() -
+                                          this->allocationsAtStart_);
+#endif
+    }
+
+    DebugStageTimer(const DebugStageTimer &) = delete;
+    DebugStageTimer(DebugStageTimer &&) = delete;
+    DebugStageTimer &operator=(const DebugStageTimer &) = delete;
+    DebugStageTimer &operator=(DebugStageTimer &&) = delete;
+
+private:
+    DebugStage stage_;
+    std::chrono::steady_clock::time_point start_;
+#ifdef CHATTERINO_DEBUG_STAGE_ALLOCATIONS
+    uint64_t allocationsAtStart_;
+#endif
 };
 
 }  // namespace chatterino
@@ -115,6 +203,10 @@ constexpr magic_enum::customize::customize_t
             return "http requests started";
         case chatterino::DebugObject::HTTPRequestSuccess:
             return "http requests succeeded";
+        case chatterino::DebugObject::GqlOperation:
+            return "GQL operations";
+        case chatterino::DebugObject::GqlRoundTrip:
+            return "GQL round trips";
         case chatterino::DebugObject::Image:
             return "images";
         case chatterino::DebugObject::LoadedImage:
@@ -137,6 +229,10 @@ constexpr magic_enum::customize::customize_t
             return "lua::api::HTTPRequest";
         case chatterino::DebugObject::MessageDrawingBuffer:
             return "message drawing buffers";
+        case chatterino::DebugObject::ArchivedMessage:
+            return "archived messages";
+        case chatterino::DebugObject::BytesArchivedMessages:
+            return "archived message bytes";
         case chatterino::DebugObject::SeventvPersonalEmoteSets:
             return "7TV Personal Emote Sets";
         case chatterino::DebugObject::SeventvPersonalEmoteAssignments:
@@ -7,7 +7,6 @@
 #include "Application.hpp"
 #include "common/QLogging.hpp"
 #include "providers/twitch/TwitchCommon.hpp"
-#include "singletons/Paths.hpp"
 
 #include <QDateTime>
 #include <QDirIterator>
@@ -15,9 +14,7 @@
 #include <QLocale>
 #include <QLoggingCategory>
 #include <QRegularExpression>
-#include <QStringBuilder>
 #include <QStringView>
-#include <QThreadPool>
 #include <QTimeZone>
 #include <QUuid>
 
@@ -480,58 +477,6 @@ void removeLastQS(QString &str)
     str.removeLast();
 }
 
-void writeProviderEmotesCache(const QString &id, const QString &provider,
-                              const QByteArray &bytes)
-{
-    auto *threadPool = QThreadPool::globalInstance();
-    if (threadPool == nullptr)
-    {
-        // Must be exiting - do nothing
-        return;
-    }
-
-    threadPool->start([bytes, id, provider]() {
-        QString cacheKey = id % "." % provider;
-        QFile responseCache(getApp()->getPaths().cacheFilePath(cacheKey));
-
-        if (responseCache.open(QIODevice::WriteOnly))
-        {
-            qCDebug(chatterinoCache)
-                << "Saved json response " << id << "." << provider;
-            responseCache.write(qCompress(bytes));
-        }
-    });
-}
-
-bool readProviderEmotesCache(const QString &id, const QString &provider,
-                             const std::function<void(QJsonDocument)> &callback)
-{
-    QString cacheKey = id % "." % provider;
-    QFile responseCache(getApp()->getPaths().cacheFilePath(cacheKey));
-
-    if (responseCache.open(QIODevice::ReadOnly))
-    {
-        QJsonParseError parseError;
-        auto doc = QJsonDocument::fromJson(qUncompress(responseCache.readAll()),
-                                           &parseError);
-
-        if (parseError.error != QJsonParseError::NoError)
-        {
-            qCWarning(chatterinoCache)
-                << "Emote cache " << id << "." << provider
-                << " parsing failed: " << parseError.errorString();
-        }
-
-        qCDebug(chatterinoCache)
-            << "Loaded emote cache: " << id << "." << provider;
-        callback(doc);
-        return true;
-    }
-
-    // If the API call fails, we need to know if loading cached emotes was successful
-    return false;
-}
-
 std::pair<QStringView, QStringView> splitOnce(QStringView haystack,
                                               QStringView needle) noexcept
 {
@@ -172,7 +172,7 @@ MultiChannel::MultiChannel(std::span<const Spec> channels,
     }
     this->refreshDisplayName();
 
-    QVarLengthArray<std::vector<MessagePtr>, 4> snapshots;
+    QVarLengthArray<LimitedQueueSnapshot<MessagePtr>, 4> snapshots;
     QVarLengthArray<std::span<const MessagePtr>, 4> snapshotViews;
     for (const auto &chan : this->channels_)
     {
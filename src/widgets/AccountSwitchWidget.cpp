@@ -60,7 +60,7 @@ AccountSwitchWidget::AccountSwitchWidget(QWidget *parent)
                 app->getAccounts()->twitch.currentUsername = newUsername;
             }
 
-            getSettings()->requestSave();
+            getSettings()->queueSave();
         }
     });
 }
@@ -19,10 +19,12 @@
 
 #    include <QBoxLayout>
 #    include <QFontDatabase>
+#    include <QLabel>
 #    include <QScrollBar>
 #    include <QSplitter>
 #    include <QTextBlock>
 #    include <QTextEdit>
+#    include <QTimer>
 #    include <sol/sol.hpp>
 
 namespace {
@@ -451,6 +453,16 @@ PluginRepl::PluginRepl(QString id, QWidget *parent)
             this->updatePinned();
         });
 
+        this->ui.stats = new QLabel;
+        this->ui.stats->setToolTip(
+            u"Time spent handling messages, number of delivered and dropped "
+            "messages, and how often the plugin ran out of budget"_s);
+        auto *statsTimer = new QTimer(this);
+        QObject::connect(statsTimer, &QTimer::timeout, this,
+                         &PluginRepl::updateStats);
+        statsTimer->start(1000);
+
+        top->addWidget(this->ui.stats);
         top->addStretch(1);
         top->addWidget(this->ui.clear);
         top->addWidget(this->ui.reload);
@@ -750,6 +762,27 @@ void PluginRepl::updatePinned()
     }
 }
 
+void PluginRepl::updateStats()
+{
+    if (!this->plugin ||
+        !this->plugin->getCallback(lua::api::EventType::MessagesReceived))
+    {
+        this->ui.stats->clear();
+        return;
+    }
+
+    const auto &stats = this->plugin->messageStreamStats;
+    auto ms = [](std::chrono::nanoseconds ns) {
+        return QString::number(static_cast<double>(ns.count()) / 1e6, 'f', 1);
+    };
+    this->ui.stats->setText(
+        u"Messages: %1 ms (last %2 ms) · %3 delivered · %4 dropped · %5 over budget"_s
+            .arg(ms(stats.callbackTime), ms(stats.lastBatchTime))
+            .arg(stats.delivered)
+            .arg(stats.dropped)
+            .arg(stats.budgetExceeded));
+}
+
 }  // namespace chatterino
 
 #    include "PluginRepl.moc"
@@ -14,6 +14,7 @@
 #    include <QTextCharFormat>
 #    include <sol/forward.hpp>
 
+class QLabel;
 class QTextEdit;
 class QTextCharFormat;
 class QTextBlockFormat;
@@ -53,6 +54,7 @@ private:
 
     void updateFont();
     void updatePinned();
+    void updateStats();
 
     QString id;
     Plugin *plugin = nullptr;
@@ -66,6 +68,7 @@ private:
     struct {
         QTextEdit *input = nullptr;
         QTextEdit *output = nullptr;
+        QLabel *stats = nullptr;
         SvgButton *clear = nullptr;
         SvgButton *reload = nullptr;
         SvgButton *pin = nullptr;
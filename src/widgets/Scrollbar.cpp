@@ -103,6 +103,11 @@ void Scrollbar::clearHighlights()
     this->highlights_.clear();
 }
 
+void Scrollbar::setHighlightsLimit(size_t limit)
+{
+    this->highlights_.rset_capacity(limit);
+}
+
 void Scrollbar::scrollToBottom(bool animate)
 {
     this->setDesiredValue(this->getBottom(), animate);
@@ -102,6 +102,9 @@ public:
     void replaceHighlight(size_t index, ScrollbarHighlight replacement);
 
     void clearHighlights();
+    /// Changes how many highlights are kept. If there are more, the oldest
+    /// ones are dropped.
+    void setHighlightsLimit(size_t limit);
 
     void scrollToBottom(bool animate = false);
     void scrollToTop(bool animate = false);
@@ -36,6 +36,11 @@ TooltipEntryWidget::TooltipEntryWidget(ImagePtr image, const QString &text,
     layout->addWidget(this->displayText_);
 }
 
+TooltipEntryWidget::~TooltipEntryWidget()
+{
+    this->releaseNativeScale();
+}
+
 void TooltipEntryWidget::setWordWrap(bool wrap)
 {
     this->displayText_->setWordWrap(wrap);
@@ -71,6 +76,7 @@ void TooltipEntryWidget::setImage(ImagePtr image)
 void TooltipEntryWidget::clearImage()
 {
     this->displayImage_->hide();
+    this->releaseNativeScale();
     this->image_ = nullptr;
     this->setImageScale(0, 0);
 }
@@ -82,18 +88,25 @@ bool TooltipEntryWidget::refreshPixmap()
         return false;
     }
 
-    auto pixmap = this->image_->pixmapOrLoad();
+    auto pixmap = this->image_->pixmapOrLoad(ImagePriority::Tooltip);
     if (!pixmap)
     {
         this->attemptRefresh_ = true;
         return false;
     }
-    pixmap->setDevicePixelRatio(this->devicePixelRatio());
+    // Tooltips show the image at its native size, but only while they're
+    // shown. Tooltips are cleared when they're hidden.
+    if (!this->holdsNativeScale_)
+    {
+        this->image_->acquireNativeScale();
+        this->holdsNativeScale_ = true;
+    }
 
     if (!this->customSize.isEmpty())
     {
-        this->displayImage_->setPixmap(
-            pixmap->scaled(this->customSize, Qt::KeepAspectRatio));
+        auto scaled = pixmap->scaled(this->customSize, Qt::KeepAspectRatio);
+        scaled.setDevicePixelRatio(this->devicePixelRatio());
+        this->displayImage_->setPixmap(scaled);
 
         if (this->displayImage_->pixmap().size() != this->customSize)
         {
@@ -102,6 +115,10 @@ bool TooltipEntryWidget::refreshPixmap()
     }
     else
     {
+        // Frames decoded for a smaller size keep their size through their
+        // device pixel ratio
+        pixmap->setDevicePixelRatio(pixmap->devicePixelRatio() *
+                                    this->devicePixelRatio());
         this->displayImage_->setPixmap(*pixmap);
     }
     this->displayImage_->show();
@@ -109,6 +126,15 @@ bool TooltipEntryWidget::refreshPixmap()
     return true;
 }
 
+void TooltipEntryWidget::releaseNativeScale()
+{
+    if (this->holdsNativeScale_ && this->image_)
+    {
+        this->image_->releaseNativeScale();
+    }
+    this->holdsNativeScale_ = false;
+}
+
 bool TooltipEntryWidget::animated() const
 {
     return this->image_ && this->image_->animated();
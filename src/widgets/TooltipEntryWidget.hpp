@@ -19,6 +19,7 @@ public:
     TooltipEntryWidget(QWidget *parent = nullptr);
     TooltipEntryWidget(ImagePtr image, const QString &text, int customWidth,
                        int customHeight, QWidget *parent = nullptr);
+    ~TooltipEntryWidget() override;
 
     void setImageScale(int w, int h);
     void setWordWrap(bool wrap);
@@ -33,12 +34,17 @@ public:
     bool attemptRefresh() const;
 
 private:
+    /// Releases the native scale requested for `image_`
+    void releaseNativeScale();
+
     QLabel *displayImage_ = nullptr;
     QLabel *displayText_ = nullptr;
 
     bool attemptRefresh_ = false;
 
     ImagePtr image_ = nullptr;
+    /// Set if `image_` is requested at its native size
+    bool holdsNativeScale_ = false;
     QSize customSize;
 };
 
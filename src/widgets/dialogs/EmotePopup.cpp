@@ -5,16 +5,13 @@
 #include "widgets/dialogs/EmotePopup.hpp"
 
 #include "Application.hpp"
-#include "common/enums/MessageContext.hpp"
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/emotes/EmoteController.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
 #include "debug/Benchmark.hpp"
 #include "messages/Emote.hpp"
-#include "messages/Message.hpp"
-#include "messages/MessageBuilder.hpp"
-#include "messages/MessageElement.hpp"
+#include "messages/Link.hpp"
 #include "providers/bttv/BttvEmotes.hpp"
 #include "providers/emoji/Emojis.hpp"
 #include "providers/ffz/FfzEmotes.hpp"
@@ -28,10 +25,9 @@
 #include "singletons/Theme.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/Helpers.hpp"
-#include "widgets/helper/ChannelView.hpp"
+#include "widgets/helper/EmoteGrid.hpp"
 #include "widgets/helper/TrimRegExpValidator.hpp"
 #include "widgets/Notebook.hpp"
-#include "widgets/Scrollbar.hpp"
 
 #include <QAbstractButton>
 #include <QHBoxLayout>
@@ -39,107 +35,78 @@
 #include <QStringBuilder>
 #include <QTabWidget>
 
+#include <algorithm>
+#include <map>
 #include <utility>
 
 namespace {
 
 using namespace chatterino;
 
-auto makeTitleMessage(const QString &title)
+std::vector<EmoteEntry> makeEntries(std::vector<EmotePtr> emotes)
 {
-    MessageBuilder builder;
-    builder.emplace<TextElement>(title, MessageElementFlag::Text);
-    builder->flags.set(MessageFlag::Centered);
-    return builder.release();
-}
-
-auto makeEmoteMessage(std::vector<EmotePtr> emotes)
-{
-    MessageBuilder builder;
-    builder->flags.set(MessageFlag::Centered);
-    builder->flags.set(MessageFlag::DisableCompactEmotes);
-
-    if (emotes.empty())
-    {
-        builder.emplace<TextElement>("no emotes available",
-                                     MessageElementFlag::Text,
-                                     MessageColor::System);
-        return builder.release();
-    }
-
-    std::sort(emotes.begin(), emotes.end(), [](const auto &l, const auto &r) {
+    std::ranges::sort(emotes, [](const auto &l, const auto &r) {
         return compareEmoteStrings(l->name.string, r->name.string);
     });
-    for (const auto &emote : emotes)
+
+    std::vector<EmoteEntry> entries;
+    entries.reserve(emotes.size());
+    for (auto &emote : emotes)
     {
-        builder
-            .emplace<EmoteElement>(
-                emote, MessageElementFlags{MessageElementFlag::AlwaysShow,
-                                           MessageElementFlag::Emote})
-            ->setLink(Link(Link::InsertText, emote->name.string));
+        entries.push_back({
+            .name = emote->name.string,
+            .insertText = emote->name.string,
+            .emote = std::move(emote),
+        });
     }
-
-    return builder.release();
+    return entries;
 }
 
-auto makeEmoteMessage(const EmoteMap &map)
+std::vector<EmoteEntry> makeEntries(const EmoteMap &map)
 {
-    if (map.empty())
-    {
-        MessageBuilder builder;
-        builder->flags.set(MessageFlag::Centered);
-        builder->flags.set(MessageFlag::DisableCompactEmotes);
-        builder.emplace<TextElement>("no emotes available",
-                                     MessageElementFlag::Text,
-                                     MessageColor::System);
-        return builder.release();
-    }
-
     std::vector<EmotePtr> vec;
     vec.reserve(map.size());
     for (const auto &[_name, ptr] : map)
     {
         vec.emplace_back(ptr);
     }
-    return makeEmoteMessage(std::move(vec));
+    return makeEntries(std::move(vec));
 }
 
-auto makeEmojiMessage(const std::vector<EmojiPtr> &emojiMap)
+std::vector<EmoteEntry> makeEmojiEntries(const std::vector<EmojiPtr> &emojis)
 {
-    MessageBuilder builder;
-    builder->flags.set(MessageFlag::Centered);
-    builder->flags.set(MessageFlag::DisableCompactEmotes);
-
-    for (const auto &value : emojiMap)
+    std::vector<EmoteEntry> entries;
+    entries.reserve(emojis.size());
+    for (const auto &emoji : emojis)
     {
-        builder
-            .emplace<EmoteElement>(
-                value->emote,
-                MessageElementFlags{MessageElementFlag::AlwaysShow,
-                                    MessageElementFlag::EmojiAll})
-            ->setLink(
-                Link(Link::Type::InsertText, ":" + value->shortCodes[0] + ":"));
+        entries.push_back({
+            .name = emoji->shortCodes[0],
+            .insertText = ":" + emoji->shortCodes[0] + ":",
+            .emote = emoji->emote,
+        });
     }
-
-    return builder.release();
+    return entries;
 }
 
-void addEmotes(Channel &channel, auto &&emotes, const QString &title)
+void addEmotes(std::vector<EmoteSection> &sections, const auto &emotes,
+               const QString &title)
 {
-    channel.addMessage(makeTitleMessage(title), MessageContext::Original);
-    channel.addMessage(makeEmoteMessage(std::forward<decltype(emotes)>(emotes)),
-                       MessageContext::Original);
+    sections.push_back({
+        .title = title,
+        .emotes = makeEntries(emotes),
+    });
 }
 
 void addTwitchEmoteSets(const std::shared_ptr<const EmoteMap> &local,
                         const std::shared_ptr<const TwitchEmoteSetMap> &sets,
-                        Channel &globalChannel, Channel &subChannel,
+                        std::vector<EmoteSection> &globalSections,
+                        std::vector<EmoteSection> &subSections,
                         const QString &currentChannelID,
                         const QString &channelName)
 {
     if (!local->empty())
     {
-        addEmotes(subChannel, *local, channelName % u" (Follower)");
+        addEmotes(subSections, *local, channelName % u" (Follower)");
     }
 
     std::vector<
@@ -151,7 +118,7 @@ void addTwitchEmoteSets(const std::shared_ptr<const EmoteMap> &local,
         if (set.owner->id == currentChannelID)
         {
             // Put current channel emotes at the top
-            addEmotes(subChannel, set.emotes, set.title());
+            addEmotes(subSections, set.emotes, set.title());
         }
         else
         {
@@ -165,96 +132,42 @@ void addTwitchEmoteSets(const std::shared_ptr<const EmoteMap> &local,
 
     for (const auto &[title, set] : sortedSets)
     {
-        addEmotes(set.get().isSubLike ? subChannel : globalChannel,
+        addEmotes(set.get().isSubLike ? subSections : globalSections,
                   set.get().emotes, title);
     }
 }
 
-void loadEmojis(ChannelView &view, const std::vector<EmojiPtr> &emojiMap)
+std::vector<EmoteSection> makeEmojiSections(
+    const std::vector<EmojiPtr> &emojis)
 {
-    static auto emoteCategoryMap = [&] {
-        std::map<QString, std::vector<EmojiPtr>> emoteCatMap;
-
-        for (const auto &emoji : emojiMap)
-        {
-            auto cat = emoteCatMap.find(emoji->category);
-            if (cat != emoteCatMap.end())
-            {
-                auto &vec = cat->second;
-                vec.push_back(emoji);
-            }
-            else
-            {
-                emoteCatMap.emplace(emoji->category,
-                                    std::vector<EmojiPtr>{emoji});
-            }
-        }
-        return emoteCatMap;
-    }();
-
-    ChannelPtr emojiChannel(new Channel("", Channel::Type::None));
-    // set the channel first to make sure the scrollbar is at the top
-    view.setChannel(emojiChannel);
+    std::map<QString, std::vector<EmojiPtr>> categories;
+    for (const auto &emoji : emojis)
+    {
+        categories[emoji->category].push_back(emoji);
+    }
 
-    for (auto &it : emoteCategoryMap)
+    std::vector<EmoteSection> sections;
+    for (const auto &[category, categoryEmojis] : categories)
     {
         // Skip the Component category for now.
-        if (it.first == "Component")
+        if (category == "Component")
         {
             continue;
         }
 
-        emojiChannel->addMessage(makeTitleMessage(it.first),
-                                 MessageContext::Original);
-        emojiChannel->addMessage(makeEmojiMessage(it.second),
-                                 MessageContext::Original);
+        sections.push_back({
+            .title = category,
+            .emotes = makeEmojiEntries(categoryEmojis),
+        });
     }
 
     // Add the Component category at the bottom of the picker.
-    emojiChannel->addMessage(makeTitleMessage("Component"),
-                             MessageContext::Original);
-    emojiChannel->addMessage(makeEmojiMessage(emoteCategoryMap["Component"]),
-                             MessageContext::Original);
-}
-
-void loadEmojis(Channel &channel, const std::vector<EmojiPtr> &emojiMap,
-                const QString &title)
-{
-    channel.addMessage(makeTitleMessage(title), MessageContext::Original);
-    channel.addMessage(makeEmojiMessage(emojiMap), MessageContext::Original);
-}
-
-// Create an emote
-EmoteMap filterEmoteMap(const QString &text,
-                        const std::shared_ptr<const EmoteMap> &emotes)
-{
-    EmoteMap filteredMap;
-
-    for (const auto &emote : *emotes)
-    {
-        if (emote.first.string.contains(text, Qt::CaseInsensitive))
-        {
-            filteredMap.insert(emote);
-        }
-    }
-
-    return filteredMap;
-}
-
-std::vector<EmotePtr> filterEmoteVec(const QString &text,
-                                     const std::vector<EmotePtr> &emotes)
-{
-    std::vector<EmotePtr> filtered;
-
-    for (const auto &emote : emotes)
-    {
-        if (emote->name.string.contains(text, Qt::CaseInsensitive))
-        {
-            filtered.emplace_back(emote);
-        }
-    }
+    sections.push_back({
+        .title = "Component",
+        .emotes = makeEmojiEntries(categories["Component"]),
+    });
 
-    return filtered;
+    return sections;
 }
 
 }  // namespace
@@ -306,13 +219,9 @@ EmotePopup::EmotePopup(QWidget *parent)
     };
 
     auto makeView = [&](QString tabTitle, bool addToNotebook = true) {
-        auto *view = new ChannelView(nullptr);
+        auto *view = new EmoteGrid(nullptr);
 
-        view->setOverrideFlags(MessageElementFlags{
-            MessageElementFlag::Default, MessageElementFlag::AlwaysShow,
-            MessageElementFlag::EmoteImage});
-        view->setEnableScrollingToBottom(false);
-        // We can safely ignore this signal connection since the ChannelView is deleted
+        // We can safely ignore this signal connection since the EmoteGrid is deleted
         // either when the notebook is deleted, or when our main layout is deleted.
         std::ignore = view->linkClicked.connect(clicked);
 
@@ -335,9 +244,14 @@ EmotePopup::EmotePopup(QWidget *parent)
     this->channelEmotesView_ = makeView("Channel");
     this->globalEmotesView_ = makeView("Global");
     this->viewEmojis_ = makeView("Emojis");
+    this->subEmotesView_->setPlaceholder("no subscription emotes available");
 
-    loadEmojis(*this->viewEmojis_,
-               getApp()->getEmotes()->getEmojis()->getEmojis());
+    const auto &emojis = getApp()->getEmotes()->getEmojis()->getEmojis();
+    this->viewEmojis_->setSections(makeEmojiSections(emojis));
+    this->emojiSection_ = {
+        .title = "Emojis",
+        .emotes = makeEmojiEntries(emojis),
+    };
     this->addShortcuts();
     this->signalHolder_.managedConnect(getApp()->getHotkeys()->onItemsUpdated,
                                        [this]() {
@@ -421,17 +335,20 @@ void EmotePopup::addShortcuts()
                  return "scrollPage hotkey called without arguments!";
              }
              auto direction = arguments.at(0);
-             auto *channelView = dynamic_cast<ChannelView *>(
-                 this->notebook_->getSelectedPage());
+             auto *grid =
+                 dynamic_cast<EmoteGrid *>(this->notebook_->getSelectedPage());
+             if (grid == nullptr)
+             {
+                 return "";
+             }
 
-             auto &scrollbar = channelView->getScrollBar();
              if (direction == "up")
              {
-                 scrollbar.offset(-scrollbar.getPageSize());
+                 grid->scrollPages(-1);
              }
              else if (direction == "down")
              {
-                 scrollbar.offset(scrollbar.getPageSize());
+                 grid->scrollPages(1);
              }
              else
              {
@@ -464,27 +381,16 @@ void EmotePopup::loadChannel(ChannelPtr channel)
 
     this->setWindowTitle("Emotes in #" + this->channel_->getName());
 
-    this->globalEmotesView_->setChannel(
-        std::make_shared<Channel>("", Channel::Type::None));
-    this->subEmotesView_->setChannel(
-        std::make_shared<Channel>("", Channel::Type::None));
-    this->channelEmotesView_->setChannel(
-        std::make_shared<Channel>("", Channel::Type::None));
-    this->searchView_->setChannel(
-        std::make_shared<Channel>("", Channel::Type::None));
-
     this->reloadEmotes();
 }
 
 void EmotePopup::reloadEmotes()
 {
-    auto subChannel = this->subEmotesView_->underlyingChannel();
-    auto globalChannel = this->globalEmotesView_->underlyingChannel();
-    auto channelChannel = this->channelEmotesView_->underlyingChannel();
+    BenchmarkGuard guard("reloadEmotes");
 
-    subChannel->clearMessages();
-    globalChannel->clearMessages();
-    channelChannel->clearMessages();
+    std::vector<EmoteSection> subSections;
+    std::vector<EmoteSection> globalSections;
+    std::vector<EmoteSection> channelSections;
 
     if (this->twitchChannel_)
     {
@@ -492,23 +398,23 @@ void EmotePopup::reloadEmotes()
         addTwitchEmoteSets(
             twitchChannel_->localTwitchEmotes(),
             *getApp()->getAccounts()->twitch.getCurrent()->accessEmoteSets(),
-            *globalChannel, *subChannel, twitchChannel_->roomId(),
+            globalSections, subSections, twitchChannel_->roomId(),
             twitchChannel_->getName());
 
         // channel
         if (Settings::instance().enableBTTVChannelEmotes)
         {
-            addEmotes(*channelChannel, *this->twitchChannel_->bttvEmotes(),
+            addEmotes(channelSections, *this->twitchChannel_->bttvEmotes(),
                       "BetterTTV");
         }
         if (Settings::instance().enableFFZChannelEmotes)
         {
-            addEmotes(*channelChannel, *this->twitchChannel_->ffzEmotes(),
+            addEmotes(channelSections, *this->twitchChannel_->ffzEmotes(),
                       "FrankerFaceZ");
         }
         if (Settings::instance().enableSevenTVChannelEmotes)
         {
-            addEmotes(*channelChannel, *this->twitchChannel_->seventvEmotes(),
+            addEmotes(channelSections, *this->twitchChannel_->seventvEmotes(),
                       "7TV");
         }
 
@@ -517,19 +423,19 @@ void EmotePopup::reloadEmotes()
              getApp()->getSeventvPersonalEmotes()->getEmoteSetsForTwitchUser(
                  getApp()->getAccounts()->twitch.getCurrent()->getUserId()))
         {
-            addEmotes(*subChannel, *map, "7TV (Personal)");
+            addEmotes(subSections, *map, "7TV (Personal)");
         }
     }
     if (this->kickChannel_)
     {
         // Kick
-        addEmotes(*globalChannel,
+        addEmotes(globalSections,
                   *getApp()->getKickChatServer()->globalEmotes(), "Kick");
 
         // channel
         if (Settings::instance().enableSevenTVChannelEmotes)
         {
-            addEmotes(*channelChannel, *this->kickChannel_->seventvEmotes(),
+            addEmotes(channelSections, *this->kickChannel_->seventvEmotes(),
                       "7TV");
         }
 
@@ -539,55 +445,55 @@ void EmotePopup::reloadEmotes()
                 getApp()->getAccounts()->kick.current()->userID());
         for (const auto &map : personalEmotes)
         {
-            addEmotes(*subChannel, *map, "7TV (Personal)");
-        }
-    }
-    if (this->kickChannel_)
-    {
-        addEmotes(*globalChannel,
-                  *getApp()->getKickChatServer()->globalEmotes(), "Kick");
-
-        if (Settings::instance().enableSevenTVChannelEmotes)
-        {
-            addEmotes(*channelChannel, *this->kickChannel_->seventvEmotes(),
-                      "7TV");
-        }
-
-        const auto personalEmotes =
-            getApp()->getSeventvPersonalEmotes()->getEmoteSetsForKickUser(
-                getApp()->getAccounts()->kick.current()->userID());
-        for (const auto &map : personalEmotes)
-        {
-            addEmotes(*subChannel, *map, "7TV (Personal)");
+            addEmotes(subSections, *map, "7TV (Personal)");
         }
     }
 
     // global
+    auto providerGlobals = globalSections.size();
     if (Settings::instance().enableBTTVGlobalEmotes)
     {
-        addEmotes(*globalChannel, *getApp()->getBttvEmotes()->emotes(),
+        addEmotes(globalSections, *getApp()->getBttvEmotes()->emotes(),
                   "BetterTTV");
     }
     if (Settings::instance().enableFFZGlobalEmotes)
     {
-        addEmotes(*globalChannel, *getApp()->getFfzEmotes()->emotes(),
+        addEmotes(globalSections, *getApp()->getFfzEmotes()->emotes(),
                   "FrankerFaceZ");
     }
     if (Settings::instance().enableSevenTVGlobalEmotes)
     {
-        addEmotes(*globalChannel, *getApp()->getSeventvEmotes()->globalEmotes(),
+        addEmotes(globalSections, *getApp()->getSeventvEmotes()->globalEmotes(),
                   "7TV");
     }
 
-    if (!subChannel->hasMessages())
+    // The search shows all tabs at once, so the provider sections get the
+    // tab in their title
+    std::vector<EmoteSection> searchSections = subSections;
+    for (auto section : channelSections)
+    {
+        section.title += u" (Channel)";
+        searchSections.emplace_back(std::move(section));
+    }
+    for (size_t i = 0; i < globalSections.size(); i++)
+    {
+        auto section = globalSections[i];
+        if (i >= providerGlobals)
+        {
+            section.title += u" (Global)";
+        }
+        searchSections.emplace_back(std::move(section));
+    }
+    searchSections.push_back(this->emojiSection_);
+    this->searchIndex_ = EmoteSearchIndex(std::move(searchSections));
+
+    this->subEmotesView_->setSections(std::move(subSections));
+    this->channelEmotesView_->setSections(std::move(channelSections));
+    this->globalEmotesView_->setSections(std::move(globalSections));
+
+    if (!this->search_->text().isEmpty())
     {
-        MessageBuilder builder;
-        builder->flags.set(MessageFlag::Centered);
-        builder->flags.set(MessageFlag::DisableCompactEmotes);
-        builder.emplace<TextElement>("no subscription emotes available",
-                                     MessageElementFlag::Text,
-                                     MessageColor::System);
-        subChannel->addMessage(builder.release(), MessageContext::Original);
+        this->filterEmotes(this->search_->text());
     }
 }
 
@@ -606,123 +512,6 @@ bool EmotePopup::eventFilter(QObject *object, QEvent *event)
     return false;
 }
 
-void EmotePopup::filterTwitchEmotes(std::shared_ptr<Channel> searchChannel,
-                                    const QString &searchText)
-{
-    if (this->twitchChannel_)
-    {
-        auto local = filterEmoteMap(searchText,
-                                    this->twitchChannel_->localTwitchEmotes());
-        if (!local.empty())
-        {
-            addEmotes(*searchChannel, local,
-                      this->twitchChannel_->getName() % u" (Follower)");
-        }
-
-        for (const auto &[_id, set] :
-             **getApp()->getAccounts()->twitch.getCurrent()->accessEmoteSets())
-        {
-            auto filtered = filterEmoteVec(searchText, set.emotes);
-            if (!filtered.empty())
-            {
-                addEmotes(*searchChannel, std::move(filtered), set.title());
-            }
-        }
-    }
-    if (this->kickChannel_)
-    {
-        auto globalEmotes = filterEmoteMap(
-            searchText, getApp()->getKickChatServer()->globalEmotes());
-        if (!globalEmotes.empty())
-        {
-            addEmotes(*searchChannel, std::move(globalEmotes), "Kick");
-        }
-    }
-
-    auto bttvGlobalEmotes =
-        filterEmoteMap(searchText, getApp()->getBttvEmotes()->emotes());
-    auto ffzGlobalEmotes =
-        filterEmoteMap(searchText, getApp()->getFfzEmotes()->emotes());
-    auto seventvGlobalEmotes = filterEmoteMap(
-        searchText, getApp()->getSeventvEmotes()->globalEmotes());
-
-    // global
-    if (!bttvGlobalEmotes.empty())
-    {
-        addEmotes(*searchChannel, bttvGlobalEmotes, "BetterTTV (Global)");
-    }
-    if (!ffzGlobalEmotes.empty())
-    {
-        addEmotes(*searchChannel, ffzGlobalEmotes, "FrankerFaceZ (Global)");
-    }
-    if (!seventvGlobalEmotes.empty())
-    {
-        addEmotes(*searchChannel, seventvGlobalEmotes, "7TV (Global)");
-    }
-
-    if (this->kickChannel_)
-    {
-        auto seventvChannelEmotes =
-            filterEmoteMap(searchText, this->kickChannel_->seventvEmotes());
-
-        if (!seventvChannelEmotes.empty())
-        {
-            addEmotes(*searchChannel, seventvChannelEmotes, "7TV (Channel)");
-        }
-
-        const auto personalEmotes =
-            getApp()->getSeventvPersonalEmotes()->getEmoteSetsForKickUser(
-                getApp()->getAccounts()->kick.current()->userID());
-        for (const auto &map : personalEmotes)
-        {
-            auto seventvPersonalEmotes = filterEmoteMap(searchText, map);
-            if (!seventvPersonalEmotes.empty())
-            {
-                addEmotes(*searchChannel, seventvPersonalEmotes,
-                          "SevenTV (Personal)");
-            }
-        }
-    }
-
-    if (this->twitchChannel_ == nullptr)
-    {
-        return;
-    }
-
-    auto bttvChannelEmotes =
-        filterEmoteMap(searchText, this->twitchChannel_->bttvEmotes());
-    auto ffzChannelEmotes =
-        filterEmoteMap(searchText, this->twitchChannel_->ffzEmotes());
-    auto seventvChannelEmotes =
-        filterEmoteMap(searchText, this->twitchChannel_->seventvEmotes());
-
-    // channel
-    if (!bttvChannelEmotes.empty())
-    {
-        addEmotes(*searchChannel, bttvChannelEmotes, "BetterTTV (Channel)");
-    }
-    if (!ffzChannelEmotes.empty())
-    {
-        addEmotes(*searchChannel, ffzChannelEmotes, "FrankerFaceZ (Channel)");
-    }
-    if (!seventvChannelEmotes.empty())
-    {
-        addEmotes(*searchChannel, seventvChannelEmotes, "7TV (Channel)");
-    }
-
-    for (const auto &map :
-         getApp()->getSeventvPersonalEmotes()->getEmoteSetsForTwitchUser(
-             getApp()->getAccounts()->twitch.getCurrent()->getUserId()))
-    {
-        auto seventvPersonalEmotes = filterEmoteMap(searchText, map);
-        if (!seventvPersonalEmotes.empty())
-        {
-            addEmotes(*searchChannel, seventvPersonalEmotes,
-                      "SevenTV (Personal)");
-        }
-    }
-}
-
 void EmotePopup::filterEmotes(const QString &searchText)
 {
     if (searchText.length() == 0)
@@ -732,32 +521,8 @@ void EmotePopup::filterEmotes(const QString &searchText)
 
         return;
     }
-    auto searchChannel = this->searchView_->underlyingChannel();
-    searchChannel->clearMessages();
-
-    // true in special channels like /mentions
-    if (this->channel_->isTwitchOrKickChannel())
-    {
-        this->filterTwitchEmotes(searchChannel, searchText);
-    }
 
-    std::vector<EmojiPtr> filteredEmojis{};
-    int emojiCount = 0;
-
-    const auto &emojis = getApp()->getEmotes()->getEmojis()->getEmojis();
-    for (const auto &emoji : emojis)
-    {
-        if (emoji->shortCodes[0].contains(searchText, Qt::CaseInsensitive))
-        {
-            filteredEmojis.push_back(emoji);
-            emojiCount++;
-        }
-    }
-    // emojis
-    if (emojiCount > 0)
-    {
-        loadEmojis(*searchChannel, filteredEmojis, "Emojis");
-    }
+    this->searchView_->setSections(this->searchIndex_.search(searchText));
 
     this->notebook_->hide();
     this->searchView_->show();
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "controllers/emotes/EmoteSearchIndex.hpp"
 #include "widgets/BasePopup.hpp"
 
 #include <pajlada/signals/signal.hpp>
@@ -12,7 +13,7 @@
 namespace chatterino {
 
 struct Link;
-class ChannelView;
+class EmoteGrid;
 class Channel;
 using ChannelPtr = std::shared_ptr<Channel>;
 class Notebook;
@@ -36,15 +37,20 @@ protected:
     void themeChangedEvent() override;
 
 private:
-    ChannelView *globalEmotesView_{};
-    ChannelView *channelEmotesView_{};
-    ChannelView *subEmotesView_{};
-    ChannelView *viewEmojis_{};
+    EmoteGrid *globalEmotesView_{};
+    EmoteGrid *channelEmotesView_{};
+    EmoteGrid *subEmotesView_{};
+    EmoteGrid *viewEmojis_{};
     /**
      * @brief Visible only when the user has specified a search query into the `search_` input.
      * Otherwise the `notebook_` and all other views are visible.
      */
-    ChannelView *searchView_{};
+    EmoteGrid *searchView_{};
+
+    /// All emojis in a single section for the search
+    EmoteSection emojiSection_;
+    /// Index over the emotes of all tabs, rebuilt in reloadEmotes
+    EmoteSearchIndex searchIndex_;
 
     ChannelPtr channel_;
     TwitchChannel *twitchChannel_{};
@@ -53,8 +59,6 @@ private:
     QLineEdit *search_;
     Notebook *notebook_;
 
-    void filterTwitchEmotes(std::shared_ptr<Channel> searchChannel,
-                            const QString &searchText);
     void filterEmotes(const QString &text);
     void addShortcuts() override;
     bool eventFilter(QObject *object, QEvent *event) override;
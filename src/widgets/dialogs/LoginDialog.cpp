@@ -71,7 +71,7 @@ bool logInWithCredentials(QWidget *parent, const QString &userID,
 
     getApp()->getAccounts()->twitch.reloadUsers();
     getApp()->getAccounts()->twitch.currentUsername = username;
-    getSettings()->requestSave();
+    getSettings()->queueSave();
     return true;
 }
 
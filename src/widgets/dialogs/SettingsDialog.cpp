@@ -466,7 +466,7 @@ void SettingsDialog::onOkClicked()
         getApp()->getCommands()->save();
     }
 
-    getSettings()->requestSave();
+    getSettings()->queueSave();
 
     this->close();
 }
@@ -503,22 +503,22 @@ QString formatUsercardStatus(const IvrUserProfile &profile)
     return "Non Affiliate";
 }
 
-bool checkMessageUserName(const QString &userName, const MessagePtr &message)
+bool checkMessageUserName(const QString &userName, const Message &message)
 {
-    if (message->flags.has(MessageFlag::Whisper))
+    if (message.flags.has(MessageFlag::Whisper))
     {
         return false;
     }
 
-    bool isSubscription = message->flags.has(MessageFlag::Subscription) &&
-                          message->loginName.isEmpty() &&
-                          message->messageText.split(" ").at(0).compare(
+    bool isSubscription = message.flags.has(MessageFlag::Subscription) &&
+                          message.loginName.isEmpty() &&
+                          message.messageText.split(" ").at(0).compare(
                               userName, Qt::CaseInsensitive) == 0;
 
     bool isModAction =
-        message->timeoutUser.compare(userName, Qt::CaseInsensitive) == 0;
+        message.timeoutUser.compare(userName, Qt::CaseInsensitive) == 0;
     bool isSelectedUser =
-        message->loginName.compare(userName, Qt::CaseInsensitive) == 0;
+        message.loginName.compare(userName, Qt::CaseInsensitive) == 0;
 
     return (isSubscription || isModAction || isSelectedUser);
 }
@@ -535,7 +535,7 @@ bool messageHasTwitchBadge(const Message &message, QStringView badge)
 
 ChannelPtr filterMessages(const QString &userName, const ChannelPtr &channel)
 {
-    std::vector<MessagePtr> snapshot = channel->getMessageSnapshot();
+    const auto snapshot = channel->getMessageSnapshot();
 
     ChannelPtr channelPtr;
     if (channel->isTwitchChannel())
@@ -548,9 +548,19 @@ ChannelPtr filterMessages(const QString &userName, const ChannelPtr &channel)
             std::make_shared<Channel>(channel->getName(), Channel::Type::None);
     }
 
+    // Archived messages are older than the ones in the snapshot
+    auto archived = channel->archive().findByUser(
+        userName, [&](const Message &message) {
+            return checkMessageUserName(userName, message);
+        });
+    for (const auto &message : archived)
+    {
+        channelPtr->addMessage(message, MessageContext::Repost);
+    }
+
     for (const auto &message : snapshot)
     {
-        if (checkMessageUserName(userName, message))
+        if (checkMessageUserName(userName, *message))
         {
             channelPtr->addMessage(message, MessageContext::Repost);
         }
@@ -1842,7 +1852,7 @@ void UserInfoPopup::updateLatestMessages()
                         this->userStateChanged_.invoke();
                     }
 
-                    if (!checkMessageUserName(this->userName_, message))
+                    if (!checkMessageUserName(this->userName_, *message))
                     {
                         return;
                     }
@@ -2559,7 +2569,7 @@ void UserInfoPopup::updateUserData()
         if (getSettings()->showPronouns)
         {
             getApp()->getPronouns()->getUserPronoun(
-                user.login,
+                user.id, user.login,
                 [this, isCurrentRequest](const auto &userPronoun) {
                     runInGuiThread([this, isCurrentRequest,
                                     userPronoun = std::move(userPronoun)]() {
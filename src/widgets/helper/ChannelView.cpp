@@ -14,6 +14,7 @@
 #include "controllers/emotes/EmoteController.hpp"
 #include "controllers/filters/FilterSet.hpp"
 #include "debug/Benchmark.hpp"
+#include "debug/StartupTrace.hpp"
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/layouts/MessageLayout.hpp"
@@ -40,6 +41,7 @@
 #include "singletons/Theme.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/Clipboard.hpp"
+#include "util/DebugCount.hpp"
 #include "util/DistanceBetweenPoints.hpp"
 #include "util/Helpers.hpp"
 #include "util/IncognitoBrowser.hpp"
@@ -51,6 +53,7 @@
 #include "widgets/dialogs/ReplyThreadPopup.hpp"
 #include "widgets/dialogs/SettingsDialog.hpp"
 #include "widgets/dialogs/UserInfoPopup.hpp"
+#include "widgets/helper/PaintProfiler.hpp"
 #include "widgets/helper/ScrollbarHighlight.hpp"
 #include "widgets/helper/SearchPopup.hpp"
 #include "widgets/Notebook.hpp"
@@ -97,6 +100,8 @@ using namespace chatterino;
 
 constexpr int SCROLLBAR_PADDING = 8;
 constexpr int MAX_AUTO_TRANSLATIONS_IN_FLIGHT_PER_CHANNEL = 5;
+/// Number of archived messages loaded when scrolling to the top
+constexpr size_t ARCHIVE_PAGE_SIZE = 100;
 
 QString messageTextForTranslation(const MessagePtr &message)
 {
@@ -1001,6 +1006,11 @@ ChannelView::ChannelView(InternalCtor /*tag*/, QWidget *parent, Split *split,
         this->scrollUpdateRequested();
     });
 
+    this->hibernateTimer_.setSingleShot(true);
+    QObject::connect(&this->hibernateTimer_, &QTimer::timeout, this, [this] {
+        this->hibernate();
+    });
+
     this->grabGesture(Qt::PanGesture);
 
     // TODO: Figure out if we need this, and if so, why
@@ -1026,6 +1036,11 @@ ChannelView::ChannelView(InternalCtor /*tag*/, QWidget *parent, Split *split,
                                               this->signalHolder_);
 }
 
+ChannelView::~ChannelView()
+{
+    PaintProfiler::instance().remove(this);
+}
+
 void ChannelView::initializeLayout()
 {
     this->goToBottom_ = new LabelButton("More messages below", this);
@@ -1050,6 +1065,21 @@ void ChannelView::initializeScrollbar()
         {
             this->performLayout(true);
             this->queueUpdate();
+
+            // Both change the scrollbar, so they can't run in its signal
+            if (this->scrollBar_->getRelativeCurrentValue() < 1)
+            {
+                QTimer::singleShot(0, this, [this] {
+                    this->loadArchivedMessages();
+                });
+            }
+            else if (this->archivedMessages_ > 0 &&
+                     this->scrollBar_->isAtBottom())
+            {
+                QTimer::singleShot(0, this, [this] {
+                    this->unloadArchivedMessages();
+                });
+            }
         }
         else
         {
@@ -1121,7 +1151,9 @@ bool ChannelView::pausable() const
 
 void ChannelView::setPausable(bool value)
 {
+    bool wasUnpaused = !this->paused();
     this->pausable_ = value;
+    this->updatePausedSnapshot(wasUnpaused);
 }
 
 bool ChannelView::paused() const
@@ -1164,6 +1196,7 @@ void ChannelView::pause(PauseReason reason, std::optional<uint> msecs)
     }
 
     this->updatePauses();
+    this->updatePausedSnapshot(wasUnpaused);
 
     if (wasUnpaused)
     {
@@ -1230,13 +1263,32 @@ void ChannelView::updatePauses()
     }
 }
 
+void ChannelView::updatePausedSnapshot(bool wasUnpaused)
+{
+    if (!this->paused())
+    {
+        this->snapshot_ = {};
+    }
+    else if (wasUnpaused)
+    {
+        // Freeze the messages that are shown
+        this->snapshot_ = this->messages_.getSnapshot();
+    }
+}
+
 void ChannelView::unpaused()
 {
+    this->snapshot_ = {};
+
     /// Move selection
     this->selection_.shiftMessageIndex(this->pauseSelectionOffset_);
     this->doubleClickSelection_.shiftMessageIndex(this->pauseSelectionOffset_);
 
     this->pauseSelectionOffset_ = 0;
+
+    QTimer::singleShot(0, this, [this] {
+        this->loadArchivedMessages();
+    });
 }
 
 void ChannelView::themeChangedEvent()
@@ -1389,6 +1441,8 @@ void ChannelView::queueLayout()
 
 void ChannelView::showEvent(QShowEvent * /*event*/)
 {
+    this->hibernateTimer_.stop();
+
     if (this->layoutQueued_)
     {
         this->performLayout(false, true);
@@ -1399,6 +1453,11 @@ void ChannelView::performLayout(bool causedByScrollbar, bool causedByShow)
 {
     // BenchmarkGuard benchmark("layout");
 
+    auto &profiler = PaintProfiler::instance();
+    auto layoutStart = profiler.enabled()
+                           ? std::chrono::steady_clock::now()
+                           : std::chrono::steady_clock::time_point{};
+
     this->layoutQueued_ = false;
 
     /// Get messages and check if there are at least 1
@@ -1417,10 +1476,16 @@ void ChannelView::performLayout(bool causedByScrollbar, bool causedByShow)
     this->goToBottom_->setVisible(this->enableScrollingToBottom_ &&
                                   this->scrollBar_->isVisible() &&
                                   !this->scrollBar_->isAtBottom());
+
+    if (profiler.enabled())
+    {
+        profiler.profile(this, this->channel_->getName())
+            .addLayout(std::chrono::steady_clock::now() - layoutStart);
+    }
 }
 
 void ChannelView::layoutVisibleMessages(
-    const std::vector<MessageLayoutPtr> &messages)
+    const LimitedQueueSnapshot<MessageLayoutPtr> &messages)
 {
     const auto start = size_t(this->scrollBar_->getRelativeCurrentValue());
     const auto layoutWidth = this->getLayoutWidth();
@@ -1469,8 +1534,9 @@ void ChannelView::layoutVisibleMessages(
     }
 }
 
-void ChannelView::updateScrollbar(const std::vector<MessageLayoutPtr> &messages,
-                                  bool causedByScrollbar, bool causedByShow)
+void ChannelView::updateScrollbar(
+    const LimitedQueueSnapshot<MessageLayoutPtr> &messages,
+    bool causedByScrollbar, bool causedByShow)
 {
     if (messages.size() == 0)
     {
@@ -1548,6 +1614,12 @@ void ChannelView::setVerticalOffset(int offset)
 
 void ChannelView::clearMessages()
 {
+    // The filtered channel batches its appends, they'd come back after this
+    if (this->channel_)
+    {
+        this->channel_->clearMessages();
+    }
+
     // Clear all stored messages in this chat widget
     this->messages_.clear();
     this->nukePreviewMessageIds_.clear();
@@ -1560,6 +1632,15 @@ void ChannelView::clearMessages()
 
     this->lastMessageHasAlternateBackground_ = false;
     this->lastMessageHasAlternateBackgroundReverse_ = true;
+
+    if (this->archivedMessages_ > 0)
+    {
+        this->messages_.setLimit(this->messages_.limit() -
+                                 this->archivedMessages_);
+        this->scrollBar_->setHighlightsLimit(this->messages_.limit());
+        this->archivedMessages_ = 0;
+    }
+    this->archivePosition_.reset();
 }
 
 Scrollbar &ChannelView::getScrollBar()
@@ -1571,8 +1652,7 @@ QString ChannelView::getSelectedText()
 {
     QString result = "";
 
-    std::vector<MessageLayoutPtr> &messagesSnapshot =
-        this->getMessagesSnapshot();
+    const auto &messagesSnapshot = this->getMessagesSnapshot();
 
     Selection selection = this->selection_;
 
@@ -1666,12 +1746,12 @@ const std::optional<MessageElementFlags> &ChannelView::getOverrideFlags() const
     return this->overrideFlags_;
 }
 
-std::vector<MessageLayoutPtr> &ChannelView::getMessagesSnapshot()
+LimitedQueueSnapshot<MessageLayoutPtr> ChannelView::getMessagesSnapshot()
 {
     this->snapshotGuard_.guard();
     if (!this->paused() /*|| this->scrollBar_->isVisible()*/)
     {
-        this->snapshot_ = this->messages_.getSnapshot();
+        return this->messages_.getSnapshot();
     }
 
     return this->snapshot_;
@@ -1963,12 +2043,14 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
     // Standard channel connections
     //
 
-    // on new message
+    // The messages copied above were already added to the view
+    this->channel_->flushAppendedMessages();
+
+    // on new messages
     this->channelConnections_.managedConnect(
-        this->channel_->messageAppended,
-        [this](MessagePtr &message,
-               std::optional<MessageFlags> overridingFlags) {
-            this->messageAppended(message, overridingFlags);
+        this->channel_->messagesAppended,
+        [this](std::span<const AppendedMessage> messages) {
+            this->messagesAppended(messages);
         });
 
     this->channelConnections_.managedConnect(
@@ -2079,81 +2161,96 @@ bool ChannelView::hasSourceChannel() const
     return this->sourceChannel_ != nullptr;
 }
 
-void ChannelView::messageAppended(MessagePtr &message,
-                                  std::optional<MessageFlags> overridingFlags)
+void ChannelView::messagesAppended(std::span<const AppendedMessage> messages)
 {
-    auto *messageFlags = &message->flags;
-    if (overridingFlags)
+    if (messages.empty())
     {
-        messageFlags = &*overridingFlags;
+        return;
     }
 
-    auto messageRef = std::make_shared<MessageLayout>(message);
+    const bool ignoreHighlights = this->channel_->shouldIgnoreHighlights();
+    const bool showScrollbarHighlights = this->showScrollbarHighlights();
 
-    if (this->lastMessageHasAlternateBackground_)
-    {
-        messageRef->flags.set(MessageLayoutFlag::AlternateBackground);
-    }
-    if (this->channel_->shouldIgnoreHighlights())
+    // The tab only shows the strongest state, so one request is enough
+    TabHighlight tabHighlight;
+    size_t nRemoved = 0;
+
+    for (const auto &[message, overridingFlags] : messages)
     {
-        messageRef->flags.set(MessageLayoutFlag::IgnoreHighlights);
+        const auto &messageFlags =
+            overridingFlags ? *overridingFlags : message->flags;
+
+        auto messageRef = std::make_shared<MessageLayout>(message);
+
+        if (this->lastMessageHasAlternateBackground_)
+        {
+            messageRef->flags.set(MessageLayoutFlag::AlternateBackground);
+        }
+        if (ignoreHighlights)
+        {
+            messageRef->flags.set(MessageLayoutFlag::IgnoreHighlights);
+        }
+        this->lastMessageHasAlternateBackground_ =
+            !this->lastMessageHasAlternateBackground_;
+
+        if (this->messages_.pushBack(messageRef))
+        {
+            nRemoved++;
+        }
+
+        if (!messageFlags.has(MessageFlag::DoNotTriggerNotification))
+        {
+            if ((messageFlags.has(MessageFlag::Highlighted) &&
+                 messageFlags.has(MessageFlag::ShowInMentions) &&
+                 !messageFlags.has(MessageFlag::Subscription) &&
+                 (getSettings()->highlightMentions ||
+                  this->channel_->getType() !=
+                      Channel::Type::TwitchMentions)) ||
+                (this->channel_->getType() == Channel::Type::TwitchAutomod &&
+                 getSettings()->enableAutomodHighlight))
+            {
+                tabHighlight = {
+                    .state = HighlightState::Highlighted,
+                    .color = message->highlightColor,
+                };
+            }
+            else if (tabHighlight.state == HighlightState::None)
+            {
+                tabHighlight.state = HighlightState::NewMessage;
+            }
+        }
+
+        if (showScrollbarHighlights)
+        {
+            this->scrollBar_->addHighlight(scrollbarHighlightForMessage(
+                message, this->nukePreviewMessageIds_));
+        }
     }
-    this->lastMessageHasAlternateBackground_ =
-        !this->lastMessageHasAlternateBackground_;
 
     if (this->paused())
     {
-        this->pauseScrollMaximumOffset_++;
+        this->pauseScrollMaximumOffset_ += static_cast<int>(messages.size());
+        this->pauseScrollMinimumOffset_ += static_cast<int>(nRemoved);
+        this->pauseSelectionOffset_ += static_cast<uint32_t>(nRemoved);
     }
     else
     {
-        this->scrollBar_->offsetMaximum(1);
-    }
-
-    if (this->messages_.pushBack(messageRef))
-    {
-        if (this->paused())
-        {
-            this->pauseScrollMinimumOffset_++;
-            this->pauseSelectionOffset_++;
-        }
-        else
+        this->scrollBar_->offsetMaximum(static_cast<qreal>(messages.size()));
+        if (nRemoved > 0)
         {
-            this->scrollBar_->offsetMinimum(1);
+            this->scrollBar_->offsetMinimum(static_cast<qreal>(nRemoved));
             if (this->showingLatestMessages_ && !this->isVisible())
             {
                 this->scrollBar_->scrollToBottom(false);
             }
-            this->selection_.shiftMessageIndex(1);
-            this->doubleClickSelection_.shiftMessageIndex(1);
+            this->selection_.shiftMessageIndex(nRemoved);
+            this->doubleClickSelection_.shiftMessageIndex(nRemoved);
         }
     }
 
-    if (!messageFlags->has(MessageFlag::DoNotTriggerNotification))
+    if (tabHighlight.state != HighlightState::None)
     {
-        if ((messageFlags->has(MessageFlag::Highlighted) &&
-             messageFlags->has(MessageFlag::ShowInMentions) &&
-             !messageFlags->has(MessageFlag::Subscription) &&
-             (getSettings()->highlightMentions ||
-              this->channel_->getType() != Channel::Type::TwitchMentions)) ||
-            (this->channel_->getType() == Channel::Type::TwitchAutomod &&
-             getSettings()->enableAutomodHighlight))
-        {
-            this->tabHighlightRequested.invoke(
-                {.state = HighlightState::Highlighted,
-                 .color = message->highlightColor});
-        }
-        else
-        {
-            this->tabHighlightRequested.invoke(
-                {.state = HighlightState::NewMessage});
-        }
-    }
-
-    if (this->showScrollbarHighlights())
-    {
-        this->scrollBar_->addHighlight(scrollbarHighlightForMessage(
-            message, this->nukePreviewMessageIds_));
+        this->tabHighlightRequested.invoke(tabHighlight);
     }
 
     this->queueLayout();
@@ -2212,6 +2309,99 @@ void ChannelView::messageAddedAtStart(std::vector<MessagePtr> &messages)
     this->queueLayout();
 }
 
+void ChannelView::loadArchivedMessages()
+{
+    // Paused views show a snapshot, they load once they're unpaused
+    if (!this->showScrollBar_ || this->paused() ||
+        this->scrollBar_->getRelativeCurrentValue() >= 1)
+    {
+        return;
+    }
+
+    // The filtered channel archives the messages this view dropped
+    const auto &archive = this->channel_->archive();
+    if (archive.size() == 0)
+    {
+        return;
+    }
+    if (!this->archivePosition_)
+    {
+        this->archivePosition_ = this->findArchivePosition();
+    }
+
+    auto page = archive.findBefore(*this->archivePosition_, ARCHIVE_PAGE_SIZE,
+                                   [](const auto &) {
+                                       return true;
+                                   });
+    if (page.messages.empty())
+    {
+        return;
+    }
+    this->archivePosition_ = page.start;
+
+    // The view keeps these on top of its limit until it's scrolled to the
+    // bottom again
+    this->archivedMessages_ += page.messages.size();
+    this->messages_.setLimit(this->messages_.limit() + page.messages.size());
+    this->scrollBar_->setHighlightsLimit(this->messages_.limit());
+    this->messageAddedAtStart(page.messages);
+}
+
+void ChannelView::unloadArchivedMessages()
+{
+    if (this->archivedMessages_ == 0 || this->paused() ||
+        !this->scrollBar_->isAtBottom())
+    {
+        return;
+    }
+
+    auto limit = this->messages_.limit() - this->archivedMessages_;
+    this->archivedMessages_ = 0;
+    this->archivePosition_.reset();
+
+    auto nRemoved = this->messages_.setLimit(limit);
+    this->scrollBar_->setHighlightsLimit(limit);
+    if (nRemoved > 0)
+    {
+        this->scrollBar_->offsetMinimum(static_cast<qreal>(nRemoved));
+        this->selection_.shiftMessageIndex(nRemoved);
+        this->doubleClickSelection_.shiftMessageIndex(nRemoved);
+    }
+    this->queueLayout();
+}
+
+uint64_t ChannelView::findArchivePosition() const
+{
+    const auto &archive = this->channel_->archive();
+    auto oldest = this->messages_.first();
+    if (!oldest)
+    {
+        return archive.endPosition();
+    }
+    const auto *message = (*oldest)->getMessage();
+
+    // Everything in the archive is older than the channel's messages
+    auto channelMessages = this->channel_->getMessageSnapshot();
+    if (std::ranges::any_of(channelMessages, [&](const auto &m) {
+            return m.get() == message;
+        }))
+    {
+        return archive.endPosition();
+    }
+
+    // The view can have a higher limit than the channel. If its oldest
+    // message isn't in the archive either, there's nothing older left.
+    return archive
+        .findBefore(archive.endPosition(), 1,
+                    [&](const Message &fields) {
+                        return fields.id == message->id &&
+                               fields.serverReceivedTime ==
+                                   message->serverReceivedTime &&
+                               fields.messageText == message->messageText;
+                    })
+        .start;
+}
+
 void ChannelView::messageReplaced(size_t hint, const MessagePtr &prev,
                                   const MessagePtr &replacement)
 {
@@ -2397,7 +2587,7 @@ bool ChannelView::scrollToMessage(const MessagePtr &message)
         return false;
     }
 
-    auto &messagesSnapshot = this->getMessagesSnapshot();
+    const auto messagesSnapshot = this->getMessagesSnapshot();
     if (messagesSnapshot.size() == 0)
     {
         return false;
@@ -2433,7 +2623,7 @@ bool ChannelView::scrollToMessage(const MessagePtr &message)
 
 bool ChannelView::scrollToMessageId(const QString &messageId)
 {
-    auto &messagesSnapshot = this->getMessagesSnapshot();
+    const auto messagesSnapshot = this->getMessagesSnapshot();
     if (messagesSnapshot.size() == 0)
     {
         return false;
@@ -2505,6 +2695,12 @@ void ChannelView::paintEvent(QPaintEvent *event)
 {
     //    BenchmarkGuard benchmark("paint");
 
+    auto &profiler = PaintProfiler::instance();
+    const bool profiling = profiler.enabled();
+    PaintSample sample;
+    auto frameStart = profiling ? std::chrono::steady_clock::now()
+                                : std::chrono::steady_clock::time_point{};
+
     QPainter painter(this);
 
     if (!this->transparentBackground_)
@@ -2516,7 +2712,16 @@ void ChannelView::paintEvent(QPaintEvent *event)
     painter.setClipRect(this->rect());
 
     // draw messages
-    this->drawMessages(painter, event->rect());
+    this->drawMessages(painter, event->rect(),
+                       profiling ? &sample : nullptr);
+
+    if (!this->tracedFirstPaint_ && StartupTrace::enabled() &&
+        !this->getMessagesSnapshot().empty())
+    {
+        this->tracedFirstPaint_ = true;
+        StartupTrace::instant("paint", "first paint with messages",
+                              {{"channel", this->channel_->getName()}});
+    }
 
     // draw paused sign
     if (this->paused())
@@ -2553,13 +2758,72 @@ void ChannelView::paintEvent(QPaintEvent *event)
         painter.drawText(QRectF(textX, pausedY, textWidth, indicatorSize),
                          Qt::AlignLeft | Qt::AlignVCenter, text);
     }
+
+    if (profiling)
+    {
+        sample.frame = std::chrono::steady_clock::now() - frameStart;
+        auto &profile = profiler.profile(this, this->channel_->getName());
+        profile.addFrame(std::move(sample));
+        auto overlay = this->drawPaintProfile(painter, profile);
+
+        // A partial repaint is clipped to its area and would leave parts of
+        // the overlay with the numbers of an older frame
+        if (!event->rect().contains(overlay))
+        {
+            this->update(overlay);
+        }
+    }
+}
+
+QRect ChannelView::drawPaintProfile(QPainter &painter,
+                                    const PaintProfile &profile)
+{
+    auto ms = [](std::chrono::nanoseconds elapsed) {
+        return QString::number(
+            std::chrono::duration<double, std::milli>(elapsed).count(), 'f',
+            2);
+    };
+    auto average = profile.average();
+    auto worst = profile.worst();
+
+    const auto text =
+        u"frame %1 ms, worst %2 ms\n"
+        u"layout %3 ms\n"
+        u"render %4 ms (%5 buffers)\n"
+        u"blit %6 ms (%7 buffers)\n"
+        u"emotes %8 ms\n"
+        u"selection %9 ms"_s.arg(
+            ms(average.frame), ms(worst.frame), ms(average.layout),
+            ms(average.bufferRender), QString::number(average.buffersRendered),
+            ms(average.blit), QString::number(average.buffersBlitted),
+            ms(average.emotes), ms(average.selection));
+
+    QFont font = painter.font();
+    font.setPixelSize(static_cast<int>(11 * this->scale()));
+    painter.setFont(font);
+
+    const auto padding = static_cast<int>(4 * this->scale());
+    auto textRect = QFontMetrics(font).boundingRect(
+        QRect(0, 0, this->width(), this->height()), Qt::AlignLeft, text);
+    textRect.moveTopRight(
+        QPoint(this->width() - 1 - 2 * padding, 2 * padding));
+
+    auto background = textRect.adjusted(-padding, -padding, padding, padding);
+    painter.fillRect(background, QColor(0, 0, 0, 200));
+    painter.setPen(Qt::white);
+    painter.drawText(textRect, Qt::AlignLeft, text);
+
+    return background;
 }
 
 // if overlays is false then it draws the message, if true then it draws things
 // such as the grey overlay when a message is disabled
-void ChannelView::drawMessages(QPainter &painter, const QRect &area)
+void ChannelView::drawMessages(QPainter &painter, const QRect &area,
+                               PaintSample *sample)
 {
-    auto &messagesSnapshot = this->getMessagesSnapshot();
+    DebugStageTimer timer(DebugStage::Paint);
+
+    const auto messagesSnapshot = this->getMessagesSnapshot();
 
     const auto start = size_t(this->scrollBar_->getRelativeCurrentValue());
 
@@ -2595,6 +2859,7 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
         .messageIndex = start,
         .isLastReadMessage = false,
         .isCollapsed = this->collapseMessages_,
+        .profile = sample != nullptr,
     };
     bool showLastMessageIndicator = getSettings()->showLastMessageIndicator;
 
@@ -2623,6 +2888,27 @@ void ChannelView::drawMessages(QPainter &painter, const QRect &area)
         {
             auto paintResult = layout->paint(ctx);
             const auto &message = layout->getMessagePtr();
+            if (sample != nullptr)
+            {
+                sample->bufferRender += paintResult.bufferTime;
+                sample->blit += paintResult.blitTime;
+                sample->emotes += paintResult.emoteTime;
+                sample->selection += paintResult.selectionTime;
+                if (!paintResult.renderedBuffer)
+                {
+                    sample->buffersBlitted++;
+                }
+                else
+                {
+                    sample->buffersRendered++;
+                    if (message != nullptr &&
+                        paintResult.bufferTime > sample->slowestRender)
+                    {
+                        sample->slowestRender = paintResult.bufferTime;
+                        sample->slowestMessage = message->messageText.left(60);
+                    }
+                }
+            }
             if (message != nullptr &&
                 this->nukePreviewMessageIds_.contains(message->id))
             {
@@ -2763,7 +3049,7 @@ void ChannelView::wheelEvent(QWheelEvent *event)
         qreal desired = std::max<qreal>(0, this->scrollBar_->getDesiredValue());
         qreal delta = event->angleDelta().y() * qreal(1.5) * mouseMultiplier;
 
-        auto &snapshot = this->getMessagesSnapshot();
+        const auto snapshot = this->getMessagesSnapshot();
         int snapshotLength = int(snapshot.size());
         int i = std::min<int>(int(desired - this->scrollBar_->getMinimum()),
                               snapshotLength - 1);
@@ -3165,7 +3451,7 @@ void ChannelView::mousePressEvent(QMouseEvent *event)
     if (!this->tryGetMessageAt(event->pos(), layout, relativePos, messageIndex))
     {
         this->setCursor(Qt::ArrowCursor);
-        auto &messagesSnapshot = this->getMessagesSnapshot();
+        const auto messagesSnapshot = this->getMessagesSnapshot();
         if (messagesSnapshot.size() == 0)
         {
             return;
@@ -4165,6 +4451,41 @@ void ChannelView::hideEvent(QHideEvent * /*event*/)
     }
 
     this->messagesOnScreen_.clear();
+
+    auto minutes = getSettings()->hibernateHiddenSplitsAfter.getValue();
+    if (minutes > 0)
+    {
+        this->hibernateTimer_.start(std::chrono::minutes(minutes));
+    }
+}
+
+void ChannelView::hibernate()
+{
+    if (this->isVisible())
+    {
+        return;
+    }
+
+    // The layouts themselves stay in the queue, since the scrollbar and
+    // pauses refer to messages by their index.
+    for (const auto &layout : this->messages_.getSnapshot())
+    {
+        layout->deleteCache();
+    }
+    // Might still hold layouts that were removed from the queue
+    for (const auto &layout : this->snapshot_)
+    {
+        layout->deleteCache();
+    }
+
+    // Copying a selection needs the elements of the selected messages
+    this->selection_ = Selection();
+    this->doubleClickSelection_ = Selection();
+    this->layoutQueued_ = true;
+
+    qCDebug(chatterinoWidget)
+        << "Hibernated channel view"
+        << (this->channel_ ? this->channel_->getName() : QString());
 }
 
 void ChannelView::showUserInfoPopup(const QString &userName,
@@ -4408,7 +4729,7 @@ bool ChannelView::tryGetMessageAt(QPointF p,
                                   std::shared_ptr<MessageLayout> &_message,
                                   QPointF &relativePos, int &index)
 {
-    auto &messagesSnapshot = this->getMessagesSnapshot();
+    const auto messagesSnapshot = this->getMessagesSnapshot();
 
     const auto start = size_t(this->scrollBar_->getRelativeCurrentValue());
 
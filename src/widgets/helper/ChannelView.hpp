@@ -27,7 +27,10 @@
 #include <QWheelEvent>
 #include <QWidget>
 
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -38,6 +41,7 @@ struct TabHighlight {
 };
 
 class Channel;
+struct AppendedMessage;
 using ChannelPtr = std::shared_ptr<Channel>;
 
 enum class MessagePlatform : uint8_t;
@@ -48,6 +52,9 @@ using MessagePtr = std::shared_ptr<const Message>;
 class MessageLayout;
 using MessageLayoutPtr = std::shared_ptr<MessageLayout>;
 
+struct PaintSample;
+class PaintProfile;
+
 enum class MessageElementFlag : int64_t;
 using MessageElementFlags = FlagsEnum<MessageElementFlag>;
 
@@ -60,6 +67,7 @@ class FilterSet;
 using FilterSetPtr = std::shared_ptr<FilterSet>;
 
 class LinkInfo;
+class ChannelViewTestAccess;
 
 enum class PauseReason {
     Mouse,
@@ -110,6 +118,8 @@ public:
                          Context context = Context::None,
                          size_t messagesLimit = 1000);
 
+    ~ChannelView() override;
+
     void queueUpdate();
     void queueUpdate(const QRect &area);
     Scrollbar &getScrollBar();
@@ -165,7 +175,8 @@ public:
 
     void performLayout(bool causedByScrollbar = false,
                        bool causedByShow = false);
-    void layoutVisibleMessages(const std::vector<MessageLayoutPtr> &messages);
+    void layoutVisibleMessages(
+        const LimitedQueueSnapshot<MessageLayoutPtr> &messages);
 
     void setOverrideEmoteScale(std::optional<float> value);
     std::optional<float> getOverrideEmoteScale() const;
@@ -230,7 +241,9 @@ public:
     /// Checks if this view has a #sourceChannel
     bool hasSourceChannel() const;
 
-    std::vector<MessageLayoutPtr> &getMessagesSnapshot();
+    /// Returns the messages to show: the current ones, or the ones from when
+    /// the view was paused
+    LimitedQueueSnapshot<MessageLayoutPtr> getMessagesSnapshot();
 
     void queueLayout();
     void invalidateBuffers();
@@ -307,6 +320,11 @@ protected:
     void hideEvent(QHideEvent * /*event*/) override;
     void showEvent(QShowEvent *event) override;
 
+    /// Frees the layouts of all messages while the view is hidden. The
+    /// messages are kept, only the visible ones are laid out again once the
+    /// view is shown.
+    void hibernate();
+
     void handleLinkClick(QMouseEvent *event, const Link &link,
                          MessageLayout *layout);
 
@@ -324,19 +342,30 @@ private:
     void initializeScrollbar();
     void initializeSignals();
 
-    void messageAppended(MessagePtr &message,
-                         std::optional<MessageFlags> overridingFlags);
+    void messagesAppended(std::span<const AppendedMessage> messages);
     void messageAddedAtStart(std::vector<MessagePtr> &messages);
+    /// Adds the next page of the filtered channel's archive at the top, if
+    /// the view is scrolled to the top
+    void loadArchivedMessages();
+    /// Drops the messages added by loadArchivedMessages(), if the view is
+    /// scrolled to the bottom
+    void unloadArchivedMessages();
+    /// Position in the archive before which the messages aren't shown yet
+    uint64_t findArchivePosition() const;
     void messageRemoveFromStart(MessagePtr &message);
     void messageReplaced(size_t hint, const MessagePtr &prev,
                          const MessagePtr &replacement);
     void messagesUpdated();
 
-    void updateScrollbar(const std::vector<MessageLayoutPtr> &messages,
+    void updateScrollbar(const LimitedQueueSnapshot<MessageLayoutPtr> &messages,
                          bool causedByScrollbar, bool causedByShow);
     void updateScrollWidgetGeometries();
 
-    void drawMessages(QPainter &painter, const QRect &area);
+    /// @param sample If set, the time spent in each step is added to it
+    void drawMessages(QPainter &painter, const QRect &area,
+                      PaintSample *sample);
+    /// Returns the area of the overlay
+    QRect drawPaintProfile(QPainter &painter, const PaintProfile &profile);
     void setSelection(const SelectionItem &start, const SelectionItem &end);
     void setSelection(const Selection &newSelection);
     void selectWholeMessage(MessageLayout *layout, int &messageIndex);
@@ -357,6 +386,8 @@ private:
 
     int getLayoutWidth() const;
     void updatePauses();
+    /// Takes or releases #snapshot_ after the view was (un)paused
+    void updatePausedSnapshot(bool wasUnpaused);
     void unpaused();
 
     void enableScrolling(const QPointF &scrollStart);
@@ -405,7 +436,10 @@ private:
     MessageLayoutPtr lastReadMessage_;
 
     ThreadGuard snapshotGuard_;
-    std::vector<MessageLayoutPtr> snapshot_;
+    /// The messages from when the view was paused, empty if it isn't. Only
+    /// kept while paused, since it shares the storage of #messages_ and
+    /// would keep the queue from freeing the messages it drops.
+    LimitedQueueSnapshot<MessageLayoutPtr> snapshot_;
 
     /// @brief The backing (internal) channel
     ///
@@ -457,6 +491,8 @@ private:
 
     bool isOverlay_ = false;
     bool transparentBackground_ = false;
+    /// Set once the first paint with messages was added to the StartupTrace
+    bool tracedFirstPaint_ = false;
     std::optional<float> overrideImageScale_;
     std::optional<float> overrideEmoteScale_;
     std::optional<float> overrideBadgeScale_;
@@ -480,6 +516,10 @@ private:
     QPointF currentMousePosition_;
     QTimer scrollTimer_;
 
+    /// Hibernates the view once it has been hidden for
+    /// `hibernateHiddenSplitsAfter` minutes
+    QTimer hibernateTimer_;
+
     // We're only interested in the pointer, not the contents
     MessageLayout *highlightedMessage_ = nullptr;
     QVariantAnimation highlightAnimation_;
@@ -498,6 +538,11 @@ private:
     const Context context_;
 
     LimitedQueue<MessageLayoutPtr> messages_;
+    /// Number of messages loaded from the archive. The limit of `messages_`
+    /// is raised by this much.
+    size_t archivedMessages_ = 0;
+    /// Set once messages were loaded from the archive
+    std::optional<uint64_t> archivePosition_;
 
     pajlada::Signals::SignalHolder signalHolder_;
 
@@ -523,6 +568,8 @@ private:
 
     /// Slot for the LinkInfo::stateChanged signal.
     void pendingLinkInfoStateChanged();
+
+    friend class ChannelViewTestAccess;
 };
 
 }  // namespace chatterino
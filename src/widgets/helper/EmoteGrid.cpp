@@ -0,0 +1,405 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "widgets/helper/EmoteGrid.hpp"
+
+#include "Application.hpp"
+#include "common/ThumbnailPreviewMode.hpp"
+#include "messages/Emote.hpp"
+#include "messages/Image.hpp"
+#include "messages/Link.hpp"
+#include "singletons/Fonts.hpp"
+#include "singletons/Settings.hpp"
+#include "singletons/Theme.hpp"
+#include "singletons/WindowManager.hpp"
+#include "widgets/Scrollbar.hpp"
+#include "widgets/TooltipWidget.hpp"
+
+#include <QGuiApplication>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QWheelEvent>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using namespace chatterino;
+
+constexpr int CELL_SIZE = 32;
+constexpr int CELL_PADDING = 2;
+constexpr int SCROLLBAR_WIDTH = 16;
+/// Rows scrolled per notch of the mouse wheel
+constexpr qreal WHEEL_ROWS = 1.5;
+
+}  // namespace
+
+namespace chatterino {
+
+EmoteGrid::EmoteGrid(QWidget *parent)
+    : BaseWidget(parent)
+    , scrollbar_(new Scrollbar(0, nullptr))
+    , tooltip_(new TooltipWidget(this))
+{
+    this->scrollbar_->setParent(this);
+    this->setMouseTracking(true);
+
+    this->signalHolder_.managedConnect(
+        this->scrollbar_->getCurrentValueChanged(), [this] {
+            this->update();
+        });
+
+    // Emote images are loaded while the grid is shown
+    this->signalHolder_.managedConnect(
+        getApp()->getWindows()->layoutRequested, [this](Channel *) {
+            if (this->isVisible())
+            {
+                this->update();
+            }
+        });
+    this->signalHolder_.managedConnect(
+        getApp()->getWindows()->gifRepaintRequested, [this] {
+            if (this->isVisible() && this->paintedAnimated_)
+            {
+                this->update();
+            }
+        });
+
+    getSettings()->emoteScale.connect(
+        [this](auto, auto) {
+            this->layoutRows();
+            this->update();
+        },
+        this->signalHolder_);
+}
+
+void EmoteGrid::setSections(std::vector<EmoteSection> sections)
+{
+    this->sections_ = std::move(sections);
+    this->hovered_.reset();
+    this->tooltip_->hide();
+
+    this->layoutRows();
+    this->scrollbar_->scrollToTop();
+    this->update();
+}
+
+void EmoteGrid::setPlaceholder(QString placeholder)
+{
+    this->placeholder_ = std::move(placeholder);
+    this->update();
+}
+
+void EmoteGrid::scrollPages(qreal pages)
+{
+    this->scrollbar_->offset(pages * this->scrollbar_->getPageSize());
+}
+
+int EmoteGrid::cellSize() const
+{
+    return std::max(1, static_cast<int>(CELL_SIZE * this->scale() *
+                                        getSettings()->emoteScale.getValue()));
+}
+
+int EmoteGrid::contentWidth() const
+{
+    // The scrollbar's space is always reserved, so showing it doesn't change
+    // the number of columns
+    return this->width() - static_cast<int>(SCROLLBAR_WIDTH * this->scale());
+}
+
+void EmoteGrid::layoutRows()
+{
+    this->columns_ = static_cast<uint32_t>(
+        std::max(1, this->contentWidth() / this->cellSize()));
+
+    this->rows_.clear();
+    for (uint32_t s = 0; s < this->sections_.size(); s++)
+    {
+        auto nEmotes = static_cast<uint32_t>(this->sections_[s].emotes.size());
+        this->rows_.push_back({.type = RowType::Title, .section = s});
+        if (nEmotes == 0)
+        {
+            this->rows_.push_back({.type = RowType::Empty, .section = s});
+            continue;
+        }
+        for (uint32_t e = 0; e < nEmotes; e += this->columns_)
+        {
+            this->rows_.push_back({
+                .type = RowType::Emotes,
+                .section = s,
+                .emote = e,
+            });
+        }
+    }
+
+    this->updateScrollbar();
+}
+
+void EmoteGrid::updateScrollbar()
+{
+    auto pageSize = qreal(this->height()) / this->cellSize();
+    this->scrollbar_->setMaximum(qreal(this->rows_.size()));
+    this->scrollbar_->setPageSize(pageSize);
+    // Keep the scroll position in bounds after the rows were changed
+    this->scrollbar_->offset(0);
+    this->scrollbar_->setVisible(qreal(this->rows_.size()) > pageSize);
+}
+
+QRect EmoteGrid::cellRect(size_t row, uint32_t column) const
+{
+    auto size = this->cellSize();
+    auto left =
+        (this->contentWidth() - static_cast<int>(this->columns_) * size) / 2;
+    auto top = static_cast<int>(
+        std::round((qreal(row) - this->scrollbar_->getCurrentValue()) * size));
+    return {left + static_cast<int>(column) * size, top, size, size};
+}
+
+std::optional<EmoteGrid::Cell> EmoteGrid::cellAt(QPoint pos) const
+{
+    auto size = this->cellSize();
+    auto rowValue =
+        this->scrollbar_->getCurrentValue() + qreal(pos.y()) / size;
+    if (rowValue < 0 || rowValue >= qreal(this->rows_.size()))
+    {
+        return std::nullopt;
+    }
+
+    auto rowIndex = static_cast<size_t>(rowValue);
+    const auto &row = this->rows_[rowIndex];
+    if (row.type != RowType::Emotes)
+    {
+        return std::nullopt;
+    }
+
+    auto left = this->cellRect(rowIndex, 0).left();
+    if (pos.x() < left)
+    {
+        return std::nullopt;
+    }
+    auto column = static_cast<uint32_t>((pos.x() - left) / size);
+    auto emote = row.emote + column;
+    if (column >= this->columns_ ||
+        emote >= this->sections_[row.section].emotes.size())
+    {
+        return std::nullopt;
+    }
+
+    return Cell{.section = row.section, .emote = emote};
+}
+
+void EmoteGrid::paintEvent(QPaintEvent * /*event*/)
+{
+    QPainter painter(this);
+    painter.fillRect(this->rect(), getTheme()->messages.backgrounds.regular);
+    painter.setFont(
+        getApp()->getFonts()->getFont(FontStyle::ChatMedium, this->scale()));
+
+    this->paintedAnimated_ = false;
+
+    if (this->rows_.empty())
+    {
+        painter.setPen(getTheme()->messages.textColors.system);
+        painter.drawText(QRect(0, 0, this->contentWidth(), this->cellSize()),
+                         Qt::AlignCenter, this->placeholder_);
+        return;
+    }
+
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+
+    auto size = this->cellSize();
+    auto emoteScale = this->scale() * getSettings()->emoteScale.getValue();
+    auto imageScale = emoteScale * this->devicePixelRatioF();
+    auto inner = size - static_cast<int>(2 * CELL_PADDING * this->scale());
+
+    auto first = static_cast<size_t>(
+        std::max<qreal>(0, this->scrollbar_->getCurrentValue()));
+    for (auto i = first; i < this->rows_.size(); i++)
+    {
+        auto lineRect = this->cellRect(i, 0);
+        if (lineRect.top() >= this->height())
+        {
+            break;
+        }
+        lineRect.setLeft(0);
+        lineRect.setWidth(this->contentWidth());
+
+        const auto &row = this->rows_[i];
+        const auto &section = this->sections_[row.section];
+        switch (row.type)
+        {
+            case RowType::Title:
+                painter.setPen(getTheme()->messages.textColors.regular);
+                painter.drawText(lineRect, Qt::AlignCenter, section.title);
+                break;
+
+            case RowType::Empty:
+                painter.setPen(getTheme()->messages.textColors.system);
+                painter.drawText(lineRect, Qt::AlignCenter,
+                                 "no emotes available");
+                break;
+
+            case RowType::Emotes: {
+                auto end = std::min<size_t>(row.emote + this->columns_,
+                                            section.emotes.size());
+                for (auto e = row.emote; e < end; e++)
+                {
+                    auto cell = this->cellRect(i, e - row.emote);
+                    if (this->hovered_ ==
+                        Cell{.section = row.section, .emote = e})
+                    {
+                        painter.fillRect(cell, getTheme()->messages.selection);
+                    }
+
+                    const auto &emote = section.emotes[e].emote;
+                    if (!emote)
+                    {
+                        continue;
+                    }
+
+                    // Only rows on screen request their images
+                    const auto &image = emote->images.getImageOrLoaded(
+                        static_cast<float>(imageScale));
+                    auto pixmap = image->pixmapOrLoad();
+                    if (!pixmap || image->isEmpty())
+                    {
+                        continue;
+                    }
+                    this->paintedAnimated_ |= image->animated();
+
+                    // Wide emotes are shrunk to fit into their cell
+                    auto target = image->size() * emoteScale;
+                    if (target.width() > inner || target.height() > inner)
+                    {
+                        target.scale(inner, inner, Qt::KeepAspectRatio);
+                    }
+                    QRectF targetRect(QPointF{}, target);
+                    targetRect.moveCenter(QRectF(cell).center());
+                    painter.drawPixmap(targetRect, *pixmap,
+                                       QRectF(pixmap->rect()));
+                }
+            }
+            break;
+        }
+    }
+}
+
+void EmoteGrid::resizeEvent(QResizeEvent *event)
+{
+    auto scrollbarWidth = static_cast<int>(SCROLLBAR_WIDTH * this->scale());
+    this->scrollbar_->setGeometry(this->width() - scrollbarWidth, 0,
+                                  scrollbarWidth, this->height());
+
+    this->layoutRows();
+    BaseWidget::resizeEvent(event);
+}
+
+void EmoteGrid::wheelEvent(QWheelEvent *event)
+{
+    if (event->angleDelta().y() == 0 ||
+        event->modifiers().testFlag(Qt::ControlModifier))
+    {
+        event->ignore();
+        return;
+    }
+
+    float mouseMultiplier = getSettings()->mouseScrollMultiplier;
+    auto notches = qreal(event->angleDelta().y()) / 120;
+    this->scrollbar_->offset(-notches * WHEEL_ROWS * mouseMultiplier);
+}
+
+void EmoteGrid::mouseMoveEvent(QMouseEvent *event)
+{
+    auto cell = this->cellAt(event->pos());
+    if (cell == this->hovered_)
+    {
+        return;
+    }
+
+    this->hovered_ = cell;
+    this->update();
+
+    if (cell)
+    {
+        this->setCursor(Qt::PointingHandCursor);
+        this->showTooltip(*cell, event->globalPosition().toPoint());
+    }
+    else
+    {
+        this->setCursor(Qt::ArrowCursor);
+        this->tooltip_->hide();
+    }
+}
+
+void EmoteGrid::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton)
+    {
+        return;
+    }
+
+    auto cell = this->cellAt(event->pos());
+    if (!cell)
+    {
+        return;
+    }
+
+    const auto &entry = this->sections_[cell->section].emotes[cell->emote];
+    this->linkClicked.invoke(Link(Link::InsertText, entry.insertText));
+}
+
+void EmoteGrid::leaveEvent(QEvent * /*event*/)
+{
+    this->hovered_.reset();
+    this->tooltip_->hide();
+    this->update();
+}
+
+void EmoteGrid::hideEvent(QHideEvent * /*event*/)
+{
+    this->hovered_.reset();
+    this->tooltip_->hide();
+}
+
+void EmoteGrid::scaleChangedEvent(float /*newScale*/)
+{
+    auto scrollbarWidth = static_cast<int>(SCROLLBAR_WIDTH * this->scale());
+    this->scrollbar_->setGeometry(this->width() - scrollbarWidth, 0,
+                                  scrollbarWidth, this->height());
+
+    this->layoutRows();
+    this->update();
+}
+
+void EmoteGrid::themeChangedEvent()
+{
+    this->update();
+}
+
+void EmoteGrid::showTooltip(const Cell &cell, QPoint globalPos)
+{
+    const auto &emote = this->sections_[cell.section].emotes[cell.emote].emote;
+    if (!emote)
+    {
+        this->tooltip_->hide();
+        return;
+    }
+
+    auto preview = getSettings()->emotesTooltipPreview.getEnum();
+    bool showThumbnail =
+        preview == ThumbnailPreviewMode::AlwaysShow ||
+        (preview == ThumbnailPreviewMode::ShowOnShift &&
+         QGuiApplication::keyboardModifiers() == Qt::ShiftModifier);
+
+    this->tooltip_->setOne(TooltipEntry::scaled(
+        showThumbnail ? emote->images.getImage(3.0) : nullptr,
+        emote->tooltip.string, 1.0F));
+    this->tooltip_->moveTo(globalPos + QPoint(16, 16),
+                           widgets::BoundsChecking::CursorPosition);
+    this->tooltip_->show();
+}
+
+}  // namespace chatterino
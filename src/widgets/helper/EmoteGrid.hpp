@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "controllers/emotes/EmoteSearchIndex.hpp"
+#include "widgets/BaseWidget.hpp"
+
+#include <pajlada/signals/signal.hpp>
+#include <QString>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace chatterino {
+
+struct Link;
+class Scrollbar;
+class TooltipWidget;
+
+/**
+ * @brief A grid of emotes, grouped in titled sections
+ *
+ * All rows have the same height, so the grid only has to know how many rows
+ * each section takes to lay itself out. Only the rows on screen are painted
+ * and only their emote images are requested.
+ **/
+class EmoteGrid : public BaseWidget
+{
+public:
+    explicit EmoteGrid(QWidget *parent = nullptr);
+
+    /// Replaces the shown sections and scrolls to the top
+    void setSections(std::vector<EmoteSection> sections);
+    /// The text that's shown if there are no sections
+    void setPlaceholder(QString placeholder);
+
+    /// Scrolls by `pages` pages, negative values scroll up
+    void scrollPages(qreal pages);
+
+    /// Invoked with an InsertText link when an emote is clicked
+    pajlada::Signals::Signal<Link> linkClicked;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void leaveEvent(QEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+    void scaleChangedEvent(float newScale) override;
+    void themeChangedEvent() override;
+
+private:
+    enum class RowType : uint8_t {
+        Title,
+        Emotes,
+        /// A section without any emotes
+        Empty,
+    };
+    struct Row {
+        RowType type = RowType::Title;
+        uint32_t section = 0;
+        /// The first emote in this row
+        uint32_t emote = 0;
+    };
+    struct Cell {
+        uint32_t section = 0;
+        uint32_t emote = 0;
+
+        bool operator==(const Cell &other) const = default;
+    };
+
+    /// Splits the sections into rows for the current width
+    void layoutRows();
+    void updateScrollbar();
+    std::optional<Cell> cellAt(QPoint pos) const;
+    QRect cellRect(size_t row, uint32_t column) const;
+    void showTooltip(const Cell &cell, QPoint globalPos);
+
+    int cellSize() const;
+    int contentWidth() const;
+
+    Scrollbar *scrollbar_;
+    TooltipWidget *tooltip_;
+
+    std::vector<EmoteSection> sections_;
+    std::vector<Row> rows_;
+    uint32_t columns_ = 1;
+    QString placeholder_;
+
+    std::optional<Cell> hovered_;
+    /// Whether an animated emote was painted in the last paint
+    bool paintedAnimated_ = false;
+};
+
+}  // namespace chatterino
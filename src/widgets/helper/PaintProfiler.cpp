@@ -0,0 +1,167 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "widgets/helper/PaintProfiler.hpp"
+
+#include <QStringBuilder>
+
+#include <algorithm>
+#include <utility>
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+using namespace chatterino;
+
+QString formatMs(std::chrono::nanoseconds elapsed)
+{
+    return QString::number(
+        std::chrono::duration<double, std::milli>(elapsed).count(), 'f', 2);
+}
+
+}  // namespace
+
+namespace chatterino {
+
+void PaintProfile::addLayout(std::chrono::nanoseconds elapsed)
+{
+    this->pendingLayout_ += elapsed;
+}
+
+void PaintProfile::addFrame(PaintSample sample)
+{
+    sample.layout += this->pendingLayout_;
+    this->pendingLayout_ = {};
+
+    if (this->frames_.size() < WINDOW)
+    {
+        this->frames_.push_back(std::move(sample));
+        return;
+    }
+
+    this->frames_[this->next_] = std::move(sample);
+    this->next_ = (this->next_ + 1) % WINDOW;
+}
+
+size_t PaintProfile::frameCount() const
+{
+    return this->frames_.size();
+}
+
+PaintSample PaintProfile::average() const
+{
+    PaintSample sum;
+    for (const auto &frame : this->frames_)
+    {
+        sum.frame += frame.frame;
+        sum.layout += frame.layout;
+        sum.bufferRender += frame.bufferRender;
+        sum.blit += frame.blit;
+        sum.emotes += frame.emotes;
+        sum.selection += frame.selection;
+        sum.buffersRendered += frame.buffersRendered;
+        sum.buffersBlitted += frame.buffersBlitted;
+    }
+    if (this->frames_.empty())
+    {
+        return sum;
+    }
+
+    auto n = static_cast<std::chrono::nanoseconds::rep>(this->frames_.size());
+    sum.frame /= n;
+    sum.layout /= n;
+    sum.bufferRender /= n;
+    sum.blit /= n;
+    sum.emotes /= n;
+    sum.selection /= n;
+    sum.buffersRendered /= static_cast<uint32_t>(n);
+    sum.buffersBlitted /= static_cast<uint32_t>(n);
+    return sum;
+}
+
+PaintSample PaintProfile::worst() const
+{
+    auto it = std::ranges::max_element(this->frames_, {}, &PaintSample::frame);
+    if (it == this->frames_.end())
+    {
+        return {};
+    }
+    return *it;
+}
+
+PaintProfiler &PaintProfiler::instance()
+{
+    static PaintProfiler profiler;
+    return profiler;
+}
+
+bool PaintProfiler::enabled() const
+{
+    return this->enabled_;
+}
+
+void PaintProfiler::setEnabled(bool enabled)
+{
+    this->enabled_ = enabled;
+    this->entries_.clear();
+}
+
+PaintProfile &PaintProfiler::profile(const ChannelView *view,
+                                     const QString &name)
+{
+    auto &entry = this->entries_[view];
+    entry.name = name;
+    return entry.profile;
+}
+
+void PaintProfiler::remove(const ChannelView *view)
+{
+    this->entries_.erase(view);
+}
+
+QStringList PaintProfiler::report(size_t limit) const
+{
+    std::vector<std::pair<const Entry *, PaintSample>> worst;
+    for (const auto &[view, entry] : this->entries_)
+    {
+        if (entry.profile.frameCount() > 0)
+        {
+            worst.emplace_back(&entry, entry.profile.worst());
+        }
+    }
+    std::ranges::sort(worst, [](const auto &a, const auto &b) {
+        return a.second.frame > b.second.frame;
+    });
+    if (worst.size() > limit)
+    {
+        worst.resize(limit);
+    }
+
+    QStringList lines;
+    for (const auto &[entry, frame] : worst)
+    {
+        auto average = entry->profile.average();
+        QString line =
+            entry->name % u": worst frame "_s % formatMs(frame.frame) %
+            u" ms (layout "_s % formatMs(frame.layout) % u", render "_s %
+            formatMs(frame.bufferRender) % u" for "_s %
+            QString::number(frame.buffersRendered) % u" buffers, blit "_s %
+            formatMs(frame.blit) % u" for "_s %
+            QString::number(frame.buffersBlitted) % u", emotes "_s %
+            formatMs(frame.emotes) % u", selection "_s %
+            formatMs(frame.selection) % u"), average "_s %
+            formatMs(average.frame) % u" ms over "_s %
+            QString::number(entry->profile.frameCount()) % u" frames"_s;
+        if (!frame.slowestMessage.isEmpty())
+        {
+            line += u", slowest message "_s % formatMs(frame.slowestRender) %
+                    u" ms: "_s % frame.slowestMessage;
+        }
+        lines.append(line);
+    }
+    return lines;
+}
+
+}  // namespace chatterino
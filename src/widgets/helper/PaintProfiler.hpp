@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+class ChannelView;
+
+/// Where the time of one ChannelView frame went
+struct PaintSample {
+    std::chrono::nanoseconds frame{};
+    /// Layouts since the previous frame
+    std::chrono::nanoseconds layout{};
+    /// Rendering message buffers
+    std::chrono::nanoseconds bufferRender{};
+    /// Drawing buffers onto the view
+    std::chrono::nanoseconds blit{};
+    /// Drawing animated emotes on top of the buffers
+    std::chrono::nanoseconds emotes{};
+    std::chrono::nanoseconds selection{};
+
+    uint32_t buffersRendered = 0;
+    uint32_t buffersBlitted = 0;
+
+    /// The message whose buffer took the longest to render in this frame
+    QString slowestMessage;
+    std::chrono::nanoseconds slowestRender{};
+};
+
+/// The frames of one view over the last WINDOW frames
+class PaintProfile
+{
+public:
+    static constexpr size_t WINDOW = 120;
+
+    /// Adds layout time to the next frame
+    void addLayout(std::chrono::nanoseconds elapsed);
+    void addFrame(PaintSample sample);
+
+    size_t frameCount() const;
+    /// The mean of all frames in the window
+    PaintSample average() const;
+    /// The frame with the longest frame time in the window
+    PaintSample worst() const;
+
+private:
+    std::vector<PaintSample> frames_;
+    /// Where the next frame is written once the window is full
+    size_t next_ = 0;
+    std::chrono::nanoseconds pendingLayout_{};
+};
+
+/**
+ * @brief Collects the frame times of ChannelViews
+ *
+ * Profiling is toggled with /debug-paint. Views only take timestamps while
+ * it's enabled. All functions must be called from the GUI thread.
+ **/
+class PaintProfiler
+{
+public:
+    static PaintProfiler &instance();
+
+    bool enabled() const;
+    /// Enabling or disabling clears all profiles
+    void setEnabled(bool enabled);
+
+    /// Returns the profile of `view`, `name` is shown in the report
+    PaintProfile &profile(const ChannelView *view, const QString &name);
+    void remove(const ChannelView *view);
+
+    /// Describes the `limit` views with the slowest frames, slowest first
+    QStringList report(size_t limit) const;
+
+private:
+    struct Entry {
+        QString name;
+        PaintProfile profile;
+    };
+
+    bool enabled_ = false;
+    std::unordered_map<const ChannelView *, Entry> entries_;
+};
+
+}  // namespace chatterino
@@ -133,7 +133,7 @@ const MessageLayoutElement *tryGetPinnedBannerElementAt(ChannelView *view,
         return nullptr;
     }
 
-    auto &messages = view->getMessagesSnapshot();
+    const auto messages = view->getMessagesSnapshot();
     const auto start =
         static_cast<size_t>(view->getScrollBar().getRelativeCurrentValue());
     if (start >= messages.size())
@@ -780,7 +780,7 @@ void PinnedMessageBanner::resizeEvent(QResizeEvent *event)
 
     if (this->isExpanded_)
     {
-        auto &snapshot = this->messageView_->getMessagesSnapshot();
+        const auto snapshot = this->messageView_->getMessagesSnapshot();
         if (!snapshot.empty())
         {
             int contentHeight = snapshot[0]->getHeight();
@@ -815,7 +815,7 @@ void PinnedMessageBanner::toggleExpansion()
 {
     this->split_->setFocus(Qt::MouseFocusReason);
 
-    auto &snapshot = this->messageView_->getMessagesSnapshot();
+    const auto snapshot = this->messageView_->getMessagesSnapshot();
     if (snapshot.empty())
     {
         return;
@@ -851,7 +851,7 @@ void PinnedMessageBanner::refreshLayout()
         return;
     }
 
-    auto &snapshot = this->messageView_->getMessagesSnapshot();
+    const auto snapshot = this->messageView_->getMessagesSnapshot();
     for (auto &i : snapshot)
     {
         i->flags.set(MessageLayoutFlag::RequiresLayout);
@@ -867,7 +867,7 @@ void PinnedMessageBanner::updateScaling()
         return;
     }
 
-    auto &snapshot = this->messageView_->getMessagesSnapshot();
+    const auto snapshot = this->messageView_->getMessagesSnapshot();
     if (snapshot.empty())
     {
         return;
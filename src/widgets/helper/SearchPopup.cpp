@@ -27,40 +27,61 @@
 #include <QLineEdit>
 #include <QPushButton>
 
+#include <algorithm>
+#include <iterator>
+
 namespace chatterino {
 
 ChannelPtr SearchPopup::filter(const QString &text, const QString &channelName,
-                               const std::vector<MessagePtr> &snapshot)
+                               const std::vector<MessagePtr> &snapshot,
+                               const std::vector<ChannelPtr> &archives)
 {
     ChannelPtr channel(new Channel(channelName, Channel::Type::None));
 
     // Parse predicates from tags in "text"
     auto predicates = parsePredicates(text);
 
+    auto accepts = [&](const Message &message) {
+        // Discard the message as soon as one predicate fails
+        return std::ranges::all_of(predicates, [&](const auto &pred) {
+            return pred->appliesTo(message);
+        });
+    };
+    auto add = [&](const MessagePtr &message) {
+        auto overrideFlags = std::optional<MessageFlags>(message->flags);
+        overrideFlags->set(MessageFlag::DoNotLog);
+
+        channel->addMessage(message, MessageContext::Repost, overrideFlags);
+    };
+
+    // Archived messages are older than the ones in the snapshot, so they go
+    // first. Only matching messages are rebuilt.
+    std::vector<MessagePtr> archived;
+    for (const auto &source : archives)
+    {
+        auto found = source->archive().find(accepts);
+        archived.insert(archived.end(), std::make_move_iterator(found.begin()),
+                        std::make_move_iterator(found.end()));
+    }
+    if (archives.size() > 1)
+    {
+        std::ranges::stable_sort(archived, {}, [](const MessagePtr &message) {
+            return message->serverReceivedTime;
+        });
+    }
+    for (const auto &message : archived)
+    {
+        add(message);
+    }
+
     // Check for every message whether it fulfills all predicates that have
     // been registered
-    for (size_t i = 0; i < snapshot.size(); ++i)
+    for (const auto &message : snapshot)
     {
-        MessagePtr message = snapshot[i];
-
-        bool accept = true;
-        for (const auto &pred : predicates)
-        {
-            // Discard the message as soon as one predicate fails
-            if (!pred->appliesTo(*message))
-            {
-                accept = false;
-                break;
-            }
-        }
-
         // If all predicates match, add the message to the channel
-        if (accept)
+        if (accepts(*message))
         {
-            auto overrideFlags = std::optional<MessageFlags>(message->flags);
-            overrideFlags->set(MessageFlag::DoNotLog);
-
-            channel->addMessage(message, MessageContext::Repost, overrideFlags);
+            add(message);
         }
     }
 
@@ -237,7 +258,22 @@ void SearchPopup::search()
     }
 
     this->channelView_->setChannel(filter(this->searchInput_->text(),
-                                          this->channelName_, this->snapshot_));
+                                          this->channelName_, this->snapshot_,
+                                          this->archiveSources()));
+}
+
+std::vector<ChannelPtr> SearchPopup::archiveSources() const
+{
+    std::vector<ChannelPtr> sources;
+    for (const auto &view : this->searchChannels_)
+    {
+        auto channel = view.get().channel();
+        if (channel && std::ranges::find(sources, channel) == sources.end())
+        {
+            sources.push_back(std::move(channel));
+        }
+    }
+    return sources;
 }
 
 std::vector<MessagePtr> SearchPopup::buildSnapshot()
@@ -246,7 +282,8 @@ std::vector<MessagePtr> SearchPopup::buildSnapshot()
     if (this->searchChannels_.length() == 1)
     {
         const auto channelPtr = this->searchChannels_.at(0);
-        return channelPtr.get().channel()->getMessageSnapshot();
+        const auto snapshot = channelPtr.get().channel()->getMessageSnapshot();
+        return {snapshot.begin(), snapshot.end()};
     }
 
     auto combinedSnapshot = std::vector<std::shared_ptr<const Message>>{};
@@ -255,8 +292,7 @@ std::vector<MessagePtr> SearchPopup::buildSnapshot()
         ChannelView &sharedView = channel.get();
 
         const FilterSetPtr filterSet = sharedView.getFilterSet();
-        std::vector<MessagePtr> snapshot =
-            sharedView.channel()->getMessageSnapshot();
+        const auto snapshot = sharedView.channel()->getMessageSnapshot();
 
         for (const auto &message : snapshot)
         {
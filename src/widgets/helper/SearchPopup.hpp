@@ -42,6 +42,8 @@ private:
     void search();
     void addShortcuts() override;
     std::vector<MessagePtr> buildSnapshot();
+    /// Channels whose archived messages are searched as well
+    std::vector<ChannelPtr> archiveSources() const;
 
     /**
      * @brief Only retains those message from a list of messages that satisfy a
@@ -50,13 +52,14 @@ private:
      * @param text          the search query -- will be parsed for MessagePredicates
      * @param channelName   name of the channel to be returned
      * @param snapshot      list of messages to filter
-     * @param filterSet     channel filter to apply
+     * @param archives      channels whose archived messages are filtered too
      *
      * @return a ChannelPtr with "channelName" and the filtered messages from
-     *         "snapshot"
+     *         "snapshot" and the archives
      */
     static ChannelPtr filter(const QString &text, const QString &channelName,
-                             const std::vector<MessagePtr> &snapshot);
+                             const std::vector<MessagePtr> &snapshot,
+                             const std::vector<ChannelPtr> &archives);
 
     /**
      * @brief Checks the input for tags and registers their corresponding
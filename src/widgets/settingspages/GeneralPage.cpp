@@ -1687,6 +1687,32 @@ void GeneralPage::initLayout(GeneralPageView &layout)
                             })
         ->addTo(layout);
 
+    SettingWidget::intInput("Archived message limit (requires restart)",
+                            s.scrollbackArchiveLimit,
+                            {
+                                .min = 0,
+                                .max = 1000000,
+                                .singleStep = 1000,
+                            })
+        ->setTooltip("Messages that no longer fit in a split are kept in a "
+                     "compressed archive. Searches and usercards include "
+                     "archived messages, and splits load them again when "
+                     "scrolled to the top. Set to 0 to disable the archive.")
+        ->addTo(layout);
+
+    SettingWidget::intInput("Free memory of hidden splits after (minutes)",
+                            s.hibernateHiddenSplitsAfter,
+                            {
+                                .min = 0,
+                                .max = 1440,
+                                .singleStep = 5,
+                            })
+        ->setTooltip("Splits in tabs that aren't shown for this long release "
+                     "the layouts of their messages. They keep receiving "
+                     "messages and are laid out again when shown. Set to 0 "
+                     "to disable this.")
+        ->addTo(layout);
+
     SettingWidget::dropdown("Show blocked term automod messages",
                             s.showBlockedTermAutomodMessages)
         ->setTooltip("Show messages that are blocked by AutoMod for containing "
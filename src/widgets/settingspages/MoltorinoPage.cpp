@@ -1041,19 +1041,19 @@ MoltorinoPage::MoltorinoPage()
                      this, [this] {
                          getSettings()->botBadgeClientID =
                              this->botBadgeClientIdEdit_->text().trimmed();
-                         getSettings()->requestSave();
+                         getSettings()->queueSave();
                      });
     QObject::connect(this->botBadgeClientSecretEdit_,
                      &QLineEdit::editingFinished, this, [this] {
                          getSettings()->botBadgeClientSecret =
                              this->botBadgeClientSecretEdit_->text().trimmed();
-                         getSettings()->requestSave();
+                         getSettings()->queueSave();
                      });
     QObject::connect(
         this->botBadgeSenderEdit_, &QLineEdit::editingFinished, this, [this] {
             getSettings()->botBadgeUserLogin =
                 this->botBadgeSenderEdit_->text().trimmed().toLower();
-            getSettings()->requestSave();
+            getSettings()->queueSave();
         });
     QObject::connect(this->botBadgeVerifyButton_, &QPushButton::clicked, this,
                      [this] {
@@ -2258,7 +2258,7 @@ void MoltorinoPage::verifyBotBadgeConfiguration()
                     settings.botBadgeUserName = resolvedDisplayName.isEmpty()
                                                     ? resolvedLogin
                                                     : resolvedDisplayName;
-                    settings.requestSave();
+                    settings.queueSave();
 
                     guard->populateBotBadgeFieldsFromSettings();
                     guard->updateBotBadgeStatus(
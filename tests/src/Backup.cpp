@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "util/Backup.hpp"
+
+#include "Test.hpp"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <atomic>
+#include <thread>
+
+using namespace chatterino;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+QByteArray readFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return {};
+    }
+    return file.readAll();
+}
+
+}  // namespace
+
+TEST(Backup, SaveAsync)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath(u"window-layout.json"_s);
+
+    backup::saveWithBackupsAsync(path, [] {
+        return QByteArray("{\"a\":1}");
+    });
+    backup::flushPendingSaves();
+    ASSERT_EQ(readFile(path), QByteArray("{\"a\":1}"));
+
+    backup::saveWithBackupsAsync(path, [] {
+        return QByteArray("{\"a\":2}");
+    });
+    backup::flushPendingSaves();
+    ASSERT_EQ(readFile(path), QByteArray("{\"a\":2}"));
+
+    // The previous file was kept as a backup
+    auto backups = backup::findBackupsFor(dir.path(), u"window-layout.json"_s);
+    ASSERT_FALSE(backups.empty());
+}
+
+TEST(Backup, SaveAsyncCoalesces)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath(u"settings.json"_s);
+
+    // Keep the save thread busy, so the following saves are all pending
+    std::atomic<bool> release = false;
+    backup::saveWithBackupsAsync(dir.filePath(u"other.json"_s), [&release] {
+        while (!release)
+        {
+            std::this_thread::yield();
+        }
+        return QByteArray("{}");
+    });
+
+    std::atomic<int> serialized = 0;
+    for (int i = 1; i <= 10; i++)
+    {
+        backup::saveWithBackupsAsync(path, [&serialized, i] {
+            serialized++;
+            return QByteArray::number(i);
+        });
+    }
+    release = true;
+    backup::flushPendingSaves();
+
+    ASSERT_EQ(serialized.load(), 1);
+    ASSERT_EQ(readFile(path), QByteArray("10"));
+}
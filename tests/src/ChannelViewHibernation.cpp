@@ -0,0 +1,357 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/Channel.hpp"
+#include "controllers/accounts/AccountController.hpp"
+#include "messages/layouts/MessageLayout.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "singletons/Settings.hpp"
+#include "singletons/WindowManager.hpp"
+#include "Test.hpp"
+#include "widgets/helper/ChannelView.hpp"
+#include "widgets/Scrollbar.hpp"
+
+#include <QCoreApplication>
+#include <QHideEvent>
+#include <QShowEvent>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+using namespace Qt::StringLiterals;
+
+namespace chatterino {
+
+class ChannelViewTestAccess
+{
+public:
+    static void hibernate(ChannelView &view)
+    {
+        view.hibernate();
+    }
+
+    static void select(ChannelView &view, size_t messageIndex)
+    {
+        view.setSelection({messageIndex, 0}, {messageIndex, 5});
+    }
+
+    static bool hibernationPending(const ChannelView &view)
+    {
+        return view.hibernateTimer_.isActive();
+    }
+
+    static bool layoutQueued(const ChannelView &view)
+    {
+        return view.layoutQueued_;
+    }
+
+    static void loadArchivedMessages(ChannelView &view)
+    {
+        view.loadArchivedMessages();
+    }
+
+    static void unloadArchivedMessages(ChannelView &view)
+    {
+        view.unloadArchivedMessages();
+    }
+};
+
+}  // namespace chatterino
+
+namespace {
+
+class MockApplication : public mock::BaseApplication
+{
+public:
+    MockApplication()
+        : windowManager(this->args_, this->paths_, this->settings, this->theme,
+                        this->fonts)
+    {
+    }
+
+    WindowManager *getWindows() override
+    {
+        return &this->windowManager;
+    }
+
+    AccountController *getAccounts() override
+    {
+        return &this->accounts;
+    }
+
+    AccountController accounts;
+    WindowManager windowManager;
+};
+
+constexpr size_t MESSAGES = 100;
+
+class ChannelViewHibernationTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        for (size_t i = 0; i < MESSAGES; i++)
+        {
+            this->channel->addMessage(
+                makeSystemMessage(u"message "_s + QString::number(i)),
+                MessageContext::Original);
+        }
+        this->view.resize(320, 180);
+        this->view.setChannel(this->channel);
+        // The second layout happens at the scroll position of the first
+        this->view.performLayout();
+        this->view.performLayout();
+    }
+
+    void TearDown() override
+    {
+        getSettings()->hibernateHiddenSplitsAfter.setValue(10);
+    }
+
+    void hide()
+    {
+        QHideEvent event;
+        QCoreApplication::sendEvent(&this->view, &event);
+    }
+
+    void show()
+    {
+        QShowEvent event;
+        QCoreApplication::sendEvent(&this->view, &event);
+    }
+
+    /// Number of layouts that are laid out
+    size_t laidOut()
+    {
+        size_t n = 0;
+        for (const auto &layout : this->view.getMessagesSnapshot())
+        {
+            if (!layout->flags.has(MessageLayoutFlag::RequiresLayout))
+            {
+                n++;
+            }
+        }
+        return n;
+    }
+
+    std::vector<int> heights()
+    {
+        std::vector<int> result;
+        for (const auto &layout : this->view.getMessagesSnapshot())
+        {
+            result.push_back(layout->getHeight());
+        }
+        return result;
+    }
+
+    MockApplication mockApplication;
+    ChannelPtr channel =
+        std::make_shared<Channel>(u"test"_s, Channel::Type::None);
+    ChannelView view{nullptr};
+};
+
+}  // namespace
+
+TEST_F(ChannelViewHibernationTest, HideStartsTimer)
+{
+    getSettings()->hibernateHiddenSplitsAfter.setValue(10);
+    this->hide();
+    ASSERT_TRUE(ChannelViewTestAccess::hibernationPending(this->view));
+
+    // Showing the view again before the timer fired cancels it
+    this->show();
+    ASSERT_FALSE(ChannelViewTestAccess::hibernationPending(this->view));
+
+    getSettings()->hibernateHiddenSplitsAfter.setValue(0);
+    this->hide();
+    ASSERT_FALSE(ChannelViewTestAccess::hibernationPending(this->view));
+}
+
+TEST_F(ChannelViewHibernationTest, HibernateFreesLayouts)
+{
+    auto visible = this->laidOut();
+    ASSERT_GT(visible, 0U);
+    // Only the visible messages are laid out
+    ASSERT_LT(visible, MESSAGES);
+
+    auto heightsBefore = this->heights();
+    auto scrollBefore = this->view.scrollbar()->getCurrentValue();
+    ChannelViewTestAccess::select(this->view, MESSAGES - 1);
+    ASSERT_TRUE(this->view.hasSelection());
+
+    this->hide();
+    ChannelViewTestAccess::hibernate(this->view);
+
+    ASSERT_EQ(this->laidOut(), 0U);
+    ASSERT_FALSE(this->view.hasSelection());
+    ASSERT_TRUE(ChannelViewTestAccess::layoutQueued(this->view));
+
+    // The layouts stay in the view and keep their height for scrolling
+    ASSERT_EQ(this->view.getMessagesSnapshot().size(), MESSAGES);
+    ASSERT_EQ(this->heights(), heightsBefore);
+    ASSERT_EQ(this->view.scrollbar()->getCurrentValue(), scrollBefore);
+}
+
+TEST_F(ChannelViewHibernationTest, WakeLaysOutVisibleMessages)
+{
+    auto visible = this->laidOut();
+
+    this->hide();
+    ChannelViewTestAccess::hibernate(this->view);
+
+    // Hibernated views still receive messages
+    this->channel->addMessage(makeSystemMessage(u"while hibernated"_s),
+                              MessageContext::Original);
+    this->view.channel()->flushAppendedMessages();
+    ASSERT_EQ(this->view.getMessagesSnapshot().size(), MESSAGES + 1);
+    ASSERT_EQ(this->laidOut(), 0U);
+
+    this->show();
+    ASSERT_FALSE(ChannelViewTestAccess::layoutQueued(this->view));
+
+    // Only the visible window is laid out again, not the scrollback
+    auto awake = this->laidOut();
+    ASSERT_GT(awake, 0U);
+    ASSERT_LE(awake, visible + 1);
+
+    // The view still shows the latest messages
+    const auto &snapshot = this->view.getMessagesSnapshot();
+    ASSERT_FALSE(snapshot[snapshot.size() - 1]->flags.has(
+        MessageLayoutFlag::RequiresLayout));
+    ASSERT_TRUE(snapshot[0]->flags.has(MessageLayoutFlag::RequiresLayout));
+}
+
+TEST(ChannelViewSnapshot, DroppedLayoutsAreReleased)
+{
+    MockApplication mockApplication;
+    auto channel = std::make_shared<Channel>(u"test"_s, Channel::Type::None);
+    constexpr size_t limit = 10;
+    ChannelView view(nullptr, ChannelView::Context::None, limit);
+
+    auto add = [&] {
+        channel->addMessage(makeSystemMessage(u"message"_s),
+                            MessageContext::Original);
+        view.channel()->flushAppendedMessages();
+    };
+    for (size_t i = 0; i < limit; i++)
+    {
+        add();
+    }
+    view.resize(320, 180);
+    view.setChannel(channel);
+    view.performLayout();
+    view.performLayout();
+
+    // The view doesn't hold on to the messages it laid out
+    std::weak_ptr<MessageLayout> oldest = view.getMessagesSnapshot()[0];
+    add();
+    ASSERT_TRUE(oldest.expired());
+    ASSERT_EQ(view.getMessagesSnapshot().size(), limit);
+
+    // A paused view keeps showing the messages from when it was paused
+    view.setPausable(true);
+    view.pause(PauseReason::Mouse);
+    oldest = view.getMessagesSnapshot()[0];
+    add();
+    ASSERT_FALSE(oldest.expired());
+    ASSERT_EQ(view.getMessagesSnapshot()[0], oldest.lock());
+
+    // ...until it's unpaused
+    view.unpause(PauseReason::Mouse);
+    add();
+    ASSERT_TRUE(oldest.expired());
+}
+
+TEST(ChannelViewClear, PendingAppendsAreDropped)
+{
+    MockApplication mockApplication;
+    auto channel = std::make_shared<Channel>(u"test"_s, Channel::Type::None);
+    ChannelView view(nullptr);
+    view.resize(320, 180);
+    view.setChannel(channel);
+
+    channel->addMessage(makeSystemMessage(u"shown"_s),
+                        MessageContext::Original);
+    view.channel()->flushAppendedMessages();
+    ASSERT_EQ(view.getMessagesSnapshot().size(), 1U);
+
+    // Appended in the same tick as the clear, but not delivered yet
+    channel->addMessage(makeSystemMessage(u"pending"_s),
+                        MessageContext::Original);
+    view.clearMessages();
+    view.channel()->flushAppendedMessages();
+    ASSERT_EQ(view.getMessagesSnapshot().size(), 0U);
+
+    // Messages after the clear still show up
+    channel->addMessage(makeSystemMessage(u"after"_s),
+                        MessageContext::Original);
+    view.channel()->flushAppendedMessages();
+    ASSERT_EQ(view.getMessagesSnapshot().size(), 1U);
+    ASSERT_EQ(view.getMessagesSnapshot()[0]->getMessage()->messageText,
+              u"after"_s);
+}
+
+TEST(ChannelViewArchive, ScrollingToTopLoadsArchivedMessages)
+{
+    MockApplication mockApplication;
+    constexpr size_t limit = 20;
+    getSettings()->scrollbackSplitLimit.setValue(static_cast<int>(limit));
+    auto channel = std::make_shared<Channel>(u"test"_s, Channel::Type::Misc);
+    ChannelView view(nullptr, ChannelView::Context::None, limit);
+    view.resize(320, 180);
+    view.setChannel(channel);
+
+    for (size_t i = 0; i < limit * 3; i++)
+    {
+        channel->addMessage(
+            makeSystemMessage(u"message "_s + QString::number(i)),
+            MessageContext::Repost);
+    }
+    view.channel()->flushAppendedMessages();
+    view.performLayout();
+    view.performLayout();
+    ASSERT_EQ(view.channel()->archive().size(), limit * 2);
+
+    auto first = [&] {
+        return view.getMessagesSnapshot()[0]->getMessage()->messageText;
+    };
+    ASSERT_EQ(first(), u"message 20"_s);
+
+    // Not at the top yet
+    ChannelViewTestAccess::loadArchivedMessages(view);
+    ASSERT_EQ(view.getMessagesSnapshot().size(), limit);
+
+    view.scrollbar()->scrollToTop();
+    view.performLayout(true);
+    ChannelViewTestAccess::loadArchivedMessages(view);
+    ASSERT_EQ(view.getMessagesSnapshot().size(), limit * 3);
+    ASSERT_EQ(first(), u"message 0"_s);
+    // The view stays at the message it showed
+    ASSERT_GE(view.scrollbar()->getRelativeCurrentValue(), qreal(limit * 2));
+
+    // Nothing older is left
+    view.scrollbar()->scrollToTop();
+    view.performLayout(true);
+    ChannelViewTestAccess::loadArchivedMessages(view);
+    ASSERT_EQ(view.getMessagesSnapshot().size(), limit * 3);
+
+    // New messages push out the oldest loaded one
+    channel->addMessage(makeSystemMessage(u"new"_s), MessageContext::Repost);
+    view.channel()->flushAppendedMessages();
+    ASSERT_EQ(view.getMessagesSnapshot().size(), limit * 3);
+    ASSERT_EQ(first(), u"message 1"_s);
+
+    // Back at the bottom, the view drops them again
+    view.scrollbar()->scrollToBottom();
+    view.performLayout(true);
+    ChannelViewTestAccess::unloadArchivedMessages(view);
+    ASSERT_EQ(view.getMessagesSnapshot().size(), limit);
+    ASSERT_EQ(first(), u"message 41"_s);
+    ASSERT_TRUE(view.scrollbar()->isAtBottom());
+
+    getSettings()->scrollbackSplitLimit.setValue(1000);
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "util/DebugCount.hpp"
+
+#include "Test.hpp"
+
+#include <QString>
+
+#include <chrono>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+TEST(DebugCount, LatencyPercentiles)
+{
+    DebugCount::resetLatencies();
+
+    for (int i = 0; i < 98; i++)
+    {
+        DebugCount::recordLatency(DebugStage::Filter, 1us);
+    }
+    DebugCount::recordLatency(DebugStage::Filter, 10ms);
+    DebugCount::recordLatency(DebugStage::Filter, 10ms);
+
+    auto text = DebugCount::getLatencyText();
+    // Values are rounded down to their bucket, which is within 1/16 of them
+    ASSERT_TRUE(text.contains(
+        "Filter: 100 samples, p50 0.001 ms, p99 9.961 ms, max 10.000 ms\n"))
+        << text;
+    ASSERT_TRUE(text.contains("Paint: 0 samples\n")) << text;
+}
+
+TEST(DebugCount, ResetLatencies)
+{
+    DebugCount::recordLatency(DebugStage::Layout, 5ms);
+    DebugCount::resetLatencies();
+
+    auto text = DebugCount::getLatencyText();
+    ASSERT_TRUE(text.contains("Layout: 0 samples\n")) << text;
+}
+
+TEST(DebugCount, StageTimer)
+{
+    DebugCount::resetLatencies();
+    {
+        DebugStageTimer timer(DebugStage::Paint);
+    }
+
+    auto text = DebugCount::getLatencyText();
+    ASSERT_TRUE(text.contains("Paint: 1 samples")) << text;
+}
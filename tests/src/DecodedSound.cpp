@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "controllers/sound/DecodedSound.hpp"
+
+#include "Test.hpp"
+
+#include <miniaudio.h>
+#include <QByteArray>
+#include <QDataStream>
+
+#include <chrono>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+namespace {
+
+using PlayResult = DecodedSound::PlayResult;
+
+/// A mono 16 bit WAV file with `frames` frames of silence
+QByteArray makeWav(quint32 frames, quint32 sampleRate = 48000)
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 dataSize = frames * 2;
+    out.writeRawData("RIFF", 4);
+    out << quint32(36 + dataSize);
+    out.writeRawData("WAVE", 4);
+    out.writeRawData("fmt ", 4);
+    out << quint32(16) << quint16(1) << quint16(1) << sampleRate
+        << quint32(sampleRate * 2) << quint16(2) << quint16(16);
+    out.writeRawData("data", 4);
+    out << dataSize;
+    data.append(QByteArray(static_cast<qsizetype>(dataSize), '\0'));
+
+    return data;
+}
+
+class DecodedSoundTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ma_backend backends[] = {ma_backend_null};
+        ASSERT_EQ(ma_context_init(backends, 1, nullptr, &this->context),
+                  MA_SUCCESS);
+
+        auto config = ma_engine_config_init();
+        config.pContext = &this->context;
+        ASSERT_EQ(ma_engine_init(&config, &this->engine), MA_SUCCESS);
+    }
+
+    void TearDown() override
+    {
+        ma_engine_uninit(&this->engine);
+        ma_context_uninit(&this->context);
+    }
+
+    ma_context context{};
+    ma_engine engine{};
+};
+
+}  // namespace
+
+TEST_F(DecodedSoundTest, DecodesIntoMemory)
+{
+    // Match the engine so the sound isn't resampled
+    auto sampleRate = ma_engine_get_sample_rate(&this->engine);
+    auto sound = DecodedSound::fromMemory(
+        &this->engine, makeWav(sampleRate, sampleRate), {});
+    ASSERT_NE(sound, nullptr);
+
+    auto expected = size_t{sampleRate} * ma_engine_get_channels(&this->engine) *
+                    sizeof(float);
+    ASSERT_EQ(sound->sizeInBytes(), expected);
+    ASSERT_EQ(sound->playingVoices(), 0U);
+}
+
+TEST_F(DecodedSoundTest, RejectsInvalidData)
+{
+    auto sound = DecodedSound::fromMemory(&this->engine,
+                                          QByteArray("not a sound"), {});
+    ASSERT_EQ(sound, nullptr);
+}
+
+TEST_F(DecodedSoundTest, RejectsLargeSounds)
+{
+    DecodedSound::Options options;
+    options.maxBytes = 1024;
+    ASSERT_EQ(
+        DecodedSound::fromMemory(&this->engine, makeWav(48000), options),
+        nullptr);
+}
+
+TEST_F(DecodedSoundTest, CoalescesBursts)
+{
+    auto sound = DecodedSound::fromMemory(&this->engine, makeWav(48000), {});
+    ASSERT_NE(sound, nullptr);
+
+    auto now = std::chrono::steady_clock::now();
+    ASSERT_EQ(sound->play(now), PlayResult::Started);
+    for (int i = 1; i < 50; i++)
+    {
+        ASSERT_EQ(sound->play(now + i * 1ms), PlayResult::Coalesced);
+    }
+    ASSERT_EQ(sound->playingVoices(), 1U);
+
+    ASSERT_EQ(sound->play(now + 100ms), PlayResult::Started);
+    ASSERT_EQ(sound->playingVoices(), 2U);
+}
+
+TEST_F(DecodedSoundTest, StealsOldestVoice)
+{
+    DecodedSound::Options options;
+    options.voices = 2;
+    options.coalesceWindow = 0ms;
+    auto sound =
+        DecodedSound::fromMemory(&this->engine, makeWav(48000 * 10), options);
+    ASSERT_NE(sound, nullptr);
+
+    auto now = std::chrono::steady_clock::now();
+    ASSERT_EQ(sound->play(now), PlayResult::Started);
+    ASSERT_EQ(sound->play(now + 1ms), PlayResult::Started);
+    ASSERT_EQ(sound->play(now + 2ms), PlayResult::Stolen);
+    ASSERT_EQ(sound->play(now + 3ms), PlayResult::Stolen);
+    ASSERT_EQ(sound->playingVoices(), 2U);
+}
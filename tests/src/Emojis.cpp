@@ -10,6 +10,8 @@
 #include <QDebug>
 #include <QString>
 
+#include <thread>
+
 using namespace chatterino;
 using namespace literals;
 
@@ -203,3 +205,20 @@ TEST(Emojis, Parse)
         }
     }
 }
+
+TEST(Emojis, LoadDataOnWorker)
+{
+    Emojis emojis;
+
+    // The data is parsed off the GUI thread during startup
+    std::thread([&emojis] {
+        emojis.loadData();
+    }).join();
+    ASSERT_FALSE(emojis.getEmojis().empty());
+    ASSERT_EQ(emojis.replaceShortCodes(":penguin:"), "🐧");
+    // The emotes are only created once the emoji set is known
+    ASSERT_EQ(emojis.getEmojis().front()->emote, nullptr);
+
+    emojis.load();
+    ASSERT_NE(emojis.getEmojis().front()->emote, nullptr);
+}
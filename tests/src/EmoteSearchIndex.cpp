@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "controllers/emotes/EmoteSearchIndex.hpp"
+
+#include "Test.hpp"
+
+#include <QStringList>
+
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+EmoteSection section(const QString &title, const QStringList &names)
+{
+    EmoteSection out{.title = title, .emotes = {}};
+    for (const auto &name : names)
+    {
+        out.emotes.push_back({.name = name, .insertText = name, .emote = {}});
+    }
+    return out;
+}
+
+QStringList names(const EmoteSection &section)
+{
+    QStringList out;
+    for (const auto &emote : section.emotes)
+    {
+        out.append(emote.name);
+    }
+    return out;
+}
+
+EmoteSearchIndex makeIndex()
+{
+    return EmoteSearchIndex({
+        section("Global", {"Kappa", "KappaPride", "PogChamp", "LUL"}),
+        section("Empty", {}),
+        section("Channel", {"catJAM", "pepeJAM", "Jammies", "kapp"}),
+    });
+}
+
+}  // namespace
+
+TEST(EmoteSearchIndex, FindsSubstrings)
+{
+    auto result = makeIndex().search(u"jam");
+
+    ASSERT_EQ(result.size(), 1U);
+    ASSERT_EQ(result[0].title, "Channel");
+    ASSERT_EQ(names(result[0]),
+              (QStringList{"catJAM", "pepeJAM", "Jammies"}));
+}
+
+TEST(EmoteSearchIndex, IgnoresCase)
+{
+    auto index = makeIndex();
+
+    ASSERT_EQ(index.search(u"KAPP").size(), 2U);
+    ASSERT_EQ(index.search(u"kapp").size(), 2U);
+    ASSERT_EQ(index.search(u"lUl").size(), 1U);
+}
+
+TEST(EmoteSearchIndex, KeepsOrder)
+{
+    auto result = makeIndex().search(u"pp");
+
+    ASSERT_EQ(result.size(), 2U);
+    ASSERT_EQ(result[0].title, "Global");
+    ASSERT_EQ(names(result[0]), (QStringList{"Kappa", "KappaPride"}));
+    ASSERT_EQ(result[1].title, "Channel");
+    ASSERT_EQ(names(result[1]), (QStringList{"kapp"}));
+}
+
+TEST(EmoteSearchIndex, ReturnsNamesOnce)
+{
+    // "KappaPride" contains "a" three times
+    auto result = makeIndex().search(u"a");
+
+    ASSERT_EQ(result.size(), 2U);
+    ASSERT_EQ(names(result[0]),
+              (QStringList{"Kappa", "KappaPride", "PogChamp"}));
+}
+
+TEST(EmoteSearchIndex, NoMatch)
+{
+    auto index = makeIndex();
+
+    ASSERT_TRUE(index.search(u"forsen").empty());
+    ASSERT_TRUE(index.search(u"kappaprideX").empty());
+    ASSERT_TRUE(EmoteSearchIndex().search(u"a").empty());
+}
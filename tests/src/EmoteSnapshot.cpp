@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/EmoteSnapshot.hpp"
+
+#include "messages/Image.hpp"
+#include "Test.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+
+using namespace chatterino;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+EmotePtr makeEmote(const QString &name, const QString &id)
+{
+    auto base = u"https://cdn.example.com/"_s + id;
+    return std::make_shared<const Emote>(Emote{
+        .name = {name},
+        .images =
+            ImageSet{
+                Image::fromUrl({base + u"/1x"_s}, 1, {28, 28}),
+                Image::fromUrl({base + u"/2x"_s}, 0.5, {56, 56}),
+                Image::getEmpty(),
+            },
+        .tooltip = {name + u"<br>Channel Emote"_s},
+        .homePage = {u"https://example.com/emotes/"_s + id},
+        .id = {id},
+        .author = {u"forsen"_s},
+    });
+}
+
+EmoteMap makeEmotes()
+{
+    EmoteMap emotes;
+    emotes[{u"Kappa"_s}] = makeEmote(u"Kappa"_s, u"1"_s);
+
+    auto zeroWidth = *makeEmote(u"SoSnowy"_s, u"2"_s);
+    zeroWidth.zeroWidth = true;
+    emotes[{u"SoSnowy"_s}] = std::make_shared<const Emote>(zeroWidth);
+
+    auto aliased = *makeEmote(u"Kapp"_s, u"3"_s);
+    aliased.baseName = EmoteName{u"Keepo"_s};
+    emotes[{u"Kapp"_s}] = std::make_shared<const Emote>(aliased);
+
+    auto autoscaled = *makeEmote(u"kickEmote"_s, u"4"_s);
+    autoscaled.images =
+        ImageSet{Image::fromAutoscaledUrl({u"https://kick.example/4"_s}, 32)};
+    emotes[{u"kickEmote"_s}] = std::make_shared<const Emote>(autoscaled);
+
+    return emotes;
+}
+
+}  // namespace
+
+TEST(EmoteSnapshot, RoundTrip)
+{
+    auto emotes = makeEmotes();
+
+    auto restored =
+        emotesnapshot::deserialize(emotesnapshot::serialize(emotes));
+    ASSERT_TRUE(restored.has_value());
+    ASSERT_TRUE(sameEmotes(emotes, *restored));
+
+    const auto &kapp = restored->at({u"Kapp"_s});
+    ASSERT_EQ(kapp->baseName, EmoteName{u"Keepo"_s});
+    ASSERT_EQ(kapp->author.string, u"forsen"_s);
+    ASSERT_FALSE(kapp->zeroWidth);
+    ASSERT_TRUE(restored->at({u"SoSnowy"_s})->zeroWidth);
+
+    const auto &kappa = restored->at({u"Kappa"_s});
+    ASSERT_EQ(kappa->images.getImage2()->scale(), 0.5);
+    ASSERT_EQ(kappa->images.getImage2()->expectedSize(), QSize(56, 56));
+    ASSERT_TRUE(kappa->images.getImage3()->isEmpty());
+
+    const auto &kick = restored->at({u"kickEmote"_s});
+    ASSERT_EQ(kick->images.getImage1()->autoScale(), 32);
+}
+
+TEST(EmoteSnapshot, Empty)
+{
+    auto restored = emotesnapshot::deserialize(emotesnapshot::serialize({}));
+    ASSERT_TRUE(restored.has_value());
+    ASSERT_TRUE(restored->empty());
+}
+
+TEST(EmoteSnapshot, Invalid)
+{
+    auto data = emotesnapshot::serialize(makeEmotes());
+
+    ASSERT_FALSE(emotesnapshot::deserialize({}).has_value());
+    // truncated
+    ASSERT_FALSE(
+        emotesnapshot::deserialize(QByteArrayView(data).first(data.size() / 2))
+            .has_value());
+
+    // other version
+    auto otherVersion = data;
+    otherVersion[7] = static_cast<char>(emotesnapshot::VERSION + 1);
+    ASSERT_FALSE(emotesnapshot::deserialize(otherVersion).has_value());
+}
+
+TEST(EmoteSnapshot, SameEmotes)
+{
+    auto emotes = makeEmotes();
+    auto copy = emotes;
+    ASSERT_TRUE(sameEmotes(emotes, copy));
+
+    copy.erase({u"Kappa"_s});
+    ASSERT_FALSE(sameEmotes(emotes, copy));
+
+    copy[{u"Kappa"_s}] = makeEmote(u"Kappa"_s, u"1"_s);
+    ASSERT_TRUE(sameEmotes(emotes, copy));
+
+    auto renamed = *makeEmote(u"Kappa"_s, u"1"_s);
+    renamed.zeroWidth = true;
+    copy[{u"Kappa"_s}] = std::make_shared<const Emote>(renamed);
+    ASSERT_FALSE(sameEmotes(emotes, copy));
+}
+
+TEST(EmoteSnapshot, WriteIfChanged)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath(u"global.betterttv.emotes"_s);
+
+    auto data = emotesnapshot::serialize(makeEmotes());
+    ASSERT_TRUE(emotesnapshot::writeIfChanged(path, data));
+
+    auto readBack = [&] {
+        QFile file(path);
+        EXPECT_TRUE(file.open(QIODevice::ReadOnly));
+        return file.readAll();
+    };
+    ASSERT_EQ(readBack(), data);
+
+    // Unchanged snapshots aren't written again
+    ASSERT_FALSE(emotesnapshot::writeIfChanged(path, data));
+
+    auto other = emotesnapshot::serialize({});
+    ASSERT_TRUE(emotesnapshot::writeIfChanged(path, other));
+    ASSERT_EQ(readBack(), other);
+
+    // No temporary files are left behind
+    ASSERT_EQ(QDir(dir.path()).entryList(QDir::Files),
+              QStringList{u"global.betterttv.emotes"_s});
+}
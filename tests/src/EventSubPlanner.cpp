@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/twitch/eventsub/SubscriptionPlanner.hpp"
+
+#include "Test.hpp"
+
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino::eventsub;
+
+namespace {
+
+std::vector<SubscriptionRequest> requests(const QString &owner, int count,
+                                          const QString &type = "channel.ban")
+{
+    std::vector<SubscriptionRequest> out;
+    for (int i = 0; i < count; i++)
+    {
+        out.push_back({
+            .subscriptionType = type,
+            .subscriptionVersion = "1",
+            .ownerTwitchUserID = owner,
+            .conditions = {{"broadcaster_user_id", QString::number(i)}},
+        });
+    }
+    return out;
+}
+
+SessionLimits smallLimits()
+{
+    return {
+        .maxSubscriptions = 10,
+        .maxSessionsPerUser = 3,
+        .maxTotalCost = 10,
+    };
+}
+
+}  // namespace
+
+TEST(EventSubPlanner, OpensSessionsForAllRequests)
+{
+    auto plan = planSubscriptions(requests("1", 25), {}, smallLimits(), {});
+
+    ASSERT_TRUE(plan.assignments.empty());
+    ASSERT_EQ(plan.deferred.size(), 25U);
+    ASSERT_EQ(plan.newSessions, 3U);
+}
+
+TEST(EventSubPlanner, CountsSessionsThatAreConnecting)
+{
+    // A session without a session ID is still connecting
+    std::vector<SessionLoad> sessions(1);
+    auto plan = planSubscriptions(requests("1", 15), sessions, smallLimits(),
+                                  {});
+
+    ASSERT_EQ(plan.deferred.size(), 15U);
+    ASSERT_EQ(plan.newSessions, 1U);
+}
+
+TEST(EventSubPlanner, SpreadsRequestsOverSessions)
+{
+    std::vector<SessionLoad> sessions{
+        {.sessionID = "a", .ownerTwitchUserID = "1", .subscriptions = 6},
+        {.sessionID = "b", .ownerTwitchUserID = "1", .subscriptions = 2},
+    };
+    auto plan = planSubscriptions(requests("1", 8), sessions, smallLimits(),
+                                  {});
+
+    ASSERT_EQ(plan.assignments.size(), 8U);
+    ASSERT_TRUE(plan.deferred.empty());
+    ASSERT_EQ(plan.newSessions, 0U);
+
+    size_t onA = 0;
+    for (const auto &assignment : plan.assignments)
+    {
+        if (assignment.session == 0)
+        {
+            onA++;
+        }
+    }
+    // Both sessions end up with 8 subscriptions
+    ASSERT_EQ(onA, 2U);
+}
+
+TEST(EventSubPlanner, KeepsUsersApart)
+{
+    std::vector<SessionLoad> sessions{
+        {.sessionID = "a", .ownerTwitchUserID = "1", .subscriptions = 1},
+        {.sessionID = "b"},
+    };
+    auto input = requests("2", 2);
+    auto ownRequests = requests("1", 1);
+    input.insert(input.begin(), ownRequests.begin(), ownRequests.end());
+
+    auto plan = planSubscriptions(input, sessions, smallLimits(), {});
+
+    ASSERT_EQ(plan.assignments.size(), 3U);
+    ASSERT_EQ(plan.assignments[0].session, 0U);
+    ASSERT_EQ(plan.assignments[1].session, 1U);
+    ASSERT_EQ(plan.assignments[2].session, 1U);
+}
+
+TEST(EventSubPlanner, RespectsSessionLimitPerUser)
+{
+    std::vector<SessionLoad> sessions(
+        3, {.sessionID = "a", .ownerTwitchUserID = "1", .subscriptions = 10});
+    auto plan = planSubscriptions(requests("1", 5), sessions, smallLimits(),
+                                  {});
+
+    ASSERT_TRUE(plan.assignments.empty());
+    ASSERT_EQ(plan.deferred.size(), 5U);
+    ASSERT_EQ(plan.newSessions, 0U);
+}
+
+TEST(EventSubPlanner, RespectsTotalCost)
+{
+    std::vector<SessionLoad> sessions{
+        {.sessionID = "a", .ownerTwitchUserID = "1", .cost = 8},
+    };
+    QHash<QString, int> costByType{{"stream.online", 1}};
+    auto plan = planSubscriptions(requests("1", 5, "stream.online"), sessions,
+                                  smallLimits(), costByType);
+
+    ASSERT_EQ(plan.assignments.size(), 2U);
+    ASSERT_EQ(plan.deferred.size(), 3U);
+    // Another session wouldn't have room for them either
+    ASSERT_EQ(plan.newSessions, 0U);
+}
@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/twitch/api/GqlBatcher.hpp"
+
+#include "common/network/NetworkResult.hpp"
+#include "Test.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+struct SentBatch {
+    QString token;
+    QJsonArray payload;
+    GqlBatcher::Done done;
+};
+
+GqlBatcher::Send recordInto(std::vector<SentBatch> &sent)
+{
+    return [&sent](const QString &token, const QJsonArray &payload,
+                   GqlBatcher::Done done) {
+        sent.push_back({token, payload, std::move(done)});
+    };
+}
+
+QJsonObject operation(int id)
+{
+    return {{"id", id}};
+}
+
+NetworkResult response(const QJsonArray &responses)
+{
+    return {
+        NetworkResult::NetworkError::NoError,
+        200,
+        QJsonDocument(responses).toJson(QJsonDocument::Compact),
+    };
+}
+
+void processEventsFor(std::chrono::milliseconds duration)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < duration.count())
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+}
+
+}  // namespace
+
+TEST(GqlBatcher, CombinesOperationsWithinBudget)
+{
+    std::vector<SentBatch> sent;
+    auto batcher = std::make_shared<GqlBatcher>(recordInto(sent));
+
+    std::vector<QJsonValue> received;
+    for (int i = 0; i < 3; i++)
+    {
+        BatchedGqlRequest(batcher, u"token"_s, operation(i))
+            .onSuccess([&received](const NetworkResult &result) {
+                received.push_back(result.parseJsonValue());
+            })
+            .execute();
+    }
+    ASSERT_TRUE(sent.empty());
+    ASSERT_EQ(batcher->pending(), 3U);
+
+    processEventsFor(50ms);
+    ASSERT_EQ(sent.size(), 1U);
+    ASSERT_EQ(sent[0].token, u"token"_s);
+    ASSERT_EQ(sent[0].payload,
+              (QJsonArray{operation(0), operation(1), operation(2)}));
+    ASSERT_EQ(batcher->pending(), 0U);
+
+    sent[0].done(true, response({
+                           QJsonObject{{"data", 0}},
+                           QJsonObject{{"data", 1}},
+                           QJsonObject{{"data", 2}},
+                       }));
+
+    // Every operation gets its own response as if it was sent alone
+    ASSERT_EQ(received.size(), 3U);
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_EQ(received[i], QJsonArray{QJsonObject{{"data", i}}});
+    }
+}
+
+TEST(GqlBatcher, SendsFullBatchesImmediately)
+{
+    std::vector<SentBatch> sent;
+    GqlBatcher batcher(recordInto(sent), {
+                                             .maxBatchSize = 2,
+                                             .latencyBudget = 10ms,
+                                         });
+
+    for (int i = 0; i < 3; i++)
+    {
+        batcher.add({.payload = operation(i)});
+    }
+    ASSERT_EQ(sent.size(), 1U);
+    ASSERT_EQ(sent[0].payload, (QJsonArray{operation(0), operation(1)}));
+    ASSERT_EQ(batcher.pending(), 1U);
+
+    batcher.flush();
+    ASSERT_EQ(sent.size(), 2U);
+    ASSERT_EQ(sent[1].payload, QJsonArray{operation(2)});
+}
+
+TEST(GqlBatcher, DeliversObjectsToUnwrappedOperations)
+{
+    std::vector<SentBatch> sent;
+    GqlBatcher batcher(recordInto(sent));
+
+    QJsonValue wrapped;
+    QJsonValue unwrapped;
+    batcher.add({
+        .payload = operation(0),
+        .onSuccess =
+            [&](const NetworkResult &result) {
+                wrapped = result.parseJsonValue();
+            },
+    });
+    batcher.add({
+        .payload = operation(1),
+        .wrapInArray = false,
+        .onSuccess =
+            [&](const NetworkResult &result) {
+                unwrapped = result.parseJsonValue();
+            },
+    });
+    batcher.flush();
+    ASSERT_EQ(sent.size(), 1U);
+
+    sent[0].done(true, response({
+                           QJsonObject{{"data", 0}},
+                           QJsonObject{{"data", 1}},
+                       }));
+    ASSERT_EQ(wrapped, QJsonArray{QJsonObject{{"data", 0}}});
+    ASSERT_EQ(unwrapped, (QJsonObject{{"data", 1}}));
+}
+
+TEST(GqlBatcher, ReportsErrorsToEveryOperation)
+{
+    std::vector<SentBatch> sent;
+    GqlBatcher batcher(recordInto(sent));
+
+    int errors = 0;
+    int successes = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        batcher.add({
+            .payload = operation(i),
+            .onSuccess =
+                [&](const NetworkResult & /*result*/) {
+                    successes++;
+                },
+            .onError =
+                [&](const NetworkResult &result) {
+                    EXPECT_EQ(result.status(), 500);
+                    errors++;
+                },
+        });
+    }
+    batcher.flush();
+    ASSERT_EQ(sent.size(), 1U);
+
+    sent[0].done(false, NetworkResult(
+                            NetworkResult::NetworkError::InternalServerError,
+                            500, {}));
+    ASSERT_EQ(errors, 3);
+    ASSERT_EQ(successes, 0);
+}
+
+TEST(GqlBatcher, ReportsMissingResponses)
+{
+    std::vector<SentBatch> sent;
+    GqlBatcher batcher(recordInto(sent));
+
+    int errors = 0;
+    int successes = 0;
+    for (int i = 0; i < 2; i++)
+    {
+        batcher.add({
+            .payload = operation(i),
+            .onSuccess =
+                [&](const NetworkResult & /*result*/) {
+                    successes++;
+                },
+            .onError =
+                [&](const NetworkResult & /*result*/) {
+                    errors++;
+                },
+        });
+    }
+    batcher.flush();
+    ASSERT_EQ(sent.size(), 1U);
+
+    sent[0].done(true, response({QJsonObject{{"data", 0}}}));
+    ASSERT_EQ(successes, 1);
+    ASSERT_EQ(errors, 1);
+}
+
+TEST(GqlBatcher, SplitsBatchesByToken)
+{
+    std::vector<SentBatch> sent;
+    GqlBatcher batcher(recordInto(sent));
+
+    batcher.add({.payload = operation(0), .token = u"old"_s});
+    batcher.add({.payload = operation(1), .token = u"old"_s});
+    // A refreshed token sends the operations of the previous one
+    batcher.add({.payload = operation(2), .token = u"new"_s});
+    ASSERT_EQ(sent.size(), 1U);
+    ASSERT_EQ(sent[0].token, u"old"_s);
+    ASSERT_EQ(sent[0].payload, (QJsonArray{operation(0), operation(1)}));
+    ASSERT_EQ(batcher.pending(), 1U);
+
+    // The operations of the new token are still batched
+    batcher.add({.payload = operation(3), .token = u"new"_s});
+    processEventsFor(50ms);
+    ASSERT_EQ(sent.size(), 2U);
+    ASSERT_EQ(sent[1].token, u"new"_s);
+    ASSERT_EQ(sent[1].payload, (QJsonArray{operation(2), operation(3)}));
+    ASSERT_EQ(batcher.pending(), 0U);
+
+    // Anonymous operations aren't mixed with authenticated ones
+    batcher.add({.payload = operation(4)});
+    batcher.add({.payload = operation(5), .token = u"new"_s});
+    batcher.flush();
+    ASSERT_EQ(sent.size(), 4U);
+    ASSERT_TRUE(sent[2].token.isEmpty());
+    ASSERT_EQ(sent[2].payload, QJsonArray{operation(4)});
+    ASSERT_EQ(sent[3].payload, QJsonArray{operation(5)});
+}
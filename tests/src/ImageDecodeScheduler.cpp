@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/ImageDecodeScheduler.hpp"
+
+#include "messages/Image.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "Test.hpp"
+
+#include <QPixmap>
+#include <QString>
+#include <QStringList>
+
+#include <future>
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+class ImageDecodeSchedulerTest : public ::testing::Test
+{
+protected:
+    ImagePtr makeImage()
+    {
+        // Resource images are cached by the address of their pixmap
+        auto &pixmap =
+            this->pixmaps.emplace_back(std::make_unique<QPixmap>(1, 1));
+        return Image::fromResourcePixmap(*pixmap);
+    }
+
+    /// Occupies the only worker until `unblock()` is called, so the decodes
+    /// scheduled in the meantime stay queued
+    void block()
+    {
+        auto started = std::make_shared<std::promise<void>>();
+        auto startedFuture = started->get_future();
+        this->scheduler.schedule(
+            this->blocker, ImagePriority::Visible,
+            [started, release = this->release.get_future().share()] {
+                started->set_value();
+                release.wait();
+                return true;
+            });
+        startedFuture.wait();
+    }
+
+    void unblock()
+    {
+        this->release.set_value();
+        this->released = true;
+        this->scheduler.waitForDone();
+    }
+
+    void TearDown() override
+    {
+        // Don't leave the worker blocked if an assertion failed
+        if (!this->released)
+        {
+            this->release.set_value();
+        }
+    }
+
+    void schedule(const ImagePtr &image, ImagePriority priority,
+                  const QString &name)
+    {
+        this->scheduler.schedule(image, priority, [this, name] {
+            this->decoded.append(name);
+            return true;
+        });
+    }
+
+    mock::BaseApplication mockApplication;
+    std::vector<std::unique_ptr<QPixmap>> pixmaps;
+    ImagePtr blocker = this->makeImage();
+    std::promise<void> release;
+    bool released = false;
+    /// Only touched by the single worker until waitForDone() returned
+    QStringList decoded;
+    ImageDecodeScheduler scheduler{1};
+};
+
+}  // namespace
+
+TEST_F(ImageDecodeSchedulerTest, HighestPriorityFirst)
+{
+    auto a = this->makeImage();
+    auto b = this->makeImage();
+    auto c = this->makeImage();
+    auto d = this->makeImage();
+
+    this->block();
+    this->schedule(a, ImagePriority::Offscreen, u"a"_s);
+    this->schedule(b, ImagePriority::Visible, u"b"_s);
+    this->schedule(c, ImagePriority::Tooltip, u"c"_s);
+    this->schedule(d, ImagePriority::Visible, u"d"_s);
+
+    auto stats = this->scheduler.stats();
+    ASSERT_EQ(stats.queued[0], 2U);
+    ASSERT_EQ(stats.queued[1], 1U);
+    ASSERT_EQ(stats.queued[2], 1U);
+
+    this->unblock();
+
+    // Same priorities are decoded in the order they were scheduled
+    ASSERT_EQ(this->decoded, (QStringList{"b", "d", "c", "a"}));
+    stats = this->scheduler.stats();
+    ASSERT_EQ(stats.decoded, 5U);
+    ASSERT_EQ(stats.cancelled, 0U);
+    ASSERT_EQ(stats.queued[0] + stats.queued[1] + stats.queued[2], 0U);
+}
+
+TEST_F(ImageDecodeSchedulerTest, RaisePriority)
+{
+    auto a = this->makeImage();
+    auto b = this->makeImage();
+    auto c = this->makeImage();
+    auto unknown = this->makeImage();
+
+    this->block();
+    this->schedule(a, ImagePriority::Offscreen, u"a"_s);
+    this->schedule(b, ImagePriority::Tooltip, u"b"_s);
+    this->schedule(c, ImagePriority::Offscreen, u"c"_s);
+
+    this->scheduler.raise(c.get(), ImagePriority::Visible);
+    // Lowering or keeping the priority does nothing
+    this->scheduler.raise(b.get(), ImagePriority::Offscreen);
+    this->scheduler.raise(a.get(), ImagePriority::Offscreen);
+    // Images without a queued decode are ignored
+    this->scheduler.raise(unknown.get(), ImagePriority::Visible);
+
+    auto stats = this->scheduler.stats();
+    ASSERT_EQ(stats.queued[0], 1U);
+    ASSERT_EQ(stats.queued[1], 1U);
+    ASSERT_EQ(stats.queued[2], 1U);
+
+    this->unblock();
+
+    // The raised decode only runs once, even though it's in two queues
+    ASSERT_EQ(this->decoded, (QStringList{"c", "b", "a"}));
+    ASSERT_EQ(this->scheduler.stats().decoded, 4U);
+}
+
+TEST_F(ImageDecodeSchedulerTest, CancelDroppedImages)
+{
+    auto a = this->makeImage();
+    auto b = this->makeImage();
+    auto c = this->makeImage();
+
+    this->block();
+    this->schedule(a, ImagePriority::Visible, u"a"_s);
+    this->schedule(b, ImagePriority::Visible, u"b"_s);
+    this->scheduler.schedule(c, ImagePriority::Visible, [] {
+        // Cancelled half-way
+        return false;
+    });
+
+    // Dropped while it's queued
+    a.reset();
+
+    // Dropped before it's scheduled, this is never queued
+    auto d = this->makeImage();
+    std::weak_ptr<Image> weakD = d;
+    d.reset();
+    this->scheduler.schedule(weakD, ImagePriority::Visible, [this] {
+        this->decoded.append(u"d"_s);
+        return true;
+    });
+    ASSERT_EQ(this->scheduler.stats().queued[0], 3U);
+
+    this->unblock();
+
+    ASSERT_EQ(this->decoded, (QStringList{"b"}));
+    auto stats = this->scheduler.stats();
+    ASSERT_EQ(stats.decoded, 2U);
+    ASSERT_EQ(stats.cancelled, 3U);
+}
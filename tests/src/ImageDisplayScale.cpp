@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/Image.hpp"
+
+#include "ImageTestAccess.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "Test.hpp"
+
+#include <QCoreApplication>
+#include <QString>
+#include <QThreadPool>
+
+using namespace chatterino;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+/// Loading this fails, because the resource doesn't exist
+const QString MISSING_URL = u":/does-not-exist.png"_s;
+
+class ImageDisplayScaleTest : public ::testing::Test
+{
+protected:
+    /// Waits for a load started through a resource URL to finish
+    static void waitForLoad()
+    {
+        QThreadPool::globalInstance()->waitForDone();
+        QCoreApplication::processEvents();
+    }
+
+    mock::BaseApplication mockApplication;
+};
+
+}  // namespace
+
+TEST_F(ImageDisplayScaleTest, DecodedDevicePixelRatio)
+{
+    // Not requested or close to the native size
+    ASSERT_EQ(detail::decodedDevicePixelRatio({32, 32}, 0), 1);
+    ASSERT_EQ(detail::decodedDevicePixelRatio({32, 32}, 1), 1);
+    ASSERT_EQ(detail::decodedDevicePixelRatio({32, 32}, 0.95), 1);
+
+    ASSERT_EQ(detail::decodedDevicePixelRatio({32, 32}, 0.5), 0.5);
+    // The ratio follows the rounded size the frames are decoded at
+    ASSERT_DOUBLE_EQ(detail::decodedDevicePixelRatio({10, 10}, 0.25), 0.3);
+    ASSERT_EQ(detail::decodedDevicePixelRatio({1, 1}, 0.1), 1);
+    ASSERT_EQ(detail::decodedDevicePixelRatio({}, 0.5), 1);
+}
+
+TEST_F(ImageDisplayScaleTest, LargestRequestedScale)
+{
+    auto image = ImageTestAccess::make(MISSING_URL);
+    ASSERT_EQ(ImageTestAccess::targetDisplayScale(*image), 0);
+
+    image->requestDisplayScale(0.5);
+    ASSERT_EQ(ImageTestAccess::targetDisplayScale(*image), 0.5);
+
+    // Smaller requests don't shrink the scale
+    image->requestDisplayScale(0.25);
+    ASSERT_EQ(ImageTestAccess::targetDisplayScale(*image), 0.5);
+
+    // Frames are never decoded above their native size
+    image->requestDisplayScale(2);
+    ASSERT_EQ(ImageTestAccess::targetDisplayScale(*image), 1);
+}
+
+TEST_F(ImageDisplayScaleTest, NativeScaleUntilReleased)
+{
+    auto image = ImageTestAccess::make(MISSING_URL);
+    image->requestDisplayScale(0.5);
+
+    image->acquireNativeScale();
+    image->acquireNativeScale();
+    ASSERT_EQ(ImageTestAccess::targetDisplayScale(*image), 1);
+
+    image->releaseNativeScale();
+    ASSERT_EQ(ImageTestAccess::targetDisplayScale(*image), 1);
+
+    image->releaseNativeScale();
+    ASSERT_EQ(ImageTestAccess::targetDisplayScale(*image), 0.5);
+}
+
+TEST_F(ImageDisplayScaleTest, RedecodeOnlyForDifferentScale)
+{
+    auto image = ImageTestAccess::make(MISSING_URL);
+    image->requestDisplayScale(0.5);
+    ASSERT_FALSE(ImageTestAccess::redecodePending(*image));
+
+    ImageTestAccess::setDecoded(*image, {32, 32}, 0.5);
+
+    // Slightly larger requests are served by the current frames
+    image->requestDisplayScale(0.52);
+    ASSERT_FALSE(ImageTestAccess::redecodePending(*image));
+
+    image->requestDisplayScale(0.8);
+    ASSERT_TRUE(ImageTestAccess::redecodePending(*image));
+
+    this->waitForLoad();
+    ASSERT_FALSE(ImageTestAccess::redecodePending(*image));
+}
+
+TEST_F(ImageDisplayScaleTest, FailedRedecodeKeepsFrames)
+{
+    auto image = ImageTestAccess::make(MISSING_URL);
+    image->requestDisplayScale(0.5);
+    ImageTestAccess::setDecoded(*image, {32, 32}, 0.5);
+
+    image->acquireNativeScale();
+    ASSERT_TRUE(ImageTestAccess::redecodePending(*image));
+
+    this->waitForLoad();
+
+    // The frames decoded before are still shown
+    ASSERT_FALSE(ImageTestAccess::redecodePending(*image));
+    ASSERT_FALSE(image->isEmpty());
+    ASSERT_TRUE(ImageTestAccess::hasFrames(*image));
+    ASSERT_EQ(ImageTestAccess::decodedDevicePixelRatio(*image), 0.5);
+
+    // Releasing goes back to the scale the frames are decoded at
+    image->releaseNativeScale();
+    ASSERT_FALSE(ImageTestAccess::redecodePending(*image));
+}
+
+TEST_F(ImageDisplayScaleTest, FailedLoadIsEmpty)
+{
+    auto image = ImageTestAccess::make(MISSING_URL);
+    ImageTestAccess::load(*image);
+    this->waitForLoad();
+
+    ASSERT_TRUE(image->isEmpty());
+}
+
+TEST_F(ImageDisplayScaleTest, ReleaseShrinksFrames)
+{
+    auto image = ImageTestAccess::make(MISSING_URL);
+    image->requestDisplayScale(0.5);
+    image->acquireNativeScale();
+    ImageTestAccess::setDecoded(*image, {32, 32}, 1);
+    ASSERT_FALSE(ImageTestAccess::redecodePending(*image));
+
+    // The frames are decoded again for the smaller scale
+    image->releaseNativeScale();
+    ASSERT_TRUE(ImageTestAccess::redecodePending(*image));
+
+    this->waitForLoad();
+    ASSERT_FALSE(image->isEmpty());
+    ASSERT_EQ(ImageTestAccess::decodedDevicePixelRatio(*image), 1);
+}
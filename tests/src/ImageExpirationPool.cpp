@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/Image.hpp"
+
+#include "ImageTestAccess.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "Test.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QPixmap>
+#include <QString>
+
+#include <chrono>
+#include <memory>
+
+#ifndef DISABLE_IMAGE_EXPIRATION_POOL
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+const QString SEVENTV_URL = u"https://cdn.7tv.app/emote/%1/1x.webp"_s;
+const QString BTTV_URL = u"https://cdn.betterttv.net/emote/abc/1x"_s;
+const QString TWITCH_URL =
+    u"https://static-cdn.jtvnw.net/emoticons/v2/25/default/dark/1.0"_s;
+
+int64_t bytesOf(QSize size)
+{
+    QPixmap pixmap(size);
+    return static_cast<int64_t>(size.width()) * size.height() *
+           pixmap.depth() / 8;
+}
+
+class ImageExpirationPoolTest : public ::testing::Test
+{
+protected:
+    /// Adds an image with a frame of `size` that was last used `age` ago
+    ImagePtr add(const QString &url, QSize size,
+                 std::chrono::steady_clock::duration age)
+    {
+        auto image = ImageTestAccess::make(url);
+        this->pool.addImagePtr(image);
+        ImageTestAccess::setPixmap(*image, size);
+        ImageTestAccess::setLastUsed(*image,
+                                     std::chrono::steady_clock::now() - age);
+        return image;
+    }
+
+    mock::BaseApplication mockApplication;
+    ImageExpirationPool pool;
+};
+
+}  // namespace
+
+TEST_F(ImageExpirationPoolTest, ShardsByProvider)
+{
+    auto a = this->add(SEVENTV_URL.arg(1), {32, 32}, 0s);
+    auto b = this->add(SEVENTV_URL.arg(2), {32, 32}, 0s);
+    auto c = this->add(BTTV_URL, {16, 16}, 0s);
+    auto d = this->add(TWITCH_URL, {8, 8}, 0s);
+    // Images without frames aren't listed
+    auto e = ImageTestAccess::make(u"https://cdn.frankerfacez.com/1"_s);
+    this->pool.addImagePtr(e);
+
+    auto usage = this->pool.getProviderUsageSnapshot();
+    ASSERT_EQ(usage.size(), 3U);
+
+    ASSERT_EQ(usage[0].provider, u"7TV emotes"_s);
+    ASSERT_EQ(usage[0].bytes, 2 * bytesOf({32, 32}));
+    ASSERT_EQ(usage[0].images, 2U);
+    ASSERT_EQ(usage[0].animatedImages, 0U);
+
+    ASSERT_EQ(usage[1].provider, u"BTTV"_s);
+    ASSERT_EQ(usage[1].bytes, bytesOf({16, 16}));
+    ASSERT_EQ(usage[1].images, 1U);
+
+    ASSERT_EQ(usage[2].provider, u"Twitch"_s);
+    ASSERT_EQ(usage[2].bytes, bytesOf({8, 8}));
+}
+
+TEST_F(ImageExpirationPoolTest, UsageFollowsFrames)
+{
+    auto image = this->add(BTTV_URL, {16, 16}, 0s);
+    ASSERT_EQ(this->pool.getProviderUsageSnapshot()[0].bytes,
+              bytesOf({16, 16}));
+
+    // Replacing the frames replaces their usage
+    ImageTestAccess::setPixmap(*image, {32, 32});
+    auto usage = this->pool.getProviderUsageSnapshot();
+    ASSERT_EQ(usage.size(), 1U);
+    ASSERT_EQ(usage[0].bytes, bytesOf({32, 32}));
+    ASSERT_EQ(usage[0].images, 1U);
+
+    this->pool.removeImagePtr(image.get());
+    ASSERT_TRUE(this->pool.getProviderUsageSnapshot().empty());
+
+    // Frames that were set before the image was added are counted too
+    auto loaded = ImageTestAccess::make(TWITCH_URL);
+    ImageTestAccess::setPixmap(*loaded, {8, 8});
+    this->pool.addImagePtr(loaded);
+    usage = this->pool.getProviderUsageSnapshot();
+    ASSERT_EQ(usage.size(), 1U);
+    ASSERT_EQ(usage[0].bytes, bytesOf({8, 8}));
+
+    // Destroying the image removes it
+    loaded.reset();
+    ASSERT_TRUE(this->pool.getProviderUsageSnapshot().empty());
+}
+
+TEST_F(ImageExpirationPoolTest, FreeOld)
+{
+    auto old1 = this->add(SEVENTV_URL.arg(1), {16, 16}, 1h);
+    auto old2 = this->add(SEVENTV_URL.arg(2), {16, 16}, 1h);
+    auto old3 = this->add(BTTV_URL, {16, 16}, 1h);
+    auto fresh = this->add(TWITCH_URL, {16, 16}, 1s);
+
+    auto custom = this->add(SEVENTV_URL.arg(3), {16, 16}, 10s);
+    custom->setFrameCacheLifetime(5s);
+
+    this->pool.freeOld();
+
+    ASSERT_FALSE(ImageTestAccess::hasFrames(*old1));
+    ASSERT_FALSE(ImageTestAccess::hasFrames(*old2));
+    ASSERT_FALSE(ImageTestAccess::hasFrames(*old3));
+    ASSERT_FALSE(ImageTestAccess::hasFrames(*custom));
+    ASSERT_TRUE(ImageTestAccess::hasFrames(*fresh));
+
+    auto usage = this->pool.getProviderUsageSnapshot();
+    ASSERT_EQ(usage.size(), 1U);
+    ASSERT_EQ(usage[0].provider, u"Twitch"_s);
+    ASSERT_EQ(usage[0].bytes, bytesOf({16, 16}));
+
+    ASSERT_EQ(DebugCount::get(DebugObject::LastImageGcExpired), 4);
+    ASSERT_EQ(DebugCount::get(DebugObject::LastImageGcEligible), 5);
+    ASSERT_EQ(DebugCount::get(DebugObject::LastImageGcLeft), 1);
+}
+
+TEST_F(ImageExpirationPoolTest, SweepContinuesWhereItStopped)
+{
+    auto a = this->add(SEVENTV_URL.arg(1), {16, 16}, 1h);
+    auto b = this->add(SEVENTV_URL.arg(2), {16, 16}, 1h);
+    auto c = this->add(SEVENTV_URL.arg(3), {16, 16}, 1h);
+    auto d = this->add(BTTV_URL, {16, 16}, 1h);
+    auto e = this->add(BTTV_URL + u"/2"_s, {16, 16}, 1h);
+
+    auto countLoaded = [&] {
+        int n = 0;
+        for (const auto &image : {a, b, c, d, e})
+        {
+            n += ImageTestAccess::hasFrames(*image) ? 1 : 0;
+        }
+        return n;
+    };
+
+    // The first sweep stops after two images of the first shard
+    this->pool.sweep(2, 1s);
+    ASSERT_EQ(countLoaded(), 3);
+    ASSERT_TRUE(ImageTestAccess::hasFrames(*d));
+    ASSERT_TRUE(ImageTestAccess::hasFrames(*e));
+
+    // The next one finishes the first shard and moves on to the second
+    this->pool.sweep(2, 1s);
+    ASSERT_EQ(countLoaded(), 1);
+    ASSERT_FALSE(ImageTestAccess::hasFrames(*c));
+
+    this->pool.sweep(2, 1s);
+    ASSERT_EQ(countLoaded(), 0);
+    ASSERT_TRUE(this->pool.getProviderUsageSnapshot().empty());
+}
+
+#endif
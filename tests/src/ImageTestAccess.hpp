@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "common/Aliases.hpp"
+#include "messages/Image.hpp"
+
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+
+#include <chrono>
+#include <memory>
+
+namespace chatterino {
+
+class ImageTestAccess
+{
+public:
+    /// Creates an image that isn't loaded yet
+    static ImagePtr make(const QString &url)
+    {
+        return ImagePtr(new Image(Url{url}, 1, {}));
+    }
+
+    static void setPixmap(Image &image, QSize size)
+    {
+        QPixmap pixmap(size);
+        pixmap.fill(Qt::red);
+        image.setFrames(std::make_unique<detail::Frames>(
+            QList<detail::Frame>{{.image = pixmap, .duration = 1}}));
+    }
+
+    /// Sets frames as if `sourceSize` was decoded at `devicePixelRatio` and
+    /// marks the image as loaded
+    static void setDecoded(Image &image, QSize sourceSize,
+                           qreal devicePixelRatio)
+    {
+        auto size = (sourceSize.toSizeF() * devicePixelRatio).toSize();
+        QPixmap pixmap(size.expandedTo({1, 1}));
+        pixmap.fill(Qt::red);
+        pixmap.setDevicePixelRatio(devicePixelRatio);
+        image.shouldLoad_ = false;
+        image.setFrames(std::make_unique<detail::Frames>(
+            QList<detail::Frame>{{.image = pixmap, .duration = 1}},
+            sourceSize));
+    }
+
+    static void setLastUsed(Image &image,
+                            std::chrono::steady_clock::time_point time)
+    {
+        image.lastUsed_ = time;
+    }
+
+    static bool hasFrames(const Image &image)
+    {
+        return image.frames_ && !image.frames_->empty();
+    }
+
+    static qreal decodedDevicePixelRatio(const Image &image)
+    {
+        auto first = image.frames_->first();
+        return first ? first->devicePixelRatio() : 0;
+    }
+
+    static qreal targetDisplayScale(const Image &image)
+    {
+        return image.targetDisplayScale();
+    }
+
+    static bool redecodePending(const Image &image)
+    {
+        return image.redecodePending_;
+    }
+
+    /// Starts loading the image without adding it to the expiration pool
+    static void load(Image &image)
+    {
+        image.shouldLoad_ = false;
+        image.actuallyLoad();
+    }
+};
+
+}  // namespace chatterino
@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/kick/KickPusherEvent.hpp"
+
+#include "Test.hpp"
+
+#include <boost/json.hpp>
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+using namespace chatterino;
+using Type = KickPusherEvent::Type;
+
+namespace {
+
+std::string makeFrame(std::string_view event, std::string_view channel,
+                      const boost::json::value &data)
+{
+    return boost::json::serialize(boost::json::object{
+        {"event", event},
+        {"channel", channel},
+        {"data", data},
+    });
+}
+
+KickPusherEvent decode(std::string_view frame)
+{
+    auto event = KickPusherEvent::decode(frame);
+    EXPECT_TRUE(event.has_value()) << frame;
+    if (!event)
+    {
+        return std::move(*KickPusherEvent::decode(R"({})"));
+    }
+    return std::move(*event);
+}
+
+}  // namespace
+
+TEST(KickPusherEvent, DoubleEncodedData)
+{
+    // Pusher sends the payload as a JSON encoded string
+    const std::string data =
+        R"({"id":"abc","chatroom_id":668,"sender":{"username":"forsen"}})";
+    auto event =
+        decode(makeFrame("App\\Events\\ChatMessageEvent", "chatrooms.668.v2",
+                         boost::json::string(data)));
+
+    ASSERT_EQ(event.event(), "App\\Events\\ChatMessageEvent");
+    ASSERT_EQ(event.channel(), "chatrooms.668.v2");
+    ASSERT_EQ(event.rawData(), data);
+
+    const auto *obj = event.data.if_object();
+    ASSERT_NE(obj, nullptr);
+    ASSERT_EQ(std::string_view(obj->at("id").as_string()), "abc");
+    ASSERT_EQ(obj->at("chatroom_id").to_number<int64_t>(), 668);
+    ASSERT_EQ(std::string_view(obj->at("sender").at("username").as_string()),
+              "forsen");
+
+    // The payload stays valid when the event is moved
+    auto moved = std::move(event);
+    ASSERT_EQ(
+        std::string_view(moved.data.at("sender").at("username").as_string()),
+        "forsen");
+    ASSERT_EQ(moved.rawData(), data);
+}
+
+TEST(KickPusherEvent, MissingData)
+{
+    // An empty payload
+    auto empty = decode(R"({"event":"pusher:pong","data":"{}"})");
+    ASSERT_EQ(empty.type, Type::Pong);
+    ASSERT_TRUE(empty.data.is_null());
+    ASSERT_EQ(empty.rawData(), "{}");
+
+    auto missing = decode(R"({"event":"pusher:pong"})");
+    ASSERT_TRUE(missing.data.is_null());
+    ASSERT_EQ(missing.rawData(), "");
+    ASSERT_EQ(missing.channel(), "");
+
+    // Payloads are only decoded from strings
+    auto object = decode(R"({"event":"pusher:pong","data":{"a":1}})");
+    ASSERT_TRUE(object.data.is_null());
+    ASSERT_EQ(object.rawData(), "");
+
+    // An invalid payload still decodes the envelope
+    auto invalid = decode(makeFrame("App\\Events\\ChatMessageEvent",
+                                    "chatrooms.1.v2",
+                                    boost::json::string("{nope")));
+    ASSERT_EQ(invalid.type, Type::ChatMessage);
+    ASSERT_EQ(invalid.roomID, 1U);
+    ASSERT_TRUE(invalid.data.is_null());
+    ASSERT_EQ(invalid.rawData(), "{nope");
+}
+
+TEST(KickPusherEvent, NonObjectFrames)
+{
+    for (std::string_view frame : {
+             "",
+             "{",
+             R"({"event":)",
+             "[]",
+             R"([{"event":"pusher:pong"}])",
+             "42",
+             "null",
+             R"("pusher:pong")",
+         })
+    {
+        ASSERT_FALSE(KickPusherEvent::decode(frame).has_value()) << frame;
+    }
+
+    // The parser is reused, a failed frame doesn't affect the next one
+    auto event = decode(R"({"event":"pusher:pong"})");
+    ASSERT_EQ(event.type, Type::Pong);
+}
+
+TEST(KickPusherEvent, ParseIDs)
+{
+    struct Case {
+        std::string_view channel;
+        uint64_t roomID;
+        uint64_t channelID;
+    };
+    for (const auto &c : {
+             Case{"chatrooms.668.v2", 668, 0},
+             Case{"chatrooms.668", 668, 0},
+             Case{"chatroom_668", 668, 0},
+             Case{"channel_42", 0, 42},
+             Case{"channel.42", 0, 42},
+             Case{"predictions-channel-42", 0, 42},
+             Case{"chatrooms.abc.v2", 0, 0},
+             Case{"private-livestream.1", 0, 0},
+             Case{"", 0, 0},
+         })
+    {
+        auto event = decode(makeFrame("App\\Events\\ChatMessageEvent",
+                                      c.channel, boost::json::string("{}")));
+        ASSERT_EQ(event.roomID, c.roomID) << c.channel;
+        ASSERT_EQ(event.channelID, c.channelID) << c.channel;
+    }
+}
+
+TEST(KickPusherEvent, EventTypes)
+{
+    for (const auto &[name, type] : {
+             std::pair{"pusher:pong", Type::Pong},
+             std::pair{"pusher_internal:subscription_succeeded",
+                       Type::SubscriptionSucceeded},
+             std::pair{"pusher:subscription_error", Type::SubscriptionError},
+             std::pair{"pusher:connection_established",
+                       Type::ConnectionEstablished},
+             std::pair{"App\\Events\\ChatMessageEvent", Type::ChatMessage},
+             std::pair{"App\\Events\\MessageDeletedEvent",
+                       Type::MessageDeleted},
+             std::pair{"App\\Events\\ChatroomClearEvent",
+                       Type::ChatroomClear},
+             std::pair{"App\\Events\\UserBannedEvent", Type::UserBanned},
+             std::pair{"App\\Events\\UserUnbannedEvent", Type::UserUnbanned},
+             std::pair{"App\\Events\\SubscriptionEvent", Type::Subscription},
+             std::pair{"App\\Events\\GiftedSubscriptionsEvent",
+                       Type::GiftedSubscriptions},
+             std::pair{"App\\Events\\PinnedMessageCreatedEvent",
+                       Type::PinnedMessageCreated},
+             std::pair{"App\\Events\\PinnedMessageDeletedEvent",
+                       Type::PinnedMessageDeleted},
+             std::pair{"RewardRedeemedEvent", Type::RewardRedeemed},
+             std::pair{"KicksGifted", Type::KicksGifted},
+             std::pair{"App\\Events\\StreamHostEvent", Type::StreamHost},
+             std::pair{"App\\Events\\ChatroomUpdatedEvent",
+                       Type::ChatroomUpdated},
+             std::pair{"App\\Events\\StreamHostedEvent", Type::Ignored},
+             std::pair{"App\\Events\\ChatMessageSentEvent", Type::Ignored},
+             std::pair{"KicksLeaderboardUpdated", Type::Ignored},
+             std::pair{"App\\Events\\SomethingNew", Type::Unknown},
+             // Protocol events don't take the app prefix
+             std::pair{"App\\Events\\pusher:pong", Type::Unknown},
+             std::pair{"", Type::Unknown},
+         })
+    {
+        auto event = decode(makeFrame(name, "chatrooms.1.v2",
+                                      boost::json::string("{}")));
+        ASSERT_EQ(event.type, type) << name;
+    }
+}
@@ -6,16 +6,19 @@
 
 #include "Test.hpp"
 
+#include <memory>
+#include <tuple>
 #include <vector>
 
 using namespace chatterino;
 
 template <typename T>
-inline void SNAPSHOT_EQUALS(const std::vector<T> &snapshot,
+inline void SNAPSHOT_EQUALS(const LimitedQueueSnapshot<T> &snapshot,
                             const std::vector<T> &values,
                             const std::string &msg)
 {
-    EXPECT_EQ(snapshot, values) << msg;
+    EXPECT_EQ(std::vector<T>(snapshot.begin(), snapshot.end()), values)
+        << msg;
 }
 
 TEST(LimitedQueue, PushBack)
@@ -73,6 +76,29 @@ TEST(LimitedQueue, PushFront)
     EXPECT_EQ(pushed2.size(), 0);
 }
 
+TEST(LimitedQueue, SetLimit)
+{
+    LimitedQueue<int> queue(3);
+    queue.pushBack(1);
+    queue.pushBack(2);
+    queue.pushBack(3);
+
+    // A higher limit makes room at the front
+    EXPECT_EQ(queue.setLimit(5), 0);
+    auto snapshot = queue.getSnapshot();
+    auto pushed = queue.pushFront({-1, 0});
+    EXPECT_EQ(pushed, std::vector<int>({-1, 0}));
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {-1, 0, 1, 2, 3}, "grown");
+
+    // Lowering it drops the oldest items
+    EXPECT_EQ(queue.setLimit(3), 2);
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {1, 2, 3}, "shrunk");
+    SNAPSHOT_EQUALS(snapshot, {1, 2, 3}, "snapshot");
+    EXPECT_EQ(queue.limit(), 3);
+    queue.pushBack(4);
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {2, 3, 4}, "after push");
+}
+
 TEST(LimitedQueue, ReplaceItem)
 {
     LimitedQueue<int> queue(10);
@@ -273,3 +299,68 @@ TEST(LimitedQueue, FirstN)
     SNAPSHOT_EQUALS(empty.firstN(2), {}, "empty");
     SNAPSHOT_EQUALS(empty.firstN(6), {}, "empty");
 }
+
+TEST(LimitedQueue, SnapshotIsStable)
+{
+    LimitedQueue<int> queue(3);
+    queue.pushBack(1);
+    queue.pushBack(2);
+
+    auto snapshot = queue.getSnapshot();
+    auto last = queue.lastN(1);
+
+    queue.replaceItem(1, 11);
+    queue.replaceItem(std::size_t(1), 12);
+    queue.insertBefore(11, 10);
+    queue.pushBack(3);
+    queue.pushBack(4);
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {12, 3, 4}, "queue");
+    SNAPSHOT_EQUALS(snapshot, {1, 2}, "snapshot after changes");
+    SNAPSHOT_EQUALS(last, {2}, "last after changes");
+
+    // Push enough items to move to new storage a few times
+    for (int i = 5; i < 1000; ++i)
+    {
+        queue.pushBack(i);
+    }
+    queue.pushFront({0});
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {997, 998, 999}, "queue");
+    SNAPSHOT_EQUALS(snapshot, {1, 2}, "snapshot after pushes");
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    SNAPSHOT_EQUALS(snapshot, {1, 2}, "snapshot after clear");
+    EXPECT_EQ(snapshot.front(), 1);
+    EXPECT_EQ(snapshot.back(), 2);
+    EXPECT_EQ(*snapshot.rbegin(), 2);
+}
+
+TEST(LimitedQueue, DroppedItemsAreReleased)
+{
+    LimitedQueue<std::shared_ptr<int>> queue(2);
+    auto push = [&](int value) {
+        auto item = std::make_shared<int>(value);
+        std::weak_ptr<int> weak = item;
+        queue.pushBack(std::move(item));
+        return weak;
+    };
+
+    auto first = push(1);
+    auto second = push(2);
+    // Snapshots that are gone don't keep the items
+    std::ignore = queue.getSnapshot();
+    push(3);
+    EXPECT_TRUE(first.expired());
+
+    // Items a snapshot sees stay alive while it does
+    auto snapshot = queue.getSnapshot();
+    auto fourth = push(4);
+    EXPECT_FALSE(second.expired());
+
+    // The next item that's dropped releases them too
+    snapshot = {};
+    push(5);
+    EXPECT_TRUE(second.expired());
+    EXPECT_FALSE(fourth.expired());
+    EXPECT_EQ(queue.size(), 2U);
+}
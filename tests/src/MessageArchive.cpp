@@ -0,0 +1,225 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "messages/MessageArchive.hpp"
+
+#include "messages/Message.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "Test.hpp"
+
+#include <QString>
+
+using namespace chatterino;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+MessagePtr makeMessage(const QString &id, const QString &login,
+                       const QString &text)
+{
+    MessageBuilder builder;
+    builder->id = id;
+    builder->loginName = login;
+    builder->displayName = login.toUpper();
+    builder->messageText = text;
+    builder->searchText = login + u": "_s + text;
+    builder->channelName = u"pajlada"_s;
+    builder->usernameColor = QColor(255, 0, 0);
+    builder->serverReceivedTime = QDateTime::fromMSecsSinceEpoch(1000);
+    builder->twitchBadges.emplace_back(u"subscriber"_s, u"3012"_s);
+    builder->flags.set(MessageFlag::Highlighted);
+    return builder.release();
+}
+
+bool acceptAll(const Message & /*message*/)
+{
+    return true;
+}
+
+class MessageArchiveTest : public ::testing::Test
+{
+protected:
+    mock::BaseApplication mockApplication;
+};
+
+}  // namespace
+
+TEST_F(MessageArchiveTest, Disabled)
+{
+    MessageArchive archive(0);
+    archive.add(makeMessage(u"1"_s, u"foo"_s, u"hello"_s));
+
+    ASSERT_EQ(archive.size(), 0U);
+    ASSERT_TRUE(archive.find(acceptAll).empty());
+}
+
+TEST_F(MessageArchiveTest, RoundTrip)
+{
+    MessageArchive archive(10000);
+    // fill more than one block
+    for (size_t i = 0; i < MessageArchive::BLOCK_SIZE + 10; i++)
+    {
+        archive.add(makeMessage(QString::number(i), u"foo"_s,
+                                 u"message "_s + QString::number(i)));
+    }
+    ASSERT_EQ(archive.size(), MessageArchive::BLOCK_SIZE + 10);
+
+    // The full block is read back from its compressed data
+    archive.waitForDone();
+    ASSERT_GT(archive.memoryUsage(), 0U);
+
+    auto all = archive.find(acceptAll);
+    ASSERT_EQ(all.size(), MessageArchive::BLOCK_SIZE + 10);
+    for (size_t i = 0; i < all.size(); i++)
+    {
+        ASSERT_EQ(all[i]->id, QString::number(i));
+    }
+
+    const auto &msg = all.back();
+    ASSERT_EQ(msg->loginName, u"foo"_s);
+    ASSERT_EQ(msg->displayName, u"FOO"_s);
+    ASSERT_EQ(msg->messageText,
+              u"message "_s +
+                  QString::number(MessageArchive::BLOCK_SIZE + 9));
+    ASSERT_EQ(msg->channelName, u"pajlada"_s);
+    ASSERT_EQ(msg->usernameColor, QColor(255, 0, 0));
+    ASSERT_EQ(msg->serverReceivedTime, QDateTime::fromMSecsSinceEpoch(1000));
+    ASSERT_EQ(msg->twitchBadges.size(), 1U);
+    ASSERT_EQ(msg->twitchBadges[0].key_, u"subscriber"_s);
+    ASSERT_EQ(msg->twitchBadges[0].value_, u"3012"_s);
+    ASSERT_TRUE(msg->flags.has(MessageFlag::Highlighted));
+    ASSERT_TRUE(msg->flags.has(MessageFlag::DoNotLog));
+    // timestamp, username, text
+    ASSERT_EQ(msg->elements.size(), 3U);
+
+    auto some = archive.find([](const Message &message) {
+        return message.messageText.endsWith(u'7');
+    });
+    ASSERT_EQ(some.size(), 26U);
+}
+
+TEST_F(MessageArchiveTest, Limit)
+{
+    MessageArchive archive(MessageArchive::BLOCK_SIZE * 2);
+    for (size_t i = 0; i < MessageArchive::BLOCK_SIZE * 5; i++)
+    {
+        archive.add(makeMessage(QString::number(i), u"foo"_s, u"hi"_s));
+    }
+
+    ASSERT_LE(archive.size(), MessageArchive::BLOCK_SIZE * 2);
+    archive.waitForDone();
+    ASSERT_GT(archive.memoryUsage(), 0U);
+    auto all = archive.find(acceptAll);
+    ASSERT_EQ(all.size(), archive.size());
+    // the oldest messages are dropped
+    const auto total = MessageArchive::BLOCK_SIZE * 5;
+    ASSERT_EQ(all.back()->id, QString::number(total - 1));
+    ASSERT_EQ(all.front()->id, QString::number(total - all.size()));
+
+    archive.clear();
+    ASSERT_EQ(archive.size(), 0U);
+    ASSERT_EQ(archive.memoryUsage(), 0U);
+}
+
+TEST_F(MessageArchiveTest, FindByUser)
+{
+    MessageArchive archive(10000);
+    for (size_t i = 0; i < MessageArchive::BLOCK_SIZE; i++)
+    {
+        archive.add(makeMessage(QString::number(i), u"foo"_s, u"hi"_s));
+    }
+    archive.add(makeMessage(u"bar-1"_s, u"bar"_s, u"hi"_s));
+
+    size_t visited = 0;
+    auto found = archive.findByUser(u"BAR"_s, [&](const Message &message) {
+        visited++;
+        return message.loginName == u"bar";
+    });
+    ASSERT_EQ(found.size(), 1U);
+    ASSERT_EQ(found[0]->id, u"bar-1"_s);
+    // the full block only has messages from foo
+    ASSERT_EQ(visited, 1U);
+
+    ASSERT_TRUE(archive.findByUser(u"baz"_s, acceptAll).empty());
+}
+
+TEST_F(MessageArchiveTest, UncompressedBlocks)
+{
+    MessageArchive archive(10000);
+    for (size_t i = 0; i < 10; i++)
+    {
+        archive.add(makeMessage(QString::number(i), u"foo"_s, u"hi"_s));
+    }
+
+    // Blocks are only compressed once they're full
+    archive.waitForDone();
+    ASSERT_EQ(archive.memoryUsage(), 0U);
+
+    auto all = archive.find(acceptAll);
+    ASSERT_EQ(all.size(), 10U);
+    ASSERT_EQ(all.front()->id, u"0"_s);
+    // Matches are rebuilt the same way as compressed ones
+    ASSERT_EQ(all.front()->elements.size(), 3U);
+    ASSERT_TRUE(all.front()->flags.has(MessageFlag::DoNotLog));
+}
+
+TEST_F(MessageArchiveTest, FindBefore)
+{
+    MessageArchive archive(MessageArchive::BLOCK_SIZE * 2);
+    const auto total = MessageArchive::BLOCK_SIZE * 3 + 10;
+    for (size_t i = 0; i < total; i++)
+    {
+        archive.add(makeMessage(QString::number(i), u"foo"_s, u"hi"_s));
+    }
+    archive.waitForDone();
+    ASSERT_EQ(archive.endPosition(), total);
+    ASSERT_EQ(archive.beginPosition(), total - archive.size());
+
+    // Pages go back from the newest message, across blocks
+    auto page = archive.findBefore(archive.endPosition(), 20, acceptAll);
+    ASSERT_EQ(page.messages.size(), 20U);
+    ASSERT_EQ(page.start, total - 20);
+    ASSERT_EQ(page.messages.front()->id, QString::number(total - 20));
+    ASSERT_EQ(page.messages.back()->id, QString::number(total - 1));
+
+    page = archive.findBefore(page.start, 20, acceptAll);
+    ASSERT_EQ(page.messages.front()->id, QString::number(total - 40));
+    ASSERT_EQ(page.messages.back()->id, QString::number(total - 21));
+
+    // Only matching messages count towards the page
+    page = archive.findBefore(archive.endPosition(), 3,
+                              [](const Message &message) {
+                                  return message.id.endsWith(u'0');
+                              });
+    ASSERT_EQ(page.messages.size(), 3U);
+    ASSERT_EQ(page.messages.back()->id, u"770"_s);
+    ASSERT_EQ(page.start, 750U);
+
+    // The last page starts at the oldest message
+    page = archive.findBefore(archive.beginPosition() + 5, 20, acceptAll);
+    ASSERT_EQ(page.messages.size(), 5U);
+    ASSERT_EQ(page.start, archive.beginPosition());
+    ASSERT_TRUE(
+        archive.findBefore(archive.beginPosition(), 20, acceptAll)
+            .messages.empty());
+
+    // Positions keep counting after a clear
+    archive.clear();
+    ASSERT_EQ(archive.beginPosition(), total);
+    ASSERT_EQ(archive.endPosition(), total);
+}
+
+TEST_F(MessageArchiveTest, DestroyWhileCompressing)
+{
+    for (int run = 0; run < 10; run++)
+    {
+        MessageArchive archive(MessageArchive::BLOCK_SIZE * 2);
+        for (size_t i = 0; i < MessageArchive::BLOCK_SIZE * 4; i++)
+        {
+            archive.add(makeMessage(QString::number(i), u"foo"_s, u"hi"_s));
+        }
+        // The archive waits for its blocks before it's destroyed
+    }
+}
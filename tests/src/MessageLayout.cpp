@@ -97,3 +97,51 @@ TEST(TextElement, BasicCase)
     EXPECT_EQ(wordStart, 0);
     EXPECT_EQ(wordEnd, 3);
 }
+
+TEST(MessageLayout, SharedContainer)
+{
+    MockApplication mockApplication;
+
+    MessageBuilder builder;
+    builder.append(
+        std::make_unique<TextElement>("abc", MessageElementFlag::Text));
+    MessagePtr message = builder.release();
+
+    MessageColors colors;
+    auto layoutAt = [&](MessageLayout &layout, int width) {
+        layout.layout(
+            {
+                .messageColors = colors,
+                .flags = MessageElementFlag::Text,
+                .width = width,
+                .scale = 1,
+                .imageScale = 1,
+                .selectedChannel = nullptr,
+                .message = *message,
+            },
+            false);
+    };
+    auto point = QPoint(WIDTH / 20, 1);
+
+    MessageLayout first(message);
+    MessageLayout second(message);
+    layoutAt(first, WIDTH);
+    layoutAt(second, WIDTH);
+
+    // Both layouts show the same elements
+    ASSERT_NE(first.getElementAt(point), nullptr);
+    ASSERT_EQ(first.getElementAt(point), second.getElementAt(point));
+    ASSERT_EQ(first.getHeight(), second.getHeight());
+
+    // Deleting the cache of one layout doesn't affect the other one
+    auto height = first.getHeight();
+    first.deleteCache();
+    ASSERT_EQ(first.getHeight(), height);
+    ASSERT_EQ(first.getElementAt(point), nullptr);
+    ASSERT_NE(second.getElementAt(point), nullptr);
+
+    // Other widths get their own container
+    layoutAt(first, WIDTH / 2);
+    ASSERT_NE(first.getElementAt(point), nullptr);
+    ASSERT_NE(first.getElementAt(point), second.getElementAt(point));
+}
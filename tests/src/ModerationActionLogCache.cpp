@@ -0,0 +1,361 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/twitch/ModerationActionLogs.hpp"
+
+#include "Test.hpp"
+
+#include <QString>
+#include <QTimeZone>
+
+#include <utility>
+
+using namespace chatterino;
+using namespace Qt::StringLiterals;
+
+namespace chatterino {
+
+class ModerationActionLogScannerTestAccess
+{
+public:
+    /// Starts `scanner` as if `cache` was just loaded, without fetching
+    static void begin(ModerationActionLogScanner &scanner,
+                      ModerationActionLogCache cache)
+    {
+        scanner.running_ = true;
+        scanner.cache_ = std::move(cache);
+    }
+
+    static void processPage(ModerationActionLogScanner &scanner,
+                            const GqlModerationActionLogPage &page)
+    {
+        scanner.processPage(page);
+    }
+
+    static bool isFetchingOlder(const ModerationActionLogScanner &scanner)
+    {
+        return scanner.phase_ == ModerationActionLogScanner::Phase::Older;
+    }
+
+    static bool isRunning(const ModerationActionLogScanner &scanner)
+    {
+        return scanner.running_;
+    }
+
+    static const QString &cursor(const ModerationActionLogScanner &scanner)
+    {
+        return scanner.cursor_;
+    }
+
+    static const ModerationActionLogCoverage &coverage(
+        const ModerationActionLogScanner &scanner)
+    {
+        return scanner.coverage_;
+    }
+
+    static qsizetype fetchedCount(const ModerationActionLogScanner &scanner)
+    {
+        return scanner.fetched_.size();
+    }
+};
+
+}  // namespace chatterino
+
+namespace {
+
+using TestAccess = ModerationActionLogScannerTestAccess;
+
+constexpr qint64 MINUTE = 60 * 1000;
+constexpr qint64 BASE = 1'700'000'000'000;
+
+GqlModerationActionLogEntry makeAction(const QString &id, qint64 createdAt,
+                                       GqlModerationActionKind kind =
+                                           GqlModerationActionKind::Ban)
+{
+    GqlModerationActionLogEntry action;
+    action.id = id;
+    action.createdAt =
+        QDateTime::fromMSecsSinceEpoch(createdAt, QTimeZone::utc());
+    action.kind = kind;
+    action.moderatorId = u"11148817"_s;
+    action.moderatorLogin = u"pajlada"_s;
+    action.moderatorDisplayName = u"pajlada"_s;
+    return action;
+}
+
+ModerationActionLogCoverage makeCoverage(qint64 newest, qint64 oldest,
+                                         const QString &cursor)
+{
+    return {
+        .newest = newest,
+        .oldest = oldest,
+        .oldestCursor = cursor,
+        .reachedEnd = false,
+    };
+}
+
+/// A cache covering the ten minutes before BASE, with a ban at BASE
+ModerationActionLogCache makeCache()
+{
+    auto data = ModerationActionLogCache::serializeHeader() +
+                ModerationActionLogCache::serializeChunk(
+                    {
+                        makeAction(u"cached-new"_s, BASE),
+                        makeAction(u"cached-old"_s, BASE - 10 * MINUTE),
+                    },
+                    makeCoverage(BASE, BASE - 10 * MINUTE, u"cached"_s));
+    return *ModerationActionLogCache::deserialize(data);
+}
+
+GqlModerationActionLogPage makePage(
+    QVector<GqlModerationActionLogEntry> actions, const QString &nextCursor)
+{
+    return {
+        .actions = std::move(actions),
+        .nextCursor = nextCursor,
+        .hasNextPage = !nextCursor.isEmpty(),
+    };
+}
+
+/// A request that isn't saved to the cache
+ModerationActionLogScanRequest makeRequest()
+{
+    return {
+        .pageDelayMs = 0,
+    };
+}
+
+}  // namespace
+
+TEST(ModerationActionLogCache, Coverage)
+{
+    ModerationActionLogCoverage coverage;
+    ASSERT_TRUE(coverage.isEmpty());
+    ASSERT_FALSE(coverage.contains(BASE));
+
+    coverage.include(BASE);
+    coverage.include(BASE - MINUTE);
+    coverage.include(0);
+    ASSERT_EQ(coverage.newest, BASE);
+    ASSERT_EQ(coverage.oldest, BASE - MINUTE);
+    ASSERT_TRUE(coverage.contains(BASE));
+    ASSERT_TRUE(coverage.contains(BASE - MINUTE));
+    ASSERT_FALSE(coverage.contains(BASE + 1));
+}
+
+TEST(ModerationActionLogCache, RoundTrip)
+{
+    auto coverage = makeCoverage(BASE, BASE - 2 * MINUTE, u"cursor"_s);
+    auto data = ModerationActionLogCache::serializeHeader() +
+                ModerationActionLogCache::serializeChunk(
+                    {
+                        makeAction(u"a"_s, BASE),
+                        makeAction(u"b"_s, BASE - MINUTE,
+                                   GqlModerationActionKind::Timeout),
+                    },
+                    coverage);
+
+    auto cache = ModerationActionLogCache::deserialize(data);
+    ASSERT_TRUE(cache.has_value());
+    ASSERT_EQ(cache->coverage, coverage);
+    ASSERT_EQ(cache->actions.size(), 2);
+    ASSERT_TRUE(cache->ids.contains(u"a"_s));
+    ASSERT_TRUE(cache->ids.contains(u"b"_s));
+    ASSERT_FALSE(cache->compact);
+
+    for (const auto &action : cache->actions)
+    {
+        if (action.id == u"b"_s)
+        {
+            ASSERT_EQ(action.kind, GqlModerationActionKind::Timeout);
+            ASSERT_EQ(action.createdAt.toMSecsSinceEpoch(), BASE - MINUTE);
+            ASSERT_EQ(action.moderatorLogin, u"pajlada"_s);
+        }
+    }
+}
+
+TEST(ModerationActionLogCache, LastCoverageWins)
+{
+    auto data = ModerationActionLogCache::serializeHeader() +
+                ModerationActionLogCache::serializeChunk(
+                    {
+                        makeAction(u"a"_s, BASE),
+                        makeAction(u"b"_s, BASE - MINUTE),
+                    },
+                    makeCoverage(BASE, BASE - MINUTE, u"1"_s));
+    // A newer scan that reached the cache
+    data += ModerationActionLogCache::serializeChunk(
+        {
+            makeAction(u"c"_s, BASE + MINUTE),
+            makeAction(u"a"_s, BASE),
+        },
+        makeCoverage(BASE + MINUTE, BASE - MINUTE, u"1"_s));
+
+    auto cache = ModerationActionLogCache::deserialize(data);
+    ASSERT_TRUE(cache.has_value());
+    ASSERT_EQ(cache->actions.size(), 3);
+    ASSERT_EQ(cache->coverage.newest, BASE + MINUTE);
+
+    // A scan that didn't reach the cache drops everything before it
+    data += ModerationActionLogCache::serializeChunk(
+        {makeAction(u"d"_s, BASE + 10 * MINUTE)},
+        makeCoverage(BASE + 10 * MINUTE, BASE + 9 * MINUTE, u"2"_s));
+
+    cache = ModerationActionLogCache::deserialize(data);
+    ASSERT_TRUE(cache.has_value());
+    ASSERT_EQ(cache->actions.size(), 1);
+    ASSERT_TRUE(cache->ids.contains(u"d"_s));
+    ASSERT_EQ(cache->coverage.oldestCursor, u"2"_s);
+    ASSERT_TRUE(cache->compact);
+}
+
+TEST(ModerationActionLogCache, Invalid)
+{
+    auto chunk = ModerationActionLogCache::serializeChunk(
+        {makeAction(u"a"_s, BASE)}, makeCoverage(BASE, BASE, u"1"_s));
+    auto data = ModerationActionLogCache::serializeHeader() + chunk;
+
+    ASSERT_FALSE(ModerationActionLogCache::deserialize({}).has_value());
+    ASSERT_FALSE(ModerationActionLogCache::deserialize(chunk).has_value());
+
+    // other version
+    auto otherVersion = data;
+    otherVersion[7] = static_cast<char>(ModerationActionLogCache::VERSION + 1);
+    ASSERT_FALSE(
+        ModerationActionLogCache::deserialize(otherVersion).has_value());
+
+    // An interrupted append keeps the chunks before it
+    data += chunk.first(chunk.size() / 2);
+    auto cache = ModerationActionLogCache::deserialize(data);
+    ASSERT_TRUE(cache.has_value());
+    ASSERT_EQ(cache->actions.size(), 1);
+    ASSERT_TRUE(cache->compact);
+}
+
+TEST(ModerationActionLogScanner, NewestUntilCache)
+{
+    ModerationActionLogScanner scanner(makeRequest());
+    TestAccess::begin(scanner, makeCache());
+
+    TestAccess::processPage(scanner,
+                            makePage(
+                                {
+                                    makeAction(u"a"_s, BASE + 3 * MINUTE),
+                                    makeAction(u"b"_s, BASE + 2 * MINUTE),
+                                },
+                                u"page2"_s));
+    ASSERT_FALSE(TestAccess::isFetchingOlder(scanner));
+    ASSERT_TRUE(TestAccess::isRunning(scanner));
+    ASSERT_EQ(TestAccess::cursor(scanner), u"page2"_s);
+    ASSERT_EQ(TestAccess::fetchedCount(scanner), 2);
+
+    // The page reaches the newest cached action, the rest of it is skipped
+    TestAccess::processPage(scanner,
+                            makePage(
+                                {
+                                    makeAction(u"c"_s, BASE + MINUTE),
+                                    makeAction(u"cached-new"_s, BASE),
+                                    makeAction(u"d"_s, BASE - MINUTE),
+                                },
+                                u"page3"_s));
+    ASSERT_TRUE(TestAccess::isFetchingOlder(scanner));
+    ASSERT_TRUE(TestAccess::isRunning(scanner));
+    // Continues after the oldest cached action
+    ASSERT_EQ(TestAccess::cursor(scanner), u"cached"_s);
+    ASSERT_EQ(TestAccess::fetchedCount(scanner), 3);
+
+    const auto &coverage = TestAccess::coverage(scanner);
+    ASSERT_EQ(coverage.newest, BASE + 3 * MINUTE);
+    ASSERT_EQ(coverage.oldest, BASE - 10 * MINUTE);
+    ASSERT_EQ(coverage.oldestCursor, u"cached"_s);
+
+    auto snapshot = scanner.snapshot();
+    ASSERT_EQ(snapshot.pagesRead, 2);
+    ASSERT_EQ(snapshot.totals.bans, 3);
+}
+
+TEST(ModerationActionLogScanner, OlderThanCache)
+{
+    ModerationActionLogScanner scanner(makeRequest());
+    TestAccess::begin(scanner, makeCache());
+
+    TestAccess::processPage(
+        scanner, makePage({makeAction(u"cached-new"_s, BASE)}, u"x"_s));
+    ASSERT_TRUE(TestAccess::isFetchingOlder(scanner));
+
+    // Cached actions in older pages are skipped, not treated as the cache
+    TestAccess::processPage(scanner,
+                            makePage(
+                                {
+                                    makeAction(u"cached-old"_s,
+                                               BASE - 10 * MINUTE),
+                                    makeAction(u"e"_s, BASE - 11 * MINUTE),
+                                },
+                                u"page2"_s));
+    ASSERT_TRUE(TestAccess::isFetchingOlder(scanner));
+    ASSERT_EQ(TestAccess::cursor(scanner), u"page2"_s);
+    ASSERT_EQ(TestAccess::fetchedCount(scanner), 1);
+
+    const auto &coverage = TestAccess::coverage(scanner);
+    ASSERT_EQ(coverage.oldest, BASE - 11 * MINUTE);
+    ASSERT_EQ(coverage.oldestCursor, u"page2"_s);
+    ASSERT_FALSE(coverage.reachedEnd);
+
+    // The last page ends the log
+    TestAccess::processPage(
+        scanner, makePage({makeAction(u"f"_s, BASE - 12 * MINUTE)}, {}));
+    ASSERT_FALSE(TestAccess::isRunning(scanner));
+    ASSERT_TRUE(TestAccess::coverage(scanner).reachedEnd);
+    ASSERT_EQ(TestAccess::coverage(scanner).oldest, BASE - 12 * MINUTE);
+
+    auto snapshot = scanner.snapshot();
+    ASSERT_TRUE(snapshot.complete);
+    ASSERT_FALSE(snapshot.truncated);
+    ASSERT_EQ(snapshot.totals.bans, 2);
+}
+
+TEST(ModerationActionLogScanner, CutoffInsideCache)
+{
+    auto request = makeRequest();
+    request.cutoffUtc = QDateTime::fromMSecsSinceEpoch(BASE - 5 * MINUTE,
+                                                       QTimeZone::utc());
+    ModerationActionLogScanner scanner(request);
+    TestAccess::begin(scanner, makeCache());
+
+    // The cache reaches back to the cutoff, so older pages aren't fetched
+    TestAccess::processPage(scanner,
+                            makePage(
+                                {
+                                    makeAction(u"a"_s, BASE + MINUTE),
+                                    makeAction(u"cached-new"_s, BASE),
+                                },
+                                u"x"_s));
+    ASSERT_FALSE(TestAccess::isRunning(scanner));
+
+    auto snapshot = scanner.snapshot();
+    ASSERT_TRUE(snapshot.complete);
+    ASSERT_TRUE(snapshot.reachedCutoff);
+}
+
+TEST(ModerationActionLogScanner, WithoutCache)
+{
+    ModerationActionLogScanner scanner(makeRequest());
+    TestAccess::begin(scanner, {});
+
+    // Without a cache, every page is one of the newest
+    TestAccess::processPage(scanner,
+                            makePage({makeAction(u"a"_s, BASE)}, u"page2"_s));
+    ASSERT_FALSE(TestAccess::isFetchingOlder(scanner));
+    ASSERT_EQ(TestAccess::cursor(scanner), u"page2"_s);
+
+    TestAccess::processPage(
+        scanner, makePage({makeAction(u"b"_s, BASE - MINUTE)}, {}));
+    ASSERT_FALSE(TestAccess::isFetchingOlder(scanner));
+    ASSERT_FALSE(TestAccess::isRunning(scanner));
+
+    const auto &coverage = TestAccess::coverage(scanner);
+    ASSERT_EQ(coverage.newest, BASE);
+    ASSERT_EQ(coverage.oldest, BASE - MINUTE);
+    ASSERT_TRUE(coverage.reachedEnd);
+}
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "widgets/helper/PaintProfiler.hpp"
+
+#include "Test.hpp"
+
+#include <chrono>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+namespace {
+
+PaintSample frame(std::chrono::nanoseconds elapsed)
+{
+    PaintSample sample;
+    sample.frame = elapsed;
+    sample.emotes = elapsed / 2;
+    sample.buffersBlitted = 10;
+    return sample;
+}
+
+// Only used as keys, never dereferenced
+const auto *const VIEW_A = reinterpret_cast<const ChannelView *>(0x10);
+const auto *const VIEW_B = reinterpret_cast<const ChannelView *>(0x20);
+
+}  // namespace
+
+TEST(PaintProfile, AverageAndWorst)
+{
+    PaintProfile profile;
+    profile.addLayout(1ms);
+    profile.addFrame(frame(2ms));
+    profile.addFrame(frame(4ms));
+
+    ASSERT_EQ(profile.frameCount(), 2U);
+    ASSERT_EQ(profile.average().frame, 3ms);
+    ASSERT_EQ(profile.average().buffersBlitted, 10U);
+    ASSERT_EQ(profile.average().emotes, 1500us);
+    // Layout time is added to the next frame only
+    ASSERT_EQ(profile.average().layout, 500us);
+    ASSERT_EQ(profile.worst().frame, 4ms);
+}
+
+TEST(PaintProfile, KeepsWindow)
+{
+    PaintProfile profile;
+    profile.addFrame(frame(100ms));
+    for (size_t i = 0; i < PaintProfile::WINDOW; i++)
+    {
+        profile.addFrame(frame(1ms));
+    }
+
+    ASSERT_EQ(profile.frameCount(), PaintProfile::WINDOW);
+    ASSERT_EQ(profile.worst().frame, 1ms);
+}
+
+TEST(PaintProfiler, ReportsSlowestViewsFirst)
+{
+    auto &profiler = PaintProfiler::instance();
+    profiler.setEnabled(true);
+
+    profiler.profile(VIEW_A, "fast").addFrame(frame(1ms));
+    profiler.profile(VIEW_B, "slow").addFrame(frame(8ms));
+
+    auto report = profiler.report(5);
+    ASSERT_EQ(report.size(), 2);
+    ASSERT_TRUE(report[0].startsWith("slow: worst frame 8.00 ms")) << report[0];
+    ASSERT_TRUE(report[1].startsWith("fast: worst frame 1.00 ms")) << report[1];
+
+    ASSERT_EQ(profiler.report(1).size(), 1);
+
+    profiler.remove(VIEW_B);
+    ASSERT_EQ(profiler.report(5).size(), 1);
+
+    profiler.setEnabled(false);
+    ASSERT_TRUE(profiler.report(5).empty());
+}
@@ -12,12 +12,14 @@
 #    include "controllers/commands/CommandController.hpp"
 #    include "controllers/plugins/api/ChannelRef.hpp"
 #    include "controllers/plugins/api/WebSocket.hpp"
+#    include "controllers/plugins/MessageStream.hpp"
 #    include "controllers/plugins/Plugin.hpp"
 #    include "controllers/plugins/PluginController.hpp"
 #    include "controllers/plugins/PluginPermission.hpp"
 #    include "controllers/plugins/SolTypes.hpp"  // IWYU pragma: keep
 #    include "lib/Snapshot.hpp"
 #    include "messages/Message.hpp"
+#    include "messages/MessageBuilder.hpp"
 #    include "messages/MessageElement.hpp"
 #    include "mocks/BaseApplication.hpp"
 #    include "mocks/Channel.hpp"
@@ -1063,6 +1065,142 @@ TEST_F(PluginTest, ChannelAddMessage)
     ASSERT_EQ(added[5].first, logged[2]);
 }
 
+TEST_F(PluginTest, MessagesReceived)
+{
+    configure();
+    lua->script(R"lua(
+        _G.batches = 0
+        _G.ids = {}
+        _G.channels = {}
+        _G.frozen = true
+        _G.dropped = nil
+        c2.register_callback(c2.EventType.MessagesReceived, function(batch)
+            _G.batches = _G.batches + 1
+            _G.dropped = batch.dropped
+            for _, entry in ipairs(batch.entries) do
+                table.insert(_G.ids, entry.message.id)
+                table.insert(_G.channels, entry.channel:get_name())
+                _G.frozen = _G.frozen and entry.message.frozen
+            end
+        end)
+    )lua");
+    ASSERT_TRUE(lua::MessageStream::hasSubscribers());
+
+    auto chan = std::make_shared<MockChannel>("mock");
+    EXPECT_CALL(this->app->logging, addMessage).Times(3);
+
+    for (const auto *id : {"1", "2", "3"})
+    {
+        MessageBuilder b;
+        b->id = id;
+        chan->addMessage(b.release(), MessageContext::Original);
+    }
+    {
+        // reposts aren't part of the stream
+        MessageBuilder b;
+        b->id = "4";
+        chan->addMessage(b.release(), MessageContext::Repost);
+    }
+    ASSERT_EQ(app->plugins.messageStream().pending(), 3);
+
+    app->plugins.messageStream().flush();
+    ASSERT_EQ(app->plugins.messageStream().pending(), 0);
+
+    ASSERT_EQ(lua->get<int>("batches"), 1);
+    ASSERT_EQ(lua->get<int>("dropped"), 0);
+    ASSERT_TRUE(lua->get<bool>("frozen"));
+    sol::table ids = (*lua)["ids"];
+    ASSERT_EQ(ids.size(), 3);
+    ASSERT_EQ(ids.get<QString>(1), "1");
+    ASSERT_EQ(ids.get<QString>(2), "2");
+    ASSERT_EQ(ids.get<QString>(3), "3");
+    sol::table channels = (*lua)["channels"];
+    ASSERT_EQ(channels.get<QString>(1), "mock");
+
+    const auto &stats = rawpl->messageStreamStats;
+    ASSERT_EQ(stats.batches, 1);
+    ASSERT_EQ(stats.delivered, 3);
+    ASSERT_EQ(stats.dropped, 0);
+    ASSERT_EQ(stats.budgetExceeded, 0);
+
+    // nothing pending, nothing delivered
+    app->plugins.messageStream().flush();
+    ASSERT_EQ(lua->get<int>("batches"), 1);
+
+    // messages of channels that are gone aren't delivered
+    {
+        auto gone = std::make_shared<MockChannel>("gone");
+        EXPECT_CALL(this->app->logging, addMessage).Times(1);
+        MessageBuilder b;
+        b->id = "5";
+        gone->addMessage(b.release(), MessageContext::Original);
+    }
+    app->plugins.messageStream().flush();
+    ASSERT_EQ(lua->get<int>("batches"), 2);
+    ASSERT_EQ(ids.size(), 3);
+    ASSERT_EQ(stats.batches, 2);
+    ASSERT_EQ(stats.delivered, 3);
+}
+
+TEST_F(PluginTest, MessagesReceivedBackpressure)
+{
+    configure();
+    lua->script(R"lua(
+        _G.received = 0
+        _G.dropped = 0
+        c2.register_callback(c2.EventType.MessagesReceived, function(batch)
+            _G.received = _G.received + #batch.entries
+            _G.dropped = _G.dropped + batch.dropped
+        end)
+    )lua");
+
+    auto chan = std::make_shared<MockChannel>("mock");
+    EXPECT_CALL(this->app->logging, addMessage)
+        .Times(lua::MessageStream::MAX_PENDING + 10);
+    for (size_t i = 0; i < lua::MessageStream::MAX_PENDING + 10; i++)
+    {
+        chan->addMessage(MessageBuilder().release(), MessageContext::Original);
+    }
+    app->plugins.messageStream().flush();
+
+    ASSERT_EQ(lua->get<size_t>("received"), lua::MessageStream::MAX_PENDING);
+    ASSERT_EQ(lua->get<size_t>("dropped"), 10);
+}
+
+TEST_F(PluginTest, MessagesReceivedBudget)
+{
+    configure();
+    lua->script(R"lua(
+        _G.calls = 0
+        c2.register_callback(c2.EventType.MessagesReceived, function(batch)
+            _G.calls = _G.calls + 1
+            while true do end
+        end)
+    )lua");
+
+    auto chan = std::make_shared<MockChannel>("mock");
+    EXPECT_CALL(this->app->logging, addMessage).Times(3);
+
+    chan->addMessage(MessageBuilder().release(), MessageContext::Original);
+    app->plugins.messageStream().flush();
+    ASSERT_EQ(lua->get<int>("calls"), 1);
+    ASSERT_EQ(rawpl->messageStreamStats.budgetExceeded, 1);
+
+    // the plugin ran out of budget, so the next batch is skipped
+    chan->addMessage(MessageBuilder().release(), MessageContext::Original);
+    app->plugins.messageStream().flush();
+    ASSERT_EQ(lua->get<int>("calls"), 1);
+    ASSERT_EQ(rawpl->messageStreamStats.dropped, 1);
+
+    chan->addMessage(MessageBuilder().release(), MessageContext::Original);
+    app->plugins.messageStream().flush();
+    ASSERT_EQ(lua->get<int>("calls"), 2);
+    ASSERT_EQ(rawpl->messageStreamStats.budgetExceeded, 2);
+
+    // the hook is removed after the callback returns
+    ASSERT_EQ(lua_gethook(lua->lua_state()), nullptr);
+}
+
 TEST_F(PluginTest, MessageFrozenFlag)
 {
     configure();
@@ -0,0 +1,255 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/repetitions/RepeatedMessageDetector.hpp"
+
+#include "mocks/BaseApplication.hpp"
+#include "singletons/Settings.hpp"
+#include "Test.hpp"
+
+#include <QHash>
+#include <QString>
+
+#include <cmath>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace chatterino;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+constexpr qint64 START = 1'700'000'000'000;
+constexpr qint64 SECOND = 1000;
+constexpr qint64 MINUTE = 60 * SECOND;
+/// Matches MAX_USERS_PER_CHANNEL
+constexpr int USERS_PER_CHANNEL = 2048;
+
+qint64 fakeNow = START;
+
+qint64 fakeClock()
+{
+    return fakeNow;
+}
+
+/// The scorer the detector used before it kept sketches: the Sørensen–Dice
+/// coefficient of the bigram multisets of two normalized messages
+double referenceScore(const QString &first, const QString &second)
+{
+    if (first == second)
+    {
+        return 1.0;
+    }
+    if (first.size() < 2 || second.size() < 2)
+    {
+        return 0.0;
+    }
+
+    QHash<quint32, int> firstBigrams;
+    for (qsizetype i = 0; i < first.size() - 1; ++i)
+    {
+        const auto key = (static_cast<quint32>(first.at(i).unicode()) << 16U) |
+                         static_cast<quint32>(first.at(i + 1).unicode());
+        firstBigrams[key] = firstBigrams.value(key) + 1;
+    }
+
+    int intersectionSize = 0;
+    for (qsizetype i = 0; i < second.size() - 1; ++i)
+    {
+        const auto key = (static_cast<quint32>(second.at(i).unicode()) << 16U) |
+                         static_cast<quint32>(second.at(i + 1).unicode());
+        auto count = firstBigrams.value(key);
+        if (count > 0)
+        {
+            firstBigrams[key] = count - 1;
+            intersectionSize++;
+        }
+    }
+
+    return (2.0 * intersectionSize) /
+           static_cast<double>(first.size() + second.size() - 2);
+}
+
+class RepeatedMessageDetectorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        fakeNow = START;
+    }
+
+    std::optional<int> send(const QString &user, const QString &message,
+                            const QString &channel = u"11148817"_s)
+    {
+        return this->sendWithID(user, message,
+                                QString::number(this->nextMessageID++),
+                                channel);
+    }
+
+    std::optional<int> sendWithID(const QString &user, const QString &message,
+                                  const QString &messageID,
+                                  const QString &channel = u"11148817"_s)
+    {
+        return this->detector.check({
+            .channelID = channel,
+            .userID = user,
+            .messageID = messageID,
+            .message = message,
+            .channelCanModerate = true,
+        });
+    }
+
+    mock::BaseApplication mockApplication;
+    RepeatedMessageDetector detector{&fakeClock};
+    int nextMessageID = 0;
+};
+
+}  // namespace
+
+TEST_F(RepeatedMessageDetectorTest, ExactRepeats)
+{
+    ASSERT_FALSE(this->send(u"1"_s, u"Hello  World"_s).has_value());
+    // Case, whitespace and bypass characters are ignored
+    ASSERT_EQ(this->send(u"1"_s, u"hello world"_s), 2);
+    ASSERT_EQ(this->send(u"1"_s, u" HELLO\u034F WORLD"_s), 3);
+
+    // Other users have their own count
+    ASSERT_FALSE(this->send(u"2"_s, u"hello world"_s).has_value());
+    ASSERT_EQ(this->detector.trackedUsers(), 2U);
+
+    // Only exact repeats count at the highest sensitivity
+    getSettings()->repeatedMessagesSensitivity.setValue(4);
+    ASSERT_FALSE(this->send(u"1"_s, u"hello world!"_s).has_value());
+    ASSERT_EQ(this->send(u"2"_s, u"hello world"_s), 2);
+}
+
+TEST_F(RepeatedMessageDetectorTest, FuzzyMatchesReferenceScore)
+{
+    // The detector only estimates the score. Pairs closer to the threshold
+    // than this (about four standard errors) can go either way.
+    constexpr double margin = 0.12;
+
+    const QString base = u"the quick brown fox jumps over the lazy dog"_s;
+    const std::vector<std::pair<QString, QString>> pairs{
+        {u"hello world"_s, u"hello world"_s},                       // 1.00
+        {base, u"the quick brown fox jumps over the lazy dog!"_s},   // 0.99
+        {base, u"the quick brown fox jumped over the lazy dog"_s},   // 0.94
+        {base, u"a quick brown fox jumps over the lazy cat"_s},      // 0.88
+        {base, u"the slow brown fox jumps over the lazy dog"_s},     // 0.87
+        {base, u"the quick brown fox leaps over the sleepy dog"_s},  // 0.81
+        {base, u"the quick brown fox jumps over"_s},                 // 0.82
+        {base, u"the fast brown fox hops over the lazy dog"_s},      // 0.78
+        {base, u"the quick brown fox jumps"_s},                      // 0.73
+        {base, u"quick brown fox jumps"_s},                          // 0.65
+        {base, u"the quick brown fox"_s},                            // 0.60
+        {base, u"a quick brown fox"_s},                              // 0.52
+        {base, u"the quick brown"_s},                                // 0.50
+        {base, u"hello world"_s},                                    // 0.04
+        // Repeated bigrams are only shared as often as both have them
+        {u"lol lol lol lol"_s, u"lol lol lol lol lol lol"_s},  // 0.78
+        {u"aaaaaaaaaa"_s, u"aaaaa"_s},                         // 0.62
+        {u"aaaaaaaaaa"_s, u"aaaaaaaaa"_s},                     // 0.94
+        {u"hahahahaha"_s, u"hahahaha"_s},                      // 0.88
+        {u"omegalul omegalul"_s, u"omegalul"_s},               // 0.61
+    };
+
+    int user = 0;
+    for (int sensitivity = 0; sensitivity <= 3; sensitivity++)
+    {
+        getSettings()->repeatedMessagesSensitivity.setValue(sensitivity);
+        const auto threshold =
+            static_cast<double>(60 + 10 * sensitivity) / 100.0;
+
+        int matched = 0;
+        int checked = 0;
+        for (const auto &[first, second] : pairs)
+        {
+            const auto userID = QString::number(user++);
+            ASSERT_FALSE(this->send(userID, first).has_value());
+
+            const auto score = referenceScore(first, second);
+            const auto result = this->send(userID, second).has_value();
+            // Identical messages are matched by their fingerprint
+            if (score < 1.0 && std::abs(score - threshold) < margin)
+            {
+                continue;
+            }
+
+            const bool expected = score >= threshold;
+            EXPECT_EQ(result, expected)
+                << first.toStdString() << " / " << second.toStdString()
+                << " at " << threshold;
+            matched += expected ? 1 : 0;
+            checked++;
+        }
+
+        // Every threshold has pairs on both sides
+        ASSERT_GT(matched, 0);
+        ASSERT_LT(matched, checked);
+    }
+}
+
+TEST_F(RepeatedMessageDetectorTest, DuplicateMessageIDs)
+{
+    ASSERT_FALSE(
+        this->sendWithID(u"1"_s, u"hello world"_s, u"a"_s).has_value());
+    // The same message delivered twice isn't a repeat
+    ASSERT_FALSE(
+        this->sendWithID(u"1"_s, u"hello world"_s, u"a"_s).has_value());
+    ASSERT_EQ(this->sendWithID(u"1"_s, u"hello world"_s, u"b"_s), 2);
+    ASSERT_FALSE(
+        this->sendWithID(u"1"_s, u"hello world"_s, u"b"_s).has_value());
+    ASSERT_EQ(this->sendWithID(u"1"_s, u"hello world"_s, u"c"_s), 3);
+
+    // IDs are remembered per user
+    ASSERT_FALSE(
+        this->sendWithID(u"2"_s, u"hello world"_s, u"a"_s).has_value());
+    ASSERT_EQ(this->sendWithID(u"2"_s, u"hello world"_s, u"d"_s), 2);
+}
+
+TEST_F(RepeatedMessageDetectorTest, Expiry)
+{
+    ASSERT_FALSE(this->send(u"1"_s, u"hello world"_s).has_value());
+
+    // Repeats within five minutes count and keep the user around
+    fakeNow += 4 * MINUTE;
+    ASSERT_EQ(this->send(u"1"_s, u"hello world"_s), 2);
+
+    // Five minutes after the last message, the user is forgotten
+    fakeNow += 5 * MINUTE + 10 * SECOND;
+    ASSERT_FALSE(this->send(u"2"_s, u"something else"_s).has_value());
+    ASSERT_EQ(this->detector.trackedUsers(), 1U);
+
+    ASSERT_FALSE(this->send(u"1"_s, u"hello world"_s).has_value());
+    ASSERT_EQ(this->detector.trackedUsers(), 2U);
+}
+
+TEST_F(RepeatedMessageDetectorTest, SlabEviction)
+{
+    ASSERT_FALSE(this->send(u"first"_s, u"hello world"_s).has_value());
+
+    fakeNow += 10 * SECOND;
+    for (int i = 0; i < USERS_PER_CHANNEL; i++)
+    {
+        ASSERT_FALSE(
+            this->send(QString::number(i), u"spam %1"_s.arg(i)).has_value());
+    }
+    // The user that was seen least recently made room for the last one
+    ASSERT_EQ(this->detector.trackedUsers(),
+              static_cast<size_t>(USERS_PER_CHANNEL));
+    ASSERT_FALSE(this->send(u"first"_s, u"hello world"_s).has_value());
+    ASSERT_EQ(this->detector.trackedUsers(),
+              static_cast<size_t>(USERS_PER_CHANNEL));
+
+    // The most recent users are still tracked
+    const auto last = USERS_PER_CHANNEL - 1;
+    ASSERT_EQ(this->send(QString::number(last), u"spam %1"_s.arg(last)), 2);
+
+    // Other channels have their own slab
+    ASSERT_FALSE(
+        this->send(u"first"_s, u"hello world"_s, u"22484632"_s).has_value());
+    ASSERT_EQ(this->detector.trackedUsers(),
+              static_cast<size_t>(USERS_PER_CHANNEL) + 1);
+}
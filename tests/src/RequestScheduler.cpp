@@ -0,0 +1,247 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "common/network/RequestScheduler.hpp"
+
+#include "common/network/NetworkRequest.hpp"
+#include "common/network/NetworkResult.hpp"
+#include "NetworkHelpers.hpp"
+#include "providers/twitch/api/Helix.hpp"
+#include "Test.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+/// Options without refilling during a test
+RequestScheduler::Options staticOptions(int bucketSize, int maxInFlight)
+{
+    return {
+        .bucketSize = bucketSize,
+        .refillPeriod = std::chrono::hours(24),
+        .maxInFlight = maxInFlight,
+    };
+}
+
+NetworkResult response(int status, NetworkResult::Headers headers = {})
+{
+    return {
+        status == 200 ? NetworkResult::NetworkError::NoError
+                      : NetworkResult::NetworkError::UnknownContentError,
+        status,
+        {},
+        std::move(headers),
+    };
+}
+
+void processEventsFor(std::chrono::milliseconds duration)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < duration.count())
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+}
+
+QString getHttpbinUrl(QStringView path)
+{
+    return QString("%1/%2").arg(HTTPBIN_BASE_URL, path);
+}
+
+}  // namespace
+
+TEST(RequestScheduler, StartsHighestPriorityFirst)
+{
+    RequestScheduler scheduler(staticOptions(100, 1));
+    std::vector<char> started;
+    auto record = [&](char c) {
+        return [&started, c] {
+            started.push_back(c);
+        };
+    };
+
+    scheduler.schedule(RequestPriority::Background, record('a'));
+    scheduler.schedule(RequestPriority::Background, record('b'));
+    scheduler.schedule(RequestPriority::Visible, record('c'));
+    scheduler.schedule(RequestPriority::Interactive, record('d'));
+    ASSERT_EQ(started, std::vector<char>{'a'});
+    ASSERT_EQ(scheduler.queued(), 3U);
+
+    scheduler.finished(response(200));
+    scheduler.finished(response(200));
+    scheduler.finished(response(200));
+    ASSERT_EQ(started, (std::vector<char>{'a', 'd', 'c', 'b'}));
+    ASSERT_EQ(scheduler.queued(), 0U);
+    ASSERT_EQ(scheduler.inFlight(), 1);
+}
+
+TEST(RequestScheduler, ReservesTokensForInteractive)
+{
+    auto options = staticOptions(10, 100);
+    options.backgroundReserve = 0.5;
+    RequestScheduler scheduler(options);
+
+    int background = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        scheduler.schedule(RequestPriority::Background, [&] {
+            background++;
+        });
+    }
+    // Background requests leave half of the bucket
+    ASSERT_EQ(background, 5);
+
+    int interactive = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        scheduler.schedule(RequestPriority::Interactive, [&] {
+            interactive++;
+        });
+    }
+    ASSERT_EQ(interactive, 5);
+    ASSERT_EQ(scheduler.queued(), 10U);
+}
+
+TEST(RequestScheduler, FollowsRemainingHeader)
+{
+    RequestScheduler scheduler(staticOptions(800, 16));
+
+    int started = 0;
+    scheduler.schedule(RequestPriority::Interactive, [&] {
+        started++;
+    });
+    ASSERT_EQ(started, 1);
+
+    scheduler.finished(response(200, {
+                                         {"Ratelimit-Limit", "800"},
+                                         {"ratelimit-remaining", "0"},
+                                     }));
+    ASSERT_LT(scheduler.available(), 1);
+
+    scheduler.schedule(RequestPriority::Interactive, [&] {
+        started++;
+    });
+    ASSERT_EQ(started, 1);
+    ASSERT_EQ(scheduler.queued(), 1U);
+}
+
+TEST(RequestScheduler, PausesAfterTooManyRequests)
+{
+    RequestScheduler scheduler(staticOptions(800, 16));
+
+    int started = 0;
+    scheduler.schedule(RequestPriority::Interactive, [&] {
+        started++;
+    });
+    ASSERT_EQ(started, 1);
+
+    auto reset = QByteArray::number(QDateTime::currentSecsSinceEpoch());
+    scheduler.finished(response(429, {{"Ratelimit-Reset", reset}}));
+
+    // There are no tokens left, even for interactive requests
+    scheduler.schedule(RequestPriority::Interactive, [&] {
+        started++;
+    });
+    ASSERT_EQ(started, 1);
+
+    // Requests resume after the pause once there are tokens again
+    auto options = staticOptions(800, 16);
+    options.refillPeriod = 800ms;
+    RequestScheduler refilling(options);
+    refilling.schedule(RequestPriority::Interactive, [] {});
+    refilling.finished(response(429, {{"Ratelimit-Reset", reset}}));
+
+    int refilled = 0;
+    refilling.schedule(RequestPriority::Interactive, [&] {
+        refilled++;
+    });
+    ASSERT_EQ(refilled, 0);
+
+    processEventsFor(500ms);
+    ASSERT_EQ(refilled, 1);
+}
+
+TEST(RequestScheduler, ReadsHeadersFromResponses)
+{
+    auto scheduler = std::make_shared<RequestScheduler>(staticOptions(800, 16));
+    RequestWaiter waiter;
+
+    NetworkRequest(getHttpbinUrl(u"response-headers?Ratelimit-Limit=800&"
+                                 u"Ratelimit-Remaining=3"))
+        .scheduler(scheduler, RequestPriority::Visible)
+        .onSuccess([&](const NetworkResult &result) {
+            EXPECT_EQ(result.header("ratelimit-remaining"), "3");
+            waiter.requestDone();
+        })
+        .onError([&](const NetworkResult & /*result*/) {
+            EXPECT_TRUE(false);
+            waiter.requestDone();
+        })
+        .execute();
+
+    waiter.waitForRequest();
+
+    ASSERT_EQ(scheduler->inFlight(), 0);
+    ASSERT_NEAR(scheduler->available(), 3, 0.5);
+}
+
+TEST(RequestScheduler, RetriesTooManyRequests)
+{
+    auto scheduler = std::make_shared<RequestScheduler>(staticOptions(800, 16));
+    RequestWaiter waiter;
+    int errors = 0;
+
+    NetworkRequest(getHttpbinUrl(u"status/429"))
+        .scheduler(scheduler, RequestPriority::Interactive)
+        .onSuccess([&](const NetworkResult & /*result*/) {
+            EXPECT_TRUE(false);
+            waiter.requestDone();
+        })
+        .onError([&](const NetworkResult &result) {
+            EXPECT_EQ(result.status(), 429);
+            errors++;
+            waiter.requestDone();
+        })
+        .execute();
+
+    waiter.waitForRequest();
+
+    // The error is only reported after the retries
+    ASSERT_EQ(errors, 1);
+    ASSERT_EQ(scheduler->inFlight(), 0);
+    ASSERT_EQ(scheduler->queued(), 0U);
+}
+
+TEST(RequestScheduler, KeysByUserNotToken)
+{
+    const auto before = RequestScheduler::keyedCount();
+
+    Helix helix;
+    helix.update(u"client"_s, u"KeysByUserNotToken-1"_s, u"token-1"_s);
+    ASSERT_EQ(RequestScheduler::keyedCount(), before + 1);
+
+    // Refreshed tokens keep the scheduler of the user
+    for (int i = 2; i < 10; i++)
+    {
+        helix.update(u"client"_s, u"KeysByUserNotToken-1"_s,
+                     u"token-%1"_s.arg(i));
+    }
+    ASSERT_EQ(RequestScheduler::keyedCount(), before + 1);
+
+    helix.update(u"client"_s, u"KeysByUserNotToken-2"_s, u"token-1"_s);
+    ASSERT_EQ(RequestScheduler::keyedCount(), before + 2);
+
+    // Switching back reuses the first one
+    helix.update(u"client"_s, u"KeysByUserNotToken-1"_s, u"token-10"_s);
+    ASSERT_EQ(RequestScheduler::keyedCount(), before + 2);
+}
@@ -0,0 +1,773 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "controllers/accounts/AccountController.hpp"
+#include "controllers/highlights/HighlightController.hpp"
+#include "controllers/sound/NullBackend.hpp"
+#include "ImageTestAccess.hpp"
+#include "messages/Image.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "mocks/ChatterinoBadges.hpp"
+#include "mocks/EmoteController.hpp"
+#include "mocks/LinkResolver.hpp"
+#include "mocks/Logging.hpp"
+#include "mocks/TwitchIrcServer.hpp"
+#include "mocks/UserData.hpp"
+#include "providers/bttv/BttvBadges.hpp"
+#include "providers/bttv/BttvEmotes.hpp"
+#include "providers/ffz/FfzBadges.hpp"
+#include "providers/ffz/FfzEmotes.hpp"
+#include "providers/repetitions/RepeatedMessageDetector.hpp"
+#include "providers/seventv/SeventvBadges.hpp"
+#include "providers/seventv/SeventvEmotes.hpp"
+#include "providers/seventv/SeventvPersonalEmotes.hpp"
+#include "providers/twitch/IrcMessageHandler.hpp"
+#include "providers/twitch/TwitchBadges.hpp"
+#include "providers/twitch/TwitchChannel.hpp"
+#include "providers/UserMetadataStore.hpp"
+#include "Test.hpp"
+#include "TwitchChannelTestAccess.hpp"
+#include "util/DebugCount.hpp"
+#include "util/QMagicEnum.hpp"
+
+#include <IrcMessage>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+#    include <unistd.h>
+#endif
+
+using namespace chatterino;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+/// Simulated time in milliseconds since the epoch. The soak advances it
+/// instead of waiting, so hours of chat run in seconds.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+qint64 simulatedTime = 0;
+
+qint64 simulatedClock()
+{
+    return simulatedTime;
+}
+
+/// 2026-01-01T00:00:00Z
+constexpr qint64 START_TIME = 1767225600000;
+constexpr qint64 SECOND_MS = 1000;
+constexpr qint64 MINUTE_MS = 60 * SECOND_MS;
+constexpr qint64 HOUR_MS = 60 * MINUTE_MS;
+
+/// The user metadata store's clock runs this much faster than the chat, so
+/// its week long TTLs pass in 42 minutes and users expire during the run
+constexpr qint64 METADATA_TIME_SCALE = 240;
+
+qint64 metadataClock()
+{
+    return START_TIME + (simulatedTime - START_TIME) * METADATA_TIME_SCALE;
+}
+
+/// Every channel receives one message per tick
+constexpr qint64 TICK_MS = 2 * SECOND_MS;
+constexpr qint64 SAMPLE_INTERVAL_MS = 5 * MINUTE_MS;
+
+constexpr int DEFAULT_HOURS = 3;
+constexpr int DEFAULT_CHANNELS = 6;
+
+/// Small buffers, so they're full long before the warm-up is over
+const QByteArray SETTINGS{R"({
+    "misc": {
+        "scrollback": {
+            "splitLimit": 500,
+            "archiveLimit": 512
+        }
+    },
+    "moltorino": {
+        "moderation": {
+            "repeatedMessages": {
+                "onlyModChannels": false
+            }
+        }
+    }
+})"_ba};
+
+/// Counters that only ever go up, they count events rather than objects
+constexpr std::array CUMULATIVE_COUNTERS = {
+    DebugObject::HTTPRequestStarted, DebugObject::HTTPRequestSuccess,
+    DebugObject::GqlOperation,       DebugObject::GqlRoundTrip,
+    DebugObject::BytesImageLoaded,   DebugObject::BytesImageUnloaded,
+};
+
+const std::array<QString, 10> PHRASES = {
+    u"Kappa"_s,
+    u"LUL"_s,
+    u"PogChamp PogChamp PogChamp"_s,
+    u"what did I just watch"_s,
+    u"@everyone look at this"_s,
+    u"that was a clean play ngl"_s,
+    u"first time here, hi chat"_s,
+    u"is this the new update?"_s,
+    u"https://chatterino.com/ check this out"_s,
+    u"monkaS monkaS"_s,
+};
+
+class MockApplication : public mock::BaseApplication
+{
+public:
+    MockApplication()
+        : mock::BaseApplication(QString::fromUtf8(SETTINGS))
+        , highlights(this->settings, &this->accounts)
+        , repeatedMessages(&simulatedClock)
+        , userMetadata(&metadataClock)
+    {
+    }
+
+    EmoteController *getEmotes() override
+    {
+        return &this->emotes;
+    }
+
+    IUserDataController *getUserData() override
+    {
+        return &this->userData;
+    }
+
+    AccountController *getAccounts() override
+    {
+        return &this->accounts;
+    }
+
+    ITwitchIrcServer *getTwitch() override
+    {
+        return &this->twitch;
+    }
+
+    IChatterinoBadges *getChatterinoBadges() override
+    {
+        return &this->chatterinoBadges;
+    }
+
+    FfzBadges *getFfzBadges() override
+    {
+        return &this->ffzBadges;
+    }
+
+    BttvBadges *getBttvBadges() override
+    {
+        return &this->bttvBadges;
+    }
+
+    SeventvBadges *getSeventvBadges() override
+    {
+        return &this->seventvBadges;
+    }
+
+    HighlightController *getHighlights() override
+    {
+        return &this->highlights;
+    }
+
+    SeventvPersonalEmotes *getSeventvPersonalEmotes() override
+    {
+        return &this->personalEmotes;
+    }
+
+    BttvEmotes *getBttvEmotes() override
+    {
+        return &this->bttvEmotes;
+    }
+
+    FfzEmotes *getFfzEmotes() override
+    {
+        return &this->ffzEmotes;
+    }
+
+    SeventvEmotes *getSeventvEmotes() override
+    {
+        return &this->seventvEmotes;
+    }
+
+    ILogging *getChatLogger() override
+    {
+        return &this->logging;
+    }
+
+    TwitchBadges *getTwitchBadges() override
+    {
+        return &this->twitchBadges;
+    }
+
+    ILinkResolver *getLinkResolver() override
+    {
+        return &this->linkResolver;
+    }
+
+    ISoundController *getSound() override
+    {
+        return &this->sound;
+    }
+
+    RepeatedMessageDetector *getRepeatedMessageDetector() override
+    {
+        return &this->repeatedMessages;
+    }
+
+    UserMetadataStore *getUserMetadata() override
+    {
+        return &this->userMetadata;
+    }
+
+    mock::EmptyLogging logging;
+    AccountController accounts;
+    mock::EmoteController emotes;
+    mock::UserDataController userData;
+    mock::MockTwitchIrcServer twitch;
+    mock::ChatterinoBadges chatterinoBadges;
+    FfzBadges ffzBadges;
+    BttvBadges bttvBadges;
+    SeventvBadges seventvBadges;
+    HighlightController highlights;
+    SeventvPersonalEmotes personalEmotes;
+    BttvEmotes bttvEmotes;
+    FfzEmotes ffzEmotes;
+    SeventvEmotes seventvEmotes;
+    TwitchBadges twitchBadges;
+    mock::EmptyLinkResolver linkResolver;
+    NullBackend sound;
+    RepeatedMessageDetector repeatedMessages;
+    UserMetadataStore userMetadata;
+};
+
+/// Resident set size of this process in bytes, 0 if it's unknown
+int64_t residentSetSize()
+{
+#ifdef Q_OS_LINUX
+    QFile statm(u"/proc/self/statm"_s);
+    if (!statm.open(QFile::ReadOnly))
+    {
+        return 0;
+    }
+    auto fields = statm.readAll().split(' ');
+    if (fields.size() < 2)
+    {
+        return 0;
+    }
+    return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+QString escapeTag(const QString &value)
+{
+    auto escaped = value;
+    escaped.replace(u'\\', u"\\\\"_s);
+    escaped.replace(u';', u"\\:"_s);
+    escaped.replace(u' ', u"\\s"_s);
+    return escaped;
+}
+
+struct User {
+    QString id;
+    QString login;
+    QString lastMessage;
+};
+
+struct RecentMessage {
+    QString id;
+    QString login;
+    QString text;
+    /// The message that started the reply thread, its own ID if it's no reply
+    QString rootID;
+};
+
+/// Generates the chat of one channel.
+///
+/// New users keep joining the chat, so per-user state is never reused
+/// forever. Some users repeat themselves, some reply to recent messages and
+/// some subscribe.
+class ChatGenerator
+{
+public:
+    /// Users that keep chatting, the others only send one message
+    static constexpr size_t ACTIVE_USERS = 200;
+
+    ChatGenerator(QString channel, QString roomID, uint32_t seed)
+        : channel_(std::move(channel))
+        , roomID_(std::move(roomID))
+        , random_(seed)
+    {
+    }
+
+    QByteArray next()
+    {
+        auto &user = this->pickUser();
+        auto id = u"%1-%2"_s.arg(this->roomID_).arg(this->nextMessage_++);
+        auto kind = this->roll();
+
+        if (kind < 1)
+        {
+            return this->subscription(user, id);
+        }
+
+        QString text;
+        if (kind < 20 && !user.lastMessage.isEmpty())
+        {
+            text = user.lastMessage;
+        }
+        else
+        {
+            text = PHRASES[this->random_() % PHRASES.size()];
+        }
+        user.lastMessage = text;
+
+        QString replyTags;
+        QString rootID = id;
+        if (kind >= 90 && !this->recent_.empty())
+        {
+            const auto &parent =
+                this->recent_[this->random_() % this->recent_.size()];
+            replyTags = u"reply-parent-display-name=%1;"
+                        u"reply-parent-msg-body=%2;reply-parent-msg-id=%3;"
+                        u"reply-parent-user-login=%1;"
+                        u"reply-thread-parent-msg-id=%4;"_s.arg(
+                            parent.login, escapeTag(parent.text), parent.id,
+                            parent.rootID);
+            text = u"@"_s + parent.login + u" "_s + text;
+            rootID = parent.rootID;
+        }
+
+        this->remember({
+            .id = id,
+            .login = user.login,
+            .text = text,
+            .rootID = rootID,
+        });
+
+        return (u"@badge-info=;badges=;color=#1E90FF;display-name=%1;"
+                u"emotes=;first-msg=0;flags=;id=%2;mod=0;%3"
+                u"returning-chatter=0;room-id=%4;subscriber=0;"
+                u"tmi-sent-ts=%5;turbo=0;user-id=%6;user-type= "
+                u":%1!%1@%1.tmi.twitch.tv PRIVMSG #%7 :%8"_s)
+            .arg(user.login, id, replyTags, this->roomID_,
+                 QString::number(simulatedTime), user.id, this->channel_,
+                 text)
+            .toUtf8();
+    }
+
+    /// The number of users that joined the chat so far
+    uint64_t usersJoined() const
+    {
+        return this->nextUser_;
+    }
+
+private:
+    static constexpr size_t RECENT_MESSAGES = 50;
+
+    /// A number in [0, 100)
+    uint32_t roll()
+    {
+        return static_cast<uint32_t>(this->random_() % 100);
+    }
+
+    User &pickUser()
+    {
+        // A third of the messages come from new users
+        if (this->users_.size() < ACTIVE_USERS || this->roll() < 33)
+        {
+            auto n = this->nextUser_++;
+            User user{
+                .id = this->roomID_ + QString::number(n),
+                .login = u"%1_chatter%2"_s.arg(this->channel_).arg(n),
+                .lastMessage = {},
+            };
+            if (this->users_.size() < ACTIVE_USERS)
+            {
+                this->users_.push_back(std::move(user));
+                return this->users_.back();
+            }
+            auto &slot = this->users_[this->random_() % ACTIVE_USERS];
+            slot = std::move(user);
+            return slot;
+        }
+        return this->users_[this->random_() % this->users_.size()];
+    }
+
+    void remember(RecentMessage message)
+    {
+        if (this->recent_.size() < RECENT_MESSAGES)
+        {
+            this->recent_.push_back(std::move(message));
+            return;
+        }
+        this->recent_[this->nextRecent_] = std::move(message);
+        this->nextRecent_ = (this->nextRecent_ + 1) % RECENT_MESSAGES;
+    }
+
+    QByteArray subscription(const User &user, const QString &id) const
+    {
+        return (u"@badge-info=subscriber/1;badges=subscriber/0;color=;"
+                u"display-name=%1;emotes=;flags=;id=%2;login=%1;mod=0;"
+                u"msg-id=sub;msg-param-cumulative-months=1;"
+                u"msg-param-sub-plan=1000;room-id=%3;subscriber=1;"
+                u"system-msg=%1\\ssubscribed\\sat\\sTier\\s1.;"
+                u"tmi-sent-ts=%4;user-id=%5;user-type= "
+                u":tmi.twitch.tv USERNOTICE #%6"_s)
+            .arg(user.login, id, this->roomID_,
+                 QString::number(simulatedTime), user.id, this->channel_)
+            .toUtf8();
+    }
+
+    QString channel_;
+    QString roomID_;
+    std::mt19937 random_;
+
+    std::vector<User> users_;
+    uint64_t nextUser_ = 0;
+    uint64_t nextMessage_ = 0;
+
+    std::vector<RecentMessage> recent_;
+    size_t nextRecent_ = 0;
+};
+
+/// Emote images that the chat uses, with the simulated time they were last
+/// painted at.
+///
+/// Half of the uses pick one of a few popular emotes, the other half one of
+/// many rarely used ones. Without expiration, more and more of them would
+/// keep their frames loaded.
+class EmoteImages
+{
+public:
+    EmoteImages()
+    {
+        this->emotes_.reserve(POPULAR_EMOTES + RARE_EMOTES);
+        for (size_t i = 0; i < POPULAR_EMOTES + RARE_EMOTES; i++)
+        {
+            this->emotes_.push_back({
+                .image = ImageTestAccess::make(
+                    u"https://cdn.example.com/emote/%1"_s.arg(i)),
+                .lastUsed = 0,
+            });
+        }
+    }
+
+    /// Paints an emote at the current simulated time, loading it if its
+    /// frames expired
+    void use()
+    {
+        auto index = this->random_() % 2 == 0
+                         ? this->random_() % POPULAR_EMOTES
+                         : POPULAR_EMOTES + this->random_() % RARE_EMOTES;
+        auto &emote = this->emotes_[index];
+        if (!ImageTestAccess::hasFrames(*emote.image))
+        {
+            ImageTestAccess::setPixmap(*emote.image, {4, 4});
+            ImageExpirationPool::instance().addImagePtr(emote.image);
+        }
+        emote.lastUsed = simulatedTime;
+    }
+
+    /// Runs the image expiration pool as if the simulated time passed since
+    /// the emotes were used
+    void expire()
+    {
+        auto now = std::chrono::steady_clock::now();
+        for (const auto &emote : this->emotes_)
+        {
+            if (ImageTestAccess::hasFrames(*emote.image))
+            {
+                ImageTestAccess::setLastUsed(
+                    *emote.image,
+                    now - std::chrono::milliseconds(simulatedTime -
+                                                    emote.lastUsed));
+            }
+        }
+        ImageExpirationPool::instance().freeOld();
+    }
+
+private:
+    static constexpr size_t POPULAR_EMOTES = 20;
+    static constexpr size_t RARE_EMOTES = 20'000;
+
+    struct Emote {
+        ImagePtr image;
+        qint64 lastUsed;
+    };
+
+    std::vector<Emote> emotes_;
+    std::mt19937 random_{0};
+};
+
+/// Something sampled during the soak that must not grow without bound
+struct Gauge {
+    QString name;
+    std::function<int64_t()> read;
+    std::vector<int64_t> samples;
+    /// If set, read with every sample. The gauge may never exceed it.
+    std::function<int64_t()> limit = {};
+    std::vector<int64_t> limits = {};
+};
+
+/// Returns a description of the growth if the gauge still grew after the
+/// warm-up.
+///
+/// The first third of the samples is the warm-up, where caches and buffers
+/// fill up. The maximum of the last third may only exceed the maximum of
+/// the second third by a small tolerance.
+std::optional<QString> checkBounded(const Gauge &gauge)
+{
+    const auto &samples = gauge.samples;
+    for (size_t i = 0; i < gauge.limits.size(); i++)
+    {
+        if (samples[i] > gauge.limits[i])
+        {
+            return u"%1 grew to %2 in sample %3, above its limit of %4"_s
+                .arg(gauge.name)
+                .arg(samples[i])
+                .arg(i)
+                .arg(gauge.limits[i]);
+        }
+    }
+
+    auto warmUp = samples.size() / 3;
+    auto middle = warmUp + (samples.size() - warmUp) / 2;
+    if (middle <= warmUp || middle >= samples.size())
+    {
+        return std::nullopt;
+    }
+
+    auto settled = *std::max_element(samples.begin() + warmUp,
+                                     samples.begin() + middle);
+    auto late = *std::max_element(samples.begin() + middle, samples.end());
+    auto tolerance = std::max<int64_t>(16, settled / 10);
+    if (late <= settled + tolerance)
+    {
+        return std::nullopt;
+    }
+
+    QStringList values;
+    for (auto value : samples)
+    {
+        values.append(QString::number(value));
+    }
+    return u"%1 grew from %2 to %3 (samples: %4)"_s.arg(gauge.name)
+        .arg(settled)
+        .arg(late)
+        .arg(values.join(u", "));
+}
+
+}  // namespace
+
+/// Runs simulated hours of chat in many channels through IrcMessageHandler
+/// and checks that no DebugCount counter, cache or buffer keeps growing.
+///
+/// The length can be changed with the environment variables
+/// `CHATTERINO_SOAK_HOURS` and `CHATTERINO_SOAK_CHANNELS`. The resident set
+/// size is only checked if the hours are set, the default run is too short
+/// for the allocator to settle.
+TEST(Soak, BoundedGrowth)
+{
+    auto hours = qEnvironmentVariableIntValue("CHATTERINO_SOAK_HOURS");
+    auto checkRss = hours > 0;
+    if (hours <= 0)
+    {
+        hours = DEFAULT_HOURS;
+    }
+    auto nChannels = qEnvironmentVariableIntValue("CHATTERINO_SOAK_CHANNELS");
+    if (nChannels <= 0)
+    {
+        nChannels = DEFAULT_CHANNELS;
+    }
+
+    simulatedTime = START_TIME;
+    MockApplication app;
+
+    std::vector<std::shared_ptr<TwitchChannel>> channels;
+    std::vector<ChatGenerator> generators;
+    for (int i = 0; i < nChannels; i++)
+    {
+        auto name = u"soak%1"_s.arg(i);
+        auto roomID = QString::number(1000 + i);
+        auto channel = std::make_shared<TwitchChannel>(name);
+        channel->setRoomId(roomID);
+        app.twitch.mockChannels.emplace(name, channel);
+        channels.push_back(std::move(channel));
+        generators.emplace_back(name, roomID, static_cast<uint32_t>(i + 1));
+    }
+
+    std::vector<Gauge> gauges;
+    for (size_t key = 0; key < static_cast<size_t>(DebugObject::Count); key++)
+    {
+        auto target = static_cast<DebugObject>(key);
+        if (std::ranges::find(CUMULATIVE_COUNTERS, target) !=
+            CUMULATIVE_COUNTERS.end())
+        {
+            continue;
+        }
+        gauges.push_back({
+            .name = qmagicenum::enumNameString(target),
+            .read =
+                [target] {
+                    return DebugCount::get(target);
+                },
+            .samples = {},
+        });
+    }
+    auto sumChannels = [&](auto &&fn) {
+        return [&channels, fn] {
+            int64_t sum = 0;
+            for (const auto &channel : channels)
+            {
+                sum += static_cast<int64_t>(fn(*channel));
+            }
+            return sum;
+        };
+    };
+    gauges.push_back({
+        .name = u"reply threads"_s,
+        .read = sumChannels([](const TwitchChannel &channel) {
+            return channel.threads().size();
+        }),
+        .samples = {},
+    });
+    gauges.push_back({
+        .name = u"archived messages"_s,
+        .read = sumChannels([](const TwitchChannel &channel) {
+            return channel.archive().size();
+        }),
+        .samples = {},
+    });
+    gauges.push_back({
+        .name = u"repeated message users"_s,
+        .read =
+            [&app] {
+                return static_cast<int64_t>(
+                    app.repeatedMessages.trackedUsers());
+            },
+        .samples = {},
+    });
+
+    // Users expire from the metadata store once all their fields are older
+    // than their TTL. So it may only contain the users that joined within
+    // the longest TTL and the ones that joined earlier and kept chatting.
+    std::chrono::seconds longestTtl{0};
+    for (auto field : magic_enum::enum_values<UserMetadataStore::Field>())
+    {
+        longestTtl = std::max(longestTtl, UserMetadataStore::ttl(field));
+    }
+    const auto metadataWindow =
+        std::chrono::duration_cast<std::chrono::milliseconds>(longestTtl)
+            .count() /
+        METADATA_TIME_SCALE;
+    auto usersJoined = [&generators] {
+        int64_t sum = 0;
+        for (const auto &generator : generators)
+        {
+            sum += static_cast<int64_t>(generator.usersJoined());
+        }
+        return sum;
+    };
+    // Simulated time -> users that joined until then, for every sample
+    std::vector<std::pair<qint64, int64_t>> joined{{START_TIME, 0}};
+    gauges.push_back({
+        .name = u"user metadata users"_s,
+        .read =
+            [&app] {
+                // The app prunes it whenever it's saved
+                app.userMetadata.prune();
+                return static_cast<int64_t>(app.userMetadata.size());
+            },
+        .samples = {},
+        .limit =
+            [&] {
+                int64_t joinedBefore = 0;
+                for (const auto &[time, count] : joined)
+                {
+                    if (time <= simulatedTime - metadataWindow)
+                    {
+                        joinedBefore = count;
+                    }
+                }
+                return usersJoined() - joinedBefore +
+                       static_cast<int64_t>(ChatGenerator::ACTIVE_USERS *
+                                            generators.size());
+            },
+    });
+    if (checkRss)
+    {
+        gauges.push_back({
+            .name = u"resident set size"_s,
+            .read = residentSetSize,
+            .samples = {},
+        });
+    }
+
+    EmoteImages emotes;
+
+    const auto end = START_TIME + hours * HOUR_MS;
+    auto nextSample = START_TIME + SAMPLE_INTERVAL_MS;
+    for (; simulatedTime < end; simulatedTime += TICK_MS)
+    {
+        for (size_t i = 0; i < channels.size(); i++)
+        {
+            std::unique_ptr<Communi::IrcMessage> message(
+                Communi::IrcMessage::fromData(generators[i].next(), nullptr));
+            ASSERT_NE(message.get(), nullptr);
+            IrcMessageHandler::parseMessageInto(message.get(), *channels[i],
+                                                channels[i].get());
+            emotes.use();
+        }
+
+        if (simulatedTime >= nextSample)
+        {
+            nextSample += SAMPLE_INTERVAL_MS;
+
+            // Both run on timers in the app, which don't fire here. The
+            // channels clear their threads every five minutes.
+            for (const auto &channel : channels)
+            {
+                TwitchChannelTestAccess::cleanUpReplyThreads(*channel);
+            }
+            emotes.expire();
+
+            for (auto &gauge : gauges)
+            {
+                gauge.samples.push_back(gauge.read());
+                if (gauge.limit)
+                {
+                    gauge.limits.push_back(gauge.limit());
+                }
+            }
+            joined.emplace_back(simulatedTime, usersJoined());
+        }
+    }
+
+    for (const auto &channel : channels)
+    {
+        // The chatter colors have a fixed capacity that a short run doesn't
+        // reach, so the limit is checked instead of the growth
+        ASSERT_LE(channel->colorsSize(),
+                  static_cast<size_t>(ChannelChatters::maxChatterColorCount));
+    }
+
+    for (const auto &gauge : gauges)
+    {
+        auto growth = checkBounded(gauge);
+        EXPECT_FALSE(growth.has_value()) << growth.value_or(QString());
+    }
+}
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "debug/StartupTrace.hpp"
+
+#include "Test.hpp"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QTemporaryDir>
+
+#include <thread>
+
+using namespace chatterino;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+QJsonArray readEvents(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return {};
+    }
+    return QJsonDocument::fromJson(file.readAll())
+        .object()
+        .value("traceEvents")
+        .toArray();
+}
+
+/// Returns all events with the name `name`
+QJsonArray eventsNamed(const QJsonArray &events, const QString &name)
+{
+    QJsonArray result;
+    for (const auto &event : events)
+    {
+        if (event.toObject().value("name").toString() == name)
+        {
+            result.append(event);
+        }
+    }
+    return result;
+}
+
+class StartupTraceTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(this->dir.isValid());
+        this->path = this->dir.filePath(u"trace.json"_s);
+    }
+
+    void TearDown() override
+    {
+        // Don't leak the trace into other tests
+        StartupTrace::finish();
+    }
+
+    QTemporaryDir dir;
+    QString path;
+};
+
+}  // namespace
+
+TEST_F(StartupTraceTest, Disabled)
+{
+    ASSERT_FALSE(StartupTrace::enabled());
+    ASSERT_EQ(StartupTrace::now(), 0);
+
+    // None of these are recorded
+    StartupTrace::complete("test", u"complete"_s, 0);
+    StartupTrace::instant("test", u"instant"_s);
+    {
+        StartupTrace::Scope scope("test", u"scope"_s);
+    }
+
+    StartupTrace::start(this->path);
+    StartupTrace::finish();
+
+    auto events = readEvents(this->path);
+    ASSERT_TRUE(eventsNamed(events, u"complete"_s).isEmpty());
+    ASSERT_TRUE(eventsNamed(events, u"instant"_s).isEmpty());
+    ASSERT_TRUE(eventsNamed(events, u"scope"_s).isEmpty());
+}
+
+TEST_F(StartupTraceTest, WritesEvents)
+{
+    StartupTrace::start(this->path);
+    ASSERT_TRUE(StartupTrace::enabled());
+
+    auto begin = StartupTrace::now();
+    {
+        StartupTrace::Scope scope("test", u"scope"_s);
+    }
+    StartupTrace::complete("test", u"complete"_s, begin, {{"key", "value"}});
+    StartupTrace::async("test", u"async"_s, 42, begin);
+    StartupTrace::instant("test", u"instant"_s);
+    std::thread([] {
+        StartupTrace::instant("test", u"other thread"_s);
+    }).join();
+
+    // The file is only written once the trace is finished
+    ASSERT_FALSE(QFile::exists(this->path));
+    StartupTrace::finish();
+    ASSERT_FALSE(StartupTrace::enabled());
+
+    auto events = readEvents(this->path);
+
+    auto scope = eventsNamed(events, u"scope"_s);
+    ASSERT_EQ(scope.size(), 1);
+    ASSERT_EQ(scope[0]["ph"].toString(), u"X"_s);
+    ASSERT_EQ(scope[0]["cat"].toString(), u"test"_s);
+    ASSERT_GE(scope[0]["ts"].toInteger(), begin);
+    ASSERT_GE(scope[0]["dur"].toInteger(), 0);
+
+    auto complete = eventsNamed(events, u"complete"_s);
+    ASSERT_EQ(complete.size(), 1);
+    ASSERT_EQ(complete[0]["ts"].toInteger(), begin);
+    ASSERT_EQ(complete[0]["args"]["key"].toString(), u"value"_s);
+
+    // Async spans are written as a begin and an end event
+    auto async = eventsNamed(events, u"async"_s);
+    ASSERT_EQ(async.size(), 2);
+    ASSERT_EQ(async[0]["ph"].toString(), u"b"_s);
+    ASSERT_EQ(async[1]["ph"].toString(), u"e"_s);
+    ASSERT_EQ(async[0]["id"].toString(), u"2a"_s);
+    ASSERT_EQ(async[1]["id"].toString(), u"2a"_s);
+    ASSERT_LE(async[0]["ts"].toInteger(), async[1]["ts"].toInteger());
+
+    auto instant = eventsNamed(events, u"instant"_s);
+    ASSERT_EQ(instant.size(), 1);
+    ASSERT_EQ(instant[0]["ph"].toString(), u"i"_s);
+
+    // Every thread gets its own ID and a name
+    auto other = eventsNamed(events, u"other thread"_s);
+    ASSERT_EQ(other.size(), 1);
+    ASSERT_NE(other[0]["tid"].toInt(), instant[0]["tid"].toInt());
+
+    auto threads = eventsNamed(events, u"thread_name"_s);
+    ASSERT_EQ(threads.size(), 2);
+    ASSERT_EQ(threads[0]["ph"].toString(), u"M"_s);
+    ASSERT_EQ(threads[0]["tid"].toInt(), instant[0]["tid"].toInt());
+    ASSERT_EQ(threads[0]["args"]["name"].toString(), u"GUI"_s);
+    ASSERT_EQ(threads[1]["tid"].toInt(), other[0]["tid"].toInt());
+}
+
+TEST_F(StartupTraceTest, NothingAfterFinish)
+{
+    StartupTrace::start(this->path);
+    StartupTrace::instant("test", u"before"_s);
+    StartupTrace::finish();
+    ASSERT_EQ(eventsNamed(readEvents(this->path), u"before"_s).size(), 1);
+
+    StartupTrace::instant("test", u"after"_s);
+    // Finishing twice doesn't write the file again
+    QFile::remove(this->path);
+    StartupTrace::finish();
+    ASSERT_FALSE(QFile::exists(this->path));
+}
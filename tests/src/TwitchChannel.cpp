@@ -7,12 +7,14 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/highlights/HighlightController.hpp"
 #include "messages/Message.hpp"
+#include "messages/MessageBuilder.hpp"
 #include "mocks/BaseApplication.hpp"
 #include "mocks/Logging.hpp"
 #include "mocks/TwitchIrcServer.hpp"
 #include "providers/twitch/ChannelPointReward.hpp"
 #include "providers/twitch/PubSubManager.hpp"
 #include "Test.hpp"
+#include "TwitchChannelTestAccess.hpp"
 
 #include <QJsonArray>
 #include <QJsonObject>
@@ -99,15 +101,6 @@ TEST(TwitchChannelDetail_isUnknownCommand, bad)
 
 namespace chatterino {
 
-class TwitchChannelTestAccess
-{
-public:
-    static void setRoomId(TwitchChannel &channel, const QString &roomId)
-    {
-        channel.setRoomId(roomId);
-    }
-};
-
 namespace {
 
 class MockApplication : public mock::BaseApplication
@@ -417,6 +410,46 @@ TEST(TwitchChannel, StalePinnedChatUnpinDoesNotClearNewerPin)
     EXPECT_EQ(channel.getMessageSnapshot().size(), messageCountBefore);
 }
 
+TEST(TwitchChannel, AppendedMessagesAreBatched)
+{
+    MockApplication app;
+    TwitchChannel channel("pajlada");
+
+    std::vector<std::vector<MessagePtr>> batches;
+    auto connection = channel.messagesAppended.connect(
+        [&](std::span<const AppendedMessage> messages) {
+            auto &batch = batches.emplace_back();
+            for (const auto &appended : messages)
+            {
+                batch.push_back(appended.message);
+            }
+        });
+
+    auto first = makeSystemMessage("first");
+    auto second = makeSystemMessage("second");
+    channel.addMessage(first, MessageContext::Repost);
+    channel.addMessage(second, MessageContext::Repost);
+    EXPECT_TRUE(batches.empty());
+
+    // Pending messages are delivered before the replacement
+    channel.replaceMessage(first, makeSystemMessage("replaced"));
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches[0], (std::vector<MessagePtr>{first, second}));
+
+    auto third = makeSystemMessage("third");
+    channel.addMessage(third, MessageContext::Repost);
+    channel.flushAppendedMessages();
+    channel.flushAppendedMessages();
+    ASSERT_EQ(batches.size(), 2);
+    EXPECT_EQ(batches[1], (std::vector<MessagePtr>{third}));
+
+    // Cleared messages are never delivered
+    channel.addMessage(makeSystemMessage("fourth"), MessageContext::Repost);
+    channel.clearMessages();
+    channel.flushAppendedMessages();
+    EXPECT_EQ(batches.size(), 2);
+}
+
 }  // namespace
 
 }  // namespace chatterino
@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "providers/twitch/TwitchChannel.hpp"
+
+#include <QString>
+
+namespace chatterino {
+
+class TwitchChannelTestAccess
+{
+public:
+    static void setRoomId(TwitchChannel &channel, const QString &roomId)
+    {
+        channel.setRoomId(roomId);
+    }
+
+    /// Runs what the channel's thread clear timer runs
+    static void cleanUpReplyThreads(TwitchChannel &channel)
+    {
+        channel.cleanUpReplyThreads();
+    }
+};
+
+}  // namespace chatterino
@@ -0,0 +1,239 @@
+// SPDX-FileCopyrightText: 2026 Contributors to Chatterino <https://chatterino.com>
+//
+// SPDX-License-Identifier: MIT
+
+#include "providers/UserMetadataStore.hpp"
+
+#include "Test.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QString>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include <chrono>
+
+using namespace chatterino;
+using namespace Qt::StringLiterals;
+using Field = UserMetadataStore::Field;
+
+namespace {
+
+constexpr qint64 START = 1'700'000'000'000;
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+qint64 fakeNow = START;
+
+qint64 fakeClock()
+{
+    return fakeNow;
+}
+
+}  // namespace
+
+TEST(UserMetadataStore, SetGet)
+{
+    UserMetadataStore store;
+    ASSERT_FALSE(store.get(u"11148817"_s, Field::DisplayName).has_value());
+
+    store.set(u"11148817"_s, u"PajLada"_s, Field::DisplayName, u"pajlada"_s);
+    ASSERT_EQ(store.get(u"11148817"_s, Field::DisplayName), u"pajlada"_s);
+    ASSERT_EQ(store.get(u"11148817"_s, Field::Login), u"pajlada"_s);
+    ASSERT_FALSE(store.get(u"11148817"_s, Field::Color).has_value());
+
+    ASSERT_EQ(store.getByLogin(u"PAJLADA"_s, Field::DisplayName),
+              u"pajlada"_s);
+    ASSERT_FALSE(store.getByLogin(u"forsen"_s, Field::DisplayName).has_value());
+
+    // users without an ID are ignored
+    store.set({}, u"forsen"_s, Field::Color, u"#ff0000"_s);
+    ASSERT_EQ(store.size(), 1U);
+}
+
+TEST(UserMetadataStore, Rename)
+{
+    UserMetadataStore store;
+    store.set(u"1"_s, u"old"_s, Field::Color, u"#ff0000"_s);
+    ASSERT_EQ(store.getByLogin(u"old"_s, Field::Color), u"#ff0000"_s);
+
+    store.set(u"1"_s, u"new"_s, Field::Color, u"#00ff00"_s);
+    ASSERT_FALSE(store.getByLogin(u"old"_s, Field::Color).has_value());
+    ASSERT_EQ(store.getByLogin(u"new"_s, Field::Color), u"#00ff00"_s);
+}
+
+TEST(UserMetadataStore, Expiry)
+{
+    UserMetadataStore store;
+    auto now = QDateTime::currentDateTimeUtc();
+    auto pronounsTTL = UserMetadataStore::ttl(Field::Pronouns).count();
+
+    store.set(u"1"_s, u"user"_s, Field::Pronouns, u"they/them"_s,
+              now.addSecs(-pronounsTTL - 1));
+    store.set(u"1"_s, {}, Field::Color, u"#ff0000"_s, now.addSecs(-10));
+    ASSERT_FALSE(store.get(u"1"_s, Field::Pronouns).has_value());
+    ASSERT_EQ(store.get(u"1"_s, Field::Color), u"#ff0000"_s);
+
+    // Expired fields aren't saved
+    UserMetadataStore restored;
+    ASSERT_TRUE(restored.merge(store.serialize()));
+    ASSERT_FALSE(restored.get(u"1"_s, Field::Pronouns).has_value());
+    ASSERT_EQ(restored.get(u"1"_s, Field::Color), u"#ff0000"_s);
+}
+
+TEST(UserMetadataStore, Clock)
+{
+    fakeNow = START;
+    UserMetadataStore store(&fakeClock);
+    auto ttlMs = [](Field field) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   UserMetadataStore::ttl(field))
+            .count();
+    };
+
+    // Values are set at the store's time
+    store.set(u"1"_s, u"user"_s, Field::Pronouns, u"they/them"_s);
+    store.set(u"1"_s, {}, Field::Color, u"#ff0000"_s);
+    ASSERT_EQ(store.get(u"1"_s, Field::Pronouns), u"they/them"_s);
+
+    fakeNow += ttlMs(Field::Pronouns);
+    ASSERT_FALSE(store.get(u"1"_s, Field::Pronouns).has_value());
+    ASSERT_EQ(store.get(u"1"_s, Field::Color), u"#ff0000"_s);
+    store.prune();
+    ASSERT_EQ(store.size(), 1U);
+
+    fakeNow = START + ttlMs(Field::Color);
+    ASSERT_FALSE(store.get(u"1"_s, Field::Color).has_value());
+    store.prune();
+    ASSERT_EQ(store.size(), 0U);
+}
+
+TEST(UserMetadataStore, RoundTrip)
+{
+    UserMetadataStore store;
+    store.set(u"1"_s, u"one"_s, Field::DisplayName, u"One"_s);
+    store.set(u"1"_s, u"one"_s, Field::ProfilePictureUrl,
+              u"https://example.com/1.png"_s);
+    store.set(u"2"_s, u"two"_s, Field::Pronouns, {});
+
+    UserMetadataStore restored;
+    ASSERT_TRUE(restored.merge(store.serialize()));
+    ASSERT_EQ(restored.size(), 2U);
+    ASSERT_EQ(restored.get(u"1"_s, Field::DisplayName), u"One"_s);
+    ASSERT_EQ(restored.get(u"1"_s, Field::ProfilePictureUrl),
+              u"https://example.com/1.png"_s);
+    ASSERT_EQ(restored.getByLogin(u"two"_s, Field::Pronouns), QString());
+}
+
+TEST(UserMetadataStore, MergeKeepsNewer)
+{
+    auto now = QDateTime::currentDateTimeUtc();
+
+    UserMetadataStore older;
+    older.set(u"1"_s, u"one"_s, Field::DisplayName, u"Old"_s, now.addSecs(-60));
+    older.set(u"1"_s, u"one"_s, Field::Color, u"#ff0000"_s, now.addSecs(-60));
+
+    UserMetadataStore store;
+    store.set(u"1"_s, u"one"_s, Field::DisplayName, u"New"_s, now);
+    ASSERT_TRUE(store.merge(older.serialize()));
+
+    ASSERT_EQ(store.get(u"1"_s, Field::DisplayName), u"New"_s);
+    ASSERT_EQ(store.get(u"1"_s, Field::Color), u"#ff0000"_s);
+}
+
+TEST(UserMetadataStore, Invalid)
+{
+    UserMetadataStore store;
+    store.set(u"1"_s, u"one"_s, Field::DisplayName, u"One"_s);
+    auto data = store.serialize();
+
+    UserMetadataStore restored;
+    ASSERT_FALSE(restored.merge({}));
+    ASSERT_FALSE(restored.merge(QByteArrayView(data).first(data.size() - 1)));
+
+    auto otherVersion = data;
+    otherVersion[7] = static_cast<char>(UserMetadataStore::VERSION + 1);
+    ASSERT_FALSE(restored.merge(otherVersion));
+
+    ASSERT_EQ(restored.size(), 0U);
+}
+
+TEST(UserMetadataStore, LoadFromFile)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    auto path = dir.filePath(u"users.bin"_s);
+    {
+        UserMetadataStore source;
+        source.set(u"1"_s, u"one"_s, Field::DisplayName, u"One"_s);
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(source.serialize());
+    }
+
+    auto waitForLoad = [] {
+        QThreadPool::globalInstance()->waitForDone();
+        QCoreApplication::processEvents();
+    };
+
+    UserMetadataStore store(path);
+    waitForLoad();
+    ASSERT_EQ(store.get(u"1"_s, Field::DisplayName), u"One"_s);
+
+    // Stores destroyed while they're loading drop the loaded users
+    {
+        UserMetadataStore destroyed(path);
+    }
+    waitForLoad();
+}
+
+TEST(UserMetadataStore, PruneExpired)
+{
+    UserMetadataStore store;
+    auto now = QDateTime::currentDateTimeUtc();
+    auto pronounsTTL = UserMetadataStore::ttl(Field::Pronouns).count();
+
+    store.set(u"1"_s, {}, Field::Pronouns, u"they/them"_s,
+              now.addSecs(-pronounsTTL - 1));
+    store.set(u"2"_s, u"two"_s, Field::Pronouns, u"he/him"_s,
+              now.addSecs(-pronounsTTL - 1));
+    // One field that's still fresh keeps the user
+    store.set(u"2"_s, {}, Field::Color, u"#ff0000"_s, now);
+    store.set(u"3"_s, u"three"_s, Field::Pronouns, u"she/her"_s,
+              now.addYears(-1));
+    ASSERT_EQ(store.size(), 3U);
+
+    store.prune();
+    ASSERT_EQ(store.size(), 1U);
+    ASSERT_EQ(store.getByLogin(u"two"_s, Field::Color), u"#ff0000"_s);
+
+    // The login of a pruned user can be taken by someone else
+    store.set(u"4"_s, u"three"_s, Field::Color, u"#00ff00"_s);
+    ASSERT_EQ(store.getByLogin(u"three"_s, Field::Color), u"#00ff00"_s);
+}
+
+TEST(UserMetadataStore, PruneToLimit)
+{
+    UserMetadataStore store;
+    auto now = QDateTime::currentDateTimeUtc();
+
+    // User i was updated i seconds after the first one
+    const size_t extra = 10;
+    const auto total = UserMetadataStore::MAX_USERS + extra;
+    for (size_t i = 0; i < total; i++)
+    {
+        store.set(QString::number(i), {}, Field::Color, u"#ff0000"_s,
+                  now.addSecs(static_cast<qint64>(i) -
+                              static_cast<qint64>(total)));
+    }
+    ASSERT_EQ(store.size(), total);
+
+    store.prune();
+    ASSERT_EQ(store.size(), UserMetadataStore::MAX_USERS);
+    // The users that were updated the longest time ago are dropped
+    ASSERT_FALSE(store.get(u"0"_s, Field::Color).has_value());
+    ASSERT_FALSE(
+        store.get(QString::number(extra - 1), Field::Color).has_value());
+    ASSERT_TRUE(store.get(QString::number(extra), Field::Color).has_value());
+}